@@ -7,9 +7,13 @@ import java.io.InputStream;
 import java.io.OutputStream;
 import java.io.PrintWriter;
 import java.io.StringWriter;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.Paths;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Hashtable;
 import java.util.List;
 import java.util.jar.JarFile;
@@ -23,6 +27,7 @@ import org.eclipse.jdt.core.dom.ASTVisitor;
 import org.eclipse.jdt.core.dom.BlockComment;
 import org.eclipse.jdt.core.dom.Comment;
 import org.eclipse.jdt.core.dom.CompilationUnit;
+import org.eclipse.jdt.core.dom.FileASTRequestor;
 import org.eclipse.jdt.core.dom.LineComment;
 import org.eclipse.jdt.core.dom.PackageDeclaration;
 
@@ -30,112 +35,191 @@ public class JavaIndexer
 {	
 	public static void processFile(int address, String filePath, String fileContent, String languageStandard, String classPath, int verbose)
 	{
-		processFile(new JavaIndexerAstVisitorClient(address), filePath, fileContent, languageStandard, classPath, verbose);
+		JavaIndexerAstVisitorClient astVisitorClient = new JavaIndexerAstVisitorClient(address);
+		processFile(astVisitorClient, filePath, fileContent, languageStandard, classPath, verbose);
+		astVisitorClient.flush();
 	}
 	
-	public static void processFile(AstVisitorClient astVisitorClient, String filePath, String fileContent, String languageStandard, String classPath, int verbose)
+	// Parses all files of the batch with a single environment, so the classpath is only set up once.
+	// The files are separated by the same separator as the classpath entries. The native side is told
+	// when each file starts and finishes, so each file still gets its own records. Files it does not
+	// know about are skipped.
+	public static void processFiles(int address, String filePaths, String languageStandard, String classPath, int verbose)
 	{
+		JavaIndexerAstVisitorClient batchClient = new JavaIndexerAstVisitorClient(address);
 		try
 		{
-			astVisitorClient.logInfo("indexing source file: " + filePath);
-			
-			Path path = Paths.get(filePath);
-		
-			ASTParser parser = ASTParser.newParser(AST.JLS12);
-			
-			parser.setResolveBindings(true); // solve "bindings" like the declaration of the type used in a var decl
-			parser.setKind(ASTParser.K_COMPILATION_UNIT); // specify to parse the entire compilation unit
-			parser.setBindingsRecovery(true); // also return bindings that are not resolved completely
-			parser.setStatementsRecovery(true);
-
+			List<String> sourceFilePaths = new ArrayList<>();
+			for (String filePath: filePaths.split("\\;"))
 			{
-				String convertedLanguageStandard = convertLanguageStandard(languageStandard);
-				astVisitorClient.logInfo("using language standard " + convertedLanguageStandard);
-				
-				Hashtable<String, String> options = JavaCore.getOptions();
-			    options.put(JavaCore.COMPILER_PB_ENABLE_PREVIEW_FEATURES, JavaCore.ENABLED);
-			    options.put(JavaCore.COMPILER_PB_REPORT_PREVIEW_FEATURES, JavaCore.IGNORE);
-			    options.put(JavaCore.COMPILER_SOURCE, convertedLanguageStandard);
-			    options.put(JavaCore.COMPILER_CODEGEN_TARGET_PLATFORM, convertedLanguageStandard);
-			    options.put(JavaCore.COMPILER_COMPLIANCE, convertedLanguageStandard);
-				parser.setCompilerOptions(options);
+				if (!filePath.isEmpty())
+				{
+					sourceFilePaths.add(filePath);
+				}
 			}
 			
-			parser.setUnitName(path.getFileName().toString());
-	
-			List<String> classpath = new ArrayList<>();
-			List<String> sources = new ArrayList<>();
+			batchClient.logInfo("indexing batch of " + sourceFilePaths.size() + " source files");
 			
-			for (String classPathEntry: classPath.split("\\;"))
-			{	
-				if (classPathEntry.endsWith(".jar"))
-				{
-					classpath.add(classPathEntry);
-				}
-				else if(classPathEntry.endsWith(".aar"))
+			String[] encodings = new String[sourceFilePaths.size()];
+			Arrays.fill(encodings, StandardCharsets.UTF_8.name());
+			
+			ASTParser parser = createParser(batchClient, languageStandard, classPath);
+			parser.createASTs(sourceFilePaths.toArray(new String[0]), encodings, new String[0], new FileASTRequestor()
+			{
+				@Override
+				public void acceptAST(String sourceFilePath, CompilationUnit cu)
 				{
-					File extractedJarFile = extractClassesJarFileFromAarFile(Paths.get(classPathEntry), astVisitorClient);
-					if (extractedJarFile != null)
+					if (getInterrupted(address) || !startFile(address, sourceFilePath))
+					{
+						return;
+					}
+					
+					JavaIndexerAstVisitorClient astVisitorClient = new JavaIndexerAstVisitorClient(address);
+					try
 					{
-						classpath.add(extractedJarFile.getAbsolutePath());
+						astVisitorClient.logInfo("indexing source file: " + sourceFilePath);
+						
+						Path path = Paths.get(sourceFilePath);
+						
+						// tabs are replaced the same way the native side does it for single files
+						String fileContent = new String(Files.readAllBytes(path), StandardCharsets.UTF_8).replace('\t', ' ');
+						
+						indexCompilationUnit(astVisitorClient, path, fileContent, cu, verbose);
 					}
+					catch (Throwable e)
+					{
+						logException(astVisitorClient, e);
+					}
+					astVisitorClient.flush();
+					finishFile(address);
 				}
-				else if (!classPathEntry.isEmpty())
-				{
-					sources.add(classPathEntry);
-				}		
-			}
+			}, null);
+		}
+		catch (Throwable e)
+		{
+			logException(batchClient, e);
+		}
+	}
+	
+	public static void processFile(AstVisitorClient astVisitorClient, String filePath, String fileContent, String languageStandard, String classPath, int verbose)
+	{
+		try
+		{
+			astVisitorClient.logInfo("indexing source file: " + filePath);
 			
-			parser.setEnvironment(classpath.toArray(new String[0]), sources.toArray(new String[0]), null, true);
+			Path path = Paths.get(filePath);
+		
+			ASTParser parser = createParser(astVisitorClient, languageStandard, classPath);
+			parser.setUnitName(path.getFileName().toString());
 			parser.setSource(fileContent.toCharArray());
 			
 			CompilationUnit cu = (CompilationUnit) parser.createAST(null);
 			
-			ASTVisitor visitor;
-			if (verbose != 0)
-			{
-				visitor = new VerboseContextAwareAstVisitor(astVisitorClient, path.toFile(), fileContent, cu);
-			}
-			else
+			indexCompilationUnit(astVisitorClient, path, fileContent, cu, verbose);
+		}
+		catch (Throwable e)
+		{
+			logException(astVisitorClient, e);
+		}
+	}
+	
+	private static ASTParser createParser(AstVisitorClient astVisitorClient, String languageStandard, String classPath) throws IOException
+	{
+		ASTParser parser = ASTParser.newParser(AST.JLS12);
+		
+		parser.setResolveBindings(true); // solve "bindings" like the declaration of the type used in a var decl
+		parser.setKind(ASTParser.K_COMPILATION_UNIT); // specify to parse the entire compilation unit
+		parser.setBindingsRecovery(true); // also return bindings that are not resolved completely
+		parser.setStatementsRecovery(true);
+
+		{
+			String convertedLanguageStandard = convertLanguageStandard(languageStandard);
+			astVisitorClient.logInfo("using language standard " + convertedLanguageStandard);
+			
+			Hashtable<String, String> options = JavaCore.getOptions();
+		    options.put(JavaCore.COMPILER_PB_ENABLE_PREVIEW_FEATURES, JavaCore.ENABLED);
+		    options.put(JavaCore.COMPILER_PB_REPORT_PREVIEW_FEATURES, JavaCore.IGNORE);
+		    options.put(JavaCore.COMPILER_SOURCE, convertedLanguageStandard);
+		    options.put(JavaCore.COMPILER_CODEGEN_TARGET_PLATFORM, convertedLanguageStandard);
+		    options.put(JavaCore.COMPILER_COMPLIANCE, convertedLanguageStandard);
+			parser.setCompilerOptions(options);
+		}
+
+		List<String> classpath = new ArrayList<>();
+		List<String> sources = new ArrayList<>();
+		
+		for (String classPathEntry: classPath.split("\\;"))
+		{	
+			if (classPathEntry.endsWith(".jar"))
 			{
-				visitor = new ContextAwareAstVisitor(astVisitorClient, path.toFile(), fileContent, cu);
+				classpath.add(classPathEntry);
 			}
-			
-			astVisitorClient.logInfo("starting AST traversal");
-			
-			cu.accept(visitor);
-	
-			for (IProblem problem: cu.getProblems())
+			else if(classPathEntry.endsWith(".aar"))
 			{
-				if (problem.isError())
+				File extractedJarFile = extractClassesJarFileFromAarFile(Paths.get(classPathEntry), astVisitorClient);
+				if (extractedJarFile != null)
 				{
-					Range range = new Range(
-							cu.getLineNumber(problem.getSourceStart()),
-							cu.getColumnNumber(problem.getSourceStart() + 1),
-							cu.getLineNumber(problem.getSourceEnd()),
-							cu.getColumnNumber(problem.getSourceEnd()) + 1);
-	
-					astVisitorClient.recordError(problem.getMessage(), false, true, range);
+					classpath.add(extractedJarFile.getAbsolutePath());
 				}
 			}
-			
-			for (Object commentObject: cu.getCommentList())
+			else if (!classPathEntry.isEmpty())
 			{
-				if ((commentObject instanceof LineComment) || (commentObject instanceof BlockComment))
-				{
-					((Comment) commentObject).accept(visitor);
-				}
+				sources.add(classPathEntry);
+			}		
+		}
+		
+		parser.setEnvironment(classpath.toArray(new String[0]), sources.toArray(new String[0]), null, true);
+		
+		return parser;
+	}
+	
+	private static void indexCompilationUnit(AstVisitorClient astVisitorClient, Path path, String fileContent, CompilationUnit cu, int verbose)
+	{
+		ASTVisitor visitor;
+		if (verbose != 0)
+		{
+			visitor = new VerboseContextAwareAstVisitor(astVisitorClient, path.toFile(), fileContent, cu);
+		}
+		else
+		{
+			visitor = new ContextAwareAstVisitor(astVisitorClient, path.toFile(), fileContent, cu);
+		}
+		
+		astVisitorClient.logInfo("starting AST traversal");
+		
+		cu.accept(visitor);
+
+		for (IProblem problem: cu.getProblems())
+		{
+			if (problem.isError())
+			{
+				Range range = new Range(
+						cu.getLineNumber(problem.getSourceStart()),
+						cu.getColumnNumber(problem.getSourceStart() + 1),
+						cu.getLineNumber(problem.getSourceEnd()),
+						cu.getColumnNumber(problem.getSourceEnd()) + 1);
+
+				astVisitorClient.recordError(problem.getMessage(), false, true, range);
 			}
 		}
-		catch (Exception e)
+		
+		for (Object commentObject: cu.getCommentList())
 		{
-			StringWriter sw = new StringWriter();
-			PrintWriter pw = new PrintWriter(sw);
-			e.printStackTrace(pw);
-			astVisitorClient.logError(sw.toString());
+			if ((commentObject instanceof LineComment) || (commentObject instanceof BlockComment))
+			{
+				((Comment) commentObject).accept(visitor);
+			}
 		}
 	}
 	
+	private static void logException(AstVisitorClient astVisitorClient, Throwable e)
+	{
+		StringWriter sw = new StringWriter();
+		PrintWriter pw = new PrintWriter(sw);
+		e.printStackTrace(pw);
+		astVisitorClient.logError(sw.toString());
+	}
+	
 	public static String getPackageName(String fileContent)
 	{
 		String packageName = "";
@@ -247,42 +331,11 @@ public class JavaIndexer
 	
 	static public native void logError(int address, String error);
 	
-	static public native void recordSymbol(
-			int address, String symbolName, int symbolType, 
-			int access, int definitionKind);
-
-	static public native void recordSymbolWithLocation(
-			int address, String symbolName, int symbolType, 
-			int beginLine, int beginColumn, int endLine, int endColumn,
-			int access, int definitionKind);
-	
-	static public native void recordSymbolWithLocationAndScope(
-			int address, String symbolName, int symbolType, 
-			int beginLine, int beginColumn, int endLine, int endColumn,
-			int scopeBeginLine, int scopeBeginColumn, int scopeEndLine, int scopeEndColumn,
-			int access, int definitionKind
-	);
-	
-	static public native void recordSymbolWithLocationAndScopeAndSignature(
-			int address, String symbolName, int symbolType, 
-			int beginLine, int beginColumn, int endLine, int endColumn,
-			int scopeBeginLine, int scopeBeginColumn, int scopeEndLine, int scopeEndColumn,
-			int signatureBeginLine, int signatureBeginColumn, int signatureEndLine, int signatureEndColumn,
-			int access, int definitionKind
-	);
-
-	static public native void recordReference(
-			int address, int referenceKind, String referencedName, String contextName, int beginLine, int beginColumn, int endLine, int endColumn);
-
-	static public native void recordQualifierLocation(
-			int address, String qualifierName, int beginLine, int beginColumn, int endLine, int endColumn);
-	
-	static public native void recordLocalSymbol(
-			int address, String symbolName, int beginLine, int beginColumn, int endLine, int endColumn);
+	// passes the records collected in a RecordBuffer, the first byteCount bytes of the buffer are used
+	static public native void recordBatch(int address, ByteBuffer buffer, int byteCount);
 	
-	static public native void recordComment(
-			int address, int beginLine, int beginColumn, int endLine, int endColumn);
+	// returns false if the file is not part of the batch that is currently indexed
+	static public native boolean startFile(int address, String filePath);
 	
-	static public native void recordError(
-			int address, String message, int fatal, int indexed, int beginLine, int beginColumn, int endLine, int endColumn);
+	static public native void finishFile(int address);
 }
\ No newline at end of file
@@ -6,12 +6,14 @@ import com.sourcetrail.name.NameHierarchy;
 public class JavaIndexerAstVisitorClient extends AstVisitorClient 
 {
 	private int m_address;
+	private RecordBuffer m_recordBuffer;
 	private String m_javaLangPackageName;
 	private boolean m_javaLangPackageRecorded;
 
 	public JavaIndexerAstVisitorClient(int address)
 	{
 		m_address = address;
+		m_recordBuffer = new RecordBuffer(address);
 		
 		NameHierarchy javaLangPackageNameHierarchy = new NameHierarchy();
 		javaLangPackageNameHierarchy.push(new NameElement("java"));
@@ -49,9 +51,7 @@ public class JavaIndexerAstVisitorClient extends AstVisitorClient
 			NameHierarchy symbolName, SymbolKind symbolKind,
 			AccessKind access, DefinitionKind definitionKind) 
 	{
-		JavaIndexer.recordSymbol(
-				m_address, symbolName.serialize(), symbolKind.getValue(),  
-				access.getValue(), definitionKind.getValue());
+		recordSymbol(symbolName.serialize(), symbolKind, access, definitionKind);
 	}
 
 	@Override
@@ -59,10 +59,13 @@ public class JavaIndexerAstVisitorClient extends AstVisitorClient
 			NameHierarchy symbolName, SymbolKind symbolKind, Range range,
 			AccessKind access, DefinitionKind definitionKind) 
 	{
-		JavaIndexer.recordSymbolWithLocation(
-				m_address, symbolName.serialize(), symbolKind.getValue(), 
-				range.begin.line, range.begin.column, range.end.line, range.end.column, 
-				access.getValue(), definitionKind.getValue());
+		int symbolNameId = m_recordBuffer.addString(symbolName.serialize());
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_SYMBOL_WITH_LOCATION, 8);
+		m_recordBuffer.putInt(symbolNameId);
+		m_recordBuffer.putInt(symbolKind.getValue());
+		m_recordBuffer.putRange(range);
+		m_recordBuffer.putInt(access.getValue());
+		m_recordBuffer.putInt(definitionKind.getValue());
 	}
 
 	@Override
@@ -70,11 +73,14 @@ public class JavaIndexerAstVisitorClient extends AstVisitorClient
 			NameHierarchy symbolName, SymbolKind symbolKind, Range range,
 			Range scopeRange, AccessKind access, DefinitionKind definitionKind) 
 	{
-		JavaIndexer.recordSymbolWithLocationAndScope(
-				m_address, symbolName.serialize(), symbolKind.getValue(), 
-				range.begin.line, range.begin.column, range.end.line, range.end.column, 
-				scopeRange.begin.line, scopeRange.begin.column, scopeRange.end.line, scopeRange.end.column, 
-				access.getValue(), definitionKind.getValue());
+		int symbolNameId = m_recordBuffer.addString(symbolName.serialize());
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE, 12);
+		m_recordBuffer.putInt(symbolNameId);
+		m_recordBuffer.putInt(symbolKind.getValue());
+		m_recordBuffer.putRange(range);
+		m_recordBuffer.putRange(scopeRange);
+		m_recordBuffer.putInt(access.getValue());
+		m_recordBuffer.putInt(definitionKind.getValue());
 	}
 
 	@Override
@@ -82,12 +88,15 @@ public class JavaIndexerAstVisitorClient extends AstVisitorClient
 			NameHierarchy symbolName, SymbolKind symbolKind, Range range,
 			Range scopeRange, Range signatureRange, AccessKind access, DefinitionKind definitionKind) 
 	{
-		JavaIndexer.recordSymbolWithLocationAndScopeAndSignature(
-				m_address, symbolName.serialize(), symbolKind.getValue(), 
-				range.begin.line, range.begin.column, range.end.line, range.end.column, 
-				scopeRange.begin.line, scopeRange.begin.column, scopeRange.end.line, scopeRange.end.column, 
-				signatureRange.begin.line, signatureRange.begin.column, signatureRange.end.line, signatureRange.end.column, 
-				access.getValue(), definitionKind.getValue());
+		int symbolNameId = m_recordBuffer.addString(symbolName.serialize());
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE_AND_SIGNATURE, 16);
+		m_recordBuffer.putInt(symbolNameId);
+		m_recordBuffer.putInt(symbolKind.getValue());
+		m_recordBuffer.putRange(range);
+		m_recordBuffer.putRange(scopeRange);
+		m_recordBuffer.putRange(signatureRange);
+		m_recordBuffer.putInt(access.getValue());
+		m_recordBuffer.putInt(definitionKind.getValue());
 	}
 
 	@Override
@@ -98,16 +107,18 @@ public class JavaIndexerAstVisitorClient extends AstVisitorClient
 		String serializedReferencedName = referencedName.serialize();
 		if (!m_javaLangPackageRecorded && serializedReferencedName.startsWith(m_javaLangPackageName))
 		{
-			JavaIndexer.recordSymbol(
-					m_address, m_javaLangPackageName, SymbolKind.PACKAGE.getValue(),  
-					AccessKind.NONE.getValue(), DefinitionKind.NONE.getValue());
+			recordSymbol(m_javaLangPackageName, SymbolKind.PACKAGE, AccessKind.NONE, DefinitionKind.NONE);
 			
 			m_javaLangPackageRecorded = true;
 		}
 		
-		JavaIndexer.recordReference(
-				m_address, referenceKind.getValue(), serializedReferencedName, contextName.serialize(), 
-				range.begin.line, range.begin.column, range.end.line, range.end.column);
+		int referencedNameId = m_recordBuffer.addString(serializedReferencedName);
+		int contextNameId = m_recordBuffer.addString(contextName.serialize());
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_REFERENCE, 7);
+		m_recordBuffer.putInt(referenceKind.getValue());
+		m_recordBuffer.putInt(referencedNameId);
+		m_recordBuffer.putInt(contextNameId);
+		m_recordBuffer.putRange(range);
 	}
 
 	@Override
@@ -115,32 +126,54 @@ public class JavaIndexerAstVisitorClient extends AstVisitorClient
 			NameHierarchy qualifierName, 
 			Range range)
 	{
-		JavaIndexer.recordQualifierLocation(
-				m_address, qualifierName.serialize(), 
-				range.begin.line, range.begin.column, range.end.line, range.end.column);
+		int qualifierNameId = m_recordBuffer.addString(qualifierName.serialize());
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_QUALIFIER_LOCATION, 5);
+		m_recordBuffer.putInt(qualifierNameId);
+		m_recordBuffer.putRange(range);
 	}
 
 	@Override
 	public void recordLocalSymbol(NameHierarchy symbolName, Range range) 
 	{
-		JavaIndexer.recordLocalSymbol(
-				m_address, symbolName.serialize(),
-				range.begin.line, range.begin.column, range.end.line, range.end.column);
+		int symbolNameId = m_recordBuffer.addString(symbolName.serialize());
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_LOCAL_SYMBOL, 5);
+		m_recordBuffer.putInt(symbolNameId);
+		m_recordBuffer.putRange(range);
 	}
 
 	@Override
 	public void recordComment(Range range) 
 	{
-		JavaIndexer.recordComment(
-				m_address,
-				range.begin.line, range.begin.column, range.end.line, range.end.column);
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_COMMENT, 4);
+		m_recordBuffer.putRange(range);
 	}
 
 	@Override
 	public void recordError(String message, boolean fatal, boolean indexed, Range range) 
 	{
-		JavaIndexer.recordError(
-				m_address, message, (fatal ? 1 : 0), (indexed ? 1 : 0), 
-				range.begin.line, range.begin.column, range.end.line, range.end.column);
+		int messageId = m_recordBuffer.addString(message);
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_ERROR, 7);
+		m_recordBuffer.putInt(messageId);
+		m_recordBuffer.putInt(fatal ? 1 : 0);
+		m_recordBuffer.putInt(indexed ? 1 : 0);
+		m_recordBuffer.putRange(range);
 	}
-}
+	
+	// passes the records that are still buffered to the native code
+	public void flush()
+	{
+		m_recordBuffer.flush();
+	}
+	
+	private void recordSymbol(
+			String serializedSymbolName, SymbolKind symbolKind,
+			AccessKind access, DefinitionKind definitionKind)
+	{
+		int symbolNameId = m_recordBuffer.addString(serializedSymbolName);
+		m_recordBuffer.beginRecord(RecordBuffer.RECORD_SYMBOL, 4);
+		m_recordBuffer.putInt(symbolNameId);
+		m_recordBuffer.putInt(symbolKind.getValue());
+		m_recordBuffer.putInt(access.getValue());
+		m_recordBuffer.putInt(definitionKind.getValue());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+package com.sourcetrail;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import java.util.HashMap;
+import java.util.Map;
+
+// Collects the records of the indexed file in a direct buffer that is handed to the native code in
+// a single call whenever it is full. Each string is sent once and referenced by its index
+// afterwards. The record layout needs to match the decoding in JavaParser::doRecordBatch. The direct
+// buffer is only held while records are pending and is handed back to its thread on flush, so all
+// files indexed by the same thread reuse a single buffer.
+public class RecordBuffer
+{
+	public static final int RECORD_STRING = 0;
+	public static final int RECORD_SYMBOL = 1;
+	public static final int RECORD_SYMBOL_WITH_LOCATION = 2;
+	public static final int RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE = 3;
+	public static final int RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE_AND_SIGNATURE = 4;
+	public static final int RECORD_REFERENCE = 5;
+	public static final int RECORD_QUALIFIER_LOCATION = 6;
+	public static final int RECORD_LOCAL_SYMBOL = 7;
+	public static final int RECORD_COMMENT = 8;
+	public static final int RECORD_ERROR = 9;
+
+	private static final int INITIAL_CAPACITY = 1024 * 1024;
+	private static final ThreadLocal<ByteBuffer> s_unusedBuffer = new ThreadLocal<>();
+
+	private int m_address;
+	private ByteBuffer m_buffer;
+	private Map<String, Integer> m_stringIds;
+
+	public RecordBuffer(int address)
+	{
+		m_address = address;
+		m_buffer = null;
+		m_stringIds = new HashMap<>();
+	}
+
+	// strings have to be added before the record that references them is started
+	public int addString(String str)
+	{
+		Integer stringId = m_stringIds.get(str);
+		if (stringId != null)
+		{
+			return stringId;
+		}
+
+		byte[] bytes = str.getBytes(StandardCharsets.UTF_8);
+		reserve(8 + bytes.length);
+		m_buffer.putInt(RECORD_STRING);
+		m_buffer.putInt(bytes.length);
+		m_buffer.put(bytes);
+
+		stringId = m_stringIds.size();
+		m_stringIds.put(str, stringId);
+		return stringId;
+	}
+
+	public void beginRecord(int recordType, int intCount)
+	{
+		reserve(4 + intCount * 4);
+		m_buffer.putInt(recordType);
+	}
+
+	public void putInt(int value)
+	{
+		m_buffer.putInt(value);
+	}
+
+	public void putRange(Range range)
+	{
+		m_buffer.putInt(range.begin.line);
+		m_buffer.putInt(range.begin.column);
+		m_buffer.putInt(range.end.line);
+		m_buffer.putInt(range.end.column);
+	}
+
+	public void flush()
+	{
+		if (m_buffer == null)
+		{
+			return;
+		}
+
+		if (m_buffer.position() > 0)
+		{
+			JavaIndexer.recordBatch(m_address, m_buffer, m_buffer.position());
+		}
+		m_buffer.clear();
+		s_unusedBuffer.set(m_buffer);
+		m_buffer = null;
+	}
+
+	private void reserve(int byteCount)
+	{
+		if (m_buffer == null || m_buffer.remaining() < byteCount)
+		{
+			flush();
+			m_buffer = acquire(byteCount);
+		}
+	}
+
+	// takes the buffer of the current thread, a new one is only allocated if another record buffer
+	// of this thread still holds it or if it is too small
+	private static ByteBuffer acquire(int byteCount)
+	{
+		ByteBuffer buffer = s_unusedBuffer.get();
+		s_unusedBuffer.remove();
+
+		if (buffer == null || buffer.capacity() < byteCount)
+		{
+			buffer = ByteBuffer.allocateDirect(Math.max(INITIAL_CAPACITY, byteCount));
+			buffer.order(ByteOrder.nativeOrder());
+		}
+		return buffer;
+	}
+}
@@ -11,6 +11,7 @@
 #include "CommandLineParser.h"
 #include "ConsoleLogger.h"
 #include "FileLogger.h"
+#include "IndexingStatistics.h"
 #include "LanguagePackageManager.h"
 #include "logging.h"
 #include "LogManager.h"
@@ -64,6 +65,7 @@ void setupLogging()
 	fileLogger->setLogLevel(Logger::LOG_ALL);
 	fileLogger->deleteLogFiles(FileLogger::generateDatedFileName(L"log", L"", -30));
 	logManager->addLogger(fileLogger);
+	logManager->setLoggingAsync(true);
 }
 
 void addLanguagePackages()
@@ -168,6 +170,9 @@ int main(int argc, char *argv[])
 		}
 		else
 		{
+			IndexingStatistics::getInstance()->setOutputFilePath(
+				commandLineParser.getStatsJsonFilePath());
+
 			MessageLoadProject(
 				commandLineParser.getProjectFilePath(),
 				false,
@@ -220,6 +225,9 @@ int main(int argc, char *argv[])
 		}
 		else
 		{
+			IndexingStatistics::getInstance()->setOutputFilePath(
+				commandLineParser.getStatsJsonFilePath());
+
 			MessageLoadProject(
 				commandLineParser.getProjectFilePath(),
 				false,
@@ -0,0 +1,295 @@
+#include "CommandDispatchBenchmark.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <boost/process.hpp>
+
+#include "SharedMemory.h"
+#include "SharedMemoryRing.h"
+#include "utilityUuid.h"
+
+namespace bp = boost::process;
+
+namespace
+{
+const char* s_ringNamePrefix = "cdr_";
+const char* s_queueNamePrefix = "cdq_";
+const char* s_syncNamePrefix = "cds_";
+const char* s_readyCountKeyName = "ready_count";
+const char* s_commandsKeyName = "commands";
+
+const size_t s_queueCapacity = 64;
+const size_t s_stringPoolSize = 8388608 /* 8 MB */;
+const size_t s_initialQueueMemorySize = 4194304 /* 4 MB */;
+
+using SharedCommand = SharedMemory::Vector<SharedMemory::String>;
+using SharedCommandQueue = SharedMemory::Queue<SharedCommand>;
+
+// a record with the same fields and a typical amount of compiler flags of a C++ indexer command
+SharedMemoryRing::Record createCommand(size_t index)
+{
+	SharedMemoryRing::Record record;
+	record.type = 1;
+	record.fields.resize(6);
+	record.fields[0] = {"/project/src/module_" + std::to_string(index) + ".cpp"};
+	record.fields[1] = {"/project"};
+	record.fields[4] = {"/project/build"};
+	for (size_t i = 0; i < 20; i++)
+	{
+		record.fields[5].push_back("-I/project/include/component_" + std::to_string(i));
+		record.fields[5].push_back("-DFEATURE_" + std::to_string(i) + "=1");
+	}
+	record.fields[5].push_back("-std=c++17");
+	record.fields[5].push_back(record.fields[0].front());
+	return record;
+}
+
+SharedMemoryRing::Record createStopCommand()
+{
+	return SharedMemoryRing::Record();
+}
+
+void pushLocked(SharedMemory& memory, const SharedMemoryRing::Record& record)
+{
+	while (true)
+	{
+		{
+			SharedMemory::ScopedAccess access(&memory);
+			SharedCommandQueue* queue = access.accessValueWithAllocator<SharedCommandQueue>(
+				s_commandsKeyName);
+
+			if (queue->size() < s_queueCapacity)
+			{
+				queue->push_back(SharedCommand(access.getAllocator()));
+				SharedCommand& command = queue->back();
+				command.push_back(
+					SharedMemory::String(std::to_string(record.type).c_str(), access.getAllocator()));
+				for (const std::vector<std::string>& field: record.fields)
+				{
+					command.push_back(SharedMemory::String(
+						std::to_string(field.size()).c_str(), access.getAllocator()));
+					for (const std::string& str: field)
+					{
+						command.push_back(SharedMemory::String(str.c_str(), access.getAllocator()));
+					}
+				}
+				return;
+			}
+		}
+		std::this_thread::yield();
+	}
+}
+
+bool popLocked(SharedMemory& memory, SharedMemoryRing::Record& record)
+{
+	SharedMemory::ScopedAccess access(&memory);
+	SharedCommandQueue* queue = access.accessValueWithAllocator<SharedCommandQueue>(
+		s_commandsKeyName);
+	if (queue->empty())
+	{
+		return false;
+	}
+
+	const SharedCommand& command = queue->front();
+	size_t i = 0;
+	record.type = static_cast<uint32_t>(std::stoul(command[i++].c_str()));
+	record.fields.clear();
+	while (i < command.size())
+	{
+		const size_t count = std::stoul(command[i++].c_str());
+		record.fields.emplace_back();
+		for (size_t j = 0; j < count && i < command.size(); j++)
+		{
+			record.fields.back().push_back(command[i++].c_str());
+		}
+	}
+
+	queue->pop_front();
+	return true;
+}
+}	 // namespace
+
+std::string CommandDispatchBenchmark::queueTypeToString(QueueType type)
+{
+	switch (type)
+	{
+	case QUEUE_LOCKED:
+		return "locked";
+	case QUEUE_RING:
+		return "ring";
+	}
+	return "";
+}
+
+bool CommandDispatchBenchmark::stringToQueueType(const std::string& str, QueueType& type)
+{
+	for (QueueType t: {QUEUE_LOCKED, QUEUE_RING})
+	{
+		if (queueTypeToString(t) == str)
+		{
+			type = t;
+			return true;
+		}
+	}
+	return false;
+}
+
+int CommandDispatchBenchmark::runConsumer(QueueType type, const std::string& name)
+{
+	std::shared_ptr<SharedMemory> queueMemory;
+	std::shared_ptr<SharedMemoryRing> ring;
+	if (type == QUEUE_LOCKED)
+	{
+		queueMemory = std::make_shared<SharedMemory>(
+			s_queueNamePrefix + name, 0, SharedMemory::OPEN_ONLY);
+	}
+	else
+	{
+		ring = std::make_shared<SharedMemoryRing>(s_ringNamePrefix + name, 0, 0, false);
+	}
+
+	{
+		SharedMemory syncMemory(s_syncNamePrefix + name, 0, SharedMemory::OPEN_ONLY);
+		SharedMemory::ScopedAccess access(&syncMemory);
+		(*access.accessValue<size_t>(s_readyCountKeyName))++;
+	}
+
+	std::vector<long long> popNanoseconds;
+	SharedMemoryRing::Record record;
+	while (true)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const bool popped = ring ? ring->tryPop(record) : popLocked(*queueMemory, record);
+		if (!popped)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (record.type == 0)
+		{
+			break;
+		}
+
+		popNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+									 std::chrono::steady_clock::now() - start)
+									 .count());
+	}
+
+	for (long long nanoseconds: popNanoseconds)
+	{
+		std::cout << nanoseconds << '\n';
+	}
+	std::cout.flush();
+	return 0;
+}
+
+CommandDispatchBenchmark::CommandDispatchBenchmark(
+	const std::string& executablePath, size_t consumerCount, size_t commandCount)
+	: m_executablePath(executablePath), m_consumerCount(consumerCount), m_commandCount(commandCount)
+{
+}
+
+bool CommandDispatchBenchmark::run(QueueType type, Result& result) const
+{
+	const std::string name = utility::getUuidString();
+
+	std::shared_ptr<SharedMemory> queueMemory;
+	std::shared_ptr<SharedMemoryRing> ring;
+	if (type == QUEUE_LOCKED)
+	{
+		queueMemory = std::make_shared<SharedMemory>(
+			s_queueNamePrefix + name, s_initialQueueMemorySize, SharedMemory::CREATE_AND_DELETE);
+	}
+	else
+	{
+		ring = std::make_shared<SharedMemoryRing>(
+			s_ringNamePrefix + name, s_queueCapacity, s_stringPoolSize, true);
+	}
+
+	SharedMemory syncMemory(s_syncNamePrefix + name, 65536 /* 64 kB */, SharedMemory::CREATE_AND_DELETE);
+	{
+		SharedMemory::ScopedAccess access(&syncMemory);
+		*access.accessValue<size_t>(s_readyCountKeyName) = 0;
+	}
+
+	std::vector<std::shared_ptr<bp::ipstream>> outputs;
+	std::vector<std::shared_ptr<bp::child>> consumers;
+	try
+	{
+		for (size_t i = 0; i < m_consumerCount; i++)
+		{
+			outputs.push_back(std::make_shared<bp::ipstream>());
+			consumers.push_back(std::make_shared<bp::child>(
+				m_executablePath,
+				"--consume-commands",
+				name,
+				"--queue",
+				queueTypeToString(type),
+				bp::std_out > *outputs.back()));
+		}
+	}
+	catch (bp::process_error& e)
+	{
+		std::cerr << "ERROR: unable to start consumer process: " << e.what() << std::endl;
+		for (std::shared_ptr<bp::child>& consumer: consumers)
+		{
+			consumer->terminate();
+		}
+		return false;
+	}
+
+	// start measuring when every consumer is waiting for commands
+	while (true)
+	{
+		{
+			SharedMemory::ScopedAccess access(&syncMemory);
+			if (*access.accessValue<size_t>(s_readyCountKeyName) == m_consumerCount)
+			{
+				break;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < m_commandCount + m_consumerCount; i++)
+	{
+		const SharedMemoryRing::Record record = i < m_commandCount ? createCommand(i)
+																   : createStopCommand();
+		if (ring)
+		{
+			while (!ring->tryPush(record))
+			{
+				std::this_thread::yield();
+			}
+		}
+		else
+		{
+			pushLocked(*queueMemory, record);
+		}
+	}
+
+	result = Result();
+
+	for (size_t i = 0; i < consumers.size(); i++)
+	{
+		long long nanoseconds = 0;
+		while (*outputs[i] >> nanoseconds)
+		{
+			result.popMilliseconds.push_back(nanoseconds / 1000000.0);
+		}
+		consumers[i]->wait();
+	}
+
+	result.milliseconds = std::chrono::duration<double, std::milli>(
+							  std::chrono::steady_clock::now() - start)
+							  .count();
+	result.commandCount = result.popMilliseconds.size();
+
+	return result.commandCount == m_commandCount;
+}
@@ -0,0 +1,45 @@
+#ifndef COMMAND_DISPATCH_BENCHMARK_H
+#define COMMAND_DISPATCH_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+// Measures how long indexer processes take to pop an indexer command while many of them compete
+// for the command queue. Every consumer is a separate process running the benchmark executable in
+// consumer mode, just like the indexer processes are separate instances of the indexer executable.
+// The mutex guarded shared memory queue the indexer commands used to be passed through is measured
+// as a baseline for the lock-free ring.
+class CommandDispatchBenchmark
+{
+public:
+	enum QueueType
+	{
+		QUEUE_LOCKED,
+		QUEUE_RING
+	};
+
+	struct Result
+	{
+		double milliseconds = 0.0;
+		size_t commandCount = 0;
+		std::vector<double> popMilliseconds;
+	};
+
+	static std::string queueTypeToString(QueueType type);
+	static bool stringToQueueType(const std::string& str, QueueType& type);
+
+	// runs in the consumer processes, prints the duration of each pop to stdout
+	static int runConsumer(QueueType type, const std::string& name);
+
+	CommandDispatchBenchmark(
+		const std::string& executablePath, size_t consumerCount, size_t commandCount);
+
+	bool run(QueueType type, Result& result) const;
+
+private:
+	const std::string m_executablePath;
+	const size_t m_consumerCount;
+	const size_t m_commandCount;
+};
+
+#endif	  // COMMAND_DISPATCH_BENCHMARK_H
@@ -0,0 +1,223 @@
+#include "ParserClientRecording.h"
+
+ParserClientRecording::ParserClientRecording(ParserClient* client): m_client(client) {}
+
+Id ParserClientRecording::recordFile(const FilePath& filePath, bool indexed)
+{
+	Event& event = addEvent(EVENT_FILE);
+	event.firstFlag = indexed;
+	event.dataIndex = m_filePaths.size();
+	m_filePaths.push_back(filePath);
+
+	event.resultId = m_client->recordFile(filePath, indexed);
+	return event.resultId;
+}
+
+void ParserClientRecording::recordFileLanguage(Id fileId, const std::wstring& languageIdentifier)
+{
+	Event& event = addEvent(EVENT_FILE_LANGUAGE);
+	event.firstId = fileId;
+	event.dataIndex = addString(languageIdentifier);
+
+	m_client->recordFileLanguage(fileId, languageIdentifier);
+}
+
+Id ParserClientRecording::recordSymbol(const NameHierarchy& symbolName)
+{
+	Event& event = addEvent(EVENT_SYMBOL);
+	event.dataIndex = m_names.size();
+	m_names.push_back(symbolName);
+
+	event.resultId = m_client->recordSymbol(symbolName);
+	return event.resultId;
+}
+
+void ParserClientRecording::recordSymbolKind(Id symbolId, SymbolKind symbolKind)
+{
+	Event& event = addEvent(EVENT_SYMBOL_KIND);
+	event.firstId = symbolId;
+	event.kind = symbolKind;
+
+	m_client->recordSymbolKind(symbolId, symbolKind);
+}
+
+void ParserClientRecording::recordAccessKind(Id symbolId, AccessKind accessKind)
+{
+	Event& event = addEvent(EVENT_ACCESS_KIND);
+	event.firstId = symbolId;
+	event.kind = accessKind;
+
+	m_client->recordAccessKind(symbolId, accessKind);
+}
+
+void ParserClientRecording::recordDefinitionKind(Id symbolId, DefinitionKind definitionKind)
+{
+	Event& event = addEvent(EVENT_DEFINITION_KIND);
+	event.firstId = symbolId;
+	event.kind = definitionKind;
+
+	m_client->recordDefinitionKind(symbolId, definitionKind);
+}
+
+Id ParserClientRecording::recordReference(
+	ReferenceKind referenceKind,
+	Id referencedSymbolId,
+	Id contextSymbolId,
+	const ParseLocation& location)
+{
+	Event& event = addEvent(EVENT_REFERENCE);
+	event.kind = referenceKind;
+	event.firstId = referencedSymbolId;
+	event.secondId = contextSymbolId;
+	event.location = location;
+
+	event.resultId = m_client->recordReference(
+		referenceKind, referencedSymbolId, contextSymbolId, location);
+	return event.resultId;
+}
+
+void ParserClientRecording::recordLocalSymbol(
+	const std::wstring& name, const ParseLocation& location)
+{
+	Event& event = addEvent(EVENT_LOCAL_SYMBOL);
+	event.dataIndex = addString(name);
+	event.location = location;
+
+	m_client->recordLocalSymbol(name, location);
+}
+
+void ParserClientRecording::recordLocation(
+	Id elementId, const ParseLocation& location, ParseLocationType type)
+{
+	Event& event = addEvent(EVENT_LOCATION);
+	event.firstId = elementId;
+	event.kind = static_cast<int>(type);
+	event.location = location;
+
+	m_client->recordLocation(elementId, location, type);
+}
+
+void ParserClientRecording::recordComment(const ParseLocation& location)
+{
+	Event& event = addEvent(EVENT_COMMENT);
+	event.location = location;
+
+	m_client->recordComment(location);
+}
+
+void ParserClientRecording::recordError(
+	const std::wstring& message,
+	bool fatal,
+	bool indexed,
+	const FilePath& translationUnit,
+	const ParseLocation& location)
+{
+	Event& event = addEvent(EVENT_ERROR);
+	event.firstFlag = fatal;
+	event.secondFlag = indexed;
+	event.dataIndex = addString(message);
+	event.kind = static_cast<int>(m_filePaths.size());
+	event.location = location;
+	m_filePaths.push_back(translationUnit);
+
+	m_client->recordError(message, fatal, indexed, translationUnit, location);
+}
+
+bool ParserClientRecording::hasContent() const
+{
+	return m_client->hasContent();
+}
+
+size_t ParserClientRecording::getEventCount() const
+{
+	return m_events.size();
+}
+
+void ParserClientRecording::replay(ParserClient* client) const
+{
+	// recorded ids are dense, so they can be mapped through a vector
+	std::vector<Id> replayedIds;
+	auto mapId = [&replayedIds](Id id) {
+		return id < replayedIds.size() && replayedIds[id] ? replayedIds[id] : id;
+	};
+	auto mapLocation = [&mapId](ParseLocation location) {
+		location.fileId = mapId(location.fileId);
+		return location;
+	};
+	auto storeId = [&replayedIds](Id recordedId, Id replayedId) {
+		if (recordedId >= replayedIds.size())
+		{
+			replayedIds.resize(recordedId + 1, 0);
+		}
+		replayedIds[recordedId] = replayedId;
+	};
+
+	for (const Event& event: m_events)
+	{
+		switch (event.type)
+		{
+		case EVENT_FILE:
+			storeId(
+				event.resultId, client->recordFile(m_filePaths[event.dataIndex], event.firstFlag));
+			break;
+		case EVENT_FILE_LANGUAGE:
+			client->recordFileLanguage(mapId(event.firstId), m_strings[event.dataIndex]);
+			break;
+		case EVENT_SYMBOL:
+			storeId(event.resultId, client->recordSymbol(m_names[event.dataIndex]));
+			break;
+		case EVENT_SYMBOL_KIND:
+			client->recordSymbolKind(mapId(event.firstId), static_cast<SymbolKind>(event.kind));
+			break;
+		case EVENT_ACCESS_KIND:
+			client->recordAccessKind(mapId(event.firstId), static_cast<AccessKind>(event.kind));
+			break;
+		case EVENT_DEFINITION_KIND:
+			client->recordDefinitionKind(
+				mapId(event.firstId), static_cast<DefinitionKind>(event.kind));
+			break;
+		case EVENT_REFERENCE:
+			storeId(
+				event.resultId,
+				client->recordReference(
+					static_cast<ReferenceKind>(event.kind),
+					mapId(event.firstId),
+					mapId(event.secondId),
+					mapLocation(event.location)));
+			break;
+		case EVENT_LOCAL_SYMBOL:
+			client->recordLocalSymbol(m_strings[event.dataIndex], mapLocation(event.location));
+			break;
+		case EVENT_LOCATION:
+			client->recordLocation(
+				mapId(event.firstId),
+				mapLocation(event.location),
+				static_cast<ParseLocationType>(event.kind));
+			break;
+		case EVENT_COMMENT:
+			client->recordComment(mapLocation(event.location));
+			break;
+		case EVENT_ERROR:
+			client->recordError(
+				m_strings[event.dataIndex],
+				event.firstFlag,
+				event.secondFlag,
+				m_filePaths[event.kind],
+				mapLocation(event.location));
+			break;
+		}
+	}
+}
+
+ParserClientRecording::Event& ParserClientRecording::addEvent(EventType type)
+{
+	m_events.emplace_back();
+	m_events.back().type = type;
+	return m_events.back();
+}
+
+size_t ParserClientRecording::addString(const std::wstring& str)
+{
+	m_strings.push_back(str);
+	return m_strings.size() - 1;
+}
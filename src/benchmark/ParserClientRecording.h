@@ -0,0 +1,89 @@
+#ifndef PARSER_CLIENT_RECORDING_H
+#define PARSER_CLIENT_RECORDING_H
+
+#include <string>
+#include <vector>
+
+#include "ParserClient.h"
+
+// Records the calls a parser makes to its client while forwarding them to another client, so the
+// same calls can be replayed later on without running the parser again. This allows to measure
+// the cost of storing the parsed data separately from the parsing itself.
+class ParserClientRecording: public ParserClient
+{
+public:
+	ParserClientRecording(ParserClient* client);
+
+	Id recordFile(const FilePath& filePath, bool indexed) override;
+	void recordFileLanguage(Id fileId, const std::wstring& languageIdentifier) override;
+
+	Id recordSymbol(const NameHierarchy& symbolName) override;
+	void recordSymbolKind(Id symbolId, SymbolKind symbolKind) override;
+	void recordAccessKind(Id symbolId, AccessKind accessKind) override;
+	void recordDefinitionKind(Id symbolId, DefinitionKind definitionKind) override;
+
+	Id recordReference(
+		ReferenceKind referenceKind,
+		Id referencedSymbolId,
+		Id contextSymbolId,
+		const ParseLocation& location) override;
+
+	void recordLocalSymbol(const std::wstring& name, const ParseLocation& location) override;
+	void recordLocation(Id elementId, const ParseLocation& location, ParseLocationType type) override;
+	void recordComment(const ParseLocation& location) override;
+
+	void recordError(
+		const std::wstring& message,
+		bool fatal,
+		bool indexed,
+		const FilePath& translationUnit,
+		const ParseLocation& location) override;
+
+	bool hasContent() const override;
+
+	size_t getEventCount() const;
+
+	// ids returned by the client are passed on in place of the recorded ones
+	void replay(ParserClient* client) const;
+
+private:
+	enum EventType
+	{
+		EVENT_FILE,
+		EVENT_FILE_LANGUAGE,
+		EVENT_SYMBOL,
+		EVENT_SYMBOL_KIND,
+		EVENT_ACCESS_KIND,
+		EVENT_DEFINITION_KIND,
+		EVENT_REFERENCE,
+		EVENT_LOCAL_SYMBOL,
+		EVENT_LOCATION,
+		EVENT_COMMENT,
+		EVENT_ERROR
+	};
+
+	struct Event
+	{
+		EventType type;
+		Id resultId = 0;
+		Id firstId = 0;
+		Id secondId = 0;
+		int kind = 0;
+		bool firstFlag = false;
+		bool secondFlag = false;
+		size_t dataIndex = 0;	 // index of the file path, name or string of the event
+		ParseLocation location;
+	};
+
+	Event& addEvent(EventType type);
+	size_t addString(const std::wstring& str);
+
+	ParserClient* const m_client;
+
+	std::vector<Event> m_events;
+	std::vector<FilePath> m_filePaths;
+	std::vector<NameHierarchy> m_names;
+	std::vector<std::wstring> m_strings;
+};
+
+#endif	  // PARSER_CLIENT_RECORDING_H
@@ -0,0 +1,429 @@
+#include "SyntheticProjectGenerator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+
+#include "AccessKind.h"
+#include "DefinitionKind.h"
+#include "FileSystem.h"
+#include "IntermediateStorage.h"
+#include "NameHierarchy.h"
+#include "ParserClientImpl.h"
+#include "ReferenceKind.h"
+#include "SymbolKind.h"
+#include "utilityString.h"
+
+namespace
+{
+bool writeLines(const FilePath& filePath, const std::vector<std::string>& lines)
+{
+	std::ofstream fileStream(filePath.str(), std::ios::out | std::ios::trunc);
+	if (!fileStream.is_open())
+	{
+		return false;
+	}
+
+	for (const std::string& line: lines)
+	{
+		fileStream << line << '\n';
+	}
+	return fileStream.good();
+}
+
+ParseLocation getTokenLocation(
+	Id fileId, size_t lineNumber, const std::string& line, const std::string& token)
+{
+	const size_t column = line.find(token) + 1;
+	return ParseLocation(fileId, lineNumber, column, lineNumber, column + token.size() - 1);
+}
+}	 // namespace
+
+SyntheticProjectGenerator::SyntheticProjectGenerator(const Settings& settings): m_settings(settings)
+{
+	std::mt19937 generator(m_settings.seed);
+
+	for (size_t fileIndex = 0; fileIndex < m_settings.fileCount; fileIndex++)
+	{
+		Module module;
+
+		// only include modules with lower index to keep the include graph acyclic
+		if (fileIndex > 0)
+		{
+			std::uniform_int_distribution<size_t> fileDistribution(0, fileIndex - 1);
+			for (size_t i = 0; i < m_settings.includesPerFile; i++)
+			{
+				const size_t includedFileIndex = fileDistribution(generator);
+				if (std::find(
+						module.includedFileIndices.begin(),
+						module.includedFileIndices.end(),
+						includedFileIndex) == module.includedFileIndices.end())
+				{
+					module.includedFileIndices.push_back(includedFileIndex);
+				}
+			}
+		}
+
+		std::uniform_int_distribution<size_t> classDistribution(0, m_settings.classesPerFile - 1);
+		std::uniform_int_distribution<size_t> methodDistribution(0, m_settings.methodsPerClass - 1);
+		std::uniform_int_distribution<size_t> calleeFileDistribution(
+			0, module.includedFileIndices.size());
+
+		module.calls.resize(m_settings.classesPerFile);
+		for (size_t classIndex = 0; classIndex < m_settings.classesPerFile; classIndex++)
+		{
+			module.calls[classIndex].resize(m_settings.methodsPerClass);
+			for (size_t methodIndex = 0; methodIndex < m_settings.methodsPerClass; methodIndex++)
+			{
+				for (size_t i = 0; i < m_settings.callsPerMethod; i++)
+				{
+					const size_t calleeFile = calleeFileDistribution(generator);
+
+					Call call;
+					call.fileIndex = calleeFile < module.includedFileIndices.size()
+						? module.includedFileIndices[calleeFile]
+						: fileIndex;
+					call.classIndex = classDistribution(generator);
+					call.methodIndex = methodDistribution(generator);
+					module.calls[classIndex][methodIndex].push_back(call);
+				}
+			}
+		}
+
+		m_modules.push_back(module);
+	}
+}
+
+const SyntheticProjectGenerator::Settings& SyntheticProjectGenerator::getSettings() const
+{
+	return m_settings;
+}
+
+FilePath SyntheticProjectGenerator::getHeaderFilePath(
+	const FilePath& projectDirectory, size_t fileIndex) const
+{
+	return projectDirectory.getConcatenated(L"module_" + std::to_wstring(fileIndex) + L".h");
+}
+
+FilePath SyntheticProjectGenerator::getSourceFilePath(
+	const FilePath& projectDirectory, size_t fileIndex) const
+{
+	return projectDirectory.getConcatenated(L"module_" + std::to_wstring(fileIndex) + L".cpp");
+}
+
+std::vector<FilePath> SyntheticProjectGenerator::writeProject(const FilePath& projectDirectory) const
+{
+	FileSystem::createDirectory(projectDirectory);
+
+	std::vector<FilePath> sourceFilePaths;
+	for (size_t fileIndex = 0; fileIndex < m_modules.size(); fileIndex++)
+	{
+		const FilePath sourceFilePath = getSourceFilePath(projectDirectory, fileIndex);
+
+		if (!writeLines(
+				getHeaderFilePath(projectDirectory, fileIndex),
+				generateHeader(projectDirectory, fileIndex, nullptr, 0)) ||
+			!writeLines(
+				sourceFilePath, generateSource(projectDirectory, fileIndex, nullptr, 0, 0)))
+		{
+			return {};
+		}
+
+		sourceFilePaths.push_back(sourceFilePath);
+	}
+	return sourceFilePaths;
+}
+
+std::shared_ptr<IntermediateStorage> SyntheticProjectGenerator::generateIntermediateStorage(
+	const FilePath& projectDirectory, size_t fileIndex) const
+{
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	ParserClientImpl client(storage.get());
+	recordModule(projectDirectory, fileIndex, &client);
+	return storage;
+}
+
+void SyntheticProjectGenerator::recordModule(
+	const FilePath& projectDirectory, size_t fileIndex, ParserClient* client) const
+{
+	const Id sourceFileId = client->recordFile(getSourceFilePath(projectDirectory, fileIndex), true);
+	client->recordFileLanguage(sourceFileId, L"cpp");
+	const Id headerFileId = client->recordFile(getHeaderFilePath(projectDirectory, fileIndex), true);
+	client->recordFileLanguage(headerFileId, L"cpp");
+
+	generateHeader(projectDirectory, fileIndex, client, headerFileId);
+	generateSource(projectDirectory, fileIndex, client, sourceFileId, headerFileId);
+}
+
+std::vector<std::wstring> SyntheticProjectGenerator::generateQueries(size_t queryCount) const
+{
+	std::mt19937 generator(m_settings.seed + 1);
+	std::uniform_int_distribution<size_t> fileDistribution(0, m_settings.fileCount - 1);
+	std::uniform_int_distribution<size_t> classDistribution(0, m_settings.classesPerFile - 1);
+	std::uniform_int_distribution<size_t> methodDistribution(0, m_settings.methodsPerClass - 1);
+
+	std::vector<std::wstring> queries;
+	for (size_t i = 0; i < queryCount; i++)
+	{
+		switch (i % 4)
+		{
+		case 0:	   // exact class name
+			queries.push_back(
+				getClassName(fileDistribution(generator), classDistribution(generator)));
+			break;
+		case 1:	   // class name prefix, matches many classes
+			queries.push_back(L"Class_" + std::to_wstring(fileDistribution(generator)));
+			break;
+		case 2:	   // method name, matches one method per class
+			queries.push_back(getMethodName(methodDistribution(generator)));
+			break;
+		default:	// fuzzy query with characters spread over the name
+			queries.push_back(
+				L"C" + std::to_wstring(fileDistribution(generator)) + L"m" +
+				std::to_wstring(methodDistribution(generator)));
+			break;
+		}
+	}
+	return queries;
+}
+
+std::wstring SyntheticProjectGenerator::getClassName(size_t fileIndex, size_t classIndex)
+{
+	return L"Class_" + std::to_wstring(fileIndex) + L"_" + std::to_wstring(classIndex);
+}
+
+std::wstring SyntheticProjectGenerator::getMethodName(size_t methodIndex)
+{
+	return L"method_" + std::to_wstring(methodIndex);
+}
+
+std::vector<std::string> SyntheticProjectGenerator::generateHeader(
+	const FilePath& projectDirectory, size_t fileIndex, ParserClient* client, Id fileId) const
+{
+	const Module& module = m_modules[fileIndex];
+
+	std::vector<std::string> lines;
+	lines.push_back("#pragma once");
+
+	for (size_t includedFileIndex: module.includedFileIndices)
+	{
+		const FilePath includedFilePath = getHeaderFilePath(projectDirectory, includedFileIndex);
+		lines.push_back("#include \"" + utility::encodeToUtf8(includedFilePath.fileName()) + "\"");
+
+		if (client)
+		{
+			client->recordReference(
+				REFERENCE_INCLUDE,
+				client->recordFile(includedFilePath, true),
+				fileId,
+				ParseLocation(fileId, lines.size(), 10, lines.size(), lines.back().size()));
+		}
+	}
+
+	lines.push_back("");
+	lines.push_back("namespace bench");
+	if (client)
+	{
+		const Id namespaceId = client->recordSymbol(NameHierarchy(L"bench", NAME_DELIMITER_CXX));
+		client->recordSymbolKind(namespaceId, SYMBOL_NAMESPACE);
+		client->recordDefinitionKind(namespaceId, DEFINITION_EXPLICIT);
+		client->recordLocation(
+			namespaceId,
+			getTokenLocation(fileId, lines.size(), lines.back(), "bench"),
+			ParseLocationType::TOKEN);
+	}
+	lines.push_back("{");
+
+	for (size_t classIndex = 0; classIndex < m_settings.classesPerFile; classIndex++)
+	{
+		const std::string className = utility::encodeToUtf8(getClassName(fileIndex, classIndex));
+		const size_t classStartLine = lines.size() + 1;
+
+		lines.push_back("class " + className);
+		const Id classId = recordClass(client, fileIndex, classIndex);
+		if (client)
+		{
+			client->recordDefinitionKind(classId, DEFINITION_EXPLICIT);
+			client->recordLocation(
+				classId,
+				getTokenLocation(fileId, lines.size(), lines.back(), className),
+				ParseLocationType::TOKEN);
+		}
+
+		lines.push_back("{");
+		lines.push_back("public:");
+
+		for (size_t methodIndex = 0; methodIndex < m_settings.methodsPerClass; methodIndex++)
+		{
+			const std::string methodName = utility::encodeToUtf8(getMethodName(methodIndex));
+			lines.push_back("\tint " + methodName + "(int value);");
+			if (client)
+			{
+				client->recordLocation(
+					recordMethod(client, fileIndex, classIndex, methodIndex),
+					getTokenLocation(fileId, lines.size(), lines.back(), methodName),
+					ParseLocationType::TOKEN);
+			}
+		}
+
+		lines.push_back("\tint m_value;");
+		if (client)
+		{
+			NameHierarchy fieldName(
+				{L"bench", getClassName(fileIndex, classIndex), L"m_value"}, NAME_DELIMITER_CXX);
+			const Id fieldId = client->recordSymbol(fieldName);
+			client->recordSymbolKind(fieldId, SYMBOL_FIELD);
+			client->recordAccessKind(fieldId, ACCESS_PUBLIC);
+			client->recordDefinitionKind(fieldId, DEFINITION_EXPLICIT);
+			client->recordLocation(
+				fieldId,
+				getTokenLocation(fileId, lines.size(), lines.back(), "m_value"),
+				ParseLocationType::TOKEN);
+		}
+
+		lines.push_back("};");
+		if (client)
+		{
+			client->recordLocation(
+				classId,
+				ParseLocation(fileId, classStartLine, 1, lines.size(), 2),
+				ParseLocationType::SCOPE);
+		}
+	}
+
+	lines.push_back("}	 // namespace bench");
+	return lines;
+}
+
+std::vector<std::string> SyntheticProjectGenerator::generateSource(
+	const FilePath& projectDirectory,
+	size_t fileIndex,
+	ParserClient* client,
+	Id fileId,
+	Id headerFileId) const
+{
+	const Module& module = m_modules[fileIndex];
+	const std::string headerFileName = utility::encodeToUtf8(
+		getHeaderFilePath(projectDirectory, fileIndex).fileName());
+
+	std::vector<std::string> lines;
+	lines.push_back("#include \"" + headerFileName + "\"");
+	if (client)
+	{
+		client->recordReference(
+			REFERENCE_INCLUDE,
+			headerFileId,
+			fileId,
+			ParseLocation(fileId, lines.size(), 10, lines.size(), lines.back().size()));
+	}
+
+	lines.push_back("");
+	lines.push_back("namespace bench");
+	lines.push_back("{");
+
+	for (size_t classIndex = 0; classIndex < m_settings.classesPerFile; classIndex++)
+	{
+		const std::string className = utility::encodeToUtf8(getClassName(fileIndex, classIndex));
+		for (size_t methodIndex = 0; methodIndex < m_settings.methodsPerClass; methodIndex++)
+		{
+			const std::string methodName = utility::encodeToUtf8(getMethodName(methodIndex));
+			const size_t methodStartLine = lines.size() + 1;
+
+			lines.push_back("int " + className + "::" + methodName + "(int value)");
+			const Id methodId = recordMethod(client, fileIndex, classIndex, methodIndex);
+			if (client)
+			{
+				client->recordDefinitionKind(methodId, DEFINITION_EXPLICIT);
+				client->recordLocation(
+					methodId,
+					getTokenLocation(fileId, lines.size(), lines.back(), methodName),
+					ParseLocationType::TOKEN);
+				client->recordReference(
+					REFERENCE_TYPE_USAGE,
+					recordClass(client, fileIndex, classIndex),
+					methodId,
+					getTokenLocation(fileId, lines.size(), lines.back(), className));
+			}
+			lines.push_back("{");
+
+			for (const Call& call: module.calls[classIndex][methodIndex])
+			{
+				const std::string calleeClassName = utility::encodeToUtf8(
+					getClassName(call.fileIndex, call.classIndex));
+				const std::string calleeMethodName = utility::encodeToUtf8(
+					getMethodName(call.methodIndex));
+
+				lines.push_back(
+					"\tvalue += " + calleeClassName + "()." + calleeMethodName + "(value);");
+				if (client)
+				{
+					client->recordReference(
+						REFERENCE_TYPE_USAGE,
+						recordClass(client, call.fileIndex, call.classIndex),
+						methodId,
+						getTokenLocation(fileId, lines.size(), lines.back(), calleeClassName));
+					client->recordReference(
+						REFERENCE_CALL,
+						recordMethod(client, call.fileIndex, call.classIndex, call.methodIndex),
+						methodId,
+						getTokenLocation(fileId, lines.size(), lines.back(), calleeMethodName));
+				}
+			}
+
+			lines.push_back("\treturn value + m_value;");
+			if (client)
+			{
+				NameHierarchy fieldName(
+					{L"bench", getClassName(fileIndex, classIndex), L"m_value"}, NAME_DELIMITER_CXX);
+				client->recordReference(
+					REFERENCE_USAGE,
+					client->recordSymbol(fieldName),
+					methodId,
+					getTokenLocation(fileId, lines.size(), lines.back(), "m_value"));
+			}
+
+			lines.push_back("}");
+			if (client)
+			{
+				client->recordLocation(
+					methodId,
+					ParseLocation(fileId, methodStartLine, 1, lines.size(), 1),
+					ParseLocationType::SCOPE);
+			}
+			lines.push_back("");
+		}
+	}
+
+	lines.push_back("}	 // namespace bench");
+	return lines;
+}
+
+Id SyntheticProjectGenerator::recordClass(ParserClient* client, size_t fileIndex, size_t classIndex) const
+{
+	if (!client)
+	{
+		return 0;
+	}
+
+	const Id classId = client->recordSymbol(
+		NameHierarchy({L"bench", getClassName(fileIndex, classIndex)}, NAME_DELIMITER_CXX));
+	client->recordSymbolKind(classId, SYMBOL_CLASS);
+	return classId;
+}
+
+Id SyntheticProjectGenerator::recordMethod(
+	ParserClient* client, size_t fileIndex, size_t classIndex, size_t methodIndex) const
+{
+	if (!client)
+	{
+		return 0;
+	}
+
+	NameHierarchy methodName({L"bench", getClassName(fileIndex, classIndex)}, NAME_DELIMITER_CXX);
+	methodName.push(NameElement(getMethodName(methodIndex), L"int", L"(int)"));
+
+	const Id methodId = client->recordSymbol(methodName);
+	client->recordSymbolKind(methodId, SYMBOL_METHOD);
+	client->recordAccessKind(methodId, ACCESS_PUBLIC);
+	return methodId;
+}
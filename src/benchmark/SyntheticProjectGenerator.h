@@ -0,0 +1,85 @@
+#ifndef SYNTHETIC_PROJECT_GENERATOR_H
+#define SYNTHETIC_PROJECT_GENERATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+#include "types.h"
+
+class IntermediateStorage;
+class ParserClient;
+
+// Generates a C++ project of configurable size. All randomness is derived from the seed, so the
+// same settings always produce the same project and benchmark results stay comparable between
+// versions. Each module consists of a header declaring some classes and a source file defining
+// their methods, which call methods of classes declared in included modules.
+class SyntheticProjectGenerator
+{
+public:
+	struct Settings
+	{
+		unsigned int seed = 42;
+		size_t fileCount = 200;
+		size_t classesPerFile = 4;
+		size_t methodsPerClass = 6;
+		size_t includesPerFile = 3;
+		size_t callsPerMethod = 3;
+	};
+
+	SyntheticProjectGenerator(const Settings& settings);
+
+	const Settings& getSettings() const;
+
+	FilePath getHeaderFilePath(const FilePath& projectDirectory, size_t fileIndex) const;
+	FilePath getSourceFilePath(const FilePath& projectDirectory, size_t fileIndex) const;
+
+	// writes all header and source files and returns the source file paths
+	std::vector<FilePath> writeProject(const FilePath& projectDirectory) const;
+
+	// records the same symbols a parser would find in the module's source file, this allows to
+	// benchmark the remaining phases without C++ language support
+	std::shared_ptr<IntermediateStorage> generateIntermediateStorage(
+		const FilePath& projectDirectory, size_t fileIndex) const;
+	void recordModule(
+		const FilePath& projectDirectory, size_t fileIndex, ParserClient* client) const;
+
+	// returns a mix of exact and partial symbol names to run as search queries
+	std::vector<std::wstring> generateQueries(size_t queryCount) const;
+
+private:
+	struct Call
+	{
+		size_t fileIndex;
+		size_t classIndex;
+		size_t methodIndex;
+	};
+
+	struct Module
+	{
+		std::vector<size_t> includedFileIndices;
+		std::vector<std::vector<std::vector<Call>>> calls;	  // per class and method
+	};
+
+	static std::wstring getClassName(size_t fileIndex, size_t classIndex);
+	static std::wstring getMethodName(size_t methodIndex);
+
+	std::vector<std::string> generateHeader(
+		const FilePath& projectDirectory, size_t fileIndex, ParserClient* client, Id fileId) const;
+	std::vector<std::string> generateSource(
+		const FilePath& projectDirectory,
+		size_t fileIndex,
+		ParserClient* client,
+		Id fileId,
+		Id headerFileId) const;
+
+	Id recordClass(ParserClient* client, size_t fileIndex, size_t classIndex) const;
+	Id recordMethod(ParserClient* client, size_t fileIndex, size_t classIndex, size_t methodIndex)
+		const;
+
+	const Settings m_settings;
+	std::vector<Module> m_modules;
+};
+
+#endif	  // SYNTHETIC_PROJECT_GENERATOR_H
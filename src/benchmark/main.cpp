@@ -0,0 +1,564 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/process/search_path.hpp>
+#include <boost/program_options.hpp>
+
+#include "language_packages.h"
+
+#include "CommandDispatchBenchmark.h"
+#include "FilePath.h"
+#include "FileSystem.h"
+#include "InterprocessIntermediateStorageManager.h"
+#include "IntermediateStorage.h"
+#include "InternedStringTable.h"
+#include "LowMemoryStringMap.h"
+#include "NodeTypeSet.h"
+#include "ParserClientImpl.h"
+#include "ParserClientRecording.h"
+#include "PersistentStorage.h"
+#include "StorageProvider.h"
+#include "SyntheticProjectGenerator.h"
+#include "productVersion.h"
+#include "utilityUuid.h"
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+#	include "IndexerCommandCxx.h"
+#	include "IndexerCxx.h"
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
+
+namespace po = boost::program_options;
+
+namespace
+{
+class Stopwatch
+{
+public:
+	Stopwatch(): m_start(std::chrono::steady_clock::now()) {}
+
+	double getMilliseconds() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start)
+			.count();
+	}
+
+private:
+	const std::chrono::steady_clock::time_point m_start;
+};
+
+struct PhaseResult
+{
+	std::string name;
+	double milliseconds = 0.0;
+	size_t itemCount = 0;
+	size_t byteCount = 0;
+	std::vector<double> itemMilliseconds;
+};
+
+std::string phaseResultToJson(const PhaseResult& result)
+{
+	std::stringstream ss;
+	ss << "\t\t\"" << result.name << "\": {\"ms\": " << result.milliseconds
+	   << ", \"items\": " << result.itemCount;
+
+	if (result.byteCount)
+	{
+		ss << ", \"bytes\": " << result.byteCount;
+	}
+
+	if (!result.itemMilliseconds.empty())
+	{
+		std::vector<double> values = result.itemMilliseconds;
+		std::sort(values.begin(), values.end());
+
+		auto percentile = [&values](size_t percent) {
+			return values[std::min(values.size() - 1, values.size() * percent / 100)];
+		};
+
+		ss << ", \"item_ms\": {\"p50\": " << percentile(50) << ", \"p90\": " << percentile(90)
+		   << ", \"p99\": " << percentile(99) << ", \"max\": " << values.back() << "}";
+	}
+
+	ss << "}";
+	return ss.str();
+}
+
+std::string resultsToJson(const std::string& settingsJson, const std::vector<PhaseResult>& results)
+{
+	std::stringstream ss;
+	ss << "{\n";
+	ss << "\t\"version\": \"" << GIT_VERSION_NUMBER << "\",\n";
+	ss << "\t\"commit\": \"" << GIT_COMMIT_HASH << "\",\n";
+	ss << settingsJson;
+	ss << "\t\"phases\": {\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		ss << phaseResultToJson(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	ss << "\t}\n";
+	ss << "}\n";
+	return ss.str();
+}
+
+int writeResults(const std::string& outputFile, const std::string& json)
+{
+	if (outputFile.empty())
+	{
+		std::cout << json;
+		return 0;
+	}
+
+	std::ofstream fileStream(outputFile, std::ios::out | std::ios::trunc);
+	fileStream << json;
+	if (!fileStream.good())
+	{
+		std::cerr << "ERROR: unable to write results to " << outputFile << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int runCommandDispatchBenchmark(
+	const std::string& executablePath,
+	size_t consumerCount,
+	size_t commandCount,
+	const std::string& outputFile)
+{
+	const CommandDispatchBenchmark benchmark(executablePath, consumerCount, commandCount);
+
+	std::vector<PhaseResult> results;
+	for (CommandDispatchBenchmark::QueueType type:
+		 {CommandDispatchBenchmark::QUEUE_LOCKED, CommandDispatchBenchmark::QUEUE_RING})
+	{
+		CommandDispatchBenchmark::Result dispatchResult;
+		if (!benchmark.run(type, dispatchResult))
+		{
+			std::cerr << "ERROR: command dispatch benchmark failed for "
+					  << CommandDispatchBenchmark::queueTypeToString(type) << " queue" << std::endl;
+			return 1;
+		}
+
+		PhaseResult result;
+		result.name = "command_dispatch_" + CommandDispatchBenchmark::queueTypeToString(type);
+		result.milliseconds = dispatchResult.milliseconds;
+		result.itemCount = dispatchResult.commandCount;
+		result.itemMilliseconds = dispatchResult.popMilliseconds;
+		results.push_back(result);
+	}
+
+	std::stringstream ss;
+	ss << "\t\"settings\": {\"consumers\": " << consumerCount << ", \"commands\": " << commandCount
+	   << "},\n";
+	return writeResults(outputFile, resultsToJson(ss.str(), results));
+}
+}	 // namespace
+
+int main(int argc, char* argv[])
+{
+	SyntheticProjectGenerator::Settings settings;
+	size_t queryCount = 200;
+	size_t trailCount = 20;
+	size_t trailDepth = 5;
+	std::string workingDirectory = "benchmark_data";
+	std::string outputFile;
+	bool synthetic = false;
+	size_t commandCount = 20000;
+	size_t replayCount = 5;
+
+	po::options_description options("Options");
+	options.add_options()
+		("help,h", "Print this help message")
+		("seed", po::value<unsigned int>(&settings.seed), "Seed of the synthetic project generator")
+		("files", po::value<size_t>(&settings.fileCount), "Number of generated source files")
+		("classes", po::value<size_t>(&settings.classesPerFile), "Number of classes per file")
+		("methods", po::value<size_t>(&settings.methodsPerClass), "Number of methods per class")
+		("includes", po::value<size_t>(&settings.includesPerFile), "Number of includes per file")
+		("calls", po::value<size_t>(&settings.callsPerMethod), "Number of calls per method")
+		("replays", po::value<size_t>(&replayCount), "Number of times the recorded parser events are replayed")
+		("queries", po::value<size_t>(&queryCount), "Number of search queries")
+		("trails", po::value<size_t>(&trailCount), "Number of call trail graphs")
+		("trail-depth", po::value<size_t>(&trailDepth), "Depth of call trail graphs")
+		("working-directory,d", po::value<std::string>(&workingDirectory), "Directory for generated files")
+		("output,o", po::value<std::string>(&outputFile), "JSON result file (omit to print to stdout)")
+		("synthetic", "Record the generated symbols directly instead of running the C++ parser")
+		("command-consumers", po::value<size_t>()->implicit_value(64), "Only run the indexer command dispatch benchmark with this many consumer processes (default: 64)")
+		("commands", po::value<size_t>(&commandCount), "Number of dispatched indexer commands");
+
+	po::options_description consumerOptions("Consumer process options");
+	consumerOptions.add_options()
+		("consume-commands", po::value<std::string>(), "Name of the command queue to consume")
+		("queue", po::value<std::string>(), "Type of the command queue to consume");
+
+	po::options_description allOptions;
+	allOptions.add(options).add(consumerOptions);
+
+	po::variables_map vm;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, allOptions), vm);
+		po::notify(vm);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl << options << std::endl;
+		return 1;
+	}
+
+	if (vm.count("help"))
+	{
+		std::cout << "Usage:\n  sourcetrail_benchmark [options]\n\n" << options << std::endl;
+		return 0;
+	}
+
+	if (vm.count("consume-commands"))
+	{
+		CommandDispatchBenchmark::QueueType type;
+		if (!vm.count("queue") ||
+			!CommandDispatchBenchmark::stringToQueueType(vm["queue"].as<std::string>(), type))
+		{
+			std::cerr << "ERROR: missing or invalid queue type" << std::endl;
+			return 1;
+		}
+		return CommandDispatchBenchmark::runConsumer(type, vm["consume-commands"].as<std::string>());
+	}
+
+	if (vm.count("command-consumers"))
+	{
+		const size_t consumerCount = vm["command-consumers"].as<size_t>();
+		if (!consumerCount || !commandCount)
+		{
+			std::cerr << "ERROR: command-consumers and commands need to be greater than 0"
+					  << std::endl;
+			return 1;
+		}
+
+		boost::filesystem::path executablePath(argv[0]);
+		if (!executablePath.has_parent_path())
+		{
+			executablePath = boost::process::search_path(argv[0]);
+		}
+		return runCommandDispatchBenchmark(
+			boost::filesystem::absolute(executablePath).string(),
+			consumerCount,
+			commandCount,
+			outputFile);
+	}
+
+	if (!settings.fileCount || !settings.classesPerFile || !settings.methodsPerClass)
+	{
+		std::cerr << "ERROR: files, classes and methods need to be greater than 0" << std::endl;
+		return 1;
+	}
+
+#if !BUILD_CXX_LANGUAGE_PACKAGE
+	synthetic = true;
+#else
+	synthetic = vm.count("synthetic") > 0;
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
+
+	const FilePath workingDirectoryPath = FilePath(workingDirectory).makeAbsolute();
+	const FilePath projectDirectoryPath = workingDirectoryPath.getConcatenated(L"project");
+	const FilePath indexDbFilePath = workingDirectoryPath.getConcatenated(L"benchmark.srctrldb");
+	const FilePath bookmarkDbFilePath = workingDirectoryPath.getConcatenated(L"benchmark.srctrlbm");
+
+	// remove files of previous runs that may have used different settings
+	for (const FilePath& filePath: FileSystem::getFilePathsFromDirectory(projectDirectoryPath))
+	{
+		FileSystem::remove(filePath);
+	}
+	FileSystem::remove(indexDbFilePath);
+	FileSystem::remove(bookmarkDbFilePath);
+	FileSystem::createDirectory(workingDirectoryPath);
+
+	std::vector<PhaseResult> results;
+	const SyntheticProjectGenerator generator(settings);
+
+	{
+		PhaseResult result;
+		result.name = "project_generation";
+		Stopwatch stopwatch;
+		result.itemCount = generator.writeProject(projectDirectoryPath).size();
+		result.milliseconds = stopwatch.getMilliseconds();
+		results.push_back(result);
+
+		if (result.itemCount != settings.fileCount)
+		{
+			std::cerr << "ERROR: unable to write project to " << projectDirectoryPath.str()
+					  << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<FilePath> sourceFilePaths;
+	{
+		PhaseResult result;
+		result.name = "file_discovery";
+		Stopwatch stopwatch;
+		sourceFilePaths = FileSystem::getFilePathsFromDirectory(projectDirectoryPath, {L".cpp"});
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = sourceFilePaths.size();
+		results.push_back(result);
+	}
+
+	std::vector<std::shared_ptr<IntermediateStorage>> storages;
+	{
+		PhaseResult result;
+		result.name = synthetic ? "synthetic_parsing" : "cxx_parsing";
+		Stopwatch stopwatch;
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+		IndexerCxx indexer;
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
+
+		for (size_t fileIndex = 0; fileIndex < settings.fileCount; fileIndex++)
+		{
+			Stopwatch fileStopwatch;
+			std::shared_ptr<IntermediateStorage> storage;
+
+#if BUILD_CXX_LANGUAGE_PACKAGE
+			if (!synthetic)
+			{
+				const FilePath sourceFilePath = generator.getSourceFilePath(
+					projectDirectoryPath, fileIndex);
+				storage = indexer.index(std::make_shared<IndexerCommandCxx>(
+					sourceFilePath,
+					std::set<FilePath> {projectDirectoryPath},
+					std::set<FilePathFilter>(),
+					std::set<FilePathFilter>(),
+					projectDirectoryPath,
+					std::vector<std::wstring> {L"-std=c++17", sourceFilePath.wstr()}));
+			}
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
+
+			if (synthetic)
+			{
+				storage = generator.generateIntermediateStorage(projectDirectoryPath, fileIndex);
+			}
+
+			result.itemMilliseconds.push_back(fileStopwatch.getMilliseconds());
+			if (storage)
+			{
+				storages.push_back(storage);
+			}
+		}
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = storages.size();
+		results.push_back(result);
+	}
+
+	{
+		// replays the parser client calls recorded for each file into a new intermediate storage,
+		// which measures the cost of collecting the data without the cost of producing it
+		std::vector<std::shared_ptr<ParserClientRecording>> recordings;
+		for (size_t fileIndex = 0; fileIndex < settings.fileCount; fileIndex++)
+		{
+			IntermediateStorage storage;
+			ParserClientImpl client(&storage);
+			recordings.push_back(std::make_shared<ParserClientRecording>(&client));
+			generator.recordModule(projectDirectoryPath, fileIndex, recordings.back().get());
+		}
+
+		PhaseResult result;
+		result.name = "parser_client_replay";
+		Stopwatch stopwatch;
+
+		for (size_t i = 0; i < replayCount; i++)
+		{
+			for (const std::shared_ptr<ParserClientRecording>& recording: recordings)
+			{
+				Stopwatch replayStopwatch;
+				IntermediateStorage storage;
+				ParserClientImpl client(&storage);
+				recording->replay(&client);
+				result.itemMilliseconds.push_back(replayStopwatch.getMilliseconds());
+				result.itemCount += recording->getEventCount();
+			}
+		}
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		results.push_back(result);
+	}
+
+	{
+		PhaseResult result;
+		result.name = "shared_memory_transport";
+		Stopwatch stopwatch;
+
+		InterprocessIntermediateStorageManager storageManager(utility::getUuidString(), 1, true);
+		for (std::shared_ptr<IntermediateStorage>& storage: storages)
+		{
+			Stopwatch storageStopwatch;
+			storageManager.pushIntermediateStorage(storage);
+			storage = storageManager.popIntermediateStorage();
+			result.itemMilliseconds.push_back(storageStopwatch.getMilliseconds());
+		}
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = storages.size();
+		results.push_back(result);
+	}
+
+	StorageProvider storageProvider;
+	for (const std::shared_ptr<IntermediateStorage>& storage: storages)
+	{
+		storageProvider.insert(storage);
+	}
+	storages.clear();
+
+	{
+		// merges the same way as TaskMergeStorages, the largest storage is left for injection
+		PhaseResult result;
+		result.name = "storage_merge";
+		Stopwatch stopwatch;
+
+		while (storageProvider.getStorageCount() > 2)
+		{
+			Stopwatch mergeStopwatch;
+			std::shared_ptr<IntermediateStorage> target =
+				storageProvider.consumeSecondLargestStorage();
+			std::shared_ptr<IntermediateStorage> source =
+				storageProvider.consumeSecondLargestStorage();
+			target->inject(source.get());
+			storageProvider.insert(target);
+			result.itemMilliseconds.push_back(mergeStopwatch.getMilliseconds());
+		}
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = result.itemMilliseconds.size();
+		results.push_back(result);
+	}
+
+	std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(
+		indexDbFilePath, bookmarkDbFilePath);
+	storage->setup();
+
+	{
+		PhaseResult result;
+		result.name = "sqlite_injection";
+		Stopwatch stopwatch;
+
+		storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+		while (std::shared_ptr<IntermediateStorage> source = storageProvider.consumeLargestStorage())
+		{
+			Stopwatch injectionStopwatch;
+			result.itemCount += source->getElementCount();
+			storage->inject(source.get());
+			result.itemMilliseconds.push_back(injectionStopwatch.getMilliseconds());
+		}
+		storage->setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		results.push_back(result);
+	}
+
+	{
+		// builds the node name indices SqliteIndexStorage can use for injecting into an existing
+		// database: all names of the database are added and each of them is looked up once
+		const std::vector<StorageNode> nodes = storage->getStorageNodes();
+
+		PhaseResult lowMemoryResult;
+		lowMemoryResult.name = "node_name_index_low_memory_string_map";
+		{
+			Stopwatch stopwatch;
+			LowMemoryStringMap<std::string, uint32_t, 0> index;
+			for (const StorageNode& node: nodes)
+			{
+				index.add(node.serializedName, static_cast<uint32_t>(node.id));
+			}
+			for (const StorageNode& node: nodes)
+			{
+				lowMemoryResult.itemCount += index.find(node.serializedName) != 0;
+			}
+			lowMemoryResult.milliseconds = stopwatch.getMilliseconds();
+			lowMemoryResult.byteCount = index.getByteSize();
+		}
+		results.push_back(lowMemoryResult);
+
+		PhaseResult internedResult;
+		internedResult.name = "node_name_index_interned_string_table";
+		{
+			Stopwatch stopwatch;
+			InternedStringTable index;
+			index.reserve(nodes.size());
+			for (const StorageNode& node: nodes)
+			{
+				index.add(node.serializedName, static_cast<uint32_t>(node.id));
+			}
+			for (const StorageNode& node: nodes)
+			{
+				internedResult.itemCount += index.find(node.serializedName) != 0;
+			}
+			internedResult.milliseconds = stopwatch.getMilliseconds();
+			internedResult.byteCount = index.getByteSize();
+		}
+		results.push_back(internedResult);
+	}
+
+	{
+		PhaseResult result;
+		result.name = "cache_build";
+		Stopwatch stopwatch;
+		storage->buildCaches();
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = 1;
+		results.push_back(result);
+	}
+
+	std::vector<Id> trailOriginIds;
+	{
+		PhaseResult result;
+		result.name = "search_query";
+		Stopwatch stopwatch;
+
+		for (const std::wstring& query: generator.generateQueries(queryCount))
+		{
+			Stopwatch queryStopwatch;
+			const std::vector<SearchMatch> matches = storage->getAutocompletionMatches(
+				query, NodeTypeSet::all(), false, AutocompletionRequest());
+			result.itemMilliseconds.push_back(queryStopwatch.getMilliseconds());
+
+			if (trailOriginIds.size() < trailCount && !matches.empty() &&
+				!matches.front().tokenIds.empty())
+			{
+				trailOriginIds.push_back(matches.front().tokenIds.front());
+			}
+		}
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = queryCount;
+		results.push_back(result);
+	}
+
+	{
+		PhaseResult result;
+		result.name = "trail_graph";
+		Stopwatch stopwatch;
+
+		for (Id originId: trailOriginIds)
+		{
+			Stopwatch trailStopwatch;
+			storage->getGraphForTrail(
+				originId, 0, 0, Edge::EDGE_CALL | Edge::EDGE_MEMBER, false, trailDepth, true);
+			result.itemMilliseconds.push_back(trailStopwatch.getMilliseconds());
+		}
+
+		result.milliseconds = stopwatch.getMilliseconds();
+		result.itemCount = trailOriginIds.size();
+		results.push_back(result);
+	}
+
+	std::stringstream ss;
+	ss << "\t\"parser\": \"" << (synthetic ? "synthetic" : "cxx") << "\",\n";
+	ss << "\t\"settings\": {\"seed\": " << settings.seed << ", \"files\": " << settings.fileCount
+	   << ", \"classes\": " << settings.classesPerFile << ", \"methods\": "
+	   << settings.methodsPerClass << ", \"includes\": " << settings.includesPerFile
+	   << ", \"calls\": " << settings.callsPerMethod << ", \"replays\": " << replayCount
+	   << ", \"queries\": " << queryCount << ", \"trails\": " << trailCount
+	   << ", \"trail_depth\": " << trailDepth << "},\n";
+	return writeResults(outputFile, resultsToJson(ss.str(), results));
+}
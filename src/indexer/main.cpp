@@ -1,5 +1,8 @@
 #include "includes.h"
 
+#include <cstdlib>
+#include <exception>
+
 #include "language_packages.h"
 
 #include "LanguagePackageManager.h"
@@ -10,6 +13,7 @@
 #include "FileLogger.h"
 #include "logging.h"
 #include "LogManager.h"
+#include "TraceRecorder.h"
 
 #if BUILD_CXX_LANGUAGE_PACKAGE
 #include "LanguagePackageCxx.h"
@@ -32,6 +36,14 @@ void setupLogging(const FilePath& logFilePath)
 	fileLogger->setLogFilePath(logFilePath);
 	fileLogger->setLogLevel(Logger::LOG_ALL);
 	logManager->addLogger(fileLogger);
+	logManager->setLoggingAsync(true);
+
+	// the indexer flushes its log whenever it starts a file, this also keeps the last messages
+	// before an uncaught exception
+	std::set_terminate([]() {
+		LogManager::getInstance()->flush();
+		std::abort();
+	});
 }
 
 void suppressCrashMessage()
@@ -88,6 +100,9 @@ int main(int argc, char *argv[])
 	appSettings->load(FilePath(UserPaths::getAppSettingsPath()));
 	LogManager::getInstance()->setLoggingEnabled(appSettings->getLoggingEnabled());
 
+	TraceRecorder::getInstance()->setProcessName("Sourcetrail indexer " + std::to_string(processId));
+	TraceRecorder::setEnabled(appSettings->getTracingEnabled());
+
 	LOG_INFO(L"sharedDataPath: " + AppPath::getSharedDataPath().wstr());
 	LOG_INFO(L"userDataPath: " + UserPaths::getUserDataPath().wstr());
 
@@ -103,5 +118,13 @@ int main(int argc, char *argv[])
 	InterprocessIndexer indexer(instanceUuid, processId);
 	indexer.work();
 
+	if (TraceRecorder::isEnabled())
+	{
+		// restarted indexer processes append to the same file, the app merges it after indexing
+		TraceRecorder::getInstance()->exportChromeTrace(
+			appSettings->getLogDirectoryPath().getConcatenated(
+				L"trace_indexer_" + std::to_wstring(processId) + L".json"));
+	}
+
 	return 0;
 }
@@ -22,6 +22,7 @@
 #include "TabId.h"
 #include "TaskManager.h"
 #include "TaskScheduler.h"
+#include "TraceRecorder.h"
 #include "UpdateChecker.h"
 #include "UserPaths.h"
 #include "Version.h"
@@ -113,6 +114,9 @@ void Application::loadSettings()
 	settings->load(UserPaths::getAppSettingsPath());
 
 	LogManager::getInstance()->setLoggingEnabled(settings->getLoggingEnabled());
+	TraceRecorder::getInstance()->setProcessName("Sourcetrail");
+	TraceRecorder::setEnabled(settings->getTracingEnabled());
+
 	Logger* logger = LogManager::getInstance()->getLoggerByType("FileLogger");
 	if (logger)
 	{
@@ -229,6 +233,7 @@ void Application::handleMessage(MessageCloseProject* message)
 void Application::handleMessage(MessageIndexingFinished* message)
 {
 	logStorageStats();
+	exportTraces();
 
 	if (m_hasGUI)
 	{
@@ -490,6 +495,37 @@ void Application::logStorageStats() const
 	LOG_INFO(ss.str());
 }
 
+void Application::exportTraces() const
+{
+	if (!TraceRecorder::isEnabled())
+	{
+		return;
+	}
+
+	const FilePath logDirectoryPath = ApplicationSettings::getInstance()->getLogDirectoryPath();
+	const FilePath traceFilePath = logDirectoryPath.getConcatenated(
+		FileLogger::generateDatedFileName(L"trace") + L".json");
+
+	if (!TraceRecorder::getInstance()->exportChromeTrace(traceFilePath))
+	{
+		return;
+	}
+
+	// indexer processes write their events to separate files, see indexer main
+	std::vector<FilePath> indexerTraceFilePaths;
+	for (const FilePath& filePath:
+		 FileSystem::getFilePathsFromDirectory(logDirectoryPath, {L".json"}))
+	{
+		if (utility::isPrefix<std::wstring>(L"trace_indexer_", filePath.fileName()))
+		{
+			indexerTraceFilePaths.push_back(filePath);
+		}
+	}
+
+	TraceRecorder::mergeChromeTraces(indexerTraceFilePaths, traceFilePath);
+	LOG_INFO(L"Wrote trace file: " + traceFilePath.wstr());
+}
+
 void Application::updateTitle()
 {
 	if (m_hasGUI)
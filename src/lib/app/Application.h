@@ -83,6 +83,7 @@ private:
 	void updateRecentProjects(const FilePath& projectSettingsFilePath);
 
 	void logStorageStats() const;
+	void exportTraces() const;
 
 	void updateTitle();
 
@@ -933,8 +933,7 @@ std::vector<std::string> CodeController::getProjectDescription(SourceLocationFil
 				break;
 			}
 
-			std::wstring serializedName = utility::decodeFromUtf8(
-				line.substr(posA + 1, posB - posA - 1));
+			const std::string serializedName = line.substr(posA + 1, posB - posA - 1);
 
 			NameHierarchy nameHierarchy = NameHierarchy::deserialize(serializedName);
 			Id tokenId = m_storageAccess->getNodeIdForNameHierarchy(nameHierarchy);
@@ -24,7 +24,8 @@ void CustomTrailController::autocomplete(const std::wstring query, bool from)
 	nodeTypes.remove(NodeType(NODE_PACKAGE));
 
 	getView()->showAutocompletions(
-		m_storageAccess->getAutocompletionMatches(query, nodeTypes, false), from);
+		m_storageAccess->getAutocompletionMatches(query, nodeTypes, false, AutocompletionRequest()),
+		from);
 }
 
 void CustomTrailController::activateTrail(MessageActivateTrail message)
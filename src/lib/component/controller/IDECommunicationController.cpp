@@ -1,15 +1,24 @@
 #include "IDECommunicationController.h"
 
+#include <algorithm>
+
 #include "FileSystem.h"
 #include "MessageActivateWindow.h"
 #include "MessagePingReceived.h"
 #include "MessageProjectNew.h"
 #include "MessageStatus.h"
 #include "MessageTabOpenWith.h"
+#include "TimeStamp.h"
 #include "logging.h"
 
 #include "SourceLocationFile.h"
 #include "StorageAccess.h"
+#include "TokenPositionIndex.h"
+
+namespace
+{
+const size_t SET_ACTIVE_TOKEN_LATENCY_REPORT_INTERVAL = 100;
+}
 
 IDECommunicationController::IDECommunicationController(StorageAccess* storageAccess)
 	: m_storageAccess(storageAccess), m_enabled(true)
@@ -18,7 +27,10 @@ IDECommunicationController::IDECommunicationController(StorageAccess* storageAcc
 
 IDECommunicationController::~IDECommunicationController() {}
 
-void IDECommunicationController::clear() {}
+void IDECommunicationController::clear()
+{
+	clearCachedFiles();
+}
 
 void IDECommunicationController::handleIncomingMessage(const std::wstring& message)
 {
@@ -75,36 +87,22 @@ void IDECommunicationController::handleSetActiveTokenMessage(
 {
 	if (message.valid)
 	{
-		const unsigned int cursorColumn = message.column;
+		const TimeStamp startTime = TimeStamp::now();
 
-		const Id fileId = m_storageAccess->getNodeIdForFileNode(message.filePath.getCanonical());
-		const FileInfo fileInfo = m_storageAccess->getFileInfoForFileId(fileId);
-		const FilePath filePath = fileInfo.path;
+		const CachedFile cachedFile = getCachedFile(message.filePath.getCanonical());
+		const Id fileId = cachedFile.fileId;
+		const FilePath filePath = cachedFile.fileInfo.path;
 
-		if (FileSystem::getFileInfoForPath(filePath).lastWriteTime == fileInfo.lastWriteTime)
+		if (cachedFile.positionIndex)
 		{
 			// file was not modified
-			std::shared_ptr<SourceLocationFile> sourceLocationFile =
-				m_storageAccess->getSourceLocationsForLinesInFile(filePath, message.row, message.row);
-
-			std::vector<Id> selectedLocationIds;
-			sourceLocationFile->forEachStartSourceLocation(
-				[&selectedLocationIds, &cursorColumn](SourceLocation* startLocation) {
-					const SourceLocation* endLocation = startLocation->getEndLocation();
-
-					if ((startLocation->getType() == LOCATION_TOKEN ||
-						 startLocation->getType() == LOCATION_QUALIFIER ||
-						 startLocation->getType() == LOCATION_UNSOLVED) &&
-						startLocation->getLineNumber() == endLocation->getLineNumber() &&
-						startLocation->getColumnNumber() <= cursorColumn &&
-						endLocation->getColumnNumber() + 1 >= cursorColumn)
-					{
-						selectedLocationIds.push_back(startLocation->getLocationId());
-					}
-				});
+			const std::vector<Id> selectedLocationIds =
+				cachedFile.positionIndex->getLocationIdsAtPosition(message.row, message.column);
 
 			if (!selectedLocationIds.empty())
 			{
+				logSetActiveTokenLatency(TimeStamp::durationSeconds(startTime));
+
 				MessageStatus(
 					L"Activating source location from plug-in succeeded: " + filePath.wstr() +
 					L", row: " + std::to_wstring(message.row) + L", col: " +
@@ -117,6 +115,8 @@ void IDECommunicationController::handleSetActiveTokenMessage(
 			}
 		}
 
+		logSetActiveTokenLatency(TimeStamp::durationSeconds(startTime));
+
 		if (fileId > 0)
 		{
 			MessageTabOpenWith(filePath, message.row).showNewTab(true).dispatch();
@@ -173,6 +173,73 @@ void IDECommunicationController::handlePing(const NetworkProtocolHelper::PingMes
 	}
 }
 
+IDECommunicationController::CachedFile IDECommunicationController::getCachedFile(
+	const FilePath& filePath)
+{
+	std::lock_guard<std::mutex> lock(m_cachedFilesMutex);
+
+	auto it = m_cachedFiles.find(filePath);
+	if (it == m_cachedFiles.end())
+	{
+		CachedFile cachedFile;
+		cachedFile.fileId = m_storageAccess->getNodeIdForFileNode(filePath);
+		cachedFile.fileInfo = m_storageAccess->getFileInfoForFileId(cachedFile.fileId);
+		it = m_cachedFiles.emplace(filePath, cachedFile).first;
+	}
+
+	CachedFile& cachedFile = it->second;
+
+	if (cachedFile.fileId == 0 ||
+		FileSystem::getFileInfoForPath(cachedFile.fileInfo.path).lastWriteTime !=
+		cachedFile.fileInfo.lastWriteTime)
+	{
+		// file is unknown or was modified since indexing, token positions are not reliable
+		CachedFile modifiedFile = cachedFile;
+		modifiedFile.positionIndex.reset();
+		return modifiedFile;
+	}
+
+	if (!cachedFile.positionIndex)
+	{
+		std::shared_ptr<SourceLocationFile> sourceLocationFile =
+			m_storageAccess->getSourceLocationsForFile(cachedFile.fileInfo.path);
+		cachedFile.positionIndex = std::make_shared<TokenPositionIndex>(*sourceLocationFile);
+	}
+
+	return cachedFile;
+}
+
+void IDECommunicationController::clearCachedFiles()
+{
+	std::lock_guard<std::mutex> lock(m_cachedFilesMutex);
+	m_cachedFiles.clear();
+}
+
+void IDECommunicationController::logSetActiveTokenLatency(double seconds)
+{
+	std::vector<double> latencies;
+	{
+		std::lock_guard<std::mutex> lock(m_cachedFilesMutex);
+		m_setActiveTokenLatencies.push_back(seconds * 1000.0);
+		if (m_setActiveTokenLatencies.size() < SET_ACTIVE_TOKEN_LATENCY_REPORT_INTERVAL)
+		{
+			return;
+		}
+		latencies.swap(m_setActiveTokenLatencies);
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+
+	auto percentile = [&latencies](size_t p) {
+		return latencies[std::min(latencies.size() - 1, latencies.size() * p / 100)];
+	};
+
+	LOG_INFO_STREAM(
+		<< "Set active token latency over the last " << latencies.size()
+		<< " requests (ms) - p50: " << percentile(50) << " p90: " << percentile(90)
+		<< " p99: " << percentile(99) << " max: " << latencies.back());
+}
+
 void IDECommunicationController::handleMessage(MessageWindowFocus* message)
 {
 	if (message->focusIn)
@@ -190,6 +257,11 @@ void IDECommunicationController::handleMessage(MessageIDECreateCDB* message)
 	sendMessage(networkMessage);
 }
 
+void IDECommunicationController::handleMessage(MessageIndexingFinished* message)
+{
+	clearCachedFiles();
+}
+
 void IDECommunicationController::handleMessage(MessageMoveIDECursor* message)
 {
 	std::wstring networkMessage = NetworkProtocolHelper::buildSetIDECursorMessage(
@@ -1,23 +1,31 @@
 #ifndef IDE_COMMUNICATION_CONTROLLER_H
 #define IDE_COMMUNICATION_CONTROLLER_H
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "Controller.h"
+#include "FileInfo.h"
 #include "NetworkProtocolHelper.h"
 
 #include "MessageIDECreateCDB.h"
+#include "MessageIndexingFinished.h"
 #include "MessageListener.h"
 #include "MessageMoveIDECursor.h"
 #include "MessagePluginPortChange.h"
 #include "MessageWindowFocus.h"
 
 class StorageAccess;
+class TokenPositionIndex;
 
 class IDECommunicationController
 	: public Controller
 	, public MessageListener<MessageWindowFocus>
 	, public MessageListener<MessageIDECreateCDB>
+	, public MessageListener<MessageIndexingFinished>
 	, public MessageListener<MessageMoveIDECursor>
 	, public MessageListener<MessagePluginPortChange>
 {
@@ -40,13 +48,25 @@ protected:
 	void sendUpdatePing();
 
 private:
+	struct CachedFile
+	{
+		Id fileId = 0;
+		FileInfo fileInfo;
+		std::shared_ptr<TokenPositionIndex> positionIndex;
+	};
+
 	void handleSetActiveTokenMessage(const NetworkProtocolHelper::SetActiveTokenMessage& message);
 	void handleCreateProjectMessage(const NetworkProtocolHelper::CreateProjectMessage& message);
 	void handleCreateCDBProjectMessage(const NetworkProtocolHelper::CreateCDBProjectMessage& message);
 	void handlePing(const NetworkProtocolHelper::PingMessage& message);
 
+	CachedFile getCachedFile(const FilePath& filePath);
+	void clearCachedFiles();
+	void logSetActiveTokenLatency(double seconds);
+
 	virtual void handleMessage(MessageWindowFocus* message);
 	virtual void handleMessage(MessageIDECreateCDB* message);
+	virtual void handleMessage(MessageIndexingFinished* message);
 	virtual void handleMessage(MessageMoveIDECursor* message);
 	virtual void handleMessage(MessagePluginPortChange* message);
 	virtual void sendMessage(const std::wstring& message) const = 0;
@@ -54,6 +74,12 @@ private:
 	StorageAccess* m_storageAccess;
 
 	bool m_enabled;
+
+	// token positions of files already requested by the plugin, dropped whenever the index changes
+	std::map<FilePath, CachedFile> m_cachedFiles;
+	std::mutex m_cachedFilesMutex;
+
+	std::vector<double> m_setActiveTokenLatencies;
 };
 
 #endif	  // IDE_COMMUNICATION_CONTROLLER_H
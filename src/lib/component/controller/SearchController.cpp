@@ -54,14 +54,30 @@ void SearchController::handleMessage(MessageSearchAutocomplete* message)
 	SearchView* view = getView();
 
 	// Don't autocomplete if autocompletion request is not up-to-date anymore
-	if (message->query != view->getQuery())
+	if (message->isCancelled() || message->query != view->getQuery())
 	{
 		return;
 	}
 
 	LOG_INFO(L"autocomplete string: \"" + message->query + L"\"");
-	view->setAutocompletionList(m_storageAccess->getAutocompletionMatches(
-		message->query, message->acceptedNodeTypes, true));
+
+	AutocompletionRequest request;
+	request.isCancelled = [message]() { return message->isCancelled(); };
+	request.onFirstMatches = [message, view](const std::vector<SearchMatch>& matches) {
+		if (!message->isCancelled())
+		{
+			view->setAutocompletionList(matches);
+		}
+	};
+
+	const std::vector<SearchMatch> matches = m_storageAccess->getAutocompletionMatches(
+		message->query, message->acceptedNodeTypes, true, request);
+
+	// a cancelled query returns no matches, which would hide the matches of the newer query
+	if (!message->isCancelled())
+	{
+		view->setAutocompletionList(matches);
+	}
 }
 
 SearchView* SearchController::getView()
@@ -53,6 +53,11 @@ void DialogView::updateIndexingDialog(
 {
 }
 
+void DialogView::updateIndexingMemoryUsage(
+	size_t usedByteSize, size_t budgetByteSize, bool throttled)
+{
+}
+
 void DialogView::updateCustomIndexingDialog(
 	size_t startedFileCount,
 	size_t finishedFileCount,
@@ -59,6 +59,8 @@ public:
 		size_t finishedFileCount,
 		size_t totalFileCount,
 		const std::vector<FilePath>& sourcePaths);
+	virtual void updateIndexingMemoryUsage(
+		size_t usedByteSize, size_t budgetByteSize, bool throttled);
 	virtual void updateCustomIndexingDialog(
 		size_t startedFileCount,
 		size_t finishedFileCount,
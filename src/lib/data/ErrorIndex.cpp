@@ -0,0 +1,161 @@
+#include "ErrorIndex.h"
+
+#include <algorithm>
+
+void ErrorIndex::clear()
+{
+	m_errors.clear();
+	for (std::vector<uint32_t>& errorIndices: m_categoryErrorIndices)
+	{
+		errorIndices.clear();
+	}
+	m_fileErrorIndices.clear();
+}
+
+bool ErrorIndex::empty() const
+{
+	return m_errors.empty();
+}
+
+void ErrorIndex::addError(const ErrorInfo& error, Id fileId)
+{
+	const uint32_t errorIndex = static_cast<uint32_t>(m_errors.size());
+	m_errors.push_back(error);
+
+	m_categoryErrorIndices[getCategory(error.fatal, error.indexed)].push_back(errorIndex);
+	m_fileErrorIndices[fileId].push_back(errorIndex);
+}
+
+ErrorCountInfo ErrorIndex::getErrorCount() const
+{
+	return ErrorCountInfo(
+		m_errors.size(),
+		m_categoryErrorIndices[getCategory(true, false)].size() +
+			m_categoryErrorIndices[getCategory(true, true)].size());
+}
+
+size_t ErrorIndex::getErrorCount(const ErrorFilter& filter) const
+{
+	size_t count = 0;
+	for (size_t category: getAcceptedCategories(filter))
+	{
+		count += m_categoryErrorIndices[category].size();
+	}
+	return count;
+}
+
+std::vector<ErrorInfo> ErrorIndex::getErrors(const ErrorFilter& filter) const
+{
+	const std::vector<size_t> categories = getAcceptedCategories(filter);
+	const size_t count = getErrorCount(filter);
+	const size_t end = filter.limit > 0 ? std::min(count, filter.limit) : count;
+
+	std::vector<ErrorInfo> errors;
+	errors.reserve(end);
+
+	if (categories.size() == 1)
+	{
+		const std::vector<uint32_t>& errorIndices = m_categoryErrorIndices[categories.front()];
+		for (size_t i = 0; i < end; i++)
+		{
+			errors.push_back(m_errors[errorIndices[i]]);
+		}
+		return errors;
+	}
+
+	// merges the positions of the accepted categories to keep the order the errors were added in
+	std::vector<size_t> positions(categories.size(), 0);
+	for (size_t i = 0; i < end; i++)
+	{
+		size_t nextCategory = 0;
+		uint32_t nextErrorIndex = static_cast<uint32_t>(m_errors.size());
+		for (size_t j = 0; j < categories.size(); j++)
+		{
+			const std::vector<uint32_t>& errorIndices = m_categoryErrorIndices[categories[j]];
+			if (positions[j] < errorIndices.size() && errorIndices[positions[j]] < nextErrorIndex)
+			{
+				nextCategory = j;
+				nextErrorIndex = errorIndices[positions[j]];
+			}
+		}
+
+		positions[nextCategory]++;
+		errors.push_back(m_errors[nextErrorIndex]);
+	}
+
+	return errors;
+}
+
+std::vector<ErrorInfo> ErrorIndex::getErrorsAfter(size_t errorCount) const
+{
+	if (errorCount >= m_errors.size())
+	{
+		return {};
+	}
+	return std::vector<ErrorInfo>(m_errors.begin() + errorCount, m_errors.end());
+}
+
+std::vector<ErrorInfo> ErrorIndex::getErrorsForFiles(
+	const ErrorFilter& filter, const std::set<Id>& fileIds) const
+{
+	std::vector<uint32_t> errorIndices;
+	for (Id fileId: fileIds)
+	{
+		auto it = m_fileErrorIndices.find(fileId);
+		if (it != m_fileErrorIndices.end())
+		{
+			errorIndices.insert(errorIndices.end(), it->second.begin(), it->second.end());
+		}
+	}
+	std::sort(errorIndices.begin(), errorIndices.end());
+
+	ErrorFilter unlimitedFilter = filter;
+	unlimitedFilter.limit = 0;
+	return getErrors(unlimitedFilter, errorIndices);
+}
+
+size_t ErrorIndex::getCategory(bool fatal, bool indexed)
+{
+	return (fatal ? 1 : 0) + (indexed ? 2 : 0);
+}
+
+std::vector<size_t> ErrorIndex::getAcceptedCategories(const ErrorFilter& filter)
+{
+	std::vector<size_t> categories;
+	for (bool fatal: {false, true})
+	{
+		for (bool indexed: {false, true})
+		{
+			ErrorInfo error;
+			error.fatal = fatal;
+			error.indexed = indexed;
+			if (filter.filter(error))
+			{
+				categories.push_back(getCategory(fatal, indexed));
+			}
+		}
+	}
+	return categories;
+}
+
+std::vector<ErrorInfo> ErrorIndex::getErrors(
+	const ErrorFilter& filter, const std::vector<uint32_t>& errorIndices) const
+{
+	std::vector<ErrorInfo> errors;
+
+	for (uint32_t errorIndex: errorIndices)
+	{
+		const ErrorInfo& error = m_errors[errorIndex];
+		if (filter.filter(error))
+		{
+			errors.push_back(error);
+
+			if (filter.limit > 0 && errors.size() >= filter.limit)
+			{
+				break;
+			}
+		}
+	}
+
+	return errors;
+}
@@ -0,0 +1,52 @@
+#ifndef ERROR_INDEX_H
+#define ERROR_INDEX_H
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "ErrorCountInfo.h"
+#include "ErrorFilter.h"
+#include "ErrorInfo.h"
+#include "types.h"
+
+// In memory index of all errors of a storage.
+// The errors are kept in the order they were added, and their positions are grouped by the fatal
+// and indexed flags and by file. So counts are available without iterating the errors, and a
+// limited list of filtered errors only touches the errors it returns.
+class ErrorIndex
+{
+public:
+	void clear();
+	bool empty() const;
+
+	void addError(const ErrorInfo& error, Id fileId);
+
+	ErrorCountInfo getErrorCount() const;
+	size_t getErrorCount(const ErrorFilter& filter) const;
+
+	// returns the errors accepted by the filter in the order they were added, up to its limit
+	std::vector<ErrorInfo> getErrors(const ErrorFilter& filter) const;
+
+	// returns the errors that were added after the first errorCount errors
+	std::vector<ErrorInfo> getErrorsAfter(size_t errorCount) const;
+
+	// returns all errors located in one of the files that are accepted by the filter
+	std::vector<ErrorInfo> getErrorsForFiles(
+		const ErrorFilter& filter, const std::set<Id>& fileIds) const;
+
+private:
+	static const size_t s_categoryCount = 4;
+
+	static size_t getCategory(bool fatal, bool indexed);
+	static std::vector<size_t> getAcceptedCategories(const ErrorFilter& filter);
+
+	std::vector<ErrorInfo> getErrors(
+		const ErrorFilter& filter, const std::vector<uint32_t>& errorIndices) const;
+
+	std::vector<ErrorInfo> m_errors;
+	std::vector<uint32_t> m_categoryErrorIndices[s_categoryCount];
+	std::unordered_map<Id, std::vector<uint32_t>> m_fileErrorIndices;
+};
+
+#endif	  // ERROR_INDEX_H
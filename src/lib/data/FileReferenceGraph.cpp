@@ -0,0 +1,284 @@
+#include "FileReferenceGraph.h"
+
+#include <algorithm>
+#include <limits>
+
+FileReferenceGraph::FileReferenceGraph(): m_finished(true) {}
+
+void FileReferenceGraph::clear()
+{
+	m_finished = true;
+
+	m_fileIndices.clear();
+	m_fileIds.clear();
+	m_references.clear();
+
+	m_fileComponents.clear();
+	m_componentFileOffsets.clear();
+	m_componentFiles.clear();
+	m_componentCyclic.clear();
+
+	m_referencingComponents = Adjacency();
+	m_referencedComponents = Adjacency();
+}
+
+bool FileReferenceGraph::isFinished() const
+{
+	return m_finished;
+}
+
+void FileReferenceGraph::addReference(Id referencingFileId, Id referencedFileId)
+{
+	const uint32_t referencingIndex = getIndex(referencingFileId);
+	const uint32_t referencedIndex = getIndex(referencedFileId);
+	m_references.emplace_back(referencingIndex, referencedIndex);
+	m_finished = false;
+}
+
+void FileReferenceGraph::finish()
+{
+	if (m_finished)
+	{
+		return;
+	}
+
+	std::sort(m_references.begin(), m_references.end());
+	m_references.erase(std::unique(m_references.begin(), m_references.end()), m_references.end());
+
+	Adjacency fileAdjacency;
+	fileAdjacency.build(m_fileIds.size(), m_references);
+	condense(fileAdjacency);
+
+	const size_t componentCount = m_componentCyclic.size();
+
+	std::vector<std::pair<uint32_t, uint32_t>> componentReferences;
+	for (const std::pair<uint32_t, uint32_t>& reference: m_references)
+	{
+		const uint32_t referencingComponent = m_fileComponents[reference.first];
+		const uint32_t referencedComponent = m_fileComponents[reference.second];
+		if (referencingComponent != referencedComponent)
+		{
+			componentReferences.emplace_back(referencingComponent, referencedComponent);
+		}
+		else if (reference.first == reference.second)
+		{
+			m_componentCyclic[referencingComponent] = true;
+		}
+	}
+
+	std::sort(componentReferences.begin(), componentReferences.end());
+	componentReferences.erase(
+		std::unique(componentReferences.begin(), componentReferences.end()),
+		componentReferences.end());
+	m_referencedComponents.build(componentCount, componentReferences);
+
+	for (std::pair<uint32_t, uint32_t>& reference: componentReferences)
+	{
+		std::swap(reference.first, reference.second);
+	}
+	m_referencingComponents.build(componentCount, componentReferences);
+
+	std::vector<std::pair<uint32_t, uint32_t>> componentFiles;
+	componentFiles.reserve(m_fileComponents.size());
+	for (uint32_t i = 0; i < m_fileComponents.size(); i++)
+	{
+		componentFiles.emplace_back(m_fileComponents[i], i);
+	}
+
+	Adjacency componentFileAdjacency;
+	componentFileAdjacency.build(componentCount, componentFiles);
+	m_componentFileOffsets = std::move(componentFileAdjacency.offsets);
+	m_componentFiles = std::move(componentFileAdjacency.targets);
+
+	m_finished = true;
+}
+
+std::set<Id> FileReferenceGraph::getReferencing(const std::set<Id>& fileIds) const
+{
+	return getReachable(fileIds, m_referencingComponents);
+}
+
+std::set<Id> FileReferenceGraph::getReferenced(const std::set<Id>& fileIds) const
+{
+	return getReachable(fileIds, m_referencedComponents);
+}
+
+size_t FileReferenceGraph::getFileCount() const
+{
+	return m_fileIds.size();
+}
+
+size_t FileReferenceGraph::getComponentCount() const
+{
+	return m_componentCyclic.size();
+}
+
+void FileReferenceGraph::Adjacency::build(
+	size_t nodeCount, const std::vector<std::pair<uint32_t, uint32_t>>& edges)
+{
+	offsets.assign(nodeCount + 1, 0);
+	for (const std::pair<uint32_t, uint32_t>& edge: edges)
+	{
+		offsets[edge.first + 1]++;
+	}
+
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		offsets[i + 1] += offsets[i];
+	}
+
+	targets.resize(edges.size());
+	std::vector<uint32_t> positions(offsets.begin(), offsets.end() - 1);
+	for (const std::pair<uint32_t, uint32_t>& edge: edges)
+	{
+		targets[positions[edge.first]++] = edge.second;
+	}
+}
+
+uint32_t FileReferenceGraph::getIndex(Id fileId)
+{
+	auto it = m_fileIndices.emplace(fileId, static_cast<uint32_t>(m_fileIds.size()));
+	if (it.second)
+	{
+		m_fileIds.push_back(fileId);
+	}
+	return it.first->second;
+}
+
+void FileReferenceGraph::condense(const Adjacency& fileAdjacency)
+{
+	// iterative version of Tarjan's algorithm, so long reference chains can't overflow the stack
+	const uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+	const size_t fileCount = m_fileIds.size();
+
+	std::vector<uint32_t> indices(fileCount, unvisited);
+	std::vector<uint32_t> lowLinks(fileCount, 0);
+	std::vector<bool> onStack(fileCount, false);
+	std::vector<uint32_t> stack;
+	std::vector<std::pair<uint32_t, uint32_t>> callStack;
+	uint32_t nextIndex = 0;
+
+	m_fileComponents.assign(fileCount, 0);
+	m_componentCyclic.clear();
+
+	auto visit = [&](uint32_t file) {
+		indices[file] = lowLinks[file] = nextIndex++;
+		stack.push_back(file);
+		onStack[file] = true;
+		callStack.emplace_back(file, fileAdjacency.offsets[file]);
+	};
+
+	for (uint32_t root = 0; root < fileCount; root++)
+	{
+		if (indices[root] != unvisited)
+		{
+			continue;
+		}
+
+		visit(root);
+		while (!callStack.empty())
+		{
+			const uint32_t file = callStack.back().first;
+			const uint32_t edgeIndex = callStack.back().second;
+
+			if (edgeIndex < fileAdjacency.offsets[file + 1])
+			{
+				callStack.back().second++;
+
+				const uint32_t target = fileAdjacency.targets[edgeIndex];
+				if (indices[target] == unvisited)
+				{
+					visit(target);
+				}
+				else if (onStack[target])
+				{
+					lowLinks[file] = std::min(lowLinks[file], indices[target]);
+				}
+				continue;
+			}
+
+			callStack.pop_back();
+
+			if (lowLinks[file] == indices[file])
+			{
+				const uint32_t component = static_cast<uint32_t>(m_componentCyclic.size());
+				size_t componentSize = 0;
+				uint32_t member = 0;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					onStack[member] = false;
+					m_fileComponents[member] = component;
+					componentSize++;
+				} while (member != file);
+
+				m_componentCyclic.push_back(componentSize > 1);
+			}
+
+			if (!callStack.empty())
+			{
+				const uint32_t parent = callStack.back().first;
+				lowLinks[parent] = std::min(lowLinks[parent], lowLinks[file]);
+			}
+		}
+	}
+}
+
+std::set<Id> FileReferenceGraph::getReachable(
+	const std::set<Id>& fileIds, const Adjacency& adjacency) const
+{
+	std::vector<bool> reached(m_componentCyclic.size(), false);
+	std::vector<uint32_t> components;
+
+	for (Id fileId: fileIds)
+	{
+		auto it = m_fileIndices.find(fileId);
+		if (it == m_fileIndices.end())
+		{
+			continue;
+		}
+
+		const uint32_t component = m_fileComponents[it->second];
+		if (m_componentCyclic[component])
+		{
+			if (reached[component])
+			{
+				continue;
+			}
+			reached[component] = true;
+		}
+		components.push_back(component);
+	}
+
+	for (size_t i = 0; i < components.size(); i++)
+	{
+		const uint32_t component = components[i];
+		for (uint32_t j = adjacency.offsets[component]; j < adjacency.offsets[component + 1]; j++)
+		{
+			const uint32_t target = adjacency.targets[j];
+			if (!reached[target])
+			{
+				reached[target] = true;
+				components.push_back(target);
+			}
+		}
+	}
+
+	std::set<Id> reachedFileIds;
+	for (uint32_t component: components)
+	{
+		if (!reached[component])
+		{
+			continue;
+		}
+
+		for (uint32_t j = m_componentFileOffsets[component];
+			 j < m_componentFileOffsets[component + 1];
+			 j++)
+		{
+			reachedFileIds.insert(m_fileIds[m_componentFiles[j]]);
+		}
+	}
+	return reachedFileIds;
+}
@@ -0,0 +1,67 @@
+#ifndef FILE_REFERENCE_GRAPH_H
+#define FILE_REFERENCE_GRAPH_H
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+
+// Directed graph of files referencing other files, e.g. by includes or imports.
+// Files that reference each other in a cycle are condensed into one component, so the graph of
+// components is acyclic and transitive queries visit each component and each edge between
+// components at most once. The adjacency is stored in flat arrays that are built in finish().
+class FileReferenceGraph
+{
+public:
+	FileReferenceGraph();
+
+	void clear();
+	bool isFinished() const;
+
+	void addReference(Id referencingFileId, Id referencedFileId);
+
+	// condenses the cycles of the added references, needs to be called before querying
+	void finish();
+
+	// returns all files that transitively reference one of the passed files, the passed files are
+	// only part of the result if they are part of a reference cycle
+	std::set<Id> getReferencing(const std::set<Id>& fileIds) const;
+
+	// returns all files that are transitively referenced by one of the passed files, the passed
+	// files are only part of the result if they are part of a reference cycle
+	std::set<Id> getReferenced(const std::set<Id>& fileIds) const;
+
+	size_t getFileCount() const;
+	size_t getComponentCount() const;
+
+private:
+	struct Adjacency
+	{
+		void build(size_t nodeCount, const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> targets;
+	};
+
+	uint32_t getIndex(Id fileId);
+	void condense(const Adjacency& fileAdjacency);
+	std::set<Id> getReachable(const std::set<Id>& fileIds, const Adjacency& adjacency) const;
+
+	bool m_finished;
+
+	std::unordered_map<Id, uint32_t> m_fileIndices;
+	std::vector<Id> m_fileIds;
+	std::vector<std::pair<uint32_t, uint32_t>> m_references;
+
+	std::vector<uint32_t> m_fileComponents;
+	std::vector<uint32_t> m_componentFileOffsets;
+	std::vector<uint32_t> m_componentFiles;
+	std::vector<bool> m_componentCyclic;
+
+	Adjacency m_referencingComponents;
+	Adjacency m_referencedComponents;
+};
+
+#endif	  // FILE_REFERENCE_GRAPH_H
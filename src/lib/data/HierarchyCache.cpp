@@ -1,5 +1,7 @@
 #include "HierarchyCache.h"
 
+#include <algorithm>
+
 #include "utility.h"
 
 HierarchyCache::HierarchyNode::HierarchyNode(Id nodeId)
@@ -38,11 +40,29 @@ void HierarchyCache::HierarchyNode::addBase(HierarchyNode* base, Id edgeId)
 	m_baseEdgeIds.push_back(edgeId);
 }
 
+void HierarchyCache::HierarchyNode::removeBase(Id edgeId)
+{
+	for (size_t i = 0; i < m_baseEdgeIds.size(); i++)
+	{
+		if (m_baseEdgeIds[i] == edgeId)
+		{
+			m_bases.erase(m_bases.begin() + i);
+			m_baseEdgeIds.erase(m_baseEdgeIds.begin() + i);
+			return;
+		}
+	}
+}
+
 void HierarchyCache::HierarchyNode::addChild(HierarchyNode* child)
 {
 	m_children.push_back(child);
 }
 
+void HierarchyCache::HierarchyNode::removeChild(HierarchyNode* child)
+{
+	m_children.erase(std::remove(m_children.begin(), m_children.end(), child), m_children.end());
+}
+
 size_t HierarchyCache::HierarchyNode::getChildrenCount() const
 {
 	return m_children.size();
@@ -182,6 +202,78 @@ void HierarchyCache::createInheritance(Id edgeId, Id fromId, Id toId)
 	from->addBase(to, edgeId);
 }
 
+void HierarchyCache::removeConnection(Id edgeId, Id fromId, Id toId)
+{
+	HierarchyNode* from = getNode(fromId);
+	HierarchyNode* to = getNode(toId);
+	if (!from || !to)
+	{
+		return;
+	}
+
+	from->removeChild(to);
+	if (to->getEdgeId() == edgeId)
+	{
+		to->setParent(nullptr);
+		to->setEdgeId(0);
+	}
+
+	// only sources of member edges are invisible
+	if (!from->getChildrenCount())
+	{
+		from->setIsVisible(true);
+	}
+}
+
+void HierarchyCache::removeInheritance(Id edgeId, Id fromId)
+{
+	HierarchyNode* from = getNode(fromId);
+	if (from)
+	{
+		from->removeBase(edgeId);
+	}
+}
+
+void HierarchyCache::updateNode(Id nodeId, bool visible, bool implicit)
+{
+	HierarchyNode* node = getNode(nodeId);
+	if (node)
+	{
+		if (node->getChildrenCount())
+		{
+			node->setIsVisible(visible);
+		}
+		node->setIsImplicit(implicit);
+	}
+}
+
+void HierarchyCache::removeNode(Id nodeId)
+{
+	auto it = m_nodes.find(nodeId);
+	if (it == m_nodes.end())
+	{
+		return;
+	}
+
+	HierarchyNode* node = it->second.get();
+	if (node->getParent())
+	{
+		node->getParent()->removeChild(node);
+	}
+
+	std::vector<Id> childIds;
+	std::vector<Id> childEdgeIds;
+	node->addChildIds(&childIds, &childEdgeIds);
+	for (Id childId: childIds)
+	{
+		HierarchyNode* child = getNode(childId);
+		child->setParent(nullptr);
+		child->setEdgeId(0);
+	}
+
+	m_nodes.erase(it);
+}
+
 Id HierarchyCache::getLastVisibleParentNodeId(Id nodeId) const
 {
 	HierarchyNode* node = nullptr;
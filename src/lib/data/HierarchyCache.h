@@ -17,6 +17,13 @@ public:
 		Id edgeId, Id fromId, Id toId, bool sourceVisible, bool sourceImplicit, bool targetImplicit);
 	void createInheritance(Id edgeId, Id fromId, Id toId);
 
+	// used to update the cache for changed elements without rebuilding it
+	void removeConnection(Id edgeId, Id fromId, Id toId);
+	void removeInheritance(Id edgeId, Id fromId);
+	void updateNode(Id nodeId, bool visible, bool implicit);
+	// expects the connections and inheritances of the node to be removed already
+	void removeNode(Id nodeId);
+
 	Id getLastVisibleParentNodeId(Id nodeId) const;
 	size_t getIndexOfLastVisibleParentNode(Id nodeId) const;
 
@@ -51,8 +58,10 @@ private:
 		void setParent(HierarchyNode* parent);
 
 		void addBase(HierarchyNode* base, Id edgeId);
+		void removeBase(Id edgeId);
 
 		void addChild(HierarchyNode* child);
+		void removeChild(HierarchyNode* child);
 
 		size_t getChildrenCount() const;
 		size_t getNonImplicitChildrenCount() const;
@@ -0,0 +1,213 @@
+#include "NodeTable.h"
+
+#include <algorithm>
+
+#include "NameHierarchy.h"
+
+NodeTable::NodeTable(): m_unusedNameSize(0) {}
+
+void NodeTable::clear()
+{
+	m_ids.clear();
+	m_entries.clear();
+	m_entryIndices.clear();
+	m_names.clear();
+	m_unusedNameSize = 0;
+
+	std::lock_guard<std::mutex> lock(m_nameHierarchyMutex);
+	m_recentNameHierarchies.clear();
+	m_olderNameHierarchies.clear();
+}
+
+size_t NodeTable::getNodeCount() const
+{
+	return m_entries.size();
+}
+
+void NodeTable::addNode(const StorageNode& node)
+{
+	removeNode(node.id);
+
+	Entry entry;
+	entry.nameOffset = m_names.size();
+	entry.nameSize = static_cast<uint32_t>(node.serializedName.size());
+	entry.type = node.type;
+
+	m_names.append(node.serializedName);
+	m_entryIndices.emplace(node.id, static_cast<uint32_t>(m_entries.size()));
+	m_ids.push_back(node.id);
+	m_entries.push_back(entry);
+}
+
+void NodeTable::removeNode(Id nodeId)
+{
+	auto it = m_entryIndices.find(nodeId);
+	if (it == m_entryIndices.end())
+	{
+		return;
+	}
+
+	const uint32_t entryIndex = it->second;
+	m_entryIndices.erase(it);
+	m_unusedNameSize += m_entries[entryIndex].nameSize;
+
+	// moves the last entry into the gap, the name buffer is compacted once half of it is unused
+	if (entryIndex + 1 < m_entries.size())
+	{
+		m_ids[entryIndex] = m_ids.back();
+		m_entries[entryIndex] = m_entries.back();
+		m_entryIndices[m_ids[entryIndex]] = entryIndex;
+	}
+	m_ids.pop_back();
+	m_entries.pop_back();
+
+	if (m_unusedNameSize > m_names.size() / 2)
+	{
+		compactNames();
+	}
+
+	removeNameHierarchy(nodeId);
+}
+
+bool NodeTable::containsNode(Id nodeId) const
+{
+	return m_entryIndices.find(nodeId) != m_entryIndices.end();
+}
+
+int NodeTable::getNodeType(Id nodeId) const
+{
+	auto it = m_entryIndices.find(nodeId);
+	if (it == m_entryIndices.end())
+	{
+		return 0;
+	}
+	return m_entries[it->second].type;
+}
+
+std::vector<Id> NodeTable::getNodes(
+	const std::vector<Id>& nodeIds, std::vector<StorageNode>* nodes) const
+{
+	std::vector<Id> sortedNodeIds = nodeIds;
+	std::sort(sortedNodeIds.begin(), sortedNodeIds.end());
+	sortedNodeIds.erase(
+		std::unique(sortedNodeIds.begin(), sortedNodeIds.end()), sortedNodeIds.end());
+
+	std::vector<Id> missingNodeIds;
+	for (Id nodeId: sortedNodeIds)
+	{
+		auto it = m_entryIndices.find(nodeId);
+		if (it == m_entryIndices.end())
+		{
+			missingNodeIds.push_back(nodeId);
+			continue;
+		}
+
+		const Entry& entry = m_entries[it->second];
+		nodes->emplace_back(nodeId, entry.type, m_names.substr(entry.nameOffset, entry.nameSize));
+	}
+	return missingNodeIds;
+}
+
+void NodeTable::forEachNode(const std::function<void(Id /*nodeId*/, int /*type*/)>& func) const
+{
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		func(m_ids[i], m_entries[i].type);
+	}
+}
+
+std::shared_ptr<const NameHierarchy> NodeTable::getNameHierarchy(Id nodeId) const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_nameHierarchyMutex);
+		auto it = m_recentNameHierarchies.find(nodeId);
+		if (it != m_recentNameHierarchies.end())
+		{
+			return it->second;
+		}
+	}
+
+	auto it = m_entryIndices.find(nodeId);
+	if (it == m_entryIndices.end())
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<const NameHierarchy> nameHierarchy;
+	{
+		std::lock_guard<std::mutex> lock(m_nameHierarchyMutex);
+		auto olderIt = m_olderNameHierarchies.find(nodeId);
+		if (olderIt != m_olderNameHierarchies.end())
+		{
+			nameHierarchy = olderIt->second;
+		}
+	}
+
+	// parses outside of the lock, so threads only wait for each other on the cache lookups
+	if (!nameHierarchy)
+	{
+		const Entry& entry = m_entries[it->second];
+		nameHierarchy = std::make_shared<const NameHierarchy>(
+			NameHierarchy::deserialize(m_names.substr(entry.nameOffset, entry.nameSize)));
+	}
+
+	std::lock_guard<std::mutex> lock(m_nameHierarchyMutex);
+	if (m_recentNameHierarchies.size() >= s_maxRecentNameHierarchyCount)
+	{
+		m_olderNameHierarchies = std::move(m_recentNameHierarchies);
+		m_recentNameHierarchies.clear();
+	}
+	m_recentNameHierarchies.emplace(nodeId, nameHierarchy);
+	return nameHierarchy;
+}
+
+std::shared_ptr<const NameHierarchy> NodeTable::getNameHierarchyWithoutCaching(Id nodeId) const
+{
+	auto it = m_entryIndices.find(nodeId);
+	if (it == m_entryIndices.end())
+	{
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_nameHierarchyMutex);
+		auto cachedIt = m_recentNameHierarchies.find(nodeId);
+		if (cachedIt != m_recentNameHierarchies.end())
+		{
+			return cachedIt->second;
+		}
+
+		cachedIt = m_olderNameHierarchies.find(nodeId);
+		if (cachedIt != m_olderNameHierarchies.end())
+		{
+			return cachedIt->second;
+		}
+	}
+
+	const Entry& entry = m_entries[it->second];
+	return std::make_shared<const NameHierarchy>(
+		NameHierarchy::deserialize(m_names.substr(entry.nameOffset, entry.nameSize)));
+}
+
+void NodeTable::removeNameHierarchy(Id nodeId)
+{
+	std::lock_guard<std::mutex> lock(m_nameHierarchyMutex);
+	m_recentNameHierarchies.erase(nodeId);
+	m_olderNameHierarchies.erase(nodeId);
+}
+
+void NodeTable::compactNames()
+{
+	std::string names;
+	names.reserve(m_names.size() - m_unusedNameSize);
+
+	for (Entry& entry: m_entries)
+	{
+		const size_t nameOffset = names.size();
+		names.append(m_names, entry.nameOffset, entry.nameSize);
+		entry.nameOffset = nameOffset;
+	}
+
+	m_names = std::move(names);
+	m_unusedNameSize = 0;
+}
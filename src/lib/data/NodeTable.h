@@ -0,0 +1,74 @@
+#ifndef NODE_TABLE_H
+#define NODE_TABLE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "StorageNode.h"
+#include "types.h"
+
+class NameHierarchy;
+
+// Compact in memory copy of the type and serialized name of all nodes of a storage, so that lookups
+// don't need to query the database. The serialized names share a single buffer and are only parsed
+// into name hierarchies on request. The recently requested name hierarchies are kept for reuse.
+class NodeTable
+{
+public:
+	NodeTable();
+
+	void clear();
+	size_t getNodeCount() const;
+
+	// replaces the node if it is already contained
+	void addNode(const StorageNode& node);
+	void removeNode(Id nodeId);
+
+	bool containsNode(Id nodeId) const;
+
+	// returns 0 if the node is not contained
+	int getNodeType(Id nodeId) const;
+
+	// appends the contained nodes ordered by id and returns the ids of the nodes that are not
+	// contained
+	std::vector<Id> getNodes(const std::vector<Id>& nodeIds, std::vector<StorageNode>* nodes) const;
+
+	void forEachNode(const std::function<void(Id /*nodeId*/, int /*type*/)>& func) const;
+
+	// returns nullptr if the node is not contained, can be called from several threads at once
+	std::shared_ptr<const NameHierarchy> getNameHierarchy(Id nodeId) const;
+	// like getNameHierarchy, but doesn't keep the parsed name, so lookups of many nodes at once
+	// don't push the repeatedly requested names out of the cache
+	std::shared_ptr<const NameHierarchy> getNameHierarchyWithoutCaching(Id nodeId) const;
+
+private:
+	struct Entry
+	{
+		size_t nameOffset;
+		uint32_t nameSize;
+		int type;
+	};
+
+	static const size_t s_maxRecentNameHierarchyCount = 50000;
+
+	void removeNameHierarchy(Id nodeId);
+	void compactNames();
+
+	std::vector<Id> m_ids;
+	std::vector<Entry> m_entries;
+	std::unordered_map<Id, uint32_t> m_entryIndices;
+
+	std::string m_names;
+	size_t m_unusedNameSize;
+
+	// two generations of parsed names, the older one is dropped once the recent one is full
+	mutable std::unordered_map<Id, std::shared_ptr<const NameHierarchy>> m_recentNameHierarchies;
+	mutable std::unordered_map<Id, std::shared_ptr<const NameHierarchy>> m_olderNameHierarchies;
+	mutable std::mutex m_nameHierarchyMutex;
+};
+
+#endif	  // NODE_TABLE_H
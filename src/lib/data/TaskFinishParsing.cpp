@@ -2,6 +2,7 @@
 
 #include "Blackboard.h"
 #include "DialogView.h"
+#include "IndexingStatistics.h"
 #include "MessageIndexingFinished.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
@@ -30,6 +31,8 @@ void TaskFinishParsing::doEnter(std::shared_ptr<Blackboard> blackboard)
 
 Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboard)
 {
+	IndexingStatistics::getInstance()->finish();
+
 	TimeStamp start = TimeStamp::now();
 
 	m_dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Optimizing database");
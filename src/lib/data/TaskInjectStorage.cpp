@@ -1,7 +1,10 @@
 #include "TaskInjectStorage.h"
 
+#include "IndexingStatistics.h"
 #include "Storage.h"
 #include "StorageProvider.h"
+#include "TimeStamp.h"
+#include "tracing.h"
 
 TaskInjectStorage::TaskInjectStorage(
 	std::shared_ptr<StorageProvider> storageProvider, std::weak_ptr<Storage> target)
@@ -20,7 +23,15 @@ Task::TaskState TaskInjectStorage::doUpdate(std::shared_ptr<Blackboard> blackboa
 		{
 			if (std::shared_ptr<Storage> target = m_target.lock())
 			{
+				TRACE("inject storage");
+				const size_t byteSize = source->getByteSize(sizeof(std::wstring));
+				const TimeStamp start = TimeStamp::now();
 				target->inject(source.get());
+				const float seconds = static_cast<float>(TimeStamp::durationSeconds(start));
+				m_storageProvider->recordInjection(byteSize, seconds);
+				IndexingStatistics::getInstance()->recordInjection(seconds, source->getElementCount());
+				IndexingStatistics::getInstance()->recordStorageQueueDepth(
+					m_storageProvider->getStorageCount(), m_storageProvider->getByteSize());
 				return STATE_SUCCESS;
 			}
 		}
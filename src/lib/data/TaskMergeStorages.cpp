@@ -1,6 +1,9 @@
 #include "TaskMergeStorages.h"
 
+#include "IndexingStatistics.h"
 #include "StorageProvider.h"
+#include "TimeStamp.h"
+#include "tracing.h"
 
 TaskMergeStorages::TaskMergeStorages(std::shared_ptr<StorageProvider> storageProvider)
 	: m_storageProvider(storageProvider)
@@ -17,7 +20,11 @@ Task::TaskState TaskMergeStorages::doUpdate(std::shared_ptr<Blackboard> blackboa
 		std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeSecondLargestStorage();
 		if (target && source)
 		{
+			TRACE("merge storages");
+			const TimeStamp start = TimeStamp::now();
 			target->inject(source.get());
+			IndexingStatistics::getInstance()->recordMerge(
+				static_cast<float>(TimeStamp::durationSeconds(start)));
 			m_storageProvider->insert(target);
 			return STATE_SUCCESS;
 		}
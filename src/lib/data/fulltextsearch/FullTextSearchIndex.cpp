@@ -1,4 +1,5 @@
 #include "FullTextSearchIndex.h"
+#include <algorithm>
 #include <limits>
 
 #include "logging.h"
@@ -24,6 +25,17 @@ void FullTextSearchIndex::addFile(Id fileId, const std::wstring& fileContent)
 	}
 }
 
+void FullTextSearchIndex::removeFile(Id fileId)
+{
+	std::lock_guard<std::mutex> lock(m_filesMutex);
+	m_files.erase(
+		std::remove_if(
+			m_files.begin(),
+			m_files.end(),
+			[fileId](const FullTextSearchFile& file) { return file.fileId == fileId; }),
+		m_files.end());
+}
+
 std::vector<FullTextSearchResult> FullTextSearchIndex::searchForTerm(const std::wstring& term) const
 {
 	TRACE();
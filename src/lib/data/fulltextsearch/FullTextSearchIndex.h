@@ -28,6 +28,7 @@ class FullTextSearchIndex
 {
 public:
 	void addFile(Id fileId, const std::wstring& file);
+	void removeFile(Id fileId);
 	std::vector<FullTextSearchResult> searchForTerm(const std::wstring& term) const;
 
 	size_t fileCount() const;
@@ -18,6 +18,13 @@ public:
 	std::shared_ptr<IntermediateStorage> index(std::shared_ptr<IndexerCommand> indexerCommand) override;
 	void interrupt() override;
 
+protected:
+	std::shared_ptr<IndexerStateInfo> getIndexerStateInfo() const;
+
+	// marks the files with errors as incomplete, returns nullptr if indexing was interrupted
+	std::shared_ptr<IntermediateStorage> finishStorage(
+		std::shared_ptr<IntermediateStorage> storage) const;
+
 private:
 	virtual void doIndex(
 		std::shared_ptr<T> indexerCommand,
@@ -46,6 +53,33 @@ void Indexer<T>::interrupt()
 	m_indexerStateInfo->indexingInterrupted = true;
 }
 
+template <typename T>
+std::shared_ptr<IndexerStateInfo> Indexer<T>::getIndexerStateInfo() const
+{
+	return m_indexerStateInfo;
+}
+
+template <typename T>
+std::shared_ptr<IntermediateStorage> Indexer<T>::finishStorage(
+	std::shared_ptr<IntermediateStorage> storage) const
+{
+	if (storage->hasFatalErrors())
+	{
+		storage->setAllFilesIncomplete();
+	}
+	else
+	{
+		storage->setFilesWithErrorsIncomplete();
+	}
+
+	if (m_indexerStateInfo->indexingInterrupted)
+	{
+		return nullptr;
+	}
+
+	return storage;
+}
+
 template <typename T>
 std::shared_ptr<IntermediateStorage> Indexer<T>::index(std::shared_ptr<IndexerCommand> indexerCommand)
 {
@@ -66,21 +100,7 @@ std::shared_ptr<IntermediateStorage> Indexer<T>::index(std::shared_ptr<IndexerCo
 
 	doIndex(castCommand, parserClient, m_indexerStateInfo);
 
-	if (storage->hasFatalErrors())
-	{
-		storage->setAllFilesIncomplete();
-	}
-	else
-	{
-		storage->setFilesWithErrorsIncomplete();
-	}
-
-	if (m_indexerStateInfo->indexingInterrupted)
-	{
-		return nullptr;
-	}
-
-	return storage;
+	return finishStorage(storage);
 }
 
 #endif	  // INDEXER_H
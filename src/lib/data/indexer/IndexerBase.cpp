@@ -1,3 +1,23 @@
 #include "IndexerBase.h"
 
+#include "IndexerCommand.h"
+#include "IntermediateStorage.h"
+
 IndexerBase::IndexerBase() {}
+
+size_t IndexerBase::getBatchSize(IndexerCommandType type) const
+{
+	return 1;
+}
+
+void IndexerBase::indexBatch(
+	const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+	CommandStartedCallback onStarted,
+	CommandFinishedCallback onFinished)
+{
+	for (const std::shared_ptr<IndexerCommand>& indexerCommand: indexerCommands)
+	{
+		onStarted(indexerCommand);
+		onFinished(indexerCommand, index(indexerCommand));
+	}
+}
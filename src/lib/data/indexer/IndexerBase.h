@@ -1,8 +1,10 @@
 #ifndef INDEXER_BASE_H
 #define INDEXER_BASE_H
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "IndexerCommandType.h"
 
@@ -13,6 +15,11 @@ class IntermediateStorage;
 class IndexerBase
 {
 public:
+	typedef std::function<void(std::shared_ptr<IndexerCommand>)> CommandStartedCallback;
+	typedef std::function<
+		void(std::shared_ptr<IndexerCommand>, std::shared_ptr<IntermediateStorage>)>
+		CommandFinishedCallback;
+
 	IndexerBase();
 	virtual ~IndexerBase() = default;
 
@@ -20,6 +27,17 @@ public:
 	virtual std::shared_ptr<IntermediateStorage> index(
 		std::shared_ptr<IndexerCommand> indexerCommand) = 0;
 	virtual void interrupt() = 0;
+
+	// maximum number of commands of the given type that should be passed to indexBatch at once
+	virtual size_t getBatchSize(IndexerCommandType type) const;
+
+	// Indexes commands of the same type in one run. Each command still results in its own storage,
+	// which is passed to the finished callback as soon as the command's source file is done. The
+	// default implementation indexes one command after the other.
+	virtual void indexBatch(
+		const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+		CommandStartedCallback onStarted,
+		CommandFinishedCallback onFinished);
 };
 
 #endif	  // INDEXER_BASE_H
@@ -30,6 +30,36 @@ std::shared_ptr<IntermediateStorage> IndexerComposite::index(std::shared_ptr<Ind
 	return std::shared_ptr<IntermediateStorage>();
 }
 
+size_t IndexerComposite::getBatchSize(IndexerCommandType type) const
+{
+	auto it = m_indexers.find(type);
+	if (it != m_indexers.end())
+	{
+		return it->second->getBatchSize(type);
+	}
+	return 1;
+}
+
+void IndexerComposite::indexBatch(
+	const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+	CommandStartedCallback onStarted,
+	CommandFinishedCallback onFinished)
+{
+	if (indexerCommands.empty())
+	{
+		return;
+	}
+
+	auto it = m_indexers.find(indexerCommands.front()->getIndexerCommandType());
+	if (it != m_indexers.end())
+	{
+		it->second->indexBatch(indexerCommands, onStarted, onFinished);
+		return;
+	}
+
+	IndexerBase::indexBatch(indexerCommands, onStarted, onFinished);
+}
+
 void IndexerComposite::interrupt()
 {
 	for (auto& it: m_indexers)
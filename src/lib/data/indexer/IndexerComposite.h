@@ -19,6 +19,13 @@ public:
 
 	void interrupt() override;
 
+	size_t getBatchSize(IndexerCommandType type) const override;
+
+	void indexBatch(
+		const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+		CommandStartedCallback onStarted,
+		CommandFinishedCallback onFinished) override;
+
 private:
 	std::map<IndexerCommandType, std::shared_ptr<IndexerBase>> m_indexers;
 };
@@ -0,0 +1,259 @@
+#include "IndexingStatistics.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "logging.h"
+
+std::shared_ptr<IndexingStatistics> IndexingStatistics::s_instance;
+
+const double IndexingStatistics::s_logIntervalSeconds = 10.0;
+
+namespace
+{
+float getPercentile(const std::vector<float>& sortedValues, size_t percent)
+{
+	if (sortedValues.empty())
+	{
+		return 0.0f;
+	}
+	return sortedValues[std::min(sortedValues.size() - 1, sortedValues.size() * percent / 100)];
+}
+}	 // namespace
+
+std::shared_ptr<IndexingStatistics> IndexingStatistics::getInstance()
+{
+	if (!s_instance)
+	{
+		s_instance = std::shared_ptr<IndexingStatistics>(new IndexingStatistics());
+	}
+	return s_instance;
+}
+
+IndexingStatistics::IndexingStatistics(): m_running(false), m_elapsedSeconds(0.0) {}
+
+void IndexingStatistics::setOutputFilePath(const FilePath& outputFilePath)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_outputFilePath = outputFilePath;
+}
+
+FilePath IndexingStatistics::getOutputFilePath() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_outputFilePath;
+}
+
+void IndexingStatistics::start(size_t sourceFileCount)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot = Snapshot();
+	m_snapshot.sourceFileCount = sourceFileCount;
+	m_parseSeconds.clear();
+
+	m_running = true;
+	m_startTime = TimeStamp::now();
+	m_lastLogTime = m_startTime;
+	m_elapsedSeconds = 0.0;
+}
+
+void IndexingStatistics::finish()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_running)
+		{
+			return;
+		}
+		m_elapsedSeconds = TimeStamp::durationSeconds(m_startTime);
+		m_running = false;
+	}
+
+	logCurrentState();
+
+	const FilePath outputFilePath = getOutputFilePath();
+	if (!outputFilePath.empty())
+	{
+		if (writeJson(outputFilePath))
+		{
+			LOG_INFO(L"Wrote indexing statistics to " + outputFilePath.wstr());
+		}
+		else
+		{
+			LOG_ERROR(L"Unable to write indexing statistics to " + outputFilePath.wstr());
+		}
+	}
+}
+
+void IndexingStatistics::recordIndexedFile(float parseSeconds, size_t byteSize)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.indexedFileCount++;
+	m_parseSeconds.push_back(parseSeconds);
+	m_snapshot.parseSecondsTotal += parseSeconds;
+
+	m_snapshot.intermediateStorageBytes += byteSize;
+	m_snapshot.intermediateStorageBytesMax = std::max(
+		m_snapshot.intermediateStorageBytesMax, byteSize);
+}
+
+void IndexingStatistics::recordSharedMemoryGrowth(size_t byteCount)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.sharedMemoryGrowCount++;
+	m_snapshot.sharedMemoryGrowBytes += byteCount;
+}
+
+void IndexingStatistics::recordMerge(float seconds)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.mergeCount++;
+	m_snapshot.mergeSeconds += seconds;
+}
+
+void IndexingStatistics::recordInjection(float seconds, size_t rowCount)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.injectionCount++;
+	m_snapshot.injectionSeconds += seconds;
+	m_snapshot.injectedRowCount += rowCount;
+}
+
+void IndexingStatistics::recordStorageQueueDepth(size_t depth, size_t byteSize)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.storageQueueDepth = depth;
+	m_snapshot.storageQueueDepthMax = std::max(m_snapshot.storageQueueDepthMax, depth);
+	m_snapshot.storageQueueBytes = byteSize;
+	m_snapshot.storageQueueBytesMax = std::max(m_snapshot.storageQueueBytesMax, byteSize);
+}
+
+void IndexingStatistics::recordMemoryBudget(size_t byteSize)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.memoryBudgetBytes = byteSize;
+}
+
+void IndexingStatistics::recordThrottling()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_snapshot.throttleCount++;
+}
+
+void IndexingStatistics::logPeriodically()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_running || TimeStamp::durationSeconds(m_lastLogTime) < s_logIntervalSeconds)
+		{
+			return;
+		}
+		m_lastLogTime = TimeStamp::now();
+	}
+
+	logCurrentState();
+}
+
+void IndexingStatistics::logCurrentState()
+{
+	const Snapshot snapshot = getSnapshot();
+
+	LOG_INFO_STREAM(
+		<< "indexing statistics - files: " << snapshot.indexedFileCount << "/"
+		<< snapshot.sourceFileCount << " files/s: " << snapshot.filesPerSecond
+		<< " parse s (median/90th/max): " << snapshot.parseSecondsMedian << "/"
+		<< snapshot.parseSeconds90th << "/" << snapshot.parseSecondsMax
+		<< " storage bytes: " << snapshot.intermediateStorageBytes
+		<< " shm grows: " << snapshot.sharedMemoryGrowCount << " merges: " << snapshot.mergeCount
+		<< " (" << snapshot.mergeSeconds << " s) injections: " << snapshot.injectionCount << " ("
+		<< snapshot.injectionSeconds << " s, " << snapshot.injectedRowsPerSecond << " rows/s)"
+		<< " queue depth: " << snapshot.storageQueueDepth << " (max "
+		<< snapshot.storageQueueDepthMax << ") queue bytes: " << snapshot.storageQueueBytes << "/"
+		<< snapshot.memoryBudgetBytes << " (max " << snapshot.storageQueueBytesMax
+		<< ") throttled: " << snapshot.throttleCount);
+}
+
+IndexingStatistics::Snapshot IndexingStatistics::getSnapshot() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return getSnapshotUnlocked();
+}
+
+std::string IndexingStatistics::toJson() const
+{
+	const Snapshot snapshot = getSnapshot();
+
+	std::stringstream ss;
+	ss << "{\n";
+	ss << "\t\"source_file_count\": " << snapshot.sourceFileCount << ",\n";
+	ss << "\t\"indexed_file_count\": " << snapshot.indexedFileCount << ",\n";
+	ss << "\t\"elapsed_seconds\": " << snapshot.elapsedSeconds << ",\n";
+	ss << "\t\"files_per_second\": " << snapshot.filesPerSecond << ",\n";
+	ss << "\t\"parse_seconds\": {\"total\": " << snapshot.parseSecondsTotal
+	   << ", \"median\": " << snapshot.parseSecondsMedian
+	   << ", \"90th\": " << snapshot.parseSeconds90th << ", \"max\": " << snapshot.parseSecondsMax
+	   << "},\n";
+	ss << "\t\"intermediate_storage_bytes\": {\"total\": " << snapshot.intermediateStorageBytes
+	   << ", \"max\": " << snapshot.intermediateStorageBytesMax << "},\n";
+	ss << "\t\"shared_memory_growth\": {\"count\": " << snapshot.sharedMemoryGrowCount
+	   << ", \"bytes\": " << snapshot.sharedMemoryGrowBytes << "},\n";
+	ss << "\t\"merge\": {\"count\": " << snapshot.mergeCount
+	   << ", \"seconds\": " << snapshot.mergeSeconds << "},\n";
+	ss << "\t\"injection\": {\"count\": " << snapshot.injectionCount
+	   << ", \"seconds\": " << snapshot.injectionSeconds
+	   << ", \"rows\": " << snapshot.injectedRowCount
+	   << ", \"rows_per_second\": " << snapshot.injectedRowsPerSecond << "},\n";
+	ss << "\t\"storage_queue_depth\": {\"current\": " << snapshot.storageQueueDepth
+	   << ", \"max\": " << snapshot.storageQueueDepthMax << "},\n";
+	ss << "\t\"storage_queue_bytes\": {\"current\": " << snapshot.storageQueueBytes
+	   << ", \"max\": " << snapshot.storageQueueBytesMax
+	   << ", \"budget\": " << snapshot.memoryBudgetBytes << "},\n";
+	ss << "\t\"throttle_count\": " << snapshot.throttleCount << "\n";
+	ss << "}\n";
+	return ss.str();
+}
+
+bool IndexingStatistics::writeJson(const FilePath& filePath) const
+{
+	std::ofstream fileStream(filePath.str(), std::ios::out | std::ios::trunc);
+	if (!fileStream.is_open())
+	{
+		return false;
+	}
+
+	fileStream << toJson();
+	return fileStream.good();
+}
+
+IndexingStatistics::Snapshot IndexingStatistics::getSnapshotUnlocked() const
+{
+	Snapshot snapshot = m_snapshot;
+
+	snapshot.elapsedSeconds = m_running ? TimeStamp::durationSeconds(m_startTime)
+										: m_elapsedSeconds;
+	if (snapshot.elapsedSeconds > 0.0)
+	{
+		snapshot.filesPerSecond = snapshot.indexedFileCount / snapshot.elapsedSeconds;
+	}
+	if (snapshot.injectionSeconds > 0.0f)
+	{
+		snapshot.injectedRowsPerSecond = snapshot.injectedRowCount / snapshot.injectionSeconds;
+	}
+
+	std::vector<float> parseSeconds = m_parseSeconds;
+	std::sort(parseSeconds.begin(), parseSeconds.end());
+	snapshot.parseSecondsMedian = getPercentile(parseSeconds, 50);
+	snapshot.parseSeconds90th = getPercentile(parseSeconds, 90);
+	snapshot.parseSecondsMax = parseSeconds.empty() ? 0.0f : parseSeconds.back();
+
+	return snapshot;
+}
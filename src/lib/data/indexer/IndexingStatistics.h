@@ -0,0 +1,103 @@
+#ifndef INDEXING_STATISTICS_H
+#define INDEXING_STATISTICS_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+#include "TimeStamp.h"
+
+// Collects throughput metrics of the indexing pipeline (indexer -> shared memory -> storage
+// provider -> merge -> inject into the sqlite database). The current state is written to the log
+// periodically while indexing and can be exported as JSON after indexing has finished.
+class IndexingStatistics
+{
+public:
+	struct Snapshot
+	{
+		size_t sourceFileCount = 0;
+		size_t indexedFileCount = 0;
+		double elapsedSeconds = 0.0;
+		double filesPerSecond = 0.0;
+
+		float parseSecondsTotal = 0.0f;
+		float parseSecondsMedian = 0.0f;
+		float parseSeconds90th = 0.0f;
+		float parseSecondsMax = 0.0f;
+
+		size_t intermediateStorageBytes = 0;
+		size_t intermediateStorageBytesMax = 0;
+
+		size_t sharedMemoryGrowCount = 0;
+		size_t sharedMemoryGrowBytes = 0;
+
+		size_t mergeCount = 0;
+		float mergeSeconds = 0.0f;
+
+		size_t injectionCount = 0;
+		float injectionSeconds = 0.0f;
+		size_t injectedRowCount = 0;
+		double injectedRowsPerSecond = 0.0;
+
+		size_t storageQueueDepth = 0;
+		size_t storageQueueDepthMax = 0;
+		size_t storageQueueBytes = 0;
+		size_t storageQueueBytesMax = 0;
+
+		size_t memoryBudgetBytes = 0;
+		size_t throttleCount = 0;
+	};
+
+	static std::shared_ptr<IndexingStatistics> getInstance();
+
+	// statistics are written to this file when indexing finishes, nothing is written if empty
+	void setOutputFilePath(const FilePath& outputFilePath);
+	FilePath getOutputFilePath() const;
+
+	void start(size_t sourceFileCount);
+	void finish();
+
+	void recordIndexedFile(float parseSeconds, size_t byteSize);
+	void recordSharedMemoryGrowth(size_t byteCount);
+	void recordMerge(float seconds);
+	void recordInjection(float seconds, size_t rowCount);
+	void recordStorageQueueDepth(size_t depth, size_t byteSize);
+	void recordMemoryBudget(size_t byteSize);
+
+	// counts how often the indexers had to be throttled to stay within the memory budget
+	void recordThrottling();
+
+	// logs the current state if the last log is older than the log interval
+	void logPeriodically();
+	void logCurrentState();
+
+	Snapshot getSnapshot() const;
+	std::string toJson() const;
+	bool writeJson(const FilePath& filePath) const;
+
+private:
+	static std::shared_ptr<IndexingStatistics> s_instance;
+	static const double s_logIntervalSeconds;
+
+	IndexingStatistics();
+	IndexingStatistics(const IndexingStatistics&) = delete;
+	void operator=(const IndexingStatistics&) = delete;
+
+	Snapshot getSnapshotUnlocked() const;
+
+	FilePath m_outputFilePath;
+
+	bool m_running;
+	TimeStamp m_startTime;
+	TimeStamp m_lastLogTime;
+	double m_elapsedSeconds;
+
+	Snapshot m_snapshot;
+	std::vector<float> m_parseSeconds;
+
+	mutable std::mutex m_mutex;
+};
+
+#endif	  // INDEXING_STATISTICS_H
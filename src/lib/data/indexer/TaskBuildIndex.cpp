@@ -4,6 +4,7 @@
 #include "Blackboard.h"
 #include "DialogView.h"
 #include "FileLogger.h"
+#include "IndexingStatistics.h"
 #include "InterprocessIndexer.h"
 #include "MessageIndexingStatus.h"
 #include "MessageStatus.h"
@@ -11,8 +12,12 @@
 #include "StorageProvider.h"
 #include "TimeStamp.h"
 #include "UserPaths.h"
+#include "tracing.h"
 #include "utilityApp.h"
 
+const size_t TaskBuildIndex::s_maximumQueuedStorageCount = 16;
+const double TaskBuildIndex::s_storageByteSizeSmoothing = 0.2;
+
 TaskBuildIndex::TaskBuildIndex(
 	size_t processCount,
 	std::shared_ptr<StorageProvider> storageProvider,
@@ -28,6 +33,9 @@ TaskBuildIndex::TaskBuildIndex(
 	, m_processCount(processCount)
 	, m_interrupted(false)
 	, m_indexingFileCount(0)
+	, m_averageStorageByteSize(0.0)
+	, m_queuedStorageCount(0)
+	, m_throttled(false)
 	, m_runningThreadCount(0)
 {
 }
@@ -39,6 +47,10 @@ void TaskBuildIndex::doEnter(std::shared_ptr<Blackboard> blackboard)
 	m_indexingFileCount = 0;
 	updateIndexingDialog(blackboard, std::vector<FilePath>());
 
+	const size_t memoryBudget = m_storageProvider->getMemoryBudget();
+	IndexingStatistics::getInstance()->recordMemoryBudget(memoryBudget);
+	LOG_INFO_STREAM(<< "memory budget for queued intermediate storages: " << memoryBudget << " bytes");
+
 	std::wstring logFilePath;
 	Logger* logger = LogManager::getInstance()->getLoggerByType("FileLogger");
 	if (logger)
@@ -103,12 +115,22 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 		return STATE_SUCCESS;
 	}
 
-	if (fetchIntermediateStorages(blackboard))
+	updateStorageLimits();
+
+	const bool fetchedStorages = fetchIntermediateStorages(blackboard);
+	if (fetchedStorages)
 	{
 		updateIndexingDialog(blackboard, std::vector<FilePath>());
 	}
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	IndexingStatistics::getInstance()->logPeriodically();
+
+	if (!fetchedStorages)
+	{
+		// indexers notify when they start or finish a file, the timeout only catches changes
+		// without notification, like the command queue being stopped
+		m_interprocessIndexingStatusManager.waitForStatusChange(200);
+	}
 
 	return STATE_RUNNING;
 }
@@ -128,37 +150,53 @@ void TaskBuildIndex::doExit(std::shared_ptr<Blackboard> blackboard)
 			;
 	}
 
-	std::vector<FilePath> crashedFiles =
-		m_interprocessIndexingStatusManager.getCrashedSourceFilePaths();
-	if (!crashedFiles.empty())
-	{
-		std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
-		std::shared_ptr<ParserClientImpl> parserClient = std::make_shared<ParserClientImpl>(
-			storage.get());
+	recordFileErrors(
+		m_interprocessIndexingStatusManager.getCrashedSourceFilePaths(),
+		L"The translation unit threw an exception during indexing. Please check if the source file "
+		L"conforms to the specified language standard and all necessary options are defined "
+		L"within your project setup.",
+		L"crashed translation unit: ");
 
-		for (const FilePath& path: crashedFiles)
-		{
-			Id fileId = parserClient->recordFile(path.getCanonical(), false);
-			parserClient->recordError(
-				L"The translation unit threw an exception during indexing. Please check if the "
-				L"source file "
-				"conforms to the specified language standard and all necessary options are defined "
-				"within your project "
-				"setup.",
-				true,
-				true,
-				path,
-				ParseLocation(fileId, 1, 1));
-			LOG_INFO(L"crashed translation unit: " + path.wstr());
-		}
-		m_storageProvider->insert(storage);
+	std::vector<FilePath> skippedFiles;
+	if (blackboard->exists("skipped_source_files"))
+	{
+		blackboard->get<std::vector<FilePath>>("skipped_source_files", skippedFiles);
 	}
+	recordFileErrors(
+		skippedFiles,
+		L"The indexer command of the translation unit could not be passed to the indexer "
+		L"processes, because it is too large. Please check the size of its compiler flags in your "
+		L"project setup.",
+		L"skipped translation unit: ");
 
 	blackboard->set<bool>("indexer_threads_stopped", true);
 }
 
 void TaskBuildIndex::doReset(std::shared_ptr<Blackboard> blackboard) {}
 
+void TaskBuildIndex::recordFileErrors(
+	const std::vector<FilePath>& filePaths,
+	const std::wstring& errorMessage,
+	const std::wstring& logMessage)
+{
+	if (filePaths.empty())
+	{
+		return;
+	}
+
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	std::shared_ptr<ParserClientImpl> parserClient = std::make_shared<ParserClientImpl>(
+		storage.get());
+
+	for (const FilePath& path: filePaths)
+	{
+		Id fileId = parserClient->recordFile(path.getCanonical(), false);
+		parserClient->recordError(errorMessage, true, true, path, ParseLocation(fileId, 1, 1));
+		LOG_INFO(logMessage + path.wstr());
+	}
+	m_storageProvider->insert(storage);
+}
+
 void TaskBuildIndex::terminate()
 {
 	m_interrupted = true;
@@ -212,6 +250,7 @@ void TaskBuildIndex::runIndexerProcess(int processId, const std::wstring& logFil
 		std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
 		m_runningThreadCount--;
 	}
+	m_interprocessIndexingStatusManager.notifyStatusChange();
 }
 
 void TaskBuildIndex::runIndexerThread(int processId)
@@ -232,17 +271,19 @@ void TaskBuildIndex::runIndexerThread(int processId)
 		std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
 		m_runningThreadCount--;
 	}
+	m_interprocessIndexingStatusManager.notifyStatusChange();
 }
 
 bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard)
 {
+	TRACE("fetch intermediate storages");
+
 	int poppedStorageCount = 0;
 
-	int providerStorageCount = m_storageProvider->getStorageCount();
-	if (providerStorageCount > 10)
+	if (m_storageProvider->isAboveTargetByteSize())
 	{
-		LOG_INFO_STREAM(<< "waiting, too many storages queued: " << providerStorageCount);
-
+		// the storages stay in the indexers' queues, which makes the indexers wait once their queues
+		// are full
 		std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
 		return true;
@@ -268,13 +309,34 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 		}
 
 		LOG_INFO_STREAM(<< storageManager->getProcessId() << " - storage count: " << storageCount);
-		m_storageProvider->insert(storageManager->popIntermediateStorage());
+		std::shared_ptr<IntermediateStorage> storage = storageManager->popIntermediateStorage();
+		if (storage)
+		{
+			const size_t byteSize = storage->getByteSize(sizeof(std::wstring));
+			IndexingStatistics::getInstance()->recordIndexedFile(
+				storage->getIndexingDuration(), byteSize);
+
+			if (m_averageStorageByteSize <= 0.0)
+			{
+				m_averageStorageByteSize = static_cast<double>(byteSize);
+			}
+			else
+			{
+				m_averageStorageByteSize += s_storageByteSizeSmoothing *
+					(byteSize - m_averageStorageByteSize);
+			}
+
+			m_storageProvider->insert(storage, byteSize);
+		}
 		poppedStorageCount++;
-	} while (TimeStamp::now().deltaMS(t) <
-			 500);	  // don't process all storages at once to allow for status updates in-between
+
+		// don't process all storages at once to allow for status updates in-between
+	} while (TimeStamp::now().deltaMS(t) < 500 && !m_storageProvider->isAboveTargetByteSize());
 
 	if (poppedStorageCount > 0)
 	{
+		IndexingStatistics::getInstance()->recordStorageQueueDepth(
+			m_storageProvider->getStorageCount(), m_storageProvider->getByteSize());
 		blackboard->update<int>(
 			"indexed_source_file_count", [=](int count) { return count + poppedStorageCount; });
 		return true;
@@ -283,6 +345,52 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
 	return false;
 }
 
+void TaskBuildIndex::updateStorageLimits()
+{
+	const size_t byteSize = m_storageProvider->getByteSize();
+	const size_t targetByteSize = m_storageProvider->getTargetByteSize();
+
+	const bool throttled = byteSize > targetByteSize;
+	if (throttled != m_throttled)
+	{
+		m_throttled = throttled;
+		if (throttled)
+		{
+			IndexingStatistics::getInstance()->recordThrottling();
+		}
+
+		LOG_INFO_STREAM(
+			<< (throttled ? "throttling indexers" : "stopped throttling indexers")
+			<< ", queued storages: " << byteSize << "/" << targetByteSize
+			<< " bytes (budget: " << m_storageProvider->getMemoryBudget()
+			<< " bytes, injection: " << m_storageProvider->getInjectionBytesPerSecond()
+			<< " bytes/s)");
+	}
+
+	if (m_averageStorageByteSize <= 0.0)
+	{
+		// keep the indexers' default until the size of their storages is known
+		return;
+	}
+
+	// share the unused part of the target among the indexers' queues
+	size_t queuedStorageCount = 1;
+	if (!throttled)
+	{
+		queuedStorageCount = static_cast<size_t>(
+			(targetByteSize - byteSize) / m_averageStorageByteSize / m_processCount);
+		queuedStorageCount = std::max<size_t>(
+			1, std::min(queuedStorageCount, s_maximumQueuedStorageCount));
+	}
+
+	if (queuedStorageCount != m_queuedStorageCount)
+	{
+		LOG_INFO_STREAM(<< "maximum queued storages per indexer: " << queuedStorageCount);
+		m_queuedStorageCount = queuedStorageCount;
+		m_interprocessIndexingStatusManager.setMaximumQueuedStorageCount(queuedStorageCount);
+	}
+}
+
 void TaskBuildIndex::updateIndexingDialog(
 	std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths)
 {
@@ -296,6 +404,8 @@ void TaskBuildIndex::updateIndexingDialog(
 
 	m_dialogView->updateIndexingDialog(
 		m_indexingFileCount, indexedSourceFileCount, sourceFileCount, sourcePaths);
+	m_dialogView->updateIndexingMemoryUsage(
+		m_storageProvider->getByteSize(), m_storageProvider->getMemoryBudget(), m_throttled);
 
 	int progress = 0;
 	if (sourceFileCount)
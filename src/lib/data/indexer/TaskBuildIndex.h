@@ -39,10 +39,19 @@ protected:
 	void runIndexerProcess(int processId, const std::wstring& logFilePath);
 	void runIndexerThread(int processId);
 	bool fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard);
+	void updateStorageLimits();
 	void updateIndexingDialog(
 		std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths);
 
+	// records a fatal error for each file, so it shows up in the error view
+	void recordFileErrors(
+		const std::vector<FilePath>& filePaths,
+		const std::wstring& errorMessage,
+		const std::wstring& logMessage);
+
 	static const std::wstring s_processName;
+	static const size_t s_maximumQueuedStorageCount;
+	static const double s_storageByteSizeSmoothing;
 
 	std::shared_ptr<IndexerCommandList> m_indexerCommandList;
 	std::shared_ptr<StorageProvider> m_storageProvider;
@@ -56,6 +65,10 @@ protected:
 	bool m_interrupted;
 	size_t m_indexingFileCount;
 
+	double m_averageStorageByteSize;
+	size_t m_queuedStorageCount;
+	bool m_throttled;
+
 	// store as plain pointers to avoid deallocation issues when closing app during indexing
 	std::vector<std::thread*> m_processThreads;
 	std::vector<std::shared_ptr<InterprocessIntermediateStorageManager>>
@@ -2,6 +2,7 @@
 
 #include "Blackboard.h"
 #include "FileSystem.h"
+#include "IndexerCommand.h"
 #include "IndexerCommandProvider.h"
 #include "logging.h"
 #include "utilityFile.h"
@@ -43,7 +44,7 @@ Task::TaskState TaskFillIndexerCommandsQueue::doUpdate(std::shared_ptr<Blackboar
 	{
 		std::lock_guard<std::mutex> lock(m_commandsMutex);
 
-		if (m_indexerCommandProvider->empty())
+		if (m_indexerCommandProvider->empty() && m_unpushedCommands.empty())
 		{
 			return STATE_SUCCESS;
 		}
@@ -56,6 +57,11 @@ Task::TaskState TaskFillIndexerCommandsQueue::doUpdate(std::shared_ptr<Blackboar
 
 void TaskFillIndexerCommandsQueue::doExit(std::shared_ptr<Blackboard> blackboard)
 {
+	{
+		std::lock_guard<std::mutex> lock(m_commandsMutex);
+		blackboard->set<std::vector<FilePath>>("skipped_source_files", m_skippedFilePaths);
+	}
+	m_indexerCommandManager.setIndexerCommandQueueStopped();
 	blackboard->set<bool>("indexer_command_queue_stopped", true);
 }
 
@@ -76,11 +82,13 @@ void TaskFillIndexerCommandsQueue::handleMessage(MessageIndexingInterrupted* mes
 	LOG_INFO(
 		"Discarding remaining " +
 		std::to_string(
-			m_indexerCommandProvider->size() + m_indexerCommandManager.indexerCommandCount()) +
+			m_indexerCommandProvider->size() + m_unpushedCommands.size() +
+			m_indexerCommandManager.indexerCommandCount()) +
 		" indexer commands.");
 
 	std::queue<FilePath> empty;
 	std::swap(m_filePathQueue, empty);
+	m_unpushedCommands.clear();
 
 	m_indexerCommandProvider->clear();
 	m_indexerCommandManager.clearIndexerCommands();
@@ -102,6 +110,7 @@ bool TaskFillIndexerCommandsQueue::fillCommandQueue()
 
 	std::lock_guard<std::mutex> lock(m_commandsMutex);
 	std::vector<std::shared_ptr<IndexerCommand>> commands;
+	std::swap(commands, m_unpushedCommands);
 
 	while (!m_indexerCommandProvider->empty() && commands.size() < refillAmount)
 	{
@@ -119,8 +128,18 @@ bool TaskFillIndexerCommandsQueue::fillCommandQueue()
 
 	if (commands.size())
 	{
-		m_indexerCommandManager.pushIndexerCommands(commands);
-		return true;
+		// the ring may run out of space for strings until the indexers have caught up
+		std::vector<std::shared_ptr<IndexerCommand>> skippedCommands;
+		const size_t pushedCount = m_indexerCommandManager.pushIndexerCommands(
+			commands, &skippedCommands);
+		m_unpushedCommands.assign(commands.begin() + pushedCount, commands.end());
+
+		// these files are reported as errors once indexing finishes
+		for (const std::shared_ptr<IndexerCommand>& command: skippedCommands)
+		{
+			m_skippedFilePaths.push_back(command->getSourceFilePath());
+		}
+		return pushedCount > 0;
 	}
 
 	return false;
@@ -3,6 +3,7 @@
 
 #include <queue>
 
+#include "FilePath.h"
 #include "MessageIndexingInterrupted.h"
 #include "MessageListener.h"
 #include "Task.h"
@@ -39,6 +40,8 @@ private:
 	const size_t m_maximumQueueSize;
 
 	std::queue<FilePath> m_filePathQueue;
+	std::vector<std::shared_ptr<IndexerCommand>> m_unpushedCommands;
+	std::vector<FilePath> m_skippedFilePaths;
 	std::mutex m_commandsMutex;
 
 	bool m_interrupted = false;
@@ -3,9 +3,12 @@
 #include "FileRegister.h"
 #include "IndexerCommand.h"
 #include "IndexerComposite.h"
+#include "IntermediateStorage.h"
 #include "LanguagePackageManager.h"
 #include "ScopedFunctor.h"
+#include "TimeStamp.h"
 #include "logging.h"
+#include "tracing.h"
 
 InterprocessIndexer::InterprocessIndexer(const std::string& uuid, Id processId)
 	: m_interprocessIndexerCommandManager(uuid, processId, false)
@@ -27,12 +30,19 @@ void InterprocessIndexer::work()
 		LOG_INFO_STREAM(<< m_processId << " starting up indexer");
 		indexer = LanguagePackageManager::getInstance()->instantiateSupportedIndexers();
 
+		for (const std::shared_ptr<IndexerCommand>& command:
+			 m_interprocessIndexingStatusManager.takeUnstartedIndexerCommands())
+		{
+			LOG_INFO_STREAM(
+				<< m_processId << " takes over unstarted indexer command for \""
+				<< command->getSourceFilePath().str() << "\"");
+			m_unstartedIndexerCommands.push(command);
+		}
+
 		updaterThread = std::make_shared<std::thread>([&]() {
 			while (updaterThreadRunning)
 			{
-				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-				if (m_interprocessIndexingStatusManager.getIndexingInterrupted())
+				if (m_interprocessIndexingStatusManager.waitForIndexingInterrupted(1000))
 				{
 					LOG_INFO_STREAM(<< m_processId << " received indexer interrupt command.");
 					if (indexer)
@@ -53,52 +63,95 @@ void InterprocessIndexer::work()
 			}
 		});
 
-		while (std::shared_ptr<IndexerCommand> indexerCommand =
-				   m_interprocessIndexerCommandManager.popIndexerCommand())
+		std::shared_ptr<IndexerCommand> indexerCommand = waitForIndexerCommand(
+			updaterThreadRunning);
+		while (indexerCommand)
 		{
-			LOG_INFO_STREAM(
-				<< m_processId << " fetched indexer command for \""
-				<< indexerCommand->getSourceFilePath().str() << "\"");
-			LOG_INFO_STREAM(
-				<< m_processId << " indexer commands left: "
-				<< m_interprocessIndexerCommandManager.indexerCommandCount());
+			// commands of the same type are indexed together if the indexer benefits from it
+			std::vector<std::shared_ptr<IndexerCommand>> indexerCommands = {indexerCommand};
+			indexerCommand.reset();
 
-			while (updaterThreadRunning)
+			const size_t batchSize = indexer->getBatchSize(
+				indexerCommands.front()->getIndexerCommandType());
+			while (indexerCommands.size() < batchSize)
 			{
-				const size_t storageCount =
-					m_interprocessIntermediateStorageManager.getIntermediateStorageCount();
-				if (storageCount < 2)
+				indexerCommand = popIndexerCommand();
+				if (!indexerCommand ||
+					indexerCommand->getIndexerCommandType() !=
+						indexerCommands.front()->getIndexerCommandType())
 				{
 					break;
 				}
-
-				LOG_INFO_STREAM(<< m_processId << " waits, too many intermediate storages: " << storageCount);
-
-				std::this_thread::sleep_for(std::chrono::milliseconds(200));
+				indexerCommands.push_back(indexerCommand);
+				indexerCommand.reset();
 			}
 
-			if (!updaterThreadRunning)
+			for (const std::shared_ptr<IndexerCommand>& command: indexerCommands)
 			{
-				break;
+				LOG_INFO_STREAM(
+					<< m_processId << " fetched indexer command for \""
+					<< command->getSourceFilePath().str() << "\"");
 			}
+			LOG_INFO_STREAM(
+				<< m_processId << " indexer commands left: "
+				<< m_interprocessIndexerCommandManager.indexerCommandCount());
+
+			m_interprocessIndexingStatusManager.startIndexingBatch(indexerCommands);
+
+			TimeStamp indexingStart;
 
-			LOG_INFO_STREAM(<< m_processId << " updating indexer status with currently indexed filepath");
-			m_interprocessIndexingStatusManager.startIndexingSourceFile(
-				indexerCommand->getSourceFilePath());
+			IndexerBase::CommandStartedCallback onStarted =
+				[&](std::shared_ptr<IndexerCommand> command) {
+					LOG_INFO_STREAM(
+						<< m_processId
+						<< " updating indexer status with currently indexed filepath");
+					m_interprocessIndexingStatusManager.startIndexingSourceFile(
+						command->getSourceFilePath());
 
-			LOG_INFO_STREAM(<< m_processId << " starting to index current file");
-			std::shared_ptr<IntermediateStorage> result = indexer->index(indexerCommand);
+					LOG_INFO_STREAM(<< m_processId << " starting to index current file");
+					// the log names the file being indexed if this process crashes
+					LogManager::getInstance()->flush();
+					indexingStart = TimeStamp::now();
+				};
+
+			IndexerBase::CommandFinishedCallback onFinished =
+				[&](std::shared_ptr<IndexerCommand> command,
+					std::shared_ptr<IntermediateStorage> result) {
+					if (result)
+					{
+						result->setIndexingDuration(
+							static_cast<float>(TimeStamp::durationSeconds(indexingStart)));
+
+						TRACE("push intermediate storage");
+						LOG_INFO_STREAM(<< m_processId << " pushing index to shared memory");
+						m_interprocessIntermediateStorageManager.pushIntermediateStorage(result);
+					}
+
+					LOG_INFO_STREAM(
+						<< m_processId << " finalizing indexer status for current file");
+					m_interprocessIndexingStatusManager.finishIndexingSourceFile();
+
+					// waits after each file of the batch, so the queue never exceeds the maximum
+					waitForQueuedStorages(updaterThreadRunning);
+				};
 
-			if (result)
 			{
-				LOG_INFO_STREAM(<< m_processId << " pushing index to shared memory");
-				m_interprocessIntermediateStorageManager.pushIntermediateStorage(result);
+				TRACE("index translation unit");
+				indexer->indexBatch(indexerCommands, onStarted, onFinished);
 			}
 
-			LOG_INFO_STREAM(<< m_processId << " finalizing indexer status for current file");
-			m_interprocessIndexingStatusManager.finishIndexingSourceFile();
+			if (!updaterThreadRunning)
+			{
+				m_interprocessIndexingStatusManager.clearIndexingBatch();
+				break;
+			}
 
 			LOG_INFO_STREAM(<< m_processId << " all done");
+
+			if (!indexerCommand)
+			{
+				indexerCommand = waitForIndexerCommand(updaterThreadRunning);
+			}
 		}
 	}
 	catch (boost::interprocess::interprocess_exception& e)
@@ -118,3 +171,66 @@ void InterprocessIndexer::work()
 
 	LOG_INFO_STREAM(<< m_processId << " shutting down indexer");
 }
+
+std::shared_ptr<IndexerCommand> InterprocessIndexer::popIndexerCommand()
+{
+	if (!m_unstartedIndexerCommands.empty())
+	{
+		std::shared_ptr<IndexerCommand> indexerCommand = m_unstartedIndexerCommands.front();
+		m_unstartedIndexerCommands.pop();
+		return indexerCommand;
+	}
+
+	std::vector<FilePath> failedSourceFilePaths;
+	std::shared_ptr<IndexerCommand> indexerCommand =
+		m_interprocessIndexerCommandManager.popIndexerCommand(&failedSourceFilePaths);
+
+	for (const FilePath& sourceFilePath: failedSourceFilePaths)
+	{
+		LOG_ERROR_STREAM(
+			<< m_processId << " failed to receive indexer command for \"" << sourceFilePath.str()
+			<< "\"");
+		m_interprocessIndexingStatusManager.addCrashedSourceFile(sourceFilePath);
+	}
+
+	return indexerCommand;
+}
+
+std::shared_ptr<IndexerCommand> InterprocessIndexer::waitForIndexerCommand(const bool& running)
+{
+	while (running)
+	{
+		// checked before popping, so a command pushed right before stopping the queue is not missed
+		const bool stopped = m_interprocessIndexerCommandManager.isIndexerCommandQueueStopped();
+
+		std::shared_ptr<IndexerCommand> indexerCommand = popIndexerCommand();
+		if (indexerCommand || stopped)
+		{
+			return indexerCommand;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+	return nullptr;
+}
+
+void InterprocessIndexer::waitForQueuedStorages(const bool& running)
+{
+	while (running)
+	{
+		const size_t storageCount =
+			m_interprocessIntermediateStorageManager.getIntermediateStorageCount();
+		const size_t maximumStorageCount =
+			m_interprocessIndexingStatusManager.getMaximumQueuedStorageCount();
+		if (storageCount < maximumStorageCount)
+		{
+			break;
+		}
+
+		LOG_INFO_STREAM(
+			<< m_processId << " waits, too many intermediate storages: " << storageCount << "/"
+			<< maximumStorageCount);
+
+		m_interprocessIntermediateStorageManager.waitForIntermediateStoragePopped(200);
+	}
+}
@@ -1,6 +1,8 @@
 #ifndef INTERPROCESS_INDEXER_H
 #define INTERPROCESS_INDEXER_H
 
+#include <queue>
+
 #include "InterprocessIndexerCommandManager.h"
 #include "InterprocessIndexingStatusManager.h"
 #include "InterprocessIntermediateStorageManager.h"
@@ -13,10 +15,22 @@ public:
 	void work();
 
 private:
+	// returns the unstarted commands of a previous process with the same id first, reports the files
+	// of commands that can't be received as crashed and keeps popping
+	std::shared_ptr<IndexerCommand> popIndexerCommand();
+
+	// blocks while the command queue is empty but not stopped yet, returns nullptr once it is stopped
+	std::shared_ptr<IndexerCommand> waitForIndexerCommand(const bool& running);
+
+	// blocks while this process has the maximum number of intermediate storages queued
+	void waitForQueuedStorages(const bool& running);
+
 	InterprocessIndexerCommandManager m_interprocessIndexerCommandManager;
 	InterprocessIndexingStatusManager m_interprocessIndexingStatusManager;
 	InterprocessIntermediateStorageManager m_interprocessIntermediateStorageManager;
 
+	std::queue<std::shared_ptr<IndexerCommand>> m_unstartedIndexerCommands;
+
 	const std::string m_uuid;
 	const Id m_processId;
 };
@@ -1,110 +1,106 @@
 #include "InterprocessIndexerCommandManager.h"
 
 #include "IndexerCommand.h"
+#include "SharedIndexerCommand.h"
 #include "logging.h"
 
 const char* InterprocessIndexerCommandManager::s_sharedMemoryNamePrefix = "icmd_";
 
-const char* InterprocessIndexerCommandManager::s_indexerCommandsKeyName = "indexer_commands";
+const size_t InterprocessIndexerCommandManager::s_ringCapacity = 64;
+const size_t InterprocessIndexerCommandManager::s_stringPoolSize = 8388608 /* 8 MB */;
+
+const char* InterprocessIndexerCommandManager::s_compilerFlagSetsNamePrefix = "iflg_";
+const size_t InterprocessIndexerCommandManager::s_compilerFlagSetCapacity = 16384;
+const size_t InterprocessIndexerCommandManager::s_compilerFlagSetDataSize = 33554432 /* 32 MB */;
 
 InterprocessIndexerCommandManager::InterprocessIndexerCommandManager(
 	const std::string& instanceUuid, Id processId, bool isOwner)
-	: BaseInterprocessDataManager(
-		  s_sharedMemoryNamePrefix + instanceUuid, 1048576 /* 1 MB */, instanceUuid, processId, isOwner)
+	: m_ring(s_sharedMemoryNamePrefix + instanceUuid, s_ringCapacity, s_stringPoolSize, isOwner)
+	, m_compilerFlagSets(
+		  s_compilerFlagSetsNamePrefix + instanceUuid,
+		  s_compilerFlagSetCapacity,
+		  s_compilerFlagSetDataSize,
+		  isOwner)
+	, m_processId(processId)
 {
 }
 
 InterprocessIndexerCommandManager::~InterprocessIndexerCommandManager() {}
 
-void InterprocessIndexerCommandManager::pushIndexerCommands(
-	const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands)
+Id InterprocessIndexerCommandManager::getProcessId() const
 {
-	size_t size = 0;
-	{
-		const size_t overestimationMultiplier = 2;
-		for (auto& command: indexerCommands)
-		{
-			size += command->getByteSize(sizeof(SharedMemory::String)) + sizeof(SharedIndexerCommand);
-		}
-		size *= overestimationMultiplier;
-	}
-
-	SharedMemory::ScopedAccess access(&m_sharedMemory);
-	while (access.getFreeMemorySize() < size)
-	{
-		size_t currentSize = access.getMemorySize();
-		LOG_INFO_STREAM(
-			<< "grow memory - est: " << size << " size: " << currentSize
-			<< " free: " << access.getFreeMemorySize() << " alloc: " << (currentSize));
-
-		access.growMemory(currentSize);
+	return m_processId;
+}
 
-		LOG_INFO("growing memory succeeded");
-	}
+size_t InterprocessIndexerCommandManager::pushIndexerCommands(
+	const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+	std::vector<std::shared_ptr<IndexerCommand>>* skippedCommands)
+{
+	size_t pushedCount = 0;
+	SharedMemoryRing::Record record;
 
-	SharedMemory::Queue<SharedIndexerCommand>* queue =
-		access.accessValueWithAllocator<SharedMemory::Queue<SharedIndexerCommand>>(
-			s_indexerCommandsKeyName);
-	if (!queue)
+	for (const std::shared_ptr<IndexerCommand>& command: indexerCommands)
 	{
-		return;
-	}
+		if (!SharedIndexerCommand::toRecord(command.get(), record, &m_compilerFlagSets) ||
+			SharedMemoryRing::getRequiredPoolSize(record) > m_ring.getRecordPoolSize())
+		{
+			LOG_ERROR(
+				L"Unable to pass indexer command for file " + command->getSourceFilePath().wstr() +
+				L" to the indexer processes. It will be skipped.");
+			skippedCommands->push_back(command);
+			pushedCount++;
+			continue;
+		}
 
-	for (auto& command: indexerCommands)
-	{
-		queue->push_back(SharedIndexerCommand(access.getAllocator()));
-		SharedIndexerCommand& sharedCommand = queue->back();
-		sharedCommand.fromLocal(command.get());
+		if (!m_ring.tryPush(record))
+		{
+			break;
+		}
+		pushedCount++;
 	}
 
-	LOG_INFO(access.logString());
+	return pushedCount;
 }
 
-std::shared_ptr<IndexerCommand> InterprocessIndexerCommandManager::popIndexerCommand()
+std::shared_ptr<IndexerCommand> InterprocessIndexerCommandManager::popIndexerCommand(
+	std::vector<FilePath>* failedSourceFilePaths)
 {
-	SharedMemory::ScopedAccess access(&m_sharedMemory);
-
-	SharedMemory::Queue<SharedIndexerCommand>* queue =
-		access.accessValueWithAllocator<SharedMemory::Queue<SharedIndexerCommand>>(
-			s_indexerCommandsKeyName);
-	if (!queue || !queue->size())
+	SharedMemoryRing::Record record;
+	while (m_ring.tryPop(record))
 	{
-		return nullptr;
-	}
-
-	std::shared_ptr<IndexerCommand> command = SharedIndexerCommand::fromShared(queue->front());
+		std::shared_ptr<IndexerCommand> command = SharedIndexerCommand::fromRecord(
+			record, &m_compilerFlagSets);
+		if (command)
+		{
+			return command;
+		}
 
-	queue->pop_front();
+		const FilePath sourceFilePath = SharedIndexerCommand::getSourceFilePath(record);
+		if (!sourceFilePath.empty())
+		{
+			failedSourceFilePaths->push_back(sourceFilePath);
+		}
+	}
 
-	return command;
+	return nullptr;
 }
 
 void InterprocessIndexerCommandManager::clearIndexerCommands()
 {
-	SharedMemory::ScopedAccess access(&m_sharedMemory);
-
-	SharedMemory::Queue<SharedIndexerCommand>* queue =
-		access.accessValueWithAllocator<SharedMemory::Queue<SharedIndexerCommand>>(
-			s_indexerCommandsKeyName);
-	if (!queue)
-	{
-		return;
-	}
-
-	queue->clear();
+	m_ring.clear();
 }
 
 size_t InterprocessIndexerCommandManager::indexerCommandCount()
 {
-	SharedMemory::ScopedAccess access(&m_sharedMemory);
+	return m_ring.size();
+}
 
-	SharedMemory::Queue<SharedIndexerCommand>* queue =
-		access.accessValueWithAllocator<SharedMemory::Queue<SharedIndexerCommand>>(
-			s_indexerCommandsKeyName);
-	if (!queue)
-	{
-		return 0;
-	}
+void InterprocessIndexerCommandManager::setIndexerCommandQueueStopped()
+{
+	m_ring.close();
+}
 
-	return queue->size();
+bool InterprocessIndexerCommandManager::isIndexerCommandQueueStopped() const
+{
+	return m_ring.isClosed();
 }
@@ -1,26 +1,57 @@
 #ifndef INTERPROCESS_INDEXER_COMMAND_MANAGER_H
 #define INTERPROCESS_INDEXER_COMMAND_MANAGER_H
 
-#include "BaseInterprocessDataManager.h"
-#include "SharedIndexerCommand.h"
+#include <memory>
+#include <vector>
+
+#include "FilePath.h"
+#include "SharedCompilerFlagSets.h"
+#include "SharedMemoryRing.h"
+#include "types.h"
 
 class IndexerCommand;
 
-class InterprocessIndexerCommandManager: public BaseInterprocessDataManager
+// Hands out indexer commands to the indexer processes. Commands are passed through a lock-free
+// ring in shared memory, so popping a command does not contend with other indexer processes for
+// a shared mutex. Compiler flag sets shared by many commands are stored once in a separate table
+// and the commands only reference them, so the amount of data copied into shared memory scales with
+// the number of distinct flag sets instead of the number of files.
+class InterprocessIndexerCommandManager
 {
 public:
 	InterprocessIndexerCommandManager(const std::string& instanceUuid, Id processId, bool isOwner);
 	virtual ~InterprocessIndexerCommandManager();
 
-	void pushIndexerCommands(const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands);
-	std::shared_ptr<IndexerCommand> popIndexerCommand();
+	Id getProcessId() const;
+
+	// returns the number of handled commands, the remaining commands have to be pushed again later.
+	// Commands that can't be passed to the indexer processes at all are handled by appending them to
+	// skippedCommands.
+	size_t pushIndexerCommands(
+		const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+		std::vector<std::shared_ptr<IndexerCommand>>* skippedCommands);
+	// returns nullptr if the queue is empty. Commands that can't be received are popped anyway and
+	// their source files are appended to failedSourceFilePaths.
+	std::shared_ptr<IndexerCommand> popIndexerCommand(std::vector<FilePath>* failedSourceFilePaths);
 
 	void clearIndexerCommands();
 	size_t indexerCommandCount();
 
+	// an empty queue only means that indexing is done once the queue was stopped
+	void setIndexerCommandQueueStopped();
+	bool isIndexerCommandQueueStopped() const;
+
 private:
 	static const char* s_sharedMemoryNamePrefix;
-	static const char* s_indexerCommandsKeyName;
+	static const size_t s_ringCapacity;
+	static const size_t s_stringPoolSize;
+	static const char* s_compilerFlagSetsNamePrefix;
+	static const size_t s_compilerFlagSetCapacity;
+	static const size_t s_compilerFlagSetDataSize;
+
+	SharedMemoryRing m_ring;
+	SharedCompilerFlagSets m_compilerFlagSets;
+	const Id m_processId;
 };
 
 #endif	  // INTERPROCESS_INDEXER_COMMAND_MANAGER_H
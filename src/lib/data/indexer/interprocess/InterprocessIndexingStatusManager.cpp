@@ -1,30 +1,132 @@
 #include "InterprocessIndexingStatusManager.h"
 
+#include "IndexerCommand.h"
+#include "SharedIndexerCommand.h"
 #include "logging.h"
 #include "utilityString.h"
 
 const char* InterprocessIndexingStatusManager::s_sharedMemoryNamePrefix = "ists_";
+const char* InterprocessIndexingStatusManager::s_statusChangedEventNamePrefix = "istc_";
+const char* InterprocessIndexingStatusManager::s_interruptedEventNamePrefix = "isti_";
 
 const char* InterprocessIndexingStatusManager::s_indexingFilesKeyName = "indexing_files";
+const char* InterprocessIndexingStatusManager::s_batchFilesKeyName = "batch_files";
+const char* InterprocessIndexingStatusManager::s_batchCommandsKeyName = "batch_commands";
 const char* InterprocessIndexingStatusManager::s_currentFilesKeyName = "current_files";
 const char* InterprocessIndexingStatusManager::s_crashedFilesKeyName = "crashed_files";
 const char* InterprocessIndexingStatusManager::s_finishedProcessIdsKeyName = "finished_process_ids";
 const char* InterprocessIndexingStatusManager::s_indexingInterruptedKeyName =
 	"indexing_interrupted_flag";
+const char* InterprocessIndexingStatusManager::s_maximumQueuedStorageCountKeyName =
+	"maximum_queued_storage_count";
+
+const size_t InterprocessIndexingStatusManager::s_defaultMaximumQueuedStorageCount = 2;
 
 InterprocessIndexingStatusManager::InterprocessIndexingStatusManager(
 	const std::string& instanceUuid, Id processId, bool isOwner)
 	: BaseInterprocessDataManager(
 		  s_sharedMemoryNamePrefix + instanceUuid, 1048576 /* 1 MB */, instanceUuid, processId, isOwner)
+	, m_statusChangedEvent(s_statusChangedEventNamePrefix + instanceUuid, isOwner)
+	, m_interruptedEvent(s_interruptedEventNamePrefix + instanceUuid, isOwner)
 {
 }
 
 InterprocessIndexingStatusManager::~InterprocessIndexingStatusManager() {}
 
+void InterprocessIndexingStatusManager::startIndexingBatch(
+	const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t overestimationMultiplier = 3;
+	const size_t nodeSize = 64;
+
+	std::vector<std::pair<std::string, std::string>> commandStrs;
+	size_t estimatedSize = 0;
+	for (const std::shared_ptr<IndexerCommand>& indexerCommand: indexerCommands)
+	{
+		commandStrs.emplace_back(
+			utility::encodeToUtf8(indexerCommand->getSourceFilePath().wstr()),
+			SharedIndexerCommand::toString(indexerCommand.get()));
+		estimatedSize += 2 * (nodeSize + sizeof(SharedMemory::String)) +
+			2 * commandStrs.back().first.size() + commandStrs.back().second.size();
+	}
+	estimatedSize *= overestimationMultiplier;
+
+	while (access.getFreeMemorySize() < estimatedSize)
+	{
+		LOG_INFO_STREAM(
+			<< "grow memory - est: " << estimatedSize << " size: " << access.getMemorySize()
+			<< " free: " << access.getFreeMemorySize() << " alloc: " << (access.getMemorySize()));
+		access.growMemory(access.getMemorySize());
+
+		LOG_INFO("growing memory succeeded");
+	}
+
+	SharedMemory::Map<SharedMemory::String, Id>* batchFilesPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, Id>>(
+			s_batchFilesKeyName);
+	SharedMemory::Map<SharedMemory::String, SharedMemory::String>* batchCommandsPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, SharedMemory::String>>(
+			s_batchCommandsKeyName);
+	if (batchFilesPtr && batchCommandsPtr)
+	{
+		for (const std::pair<std::string, std::string>& commandStr: commandStrs)
+		{
+			SharedMemory::String str(access.getAllocator());
+			str = commandStr.first.c_str();
+			batchFilesPtr->insert(std::pair<SharedMemory::String, Id>(str, getProcessId()));
+
+			SharedMemory::String command(access.getAllocator());
+			command.assign(commandStr.second.data(), commandStr.second.size());
+			batchCommandsPtr->insert(
+				std::pair<SharedMemory::String, SharedMemory::String>(str, command));
+		}
+	}
+}
+
+void InterprocessIndexingStatusManager::clearIndexingBatch()
+{
+	takeUnstartedIndexerCommandStrs();
+}
+
+std::vector<std::shared_ptr<IndexerCommand>> InterprocessIndexingStatusManager::
+	takeUnstartedIndexerCommands()
+{
+	std::vector<std::shared_ptr<IndexerCommand>> indexerCommands;
+	for (const std::string& commandStr: takeUnstartedIndexerCommandStrs())
+	{
+		std::shared_ptr<IndexerCommand> indexerCommand = SharedIndexerCommand::fromString(commandStr);
+		if (indexerCommand)
+		{
+			indexerCommands.push_back(indexerCommand);
+		}
+	}
+	return indexerCommands;
+}
+
 void InterprocessIndexingStatusManager::startIndexingSourceFile(const FilePath& filePath)
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
 
+	SharedMemory::Map<SharedMemory::String, Id>* batchFilesPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, Id>>(
+			s_batchFilesKeyName);
+	if (batchFilesPtr)
+	{
+		SharedMemory::String fileStr(access.getAllocator());
+		fileStr = utility::encodeToUtf8(filePath.wstr()).c_str();
+		batchFilesPtr->erase(fileStr);
+
+		SharedMemory::Map<SharedMemory::String, SharedMemory::String>* batchCommandsPtr =
+			access.accessValueWithAllocator<
+				SharedMemory::Map<SharedMemory::String, SharedMemory::String>>(s_batchCommandsKeyName);
+		if (batchCommandsPtr)
+		{
+			batchCommandsPtr->erase(fileStr);
+		}
+	}
+
 	SharedMemory::Queue<SharedMemory::String>* indexingFilesPtr =
 		access.accessValueWithAllocator<SharedMemory::Queue<SharedMemory::String>>(
 			s_indexingFilesKeyName);
@@ -85,6 +187,9 @@ void InterprocessIndexingStatusManager::startIndexingSourceFile(const FilePath&
 		it = currentFilesPtr->insert(std::pair<Id, SharedMemory::String>(getProcessId(), str)).first;
 		it->second = str;
 	}
+
+	access.unlock();
+	notifyStatusChange();
 }
 
 void InterprocessIndexingStatusManager::finishIndexingSourceFile()
@@ -105,6 +210,40 @@ void InterprocessIndexingStatusManager::finishIndexingSourceFile()
 	{
 		finishedProcessIdsPtr->push_back(m_processId);
 	}
+
+	access.unlock();
+	notifyStatusChange();
+}
+
+void InterprocessIndexingStatusManager::addCrashedSourceFile(const FilePath& filePath)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	const size_t overestimationMultiplier = 3;
+	const std::string filePathStr = utility::encodeToUtf8(filePath.wstr());
+
+	size_t estimatedSize = 262144 + sizeof(SharedMemory::String) + filePathStr.size();
+	estimatedSize *= overestimationMultiplier;
+
+	while (access.getFreeMemorySize() < estimatedSize)
+	{
+		LOG_INFO_STREAM(
+			<< "grow memory - est: " << estimatedSize << " size: " << access.getMemorySize()
+			<< " free: " << access.getFreeMemorySize() << " alloc: " << (access.getMemorySize()));
+		access.growMemory(access.getMemorySize());
+
+		LOG_INFO("growing memory succeeded");
+	}
+
+	SharedMemory::Vector<SharedMemory::String>* crashedFilesPtr =
+		access.accessValueWithAllocator<SharedMemory::Vector<SharedMemory::String>>(
+			s_crashedFilesKeyName);
+	if (crashedFilesPtr)
+	{
+		SharedMemory::String str(access.getAllocator());
+		str = filePathStr.c_str();
+		crashedFilesPtr->push_back(str);
+	}
 }
 
 void InterprocessIndexingStatusManager::setIndexingInterrupted(bool interrupted)
@@ -116,6 +255,10 @@ void InterprocessIndexingStatusManager::setIndexingInterrupted(bool interrupted)
 	{
 		*indexingInterruptedPtr = interrupted;
 	}
+
+	access.unlock();
+	m_interruptedEvent.notify();
+	notifyStatusChange();
 }
 
 bool InterprocessIndexingStatusManager::getIndexingInterrupted()
@@ -131,6 +274,53 @@ bool InterprocessIndexingStatusManager::getIndexingInterrupted()
 	return false;
 }
 
+bool InterprocessIndexingStatusManager::waitForIndexingInterrupted(size_t timeoutMilliseconds)
+{
+	if (getIndexingInterrupted())
+	{
+		return true;
+	}
+
+	m_interruptedEvent.wait(timeoutMilliseconds);
+	return getIndexingInterrupted();
+}
+
+void InterprocessIndexingStatusManager::notifyStatusChange()
+{
+	m_statusChangedEvent.notify();
+}
+
+bool InterprocessIndexingStatusManager::waitForStatusChange(size_t timeoutMilliseconds)
+{
+	return m_statusChangedEvent.wait(timeoutMilliseconds);
+}
+
+void InterprocessIndexingStatusManager::setMaximumQueuedStorageCount(size_t count)
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	size_t* maximumQueuedStorageCountPtr = access.accessValue<size_t>(
+		s_maximumQueuedStorageCountKeyName);
+	if (maximumQueuedStorageCountPtr)
+	{
+		*maximumQueuedStorageCountPtr = count;
+	}
+}
+
+size_t InterprocessIndexingStatusManager::getMaximumQueuedStorageCount()
+{
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	size_t* maximumQueuedStorageCountPtr = access.accessValue<size_t>(
+		s_maximumQueuedStorageCountKeyName);
+	if (maximumQueuedStorageCountPtr && *maximumQueuedStorageCountPtr)
+	{
+		return *maximumQueuedStorageCountPtr;
+	}
+
+	return s_defaultMaximumQueuedStorageCount;
+}
+
 Id InterprocessIndexingStatusManager::getNextFinishedProcessId()
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
@@ -202,3 +392,41 @@ std::vector<FilePath> InterprocessIndexingStatusManager::getCrashedSourceFilePat
 
 	return crashedFiles;
 }
+
+std::vector<std::string> InterprocessIndexingStatusManager::takeUnstartedIndexerCommandStrs()
+{
+	std::vector<std::string> commandStrs;
+
+	SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+	SharedMemory::Map<SharedMemory::String, Id>* batchFilesPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, Id>>(
+			s_batchFilesKeyName);
+	SharedMemory::Map<SharedMemory::String, SharedMemory::String>* batchCommandsPtr =
+		access.accessValueWithAllocator<SharedMemory::Map<SharedMemory::String, SharedMemory::String>>(
+			s_batchCommandsKeyName);
+	if (batchFilesPtr && batchCommandsPtr)
+	{
+		for (SharedMemory::Map<SharedMemory::String, Id>::iterator it = batchFilesPtr->begin();
+			 it != batchFilesPtr->end();)
+		{
+			if (it->second == getProcessId())
+			{
+				SharedMemory::Map<SharedMemory::String, SharedMemory::String>::iterator commandIt =
+					batchCommandsPtr->find(it->first);
+				if (commandIt != batchCommandsPtr->end())
+				{
+					commandStrs.emplace_back(commandIt->second.data(), commandIt->second.size());
+					batchCommandsPtr->erase(commandIt);
+				}
+				it = batchFilesPtr->erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+	}
+
+	return commandStrs;
+}
@@ -1,10 +1,14 @@
 #ifndef INTERPROCESS_INDEXING_STATUS_MANAGER_H
 #define INTERPROCESS_INDEXING_STATUS_MANAGER_H
 
+#include <memory>
 #include <set>
 
 #include "BaseInterprocessDataManager.h"
 #include "FilePath.h"
+#include "InterprocessEvent.h"
+
+class IndexerCommand;
 
 class InterprocessIndexingStatusManager: public BaseInterprocessDataManager
 {
@@ -12,25 +16,60 @@ public:
 	InterprocessIndexingStatusManager(const std::string& instanceUuid, Id processId, bool isOwner);
 	virtual ~InterprocessIndexingStatusManager();
 
+	// registers all commands of a batch before the first one is started, so the commands that were
+	// not started yet can be taken over by the restarted indexer process if this one dies
+	void startIndexingBatch(const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands);
+	// forgets the commands of the batch that were not started, e.g. because indexing was interrupted
+	void clearIndexingBatch();
+	// returns the unstarted batch commands of a previous indexer process with the same id
+	std::vector<std::shared_ptr<IndexerCommand>> takeUnstartedIndexerCommands();
+
 	void startIndexingSourceFile(const FilePath& filePath);
 	void finishIndexingSourceFile();
 
+	// reports a file as crashed without indexing it, e.g. because its command could not be received
+	void addCrashedSourceFile(const FilePath& filePath);
+
 	void setIndexingInterrupted(bool interrupted);
 	bool getIndexingInterrupted();
 
+	// returns the interrupted flag after it changed or the timeout expired
+	bool waitForIndexingInterrupted(size_t timeoutMilliseconds);
+
+	// wakes up the owner waiting for a status change, e.g. when an indexer starts or finishes a file
+	void notifyStatusChange();
+	bool waitForStatusChange(size_t timeoutMilliseconds);
+
+	// number of intermediate storages each indexer may have queued before it waits, adapted by the
+	// owner to stay within the memory budget
+	void setMaximumQueuedStorageCount(size_t count);
+	size_t getMaximumQueuedStorageCount();
+
 	Id getNextFinishedProcessId();
 
 	std::vector<FilePath> getCurrentlyIndexedSourceFilePaths();
 	std::vector<FilePath> getCrashedSourceFilePaths();
 
 private:
+	std::vector<std::string> takeUnstartedIndexerCommandStrs();
+
 	static const char* s_sharedMemoryNamePrefix;
+	static const char* s_statusChangedEventNamePrefix;
+	static const char* s_interruptedEventNamePrefix;
 
 	static const char* s_indexingFilesKeyName;
+	static const char* s_batchFilesKeyName;
+	static const char* s_batchCommandsKeyName;
 	static const char* s_currentFilesKeyName;
 	static const char* s_crashedFilesKeyName;
 	static const char* s_finishedProcessIdsKeyName;
 	static const char* s_indexingInterruptedKeyName;
+	static const char* s_maximumQueuedStorageCountKeyName;
+
+	static const size_t s_defaultMaximumQueuedStorageCount;
+
+	InterprocessEvent m_statusChangedEvent;
+	InterprocessEvent m_interruptedEvent;
 };
 
 #endif	  // INTERPROCESS_INDEXING_STATUS_MANAGER_H
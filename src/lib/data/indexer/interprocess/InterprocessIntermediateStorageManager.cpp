@@ -1,10 +1,12 @@
 #include "InterprocessIntermediateStorageManager.h"
 
+#include "IndexingStatistics.h"
 #include "IntermediateStorage.h"
 #include "SharedIntermediateStorage.h"
 #include "logging.h"
 
 const char* InterprocessIntermediateStorageManager::s_sharedMemoryNamePrefix = "iist_";
+const char* InterprocessIntermediateStorageManager::s_poppedEventNamePrefix = "iisp_";
 
 const char* InterprocessIntermediateStorageManager::s_intermediatStoragesKeyName =
 	"intermediate_storages";
@@ -18,6 +20,8 @@ InterprocessIntermediateStorageManager::InterprocessIntermediateStorageManager(
 		  processId,
 		  isOwner)
 	, m_insertsWithoutGrowth(0)
+	, m_lastObservedMemorySize(0)
+	, m_poppedEvent(s_poppedEventNamePrefix + std::to_string(processId) + "_" + instanceUuid, isOwner)
 {
 }
 
@@ -76,6 +80,7 @@ void InterprocessIntermediateStorageManager::pushIntermediateStorage(
 	storage.setStorageErrors(intermediateStorage->getErrors());
 
 	storage.setNextId(intermediateStorage->getNextId());
+	storage.setIndexingDuration(intermediateStorage->getIndexingDuration());
 
 	if (m_insertsWithoutGrowth >= requiredInsertsToShrink)
 	{
@@ -95,6 +100,15 @@ std::shared_ptr<IntermediateStorage> InterprocessIntermediateStorageManager::pop
 {
 	SharedMemory::ScopedAccess access(&m_sharedMemory);
 
+	// the memory is grown by the indexer process, so growth can only be observed between pops
+	const size_t memorySize = access.getMemorySize();
+	if (m_lastObservedMemorySize && memorySize > m_lastObservedMemorySize)
+	{
+		IndexingStatistics::getInstance()->recordSharedMemoryGrowth(
+			memorySize - m_lastObservedMemorySize);
+	}
+	m_lastObservedMemorySize = memorySize;
+
 	SharedMemory::Queue<SharedIntermediateStorage>* queue =
 		access.accessValueWithAllocator<SharedMemory::Queue<SharedIntermediateStorage>>(
 			s_intermediatStoragesKeyName);
@@ -118,10 +132,14 @@ std::shared_ptr<IntermediateStorage> InterprocessIntermediateStorageManager::pop
 	storage->setErrors(sharedIntermediateStorage.getStorageErrors());
 
 	storage->setNextId(sharedIntermediateStorage.getNextId());
+	storage->setIndexingDuration(sharedIntermediateStorage.getIndexingDuration());
 
 	queue->pop_front();
 	LOG_INFO(access.logString());
 
+	access.unlock();
+	m_poppedEvent.notify();
+
 	return storage;
 }
 
@@ -139,3 +157,9 @@ size_t InterprocessIntermediateStorageManager::getIntermediateStorageCount()
 
 	return queue->size();
 }
+
+bool InterprocessIntermediateStorageManager::waitForIntermediateStoragePopped(
+	size_t timeoutMilliseconds)
+{
+	return m_poppedEvent.wait(timeoutMilliseconds);
+}
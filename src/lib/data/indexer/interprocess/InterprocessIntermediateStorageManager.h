@@ -2,6 +2,7 @@
 #define INTERPROCESS_INTERMEDIATE_STORAGE_MANAGER_H
 
 #include "BaseInterprocessDataManager.h"
+#include "InterprocessEvent.h"
 
 class IntermediateStorage;
 
@@ -16,11 +17,18 @@ public:
 
 	size_t getIntermediateStorageCount();
 
+	// returns false if no storage was popped within the timeout
+	bool waitForIntermediateStoragePopped(size_t timeoutMilliseconds);
+
 private:
 	static const char* s_sharedMemoryNamePrefix;
+	static const char* s_poppedEventNamePrefix;
 	static const char* s_intermediatStoragesKeyName;
 
 	size_t m_insertsWithoutGrowth;
+	size_t m_lastObservedMemorySize;
+
+	InterprocessEvent m_poppedEvent;
 };
 
 #endif	  // INTERPROCESS_INTERMEDIATE_STORAGE_MANAGER_H
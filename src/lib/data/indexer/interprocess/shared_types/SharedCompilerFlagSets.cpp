@@ -0,0 +1,69 @@
+#include "SharedCompilerFlagSets.h"
+
+#include "logging.h"
+#include "utilityString.h"
+
+SharedCompilerFlagSets::SharedCompilerFlagSets(
+	const std::string& name, size_t capacity, size_t dataSize, bool isOwner)
+	: m_table(name, capacity, dataSize, isOwner)
+{
+}
+
+bool SharedCompilerFlagSets::getId(
+	std::shared_ptr<const std::vector<std::wstring>> compilerFlags, uint32_t& id)
+{
+	auto it = m_pushedIds.find(compilerFlags);
+	if (it != m_pushedIds.end())
+	{
+		id = it->second;
+		return true;
+	}
+
+	std::vector<std::string> strings;
+	strings.reserve(compilerFlags->size());
+	for (const std::wstring& compilerFlag: *compilerFlags)
+	{
+		strings.push_back(utility::encodeToUtf8(compilerFlag));
+	}
+
+	if (!m_table.tryAdd(strings, id))
+	{
+		return false;
+	}
+
+	m_pushedIds.emplace(compilerFlags, id);
+	return true;
+}
+
+std::shared_ptr<const std::vector<std::wstring>> SharedCompilerFlagSets::getCompilerFlags(
+	uint32_t id)
+{
+	auto it = m_poppedCompilerFlags.find(id);
+	if (it != m_poppedCompilerFlags.end())
+	{
+		return it->second;
+	}
+
+	std::vector<std::string> strings;
+	if (!m_table.get(id, strings))
+	{
+		LOG_ERROR("Shared compiler flag set " + std::to_string(id) + " does not exist.");
+		return nullptr;
+	}
+
+	std::shared_ptr<std::vector<std::wstring>> compilerFlags =
+		std::make_shared<std::vector<std::wstring>>();
+	compilerFlags->reserve(strings.size());
+	for (const std::string& str: strings)
+	{
+		compilerFlags->push_back(utility::decodeFromUtf8(str));
+	}
+
+	m_poppedCompilerFlags.emplace(id, compilerFlags);
+	return compilerFlags;
+}
+
+size_t SharedCompilerFlagSets::getCompilerFlagSetCount() const
+{
+	return m_table.size();
+}
@@ -0,0 +1,36 @@
+#ifndef SHARED_COMPILER_FLAG_SETS_H
+#define SHARED_COMPILER_FLAG_SETS_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SharedStringListTable.h"
+
+// Compiler flag sets shared by the indexer commands, stored in shared memory once per set. The
+// owner assigns ids to the flag sets it pushes, other instances decode each set once and hand the
+// same flags to all commands referencing it.
+class SharedCompilerFlagSets
+{
+public:
+	SharedCompilerFlagSets(const std::string& name, size_t capacity, size_t dataSize, bool isOwner);
+
+	// returns false if the table is full, the flags have to be passed with the command then
+	bool getId(std::shared_ptr<const std::vector<std::wstring>> compilerFlags, uint32_t& id);
+
+	// returns nullptr if there is no flag set with this id
+	std::shared_ptr<const std::vector<std::wstring>> getCompilerFlags(uint32_t id);
+
+	size_t getCompilerFlagSetCount() const;
+
+private:
+	SharedStringListTable m_table;
+
+	// flag sets are kept alive, so their addresses can't be reused by other sets
+	std::map<std::shared_ptr<const std::vector<std::wstring>>, uint32_t> m_pushedIds;
+	std::map<uint32_t, std::shared_ptr<const std::vector<std::wstring>>> m_poppedCompilerFlags;
+};
+
+#endif	  // SHARED_COMPILER_FLAG_SETS_H
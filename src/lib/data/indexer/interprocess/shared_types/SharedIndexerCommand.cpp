@@ -1,273 +1,303 @@
 #include "SharedIndexerCommand.h"
 
+#include "language_packages.h"
+
 #include "IndexerCommandCxx.h"
 #include "IndexerCommandJava.h"
+#include "SharedCompilerFlagSets.h"
 
 #include "logging.h"
 #include "utilityString.h"
 
-void SharedIndexerCommand::fromLocal(IndexerCommand* indexerCommand)
+namespace
 {
-	setSourceFilePath(indexerCommand->getSourceFilePath());
-
+enum Field
+{
+	FIELD_SOURCE_FILE_PATH = 0,
 #if BUILD_CXX_LANGUAGE_PACKAGE
-	if (dynamic_cast<IndexerCommandCxx*>(indexerCommand) != nullptr)
-	{
-		IndexerCommandCxx* cmd = dynamic_cast<IndexerCommandCxx*>(indexerCommand);
-
-		setType(CXX);
-		setIndexedPaths(cmd->getIndexedPaths());
-		setExcludeFilters(cmd->getExcludeFilters());
-		setIncludeFilters(cmd->getIncludeFilters());
-		setWorkingDirectory(cmd->getWorkingDirectory());
-		setCompilerFlags(cmd->getCompilerFlags());
-		return;
-	}
+	FIELD_CXX_INDEXED_PATHS = 1,
+	FIELD_CXX_EXCLUDE_FILTERS = 2,
+	FIELD_CXX_INCLUDE_FILTERS = 3,
+	FIELD_CXX_WORKING_DIRECTORY = 4,
+	FIELD_CXX_COMPILER_FLAGS = 5,
 #endif	  // BUILD_CXX_LANGUAGE_PACKAGE
 #if BUILD_JAVA_LANGUAGE_PACKAGE
-	if (dynamic_cast<IndexerCommandJava*>(indexerCommand) != nullptr)
-	{
-		IndexerCommandJava* cmd = dynamic_cast<IndexerCommandJava*>(indexerCommand);
-
-		setType(JAVA);
-		setLanguageStandard(cmd->getLanguageStandard());
-		setClassPaths(cmd->getClassPath());
-		return;
-	}
+	FIELD_JAVA_LANGUAGE_STANDARD = 1,
+	FIELD_JAVA_CLASS_PATHS = 2,
 #endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
+};
 
-	LOG_ERROR(
-		L"Trying to push unhandled type of IndexerCommand for file: " +
-		indexerCommand->getSourceFilePath().wstr() + L". Type string is: " +
-		utility::decodeFromUtf8(indexerCommandTypeToString(indexerCommand->getIndexerCommandType())) +
-		L". It will be ignored.");
-}
+// compiler flags can't contain null characters, so this marks a reference to a shared flag set
+const char s_compilerFlagSetMarker = '\0';
 
-std::shared_ptr<IndexerCommand> SharedIndexerCommand::fromShared(const SharedIndexerCommand& indexerCommand)
+template <typename ContainerType>
+std::vector<std::string> toStrings(const ContainerType& paths)
 {
-	switch (indexerCommand.getType())
+	std::vector<std::string> strings;
+	strings.reserve(paths.size());
+	for (const auto& path: paths)
 	{
-#if BUILD_CXX_LANGUAGE_PACKAGE
-	case CXX:
-		return std::make_shared<IndexerCommandCxx>(
-			indexerCommand.getSourceFilePath(),
-			indexerCommand.getIndexedPaths(),
-			indexerCommand.getExcludeFilters(),
-			indexerCommand.getIncludeFilters(),
-			indexerCommand.getWorkingDirectory(),
-			indexerCommand.getCompilerFlags());
-#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
-#if BUILD_JAVA_LANGUAGE_PACKAGE
-	case JAVA:
-		return std::make_shared<IndexerCommandJava>(
-			indexerCommand.getSourceFilePath(),
-			indexerCommand.getLanguageStandard(),
-			indexerCommand.getClassPaths());
-#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
-#if BUILD_PYTHON_LANGUAGE_PACKAGE
-	case PYTHON:
-		LOG_ERROR(
-			L"Cannot convert shared IndexerCommand for file: " +
-			indexerCommand.getSourceFilePath().wstr() + L". The type is unknown.");
-		break;
-#endif	  // BUILD_PYTHON_LANGUAGE_PACKAGE
-	default:
-		LOG_ERROR(
-			L"Cannot convert shared IndexerCommand for file: " +
-			indexerCommand.getSourceFilePath().wstr() + L". The type is unknown.");
+		strings.push_back(utility::encodeToUtf8(path.wstr()));
 	}
-
-	return nullptr;
-}
-
-
-SharedIndexerCommand::SharedIndexerCommand(SharedMemory::Allocator* allocator)
-	: m_type(Type::UNKNOWN)
-	, m_sourceFilePath("", allocator)
-#if BUILD_CXX_LANGUAGE_PACKAGE
-	, m_indexedPaths(allocator)
-	, m_excludeFilters(allocator)
-	, m_includeFilters(allocator)
-	, m_workingDirectory("", allocator)
-	, m_compilerFlags(allocator)
-#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
-#if BUILD_JAVA_LANGUAGE_PACKAGE
-	, m_languageStandard("", allocator)
-	, m_classPaths(allocator)
-#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
-{
-}
-
-SharedIndexerCommand::~SharedIndexerCommand() {}
-
-FilePath SharedIndexerCommand::getSourceFilePath() const
-{
-	return FilePath(utility::decodeFromUtf8(m_sourceFilePath.c_str()));
+	return strings;
 }
 
-void SharedIndexerCommand::setSourceFilePath(const FilePath& filePath)
+template <typename ContainerType>
+ContainerType fromStrings(const std::vector<std::string>& strings)
 {
-	m_sourceFilePath = utility::encodeToUtf8(filePath.wstr()).c_str();
-}
-
-#if BUILD_CXX_LANGUAGE_PACKAGE
-
-std::set<FilePath> SharedIndexerCommand::getIndexedPaths() const
-{
-	std::set<FilePath> result;
-
-	for (unsigned int i = 0; i < m_indexedPaths.size(); i++)
+	ContainerType paths;
+	for (const std::string& str: strings)
 	{
-		result.insert(FilePath(utility::decodeFromUtf8(m_indexedPaths[i].c_str())));
+		paths.insert(paths.end(), typename ContainerType::value_type(utility::decodeFromUtf8(str)));
 	}
-
-	return result;
+	return paths;
 }
 
-void SharedIndexerCommand::setIndexedPaths(const std::set<FilePath>& indexedPaths)
+std::wstring getString(const SharedMemoryRing::Record& record, size_t field)
 {
-	m_indexedPaths.clear();
-
-	for (const FilePath& indexedPath: indexedPaths)
+	if (field < record.fields.size() && !record.fields[field].empty())
 	{
-		SharedMemory::String path(m_indexedPaths.get_allocator());
-		path = utility::encodeToUtf8(indexedPath.wstr()).c_str();
-		m_indexedPaths.push_back(path);
+		return utility::decodeFromUtf8(record.fields[field].front());
 	}
+	return std::wstring();
 }
 
-std::set<FilePathFilter> SharedIndexerCommand::getExcludeFilters() const
+const std::vector<std::string>& getStrings(const SharedMemoryRing::Record& record, size_t field)
 {
-	std::set<FilePathFilter> result;
-
-	for (unsigned int i = 0; i < m_excludeFilters.size(); i++)
-	{
-		result.insert(FilePathFilter(utility::decodeFromUtf8(m_excludeFilters[i].c_str())));
-	}
-
-	return result;
+	static const std::vector<std::string> empty;
+	return field < record.fields.size() ? record.fields[field] : empty;
 }
 
-void SharedIndexerCommand::setExcludeFilters(const std::set<FilePathFilter>& excludeFilters)
+void appendNumber(std::string& str, size_t number)
 {
-	m_excludeFilters.clear();
-
-	for (const FilePathFilter& excludeFilter: excludeFilters)
-	{
-		SharedMemory::String path(m_excludeFilters.get_allocator());
-		path = utility::encodeToUtf8(excludeFilter.wstr()).c_str();
-		m_excludeFilters.push_back(path);
-	}
+	str += std::to_string(number);
+	str += ' ';
 }
 
-std::set<FilePathFilter> SharedIndexerCommand::getIncludeFilters() const
+bool readNumber(const std::string& str, size_t& position, size_t& number)
 {
-	std::set<FilePathFilter> result;
-
-	for (unsigned int i = 0; i < m_includeFilters.size(); i++)
+	const size_t start = position;
+	number = 0;
+	while (position < str.size() && str[position] >= '0' && str[position] <= '9')
 	{
-		result.insert(FilePathFilter(utility::decodeFromUtf8(m_includeFilters[i].c_str())));
+		number = number * 10 + (str[position] - '0');
+		position++;
 	}
 
-	return result;
-}
-
-void SharedIndexerCommand::setIncludeFilters(const std::set<FilePathFilter>& includeFilters)
-{
-	m_includeFilters.clear();
-
-	for (const FilePathFilter& includeFilter: includeFilters)
+	if (position == start || position >= str.size() || str[position] != ' ')
 	{
-		SharedMemory::String path(m_includeFilters.get_allocator());
-		path = utility::encodeToUtf8(includeFilter.wstr()).c_str();
-		m_includeFilters.push_back(path);
+		return false;
 	}
+	position++;
+	return true;
 }
+}	 // namespace
 
-FilePath SharedIndexerCommand::getWorkingDirectory() const
+bool SharedIndexerCommand::toRecord(
+	IndexerCommand* indexerCommand,
+	SharedMemoryRing::Record& record,
+	SharedCompilerFlagSets* compilerFlagSets)
 {
-	return FilePath(utility::decodeFromUtf8(m_workingDirectory.c_str()));
-}
-
-void SharedIndexerCommand::setWorkingDirectory(const FilePath& workingDirectory)
-{
-	m_workingDirectory = utility::encodeToUtf8(workingDirectory.wstr()).c_str();
-}
+	record.type = indexerCommand->getIndexerCommandType();
+	record.fields.clear();
 
-std::vector<std::wstring> SharedIndexerCommand::getCompilerFlags() const
-{
-	std::vector<std::wstring> result;
-	result.reserve(m_compilerFlags.size());
+#if BUILD_CXX_LANGUAGE_PACKAGE
+	if (dynamic_cast<IndexerCommandCxx*>(indexerCommand) != nullptr)
+	{
+		IndexerCommandCxx* cmd = dynamic_cast<IndexerCommandCxx*>(indexerCommand);
 
-	for (unsigned int i = 0; i < m_compilerFlags.size(); i++)
+		std::vector<std::string> compilerFlags;
+		uint32_t compilerFlagSetId = 0;
+		if (compilerFlagSets &&
+			compilerFlagSets->getId(cmd->getSharedCompilerFlags(), compilerFlagSetId))
+		{
+			compilerFlags = {
+				s_compilerFlagSetMarker + std::to_string(compilerFlagSetId),
+				utility::encodeToUtf8(cmd->getSourceFileArgument())};
+		}
+		else
+		{
+			compilerFlags.reserve(cmd->getSharedCompilerFlags()->size());
+			for (const std::wstring& compilerFlag: cmd->getCompilerFlags())
+			{
+				compilerFlags.push_back(utility::encodeToUtf8(compilerFlag));
+			}
+		}
+
+		record.type = INDEXER_COMMAND_CXX;
+		record.fields.resize(FIELD_CXX_COMPILER_FLAGS + 1);
+		record.fields[FIELD_SOURCE_FILE_PATH] = {
+			utility::encodeToUtf8(cmd->getSourceFilePath().wstr())};
+		record.fields[FIELD_CXX_INDEXED_PATHS] = toStrings(cmd->getIndexedPaths());
+		record.fields[FIELD_CXX_EXCLUDE_FILTERS] = toStrings(cmd->getExcludeFilters());
+		record.fields[FIELD_CXX_INCLUDE_FILTERS] = toStrings(cmd->getIncludeFilters());
+		record.fields[FIELD_CXX_WORKING_DIRECTORY] = {
+			utility::encodeToUtf8(cmd->getWorkingDirectory().wstr())};
+		record.fields[FIELD_CXX_COMPILER_FLAGS] = std::move(compilerFlags);
+		return true;
+	}
+#endif	  // BUILD_CXX_LANGUAGE_PACKAGE
+#if BUILD_JAVA_LANGUAGE_PACKAGE
+	if (dynamic_cast<IndexerCommandJava*>(indexerCommand) != nullptr)
 	{
-		result.push_back(utility::decodeFromUtf8(m_compilerFlags[i].c_str()));
+		IndexerCommandJava* cmd = dynamic_cast<IndexerCommandJava*>(indexerCommand);
+
+		record.type = INDEXER_COMMAND_JAVA;
+		record.fields.resize(FIELD_JAVA_CLASS_PATHS + 1);
+		record.fields[FIELD_SOURCE_FILE_PATH] = {
+			utility::encodeToUtf8(cmd->getSourceFilePath().wstr())};
+		record.fields[FIELD_JAVA_LANGUAGE_STANDARD] = {
+			utility::encodeToUtf8(cmd->getLanguageStandard())};
+		record.fields[FIELD_JAVA_CLASS_PATHS] = toStrings(cmd->getClassPath());
+		return true;
 	}
+#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
 
-	return result;
+	LOG_ERROR(
+		L"Trying to push unhandled type of IndexerCommand for file: " +
+		indexerCommand->getSourceFilePath().wstr() + L". Type string is: " +
+		utility::decodeFromUtf8(indexerCommandTypeToString(indexerCommand->getIndexerCommandType())) +
+		L". It will be ignored.");
+	return false;
 }
 
-void SharedIndexerCommand::setCompilerFlags(const std::vector<std::wstring>& compilerFlags)
+std::shared_ptr<IndexerCommand> SharedIndexerCommand::fromRecord(
+	const SharedMemoryRing::Record& record, SharedCompilerFlagSets* compilerFlagSets)
 {
-	m_compilerFlags.clear();
-	m_compilerFlags.reserve(compilerFlags.size());
+	const FilePath sourceFilePath = getSourceFilePath(record);
 
-	for (const std::wstring& compilerFlag: compilerFlags)
+	switch (record.type)
 	{
-		SharedMemory::String path(m_compilerFlags.get_allocator());
-		path = utility::encodeToUtf8(compilerFlag).c_str();
-		m_compilerFlags.push_back(path);
-	}
-}
+#if BUILD_CXX_LANGUAGE_PACKAGE
+	case INDEXER_COMMAND_CXX:
+	{
+		const std::vector<std::string>& strings = getStrings(record, FIELD_CXX_COMPILER_FLAGS);
+
+		std::shared_ptr<const std::vector<std::wstring>> compilerFlags;
+		std::wstring sourceFileArgument;
+		if (strings.size() == 2 && !strings[0].empty() && strings[0][0] == s_compilerFlagSetMarker)
+		{
+			if (compilerFlagSets)
+			{
+				try
+				{
+					compilerFlags = compilerFlagSets->getCompilerFlags(
+						static_cast<uint32_t>(std::stoul(strings[0].substr(1))));
+				}
+				catch (std::logic_error&)
+				{
+					// the marker is not followed by a valid id
+				}
+			}
+			if (!compilerFlags)
+			{
+				LOG_ERROR(
+					L"Cannot convert shared IndexerCommand for file: " + sourceFilePath.wstr() +
+					L". Its compiler flags are unavailable.");
+				return nullptr;
+			}
+			sourceFileArgument = utility::decodeFromUtf8(strings[1]);
+		}
+		else
+		{
+			std::shared_ptr<std::vector<std::wstring>> decodedCompilerFlags =
+				std::make_shared<std::vector<std::wstring>>();
+			decodedCompilerFlags->reserve(strings.size());
+			for (const std::string& compilerFlag: strings)
+			{
+				decodedCompilerFlags->push_back(utility::decodeFromUtf8(compilerFlag));
+			}
+			compilerFlags = decodedCompilerFlags;
+		}
 
+		return std::make_shared<IndexerCommandCxx>(
+			sourceFilePath,
+			fromStrings<std::set<FilePath>>(getStrings(record, FIELD_CXX_INDEXED_PATHS)),
+			fromStrings<std::set<FilePathFilter>>(getStrings(record, FIELD_CXX_EXCLUDE_FILTERS)),
+			fromStrings<std::set<FilePathFilter>>(getStrings(record, FIELD_CXX_INCLUDE_FILTERS)),
+			FilePath(getString(record, FIELD_CXX_WORKING_DIRECTORY)),
+			compilerFlags,
+			sourceFileArgument);
+	}
 #endif	  // BUILD_CXX_LANGUAGE_PACKAGE
-
 #if BUILD_JAVA_LANGUAGE_PACKAGE
+	case INDEXER_COMMAND_JAVA:
+		return std::make_shared<IndexerCommandJava>(
+			sourceFilePath,
+			getString(record, FIELD_JAVA_LANGUAGE_STANDARD),
+			fromStrings<std::vector<FilePath>>(getStrings(record, FIELD_JAVA_CLASS_PATHS)));
+#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
+	default:
+		LOG_ERROR(
+			L"Cannot convert shared IndexerCommand for file: " + sourceFilePath.wstr() +
+			L". The type is unknown.");
+	}
 
-std::wstring SharedIndexerCommand::getLanguageStandard() const
-{
-	return utility::decodeFromUtf8(m_languageStandard.c_str());
+	return nullptr;
 }
 
-void SharedIndexerCommand::setLanguageStandard(const std::wstring& languageStandard)
+FilePath SharedIndexerCommand::getSourceFilePath(const SharedMemoryRing::Record& record)
 {
-	m_languageStandard = utility::encodeToUtf8(languageStandard).c_str();
+	return FilePath(getString(record, FIELD_SOURCE_FILE_PATH));
 }
 
-std::vector<FilePath> SharedIndexerCommand::getClassPaths() const
+std::string SharedIndexerCommand::toString(IndexerCommand* indexerCommand)
 {
-	std::vector<FilePath> result;
-	result.reserve(m_classPaths.size());
-
-	for (unsigned int i = 0; i < m_classPaths.size(); i++)
+	SharedMemoryRing::Record record;
+	if (!toRecord(indexerCommand, record))
 	{
-		result.push_back(FilePath(utility::decodeFromUtf8(m_classPaths[i].c_str())));
+		return std::string();
 	}
 
-	return result;
+	// all strings are length prefixed, so they may contain any character
+	std::string str;
+	appendNumber(str, record.type);
+	appendNumber(str, record.fields.size());
+	for (const std::vector<std::string>& strings: record.fields)
+	{
+		appendNumber(str, strings.size());
+		for (const std::string& field: strings)
+		{
+			appendNumber(str, field.size());
+			str += field;
+		}
+	}
+	return str;
 }
 
-void SharedIndexerCommand::setClassPaths(const std::vector<FilePath>& classPaths)
+std::shared_ptr<IndexerCommand> SharedIndexerCommand::fromString(const std::string& str)
 {
-	m_classPaths.clear();
-	m_classPaths.reserve(classPaths.size());
-
-	for (const FilePath& classPath: classPaths)
+	SharedMemoryRing::Record record;
+	size_t position = 0;
+	size_t type = 0;
+	size_t fieldCount = 0;
+	if (!readNumber(str, position, type) || !readNumber(str, position, fieldCount) ||
+		fieldCount > SharedMemoryRing::s_maxFieldCount)
 	{
-		SharedMemory::String path(m_classPaths.get_allocator());
-		path = utility::encodeToUtf8(classPath.wstr()).c_str();
-		m_classPaths.push_back(path);
+		return nullptr;
 	}
-}
 
-#endif	  // BUILD_JAVA_LANGUAGE_PACKAGE
-
-SharedIndexerCommand::Type SharedIndexerCommand::getType() const
-{
-	return m_type;
-}
+	record.type = static_cast<uint32_t>(type);
+	record.fields.resize(fieldCount);
+	for (std::vector<std::string>& strings: record.fields)
+	{
+		size_t count = 0;
+		if (!readNumber(str, position, count))
+		{
+			return nullptr;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t length = 0;
+			if (!readNumber(str, position, length) || length > str.size() - position)
+			{
+				return nullptr;
+			}
+			strings.push_back(str.substr(position, length));
+			position += length;
+		}
+	}
 
-void SharedIndexerCommand::setType(const SharedIndexerCommand::Type type)
-{
-	m_type = type;
+	return fromRecord(record);
 }
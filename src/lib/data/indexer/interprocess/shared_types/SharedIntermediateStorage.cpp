@@ -12,6 +12,7 @@ SharedIntermediateStorage::SharedIntermediateStorage(SharedMemory::Allocator* al
 	, m_storageErrors(allocator)
 	, m_allocator(allocator)
 	, m_nextId(1)
+	, m_indexingDuration(0.0f)
 {
 }
 
@@ -232,3 +233,13 @@ void SharedIntermediateStorage::setNextId(const Id nextId)
 {
 	m_nextId = static_cast<int>(nextId);
 }
+
+float SharedIntermediateStorage::getIndexingDuration() const
+{
+	return m_indexingDuration;
+}
+
+void SharedIntermediateStorage::setIndexingDuration(float indexingDuration)
+{
+	m_indexingDuration = indexingDuration;
+}
@@ -43,6 +43,9 @@ public:
 	Id getNextId() const;
 	void setNextId(const Id nextId);
 
+	float getIndexingDuration() const;
+	void setIndexingDuration(float indexingDuration);
+
 private:
 	SharedMemory::Vector<SharedStorageFile> m_storageFiles;
 	SharedMemory::Vector<SharedStorageSymbol> m_storageSymbols;
@@ -57,6 +60,7 @@ private:
 	SharedMemory::Allocator* m_allocator;
 
 	int m_nextId;
+	float m_indexingDuration;
 };
 
 #endif	  // SHARED_INTERMEDIATE_STORAGE_H
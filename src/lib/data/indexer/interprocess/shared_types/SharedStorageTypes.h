@@ -43,7 +43,9 @@ struct SharedStorageNode
 {
 	SharedStorageNode(
 		Id id, int type, const std::string& serializedName, SharedMemory::Allocator* allocator)
-		: id(id), type(type), serializedName(serializedName.c_str(), allocator)
+		: id(id)
+		, type(type)
+		, serializedName(serializedName.c_str(), serializedName.size(), allocator)
 	{
 	}
 
@@ -54,13 +56,15 @@ struct SharedStorageNode
 
 inline SharedStorageNode toShared(const StorageNode& node, SharedMemory::Allocator* allocator)
 {
-	return SharedStorageNode(
-		node.id, node.type, utility::encodeToUtf8(node.serializedName), allocator);
+	return SharedStorageNode(node.id, node.type, node.serializedName, allocator);
 }
 
 inline StorageNode fromShared(const SharedStorageNode& node)
 {
-	return StorageNode(node.id, node.type, utility::decodeFromUtf8(node.serializedName.c_str()));
+	return StorageNode(
+		node.id,
+		node.type,
+		std::string(node.serializedName.c_str(), node.serializedName.size()));
 }
 
 
@@ -74,7 +78,7 @@ struct SharedStorageFile
 		bool complete,
 		SharedMemory::Allocator* allocator)
 		: id(id)
-		, filePath(filePath.c_str(), allocator)
+		, filePath(filePath.c_str(), filePath.size(), allocator)
 		, languageIdentifier(languageIdentifier.c_str(), allocator)
 		, indexed(indexed)
 		, complete(complete)
@@ -92,7 +96,7 @@ inline SharedStorageFile toShared(const StorageFile& file, SharedMemory::Allocat
 {
 	return SharedStorageFile(
 		file.id,
-		utility::encodeToUtf8(file.filePath),
+		file.filePath,
 		utility::encodeToUtf8(file.languageIdentifier),
 		file.indexed,
 		file.complete,
@@ -103,7 +107,7 @@ inline StorageFile fromShared(const SharedStorageFile& file)
 {
 	return StorageFile(
 		file.id,
-		utility::decodeFromUtf8(file.filePath.c_str()),
+		std::string(file.filePath.c_str(), file.filePath.size()),
 		utility::decodeFromUtf8(file.languageIdentifier.c_str()),
 		"",
 		file.indexed,
@@ -0,0 +1,76 @@
+#include "TokenPositionIndex.h"
+
+#include <algorithm>
+
+#include "SourceLocation.h"
+#include "SourceLocationFile.h"
+
+TokenPositionIndex::TokenPositionIndex(const SourceLocationFile& locationFile)
+{
+	m_entries.reserve(locationFile.getSourceLocationCount() / 2);
+
+	locationFile.forEachStartSourceLocation([this](SourceLocation* startLocation) {
+		const SourceLocation* endLocation = startLocation->getEndLocation();
+
+		if ((startLocation->getType() == LOCATION_TOKEN ||
+			 startLocation->getType() == LOCATION_QUALIFIER ||
+			 startLocation->getType() == LOCATION_UNSOLVED) &&
+			endLocation && startLocation->getLineNumber() == endLocation->getLineNumber())
+		{
+			m_entries.push_back(
+				{startLocation->getLineNumber(),
+				 startLocation->getColumnNumber(),
+				 endLocation->getColumnNumber(),
+				 startLocation->getLocationId()});
+		}
+	});
+
+	// keep the ordering of SourceLocation::operator< so results match a linear scan over the file
+	std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+		if (a.lineNumber != b.lineNumber)
+		{
+			return a.lineNumber < b.lineNumber;
+		}
+		if (a.startColumnNumber != b.startColumnNumber)
+		{
+			return a.startColumnNumber < b.startColumnNumber;
+		}
+		return a.locationId < b.locationId;
+	});
+}
+
+std::vector<Id> TokenPositionIndex::getLocationIdsAtPosition(
+	size_t lineNumber, size_t columnNumber) const
+{
+	const std::vector<Entry>::const_iterator lineBegin = std::lower_bound(
+		m_entries.begin(), m_entries.end(), lineNumber, [](const Entry& entry, size_t line) {
+			return entry.lineNumber < line;
+		});
+
+	const std::vector<Entry>::const_iterator candidatesEnd = std::upper_bound(
+		lineBegin,
+		m_entries.end(),
+		std::make_pair(lineNumber, columnNumber),
+		[](const std::pair<size_t, size_t>& position, const Entry& entry) {
+			if (position.first != entry.lineNumber)
+			{
+				return position.first < entry.lineNumber;
+			}
+			return position.second < entry.startColumnNumber;
+		});
+
+	std::vector<Id> locationIds;
+	for (std::vector<Entry>::const_iterator it = lineBegin; it != candidatesEnd; it++)
+	{
+		if (it->endColumnNumber + 1 >= columnNumber)
+		{
+			locationIds.push_back(it->locationId);
+		}
+	}
+	return locationIds;
+}
+
+size_t TokenPositionIndex::getEntryCount() const
+{
+	return m_entries.size();
+}
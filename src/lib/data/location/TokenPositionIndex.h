@@ -0,0 +1,33 @@
+#ifndef TOKEN_POSITION_INDEX_H
+#define TOKEN_POSITION_INDEX_H
+
+#include <vector>
+
+#include "types.h"
+
+class SourceLocationFile;
+
+// Maps a cursor position within a file to the ids of the single line token locations covering it.
+// Built once from all locations of a file, lookups are a binary search over the sorted start positions.
+class TokenPositionIndex
+{
+public:
+	TokenPositionIndex(const SourceLocationFile& locationFile);
+
+	std::vector<Id> getLocationIdsAtPosition(size_t lineNumber, size_t columnNumber) const;
+
+	size_t getEntryCount() const;
+
+private:
+	struct Entry
+	{
+		size_t lineNumber;
+		size_t startColumnNumber;
+		size_t endColumnNumber;
+		Id locationId;
+	};
+
+	std::vector<Entry> m_entries;
+};
+
+#endif	  // TOKEN_POSITION_INDEX_H
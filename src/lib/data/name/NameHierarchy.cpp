@@ -13,12 +13,12 @@ const std::wstring PART_DELIMITER = L"\ts";
 const std::wstring SIGNATURE_DELIMITER = L"\tp";
 }	 // namespace
 
-std::wstring NameHierarchy::serialize(const NameHierarchy& nameHierarchy)
+std::string NameHierarchy::serialize(const NameHierarchy& nameHierarchy)
 {
 	return serializeRange(nameHierarchy, 0, nameHierarchy.size());
 }
 
-std::wstring NameHierarchy::serializeRange(const NameHierarchy& nameHierarchy, size_t first, size_t last)
+std::string NameHierarchy::serializeRange(const NameHierarchy& nameHierarchy, size_t first, size_t last)
 {
 	std::wstringstream ss;
 	ss << nameHierarchy.getDelimiter();
@@ -35,11 +35,13 @@ std::wstring NameHierarchy::serializeRange(const NameHierarchy& nameHierarchy, s
 		ss << SIGNATURE_DELIMITER;
 		ss << nameHierarchy[i].getSignature().getPostfix();
 	}
-	return ss.str();
+	return utility::encodeToUtf8(ss.str());
 }
 
-NameHierarchy NameHierarchy::deserialize(const std::wstring& serializedName)
+NameHierarchy NameHierarchy::deserialize(const std::string& utf8SerializedName)
 {
+	const std::wstring serializedName = utility::decodeFromUtf8(utf8SerializedName);
+
 	size_t mpos = serializedName.find(META_DELIMITER);
 	if (mpos == std::wstring::npos)
 	{
@@ -10,9 +10,10 @@
 class NameHierarchy
 {
 public:
-	static std::wstring serialize(const NameHierarchy& nameHierarchy);
-	static std::wstring serializeRange(const NameHierarchy& nameHierarchy, size_t first, size_t last);
-	static NameHierarchy deserialize(const std::wstring& serializedName);
+	// serialized names are UTF-8 encoded, as stored in the database and shared memory
+	static std::string serialize(const NameHierarchy& nameHierarchy);
+	static std::string serializeRange(const NameHierarchy& nameHierarchy, size_t first, size_t last);
+	static NameHierarchy deserialize(const std::string& serializedName);
 
 	NameHierarchy(std::wstring delimiter);
 	NameHierarchy(std::wstring name, std::wstring delimiter);
@@ -3,13 +3,15 @@
 #include "Edge.h"
 #include "Node.h"
 #include "ParseLocation.h"
+#include "utilityString.h"
 
 ParserClientImpl::ParserClientImpl(IntermediateStorage* const storage): m_storage(storage) {}
 
 Id ParserClientImpl::recordFile(const FilePath& filePath, bool indexed)
 {
 	Id fileId = addFileName(filePath);
-	m_storage->addFile(StorageFile(fileId, filePath.wstr(), L"", "", indexed, true));
+	m_storage->addFile(
+		StorageFile(fileId, utility::encodeToUtf8(filePath.wstr()), L"", "", indexed, true));
 	return fileId;
 }
 
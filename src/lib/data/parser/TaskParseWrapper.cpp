@@ -2,6 +2,7 @@
 
 #include "Blackboard.h"
 #include "DialogView.h"
+#include "IndexingStatistics.h"
 #include "PersistentStorage.h"
 
 TaskParseWrapper::TaskParseWrapper(
@@ -19,6 +20,7 @@ void TaskParseWrapper::doEnter(std::shared_ptr<Blackboard> blackboard)
 	m_dialogView->updateIndexingDialog(0, 0, sourceFileCount, {});
 
 	m_start = TimeStamp::now();
+	IndexingStatistics::getInstance()->start(static_cast<size_t>(sourceFileCount));
 
 	if (sourceFileCount > 0)
 	{
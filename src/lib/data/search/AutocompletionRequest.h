@@ -0,0 +1,19 @@
+#ifndef AUTOCOMPLETION_REQUEST_H
+#define AUTOCOMPLETION_REQUEST_H
+
+#include <functional>
+#include <vector>
+
+#include "SearchMatch.h"
+
+// Lets the requester of autocompletion matches stop the query once it got stale and show the
+// first matches before all matches are created. Both callbacks are optional.
+struct AutocompletionRequest
+{
+	// checked while searching, also from several threads at once
+	std::function<bool()> isCancelled;
+
+	std::function<void(const std::vector<SearchMatch>&)> onFirstMatches;
+};
+
+#endif	  // AUTOCOMPLETION_REQUEST_H
@@ -3,11 +3,15 @@
 #include <algorithm>
 #include <ctype.h>
 #include <iterator>
+#include <queue>
+#include <thread>
 
 #include "utility.h"
+#include "utilityApp.h"
 #include "utilityString.h"
 
-SearchIndex::SearchIndex()
+SearchIndex::SearchIndex(bool flatteningEnabled)
+	: m_revision(0), m_flatteningEnabled(flatteningEnabled), m_flattened(false)
 {
 	clear();
 }
@@ -16,6 +20,17 @@ SearchIndex::~SearchIndex() {}
 
 void SearchIndex::addNode(Id id, std::wstring name, NodeType type)
 {
+	// gates of the edges along the path need the characters of the remaining name once the gates
+	// have been populated
+	std::wstring gateName;
+	std::vector<SearchEdge*> gatedEdges;
+	if (m_setupFinished)
+	{
+		gateName = utility::toLowerCase(name);
+	}
+	m_flattened = false;
+	m_revision++;
+
 	SearchNode* currentNode = m_root;
 
 	while (name.size() > 0)
@@ -26,6 +41,10 @@ void SearchIndex::addNode(Id id, std::wstring name, NodeType type)
 		if (it != currentNode->edges.end())
 		{
 			SearchEdge* currentEdge = it->second;
+			if (m_setupFinished)
+			{
+				gatedEdges.push_back(currentEdge);
+			}
 			const std::wstring& edgeString = currentEdge->s;
 
 			size_t matchCount = 1;
@@ -48,6 +67,9 @@ void SearchIndex::addNode(Id id, std::wstring name, NodeType type)
 					currentEdge->target, edgeString.substr(matchCount)));
 				SearchEdge* e = m_edges.back().get();
 
+				// the gate of the split edge still covers everything below the new edge
+				e->gate = currentEdge->gate;
+
 				n->edges.emplace(e->s[0], e);
 
 				currentEdge->s = edgeString.substr(0, matchCount);
@@ -64,6 +86,10 @@ void SearchIndex::addNode(Id id, std::wstring name, NodeType type)
 
 			m_edges.push_back(std::make_unique<SearchEdge>(n, std::move(name)));
 			SearchEdge* e = m_edges.back().get();
+			if (m_setupFinished)
+			{
+				gatedEdges.push_back(e);
+			}
 
 			currentNode->edges.emplace(e->s[0], e);
 			currentNode = n;
@@ -73,14 +99,28 @@ void SearchIndex::addNode(Id id, std::wstring name, NodeType type)
 	}
 
 	currentNode->elementIds.emplace(id, type);
+
+	size_t offset = 0;
+	for (SearchEdge* e: gatedEdges)
+	{
+		e->gate.insert(gateName.begin() + offset, gateName.end());
+		offset += e->s.size();
+	}
 }
 
 void SearchIndex::finishSetup()
 {
-	for (auto& p: m_root->edges)
+	if (!m_setupFinished)
 	{
-		populateEdgeGate(p.second);
+		for (auto& p: m_root->edges)
+		{
+			populateEdgeGate(p.second);
+		}
+
+		m_setupFinished = true;
 	}
+
+	repack();
 }
 
 void SearchIndex::clear()
@@ -91,22 +131,166 @@ void SearchIndex::clear()
 	m_nodes.push_back(std::make_unique<SearchNode>(NodeTypeSet()));
 
 	m_root = m_nodes.back().get();
+	m_setupFinished = false;
+	m_revision++;
+
+	m_flattened = false;
+	m_flatArrays.clear();
+}
+
+bool SearchIndex::removeNode(Id id, const std::wstring& name)
+{
+	// leaves the trie structure, contained types and gates as they are, they only need to include
+	// what is reachable below them
+	SearchNode* currentNode = m_root;
+
+	size_t offset = 0;
+	while (offset < name.size())
+	{
+		auto it = currentNode->edges.find(name[offset]);
+		if (it == currentNode->edges.end())
+		{
+			return false;
+		}
+
+		const std::wstring& edgeString = it->second->s;
+		if (name.compare(offset, edgeString.size(), edgeString) != 0)
+		{
+			return false;
+		}
+
+		offset += edgeString.size();
+		currentNode = it->second->target;
+	}
+
+	if (currentNode->elementIds.erase(id) == 0)
+	{
+		return false;
+	}
+
+	m_flattened = false;
+	m_revision++;
+	return true;
+}
+
+void SearchIndex::repack()
+{
+	if (!m_setupFinished || !m_flatteningEnabled || m_flattened)
+	{
+		return;
+	}
+
+	FlatArrays flatArrays;
+	pack(&flatArrays);
+
+	std::lock_guard<std::shared_timed_mutex> lock(m_flatArraysMutex);
+	std::swap(m_flatArrays, flatArrays);
+	m_revision++;
+	m_flattened = true;
+}
+
+bool SearchIndex::isFlattened() const
+{
+	return m_flattened;
 }
 
 std::vector<SearchResult> SearchIndex::search(
 	const std::wstring& query,
 	NodeTypeSet acceptedNodeTypes,
 	size_t maxResultCount,
-	size_t maxBestScoredResultsLength) const
+	size_t maxBestScoredResultsLength,
+	SearchSession* session,
+	const std::function<bool()>& isCancelled,
+	const std::function<void(const std::multiset<SearchResult>&)>& onFoundResults) const
 {
-	// find paths containing query
-	std::vector<SearchPath> paths;
-	searchRecursive(
-		SearchPath(L"", {}, m_root), utility::toLowerCase(query), acceptedNodeTypes, &paths);
+	std::shared_lock<std::shared_timed_mutex> lock(m_flatArraysMutex);
+
+	// find paths containing query and create scored search results
+	const std::wstring lowerQuery = utility::toLowerCase(query);
+	std::multiset<SearchResult> searchResults;
+	if (m_flattened)
+	{
+		// the gate of each remaining part of the query is checked against the edge gates
+		std::vector<FlatGate> queryGates(lowerQuery.size() + 1);
+		for (size_t i = lowerQuery.size(); i > 0; i--)
+		{
+			queryGates[i - 1] = queryGates[i];
+			queryGates[i - 1].add(lowerQuery[i - 1]);
+		}
+
+		std::vector<FlatSearchItem> items;
+		if (session && session->m_index == this && session->m_revision == m_revision &&
+			session->m_acceptedNodeTypes == acceptedNodeTypes && !session->m_lowerQuery.empty() &&
+			utility::isPrefix(session->m_lowerQuery, lowerQuery))
+		{
+			items.reserve(session->m_paths.size());
+			for (const SearchPath& path: session->m_paths)
+			{
+				items.push_back(continueFlatPath(path, lowerQuery));
+			}
+		}
+		else
+		{
+			items.push_back({SearchPath(L"", {}, nullptr, 0), 0});
+		}
+
+		size_t threadCount = 1;
+		if (m_flatArrays.nodes.size() >= s_minParallelSearchNodeCount)
+		{
+			threadCount = static_cast<size_t>(std::max(utility::getIdealThreadCount(), 1));
+		}
+
+		std::vector<SearchPath> paths;
+		const bool finished = searchFlat(
+			std::move(items),
+			lowerQuery,
+			queryGates,
+			acceptedNodeTypes,
+			maxResultCount * 3,
+			threadCount,
+			isCancelled,
+			session ? &paths : nullptr,
+			&searchResults);
+
+		if (session)
+		{
+			session->clear();
+			if (finished && !lowerQuery.empty() && paths.size() <= s_maxSessionPathCount)
+			{
+				session->m_index = this;
+				session->m_revision = m_revision;
+				session->m_lowerQuery = lowerQuery;
+				session->m_acceptedNodeTypes = acceptedNodeTypes;
+				session->m_paths = std::move(paths);
+			}
+		}
+
+		if (!finished)
+		{
+			return {};
+		}
+	}
+	else
+	{
+		if (session)
+		{
+			session->clear();
+		}
 
-	// create scored search results
-	std::multiset<SearchResult> searchResults = createScoredResults(
-		paths, acceptedNodeTypes, maxResultCount * 3);
+		std::vector<SearchPath> paths;
+		searchRecursive(SearchPath(L"", {}, m_root, 0), lowerQuery, acceptedNodeTypes, &paths);
+
+		for (PathResult& pathResult:
+			 createScoredResults(paths, acceptedNodeTypes, maxResultCount * 3))
+		{
+			searchResults.insert(std::move(pathResult.result));
+		}
+	}
+
+	if (onFoundResults)
+	{
+		onFoundResults(searchResults);
+	}
 
 	// find maximum length for best scores
 	std::multiset<size_t> resultLengths;
@@ -127,6 +311,11 @@ std::vector<SearchResult> SearchIndex::search(
 	std::multiset<SearchResult> bestResults;
 	for (const SearchResult& result: searchResults)
 	{
+		if (isCancelled && isCancelled())
+		{
+			return {};
+		}
+
 		if (!maxResultLength || result.text.size() <= maxResultLength)
 		{
 			bestResults.insert(bestScoredResult(result, &scoresCache, maxBestScoredResultsLength));
@@ -159,6 +348,296 @@ void SearchIndex::populateEdgeGate(SearchEdge* e)
 	}
 }
 
+void SearchIndex::pack(FlatArrays* flatArrays) const
+{
+	// breadth first, so the edges of each node are stored next to each other in the order of the
+	// trie, which keeps the order of the search results
+	std::queue<const SearchNode*> nodes;
+	nodes.push(m_root);
+	uint32_t nextNodeIndex = 1;
+
+	while (!nodes.empty())
+	{
+		const SearchNode* node = nodes.front();
+		nodes.pop();
+
+		FlatNode flatNode;
+		flatNode.containedTypes = node->containedTypes;
+
+		flatNode.elementsBegin = static_cast<uint32_t>(flatArrays->elements.size());
+		flatArrays->elements.insert(
+			flatArrays->elements.end(), node->elementIds.begin(), node->elementIds.end());
+		flatNode.elementsEnd = static_cast<uint32_t>(flatArrays->elements.size());
+
+		flatNode.edgesBegin = static_cast<uint32_t>(flatArrays->edges.size());
+		for (const auto& p: node->edges)
+		{
+			const SearchEdge* edge = p.second;
+
+			FlatEdge flatEdge;
+			for (wchar_t c: edge->gate)
+			{
+				flatEdge.gate.add(c);
+			}
+			flatEdge.labelBegin = static_cast<uint32_t>(flatArrays->labels.size());
+			flatArrays->labels += edge->s;
+			for (wchar_t c: edge->s)
+			{
+				flatArrays->lowerLabels.push_back(towlower(c));
+			}
+			flatEdge.labelEnd = static_cast<uint32_t>(flatArrays->labels.size());
+			flatEdge.target = nextNodeIndex++;
+			flatArrays->edges.push_back(flatEdge);
+
+			nodes.push(edge->target);
+		}
+		flatNode.edgesEnd = static_cast<uint32_t>(flatArrays->edges.size());
+
+		flatArrays->nodes.push_back(flatNode);
+	}
+}
+
+void SearchIndex::searchFlatRecursive(
+	const SearchPath& path,
+	const std::wstring& query,
+	size_t queryPos,
+	const std::vector<FlatGate>& queryGates,
+	NodeTypeSet acceptedNodeTypes,
+	std::vector<SearchIndex::SearchPath>* results) const
+{
+	const FlatNode& node = m_flatArrays.nodes[path.flatNode];
+	for (uint32_t edgeIndex = node.edgesBegin; edgeIndex < node.edgesEnd; edgeIndex++)
+	{
+		const FlatEdge& edge = m_flatArrays.edges[edgeIndex];
+
+		if (!acceptedNodeTypes.intersectsWith(m_flatArrays.nodes[edge.target].containedTypes) ||
+			!edge.gate.contains(queryGates[queryPos]))
+		{
+			continue;
+		}
+
+		size_t j = queryPos;
+		SearchPath currentPath = followFlatEdge(path, edge, query, &j);
+
+		if (j == query.size())
+		{
+			results->push_back(std::move(currentPath));
+		}
+		else
+		{
+			searchFlatRecursive(currentPath, query, j, queryGates, acceptedNodeTypes, results);
+		}
+	}
+}
+
+bool SearchIndex::searchFlat(
+	std::vector<FlatSearchItem> items,
+	const std::wstring& query,
+	const std::vector<FlatGate>& queryGates,
+	NodeTypeSet acceptedNodeTypes,
+	size_t maxResultCount,
+	size_t threadCount,
+	const std::function<bool()>& isCancelled,
+	std::vector<SearchPath>* paths,
+	std::multiset<SearchResult>* searchResults) const
+{
+	// expands the search level by level until there are enough subtrees to share between the
+	// threads and to check for cancellation in between, a single root edge would keep all work on
+	// one thread if all names share a prefix
+	bool expanded = true;
+	while (expanded && items.size() < threadCount * 16)
+	{
+		expanded = false;
+		std::vector<FlatSearchItem> nextItems;
+		for (FlatSearchItem& item: items)
+		{
+			if (item.queryPos == query.size())
+			{
+				nextItems.push_back(std::move(item));
+				continue;
+			}
+
+			const FlatNode& node = m_flatArrays.nodes[item.path.flatNode];
+			for (uint32_t edgeIndex = node.edgesBegin; edgeIndex < node.edgesEnd; edgeIndex++)
+			{
+				const FlatEdge& edge = m_flatArrays.edges[edgeIndex];
+				if (acceptedNodeTypes.intersectsWith(
+						m_flatArrays.nodes[edge.target].containedTypes) &&
+					edge.gate.contains(queryGates[item.queryPos]))
+				{
+					size_t queryPos = item.queryPos;
+					SearchPath childPath = followFlatEdge(item.path, edge, query, &queryPos);
+					nextItems.push_back({std::move(childPath), queryPos});
+				}
+			}
+			expanded = true;
+		}
+		items = std::move(nextItems);
+	}
+
+	std::vector<size_t> itemIndices;
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		itemIndices.push_back(i);
+	}
+
+	// each shard keeps the results of its best scored paths, the items are in the order of the
+	// sequential search, so the shards are merged by path score and item index
+	const std::vector<std::vector<size_t>> shardItemIndices = utility::splitToEqualySizedParts(
+		itemIndices, threadCount);
+	std::vector<std::vector<SearchPath>> shardPaths(shardItemIndices.size());
+	std::vector<std::vector<PathResult>> shardResults(shardItemIndices.size());
+	std::vector<std::pair<size_t, size_t>> itemPathRanges(items.size());
+
+	auto searchShard = [&](size_t shard) {
+		std::vector<SearchPath>& currentPaths = shardPaths[shard];
+		std::vector<size_t> pathItemIndices;
+		for (size_t itemIndex: shardItemIndices[shard])
+		{
+			if (isCancelled && isCancelled())
+			{
+				return;
+			}
+
+			const FlatSearchItem& item = items[itemIndex];
+			const size_t pathsBegin = currentPaths.size();
+			if (item.queryPos == query.size())
+			{
+				currentPaths.push_back(item.path);
+			}
+			else
+			{
+				searchFlatRecursive(
+					item.path, query, item.queryPos, queryGates, acceptedNodeTypes, &currentPaths);
+			}
+			pathItemIndices.resize(currentPaths.size(), itemIndex);
+			itemPathRanges[itemIndex] = std::make_pair(pathsBegin, currentPaths.size());
+		}
+
+		shardResults[shard] = createScoredResults(currentPaths, acceptedNodeTypes, maxResultCount);
+		for (PathResult& pathResult: shardResults[shard])
+		{
+			pathResult.pathIndex = pathItemIndices[pathResult.pathIndex];
+		}
+	};
+
+	if (shardItemIndices.size() == 1)
+	{
+		searchShard(0);
+	}
+	else
+	{
+		std::vector<std::shared_ptr<std::thread>> threads;
+		for (size_t i = 0; i < shardItemIndices.size(); i++)
+		{
+			threads.push_back(std::make_shared<std::thread>(searchShard, i));
+		}
+
+		for (std::shared_ptr<std::thread> thread: threads)
+		{
+			thread->join();
+		}
+	}
+
+	if (isCancelled && isCancelled())
+	{
+		return false;
+	}
+
+	std::vector<size_t> positions(shardResults.size(), 0);
+	while (!maxResultCount || searchResults->size() < maxResultCount)
+	{
+		const PathResult* nextResult = nullptr;
+		size_t nextShard = 0;
+		for (size_t i = 0; i < shardResults.size(); i++)
+		{
+			if (positions[i] == shardResults[i].size())
+			{
+				continue;
+			}
+
+			const PathResult& pathResult = shardResults[i][positions[i]];
+			if (!nextResult || pathResult.pathScore > nextResult->pathScore ||
+				(pathResult.pathScore == nextResult->pathScore &&
+				 pathResult.pathIndex < nextResult->pathIndex))
+			{
+				nextResult = &pathResult;
+				nextShard = i;
+			}
+		}
+
+		if (!nextResult)
+		{
+			break;
+		}
+
+		positions[nextShard]++;
+		searchResults->insert(nextResult->result);
+	}
+
+	if (paths)
+	{
+		for (size_t shard = 0; shard < shardItemIndices.size(); shard++)
+		{
+			for (size_t itemIndex: shardItemIndices[shard])
+			{
+				itemIndices[itemIndex] = shard;
+			}
+		}
+
+		// puts the paths back into the order of the items
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			std::vector<SearchPath>& currentPaths = shardPaths[itemIndices[i]];
+			std::move(
+				currentPaths.begin() + itemPathRanges[i].first,
+				currentPaths.begin() + itemPathRanges[i].second,
+				std::back_inserter(*paths));
+		}
+	}
+
+	return true;
+}
+
+SearchIndex::FlatSearchItem SearchIndex::continueFlatPath(
+	const SearchPath& path, const std::wstring& query) const
+{
+	// the last query was completed on the last edge of the path, so the rest of the query is
+	// matched against the remaining characters of that edge first
+	FlatSearchItem item {path, path.indices.size()};
+	for (size_t i = path.indices.back() + 1; i < path.text.size() && item.queryPos < query.size();
+		 i++)
+	{
+		if (static_cast<wchar_t>(towlower(path.text[i])) == query[item.queryPos])
+		{
+			item.path.indices.push_back(i);
+			item.queryPos++;
+		}
+	}
+	return item;
+}
+
+SearchIndex::SearchPath SearchIndex::followFlatEdge(
+	const SearchPath& path, const FlatEdge& edge, const std::wstring& query, size_t* queryPos) const
+{
+	// consume characters for edge
+	SearchPath currentPath {path.text, path.indices, nullptr, edge.target};
+	currentPath.text.append(m_flatArrays.labels, edge.labelBegin, edge.labelEnd - edge.labelBegin);
+
+	size_t j = *queryPos;
+	for (uint32_t i = edge.labelBegin; i < edge.labelEnd && j < query.size(); i++)
+	{
+		if (m_flatArrays.lowerLabels[i] == query[j])
+		{
+			currentPath.indices.push_back(path.text.size() + i - edge.labelBegin);
+			j++;
+		}
+	}
+
+	*queryPos = j;
+	return currentPath;
+}
+
 void SearchIndex::searchRecursive(
 	const SearchPath& path,
 	const std::wstring& remainingQuery,
@@ -192,7 +671,7 @@ void SearchIndex::searchRecursive(
 
 		// consume characters for edge
 		const std::wstring& edgeString = currentEdge->s;
-		SearchPath currentPath {path.text + edgeString, path.indices, currentEdge->target};
+		SearchPath currentPath {path.text + edgeString, path.indices, currentEdge->target, 0};
 
 		size_t j = 0;
 		for (size_t i = 0; i < edgeString.size() && j < remainingQuery.size(); i++)
@@ -215,22 +694,41 @@ void SearchIndex::searchRecursive(
 	}
 }
 
-std::multiset<SearchResult> SearchIndex::createScoredResults(
+std::vector<SearchIndex::PathResult> SearchIndex::createScoredResults(
 	const std::vector<SearchPath>& paths, NodeTypeSet acceptedNodeTypes, size_t maxResultCount) const
 {
-	// score and order initial paths
-	std::multimap<int, SearchPath, std::greater<int>> scoredPaths;
-	for (const SearchPath& path: paths)
+	// score initial paths, orders positions to not copy the paths
+	std::vector<std::pair<int, size_t>> scoredPaths;
+	scoredPaths.reserve(paths.size());
+	for (size_t i = 0; i < paths.size(); i++)
 	{
-		scoredPaths.emplace(scoreText(path.text, path.indices), path);
+		scoredPaths.emplace_back(scoreText(paths[i].text, paths[i].indices), i);
 	}
 
+	// each path has at least one result below it unless nodes were removed, so only the next best
+	// scored maxResultCount paths are ordered at a time
+	const size_t orderedCount = maxResultCount ? maxResultCount : scoredPaths.size();
+	size_t orderedEnd = 0;
+
 	// score paths and subpaths
-	std::multiset<SearchResult> searchResults;
-	for (const std::pair<int, SearchPath>& p: scoredPaths)
+	std::vector<PathResult> searchResults;
+	for (size_t i = 0; i < scoredPaths.size(); i++)
 	{
+		if (i == orderedEnd)
+		{
+			orderedEnd = std::min(scoredPaths.size(), orderedEnd + orderedCount);
+			std::partial_sort(
+				scoredPaths.begin() + i,
+				scoredPaths.begin() + orderedEnd,
+				scoredPaths.end(),
+				[](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) {
+					return a.first > b.first || (a.first == b.first && a.second < b.second);
+				});
+		}
+
+		const std::pair<int, size_t>& p = scoredPaths[i];
 		std::vector<SearchPath> currentPaths;
-		currentPaths.push_back(p.second);
+		currentPaths.push_back(paths[p.second]);
 
 		while (!currentPaths.empty())
 		{
@@ -238,38 +736,25 @@ std::multiset<SearchResult> SearchIndex::createScoredResults(
 
 			for (const SearchPath& path: currentPaths)
 			{
-				if (!path.node->elementIds.empty() &&
-					(acceptedNodeTypes.intersectsWith(path.node->containedTypes)))
+				std::vector<Id> elementIds = getAcceptedElementIds(path, acceptedNodeTypes);
+				if (!elementIds.empty())
 				{
-					std::vector<Id> elementIds;
-					for (const auto& p: path.node->elementIds)
-					{
-						if (acceptedNodeTypes.contains(p.second))
-						{
-							elementIds.push_back(p.first);
-						}
-					}
-
-					if (!elementIds.empty())
+					searchResults.push_back(
+						{p.first,
+						 p.second,
+						 SearchResult(
+							 path.text,
+							 std::move(elementIds),
+							 path.indices,
+							 scoreText(path.text, path.indices))});
+
+					if (maxResultCount && searchResults.size() >= maxResultCount)
 					{
-						searchResults.emplace(
-							path.text,
-							std::move(elementIds),
-							path.indices,
-							scoreText(path.text, path.indices));
-
-						if (maxResultCount && searchResults.size() >= maxResultCount)
-						{
-							return searchResults;
-						}
+						return searchResults;
 					}
 				}
 
-				for (auto p: path.node->edges)
-				{
-					const SearchEdge* edge = p.second;
-					nextPaths.emplace_back(path.text + edge->s, path.indices, edge->target);
-				}
+				addChildPaths(path, &nextPaths);
 			}
 
 			currentPaths = std::move(nextPaths);
@@ -279,6 +764,63 @@ std::multiset<SearchResult> SearchIndex::createScoredResults(
 	return searchResults;
 }
 
+std::vector<Id> SearchIndex::getAcceptedElementIds(
+	const SearchPath& path, NodeTypeSet acceptedNodeTypes) const
+{
+	std::vector<Id> elementIds;
+	if (m_flattened)
+	{
+		const FlatNode& node = m_flatArrays.nodes[path.flatNode];
+		if (node.elementsBegin != node.elementsEnd &&
+			acceptedNodeTypes.intersectsWith(node.containedTypes))
+		{
+			for (uint32_t i = node.elementsBegin; i < node.elementsEnd; i++)
+			{
+				if (acceptedNodeTypes.contains(m_flatArrays.elements[i].second))
+				{
+					elementIds.push_back(m_flatArrays.elements[i].first);
+				}
+			}
+		}
+	}
+	else if (
+		!path.node->elementIds.empty() &&
+		acceptedNodeTypes.intersectsWith(path.node->containedTypes))
+	{
+		for (const auto& p: path.node->elementIds)
+		{
+			if (acceptedNodeTypes.contains(p.second))
+			{
+				elementIds.push_back(p.first);
+			}
+		}
+	}
+	return elementIds;
+}
+
+void SearchIndex::addChildPaths(const SearchPath& path, std::vector<SearchPath>* paths) const
+{
+	if (m_flattened)
+	{
+		const FlatNode& node = m_flatArrays.nodes[path.flatNode];
+		for (uint32_t i = node.edgesBegin; i < node.edgesEnd; i++)
+		{
+			const FlatEdge& edge = m_flatArrays.edges[i];
+			paths->emplace_back(path.text, path.indices, nullptr, edge.target);
+			paths->back().text.append(
+				m_flatArrays.labels, edge.labelBegin, edge.labelEnd - edge.labelBegin);
+		}
+	}
+	else
+	{
+		for (auto p: path.node->edges)
+		{
+			const SearchEdge* edge = p.second;
+			paths->emplace_back(path.text + edge->s, path.indices, edge->target, 0);
+		}
+	}
+}
+
 SearchResult SearchIndex::bestScoredResult(
 	SearchResult result,
 	std::map<std::wstring, SearchResult>* scoresCache,
@@ -547,6 +1089,46 @@ SearchResult SearchIndex::rescoreText(
 	return result;
 }
 
+void SearchIndex::FlatGate::add(wchar_t c)
+{
+	size_t bit = static_cast<size_t>(c);
+	if (bit >= 192)
+	{
+		bit = 192 + bit % 64;
+	}
+	bits[bit / 64] |= uint64_t(1) << (bit % 64);
+}
+
+bool SearchIndex::FlatGate::contains(const FlatGate& other) const
+{
+	// checks all words without branching, so the check can be vectorized
+	return ((other.bits[0] & ~bits[0]) | (other.bits[1] & ~bits[1]) | (other.bits[2] & ~bits[2]) |
+			(other.bits[3] & ~bits[3])) == 0;
+}
+
+void SearchIndex::FlatArrays::clear()
+{
+	nodes.clear();
+	edges.clear();
+	labels.clear();
+	lowerLabels.clear();
+	elements.clear();
+}
+
+SearchIndex::SearchSession::SearchSession()
+{
+	clear();
+}
+
+void SearchIndex::SearchSession::clear()
+{
+	m_index = nullptr;
+	m_revision = 0;
+	m_lowerQuery.clear();
+	m_acceptedNodeTypes = NodeTypeSet();
+	m_paths.clear();
+}
+
 bool SearchIndex::isNoLetter(const wchar_t c)
 {
 	switch (c)
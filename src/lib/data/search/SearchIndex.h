@@ -1,9 +1,14 @@
 #ifndef SEARCH_INDEX_H
 #define SEARCH_INDEX_H
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -36,19 +41,43 @@ struct SearchResult
 class SearchIndex
 {
 public:
-	SearchIndex();
+	class SearchSession;
+
+	// an index without flattening is always searched in the trie, e.g. to compare both searches
+	explicit SearchIndex(bool flatteningEnabled = true);
 	virtual ~SearchIndex();
 
+	// nodes added after finishSetup() are searchable right away, searches use the trie until the
+	// flat arrays are packed again by repack()
 	void addNode(Id id, std::wstring name, NodeType type = NodeType(NODE_SYMBOL));
+	// populates the gates of the trie and packs it into flat arrays, which are used for searching
 	void finishSetup();
 	void clear();
 
-	// maxResultCount == 0 means "no restriction".
+	// name needs to be the one used for adding the node, returns false if it was not found
+	bool removeNode(Id id, const std::wstring& name);
+
+	// packs the changed trie into new flat arrays and swaps them in once they are complete. Other
+	// threads can search the trie meanwhile, but the trie must not be changed during the repack.
+	void repack();
+
+	// true if the flat arrays are up to date, false if the trie was changed since they were packed
+	bool isFlattened() const;
+
+	// maxResultCount == 0 means "no restriction". The session is used and updated if passed.
+	// isCancelled is checked while searching, also from several threads at once, and a cancelled
+	// search returns no results. Searches can run on several threads at once, but not while the
+	// index is changed. onFoundResults receives all found results ordered by their first score,
+	// before they are rescored for the best indices, which takes most of the time of short queries.
 	std::vector<SearchResult> search(
 		const std::wstring& query,
 		NodeTypeSet acceptedNodeTypes,
 		size_t maxResultCount,
-		size_t maxBestScoredResultsLength = 0) const;
+		size_t maxBestScoredResultsLength = 0,
+		SearchSession* session = nullptr,
+		const std::function<bool()>& isCancelled = std::function<bool()>(),
+		const std::function<void(const std::multiset<SearchResult>&)>& onFoundResults =
+			std::function<void(const std::multiset<SearchResult>&)>()) const;
 
 private:
 	struct SearchEdge;
@@ -71,26 +100,143 @@ private:
 		std::set<wchar_t> gate;
 	};
 
+	// bitmap of the lower case characters below an edge, characters outside of the first 192 code
+	// points share the bits of the last quarter, which only lets more edges pass
+	struct FlatGate
+	{
+		FlatGate(): bits {0, 0, 0, 0} {}
+
+		void add(wchar_t c);
+		bool contains(const FlatGate& other) const;
+
+		uint64_t bits[4];
+	};
+
+	struct FlatNode
+	{
+		uint32_t edgesBegin;
+		uint32_t edgesEnd;
+		uint32_t elementsBegin;
+		uint32_t elementsEnd;
+		NodeTypeSet containedTypes;
+	};
+
+	struct FlatEdge
+	{
+		FlatGate gate;
+		uint32_t labelBegin;
+		uint32_t labelEnd;
+		uint32_t target;
+	};
+
+	struct FlatArrays
+	{
+		void clear();
+
+		std::vector<FlatNode> nodes;
+		std::vector<FlatEdge> edges;
+		std::wstring labels;
+		std::wstring lowerLabels;
+		std::vector<std::pair<Id, NodeType>> elements;
+	};
+
+	// node is used for the trie and flatNode for the flat arrays
 	struct SearchPath
 	{
-		SearchPath(std::wstring text, std::vector<size_t> indices, SearchNode* node)
-			: text(std::move(text)), indices(std::move(indices)), node(node)
+		SearchPath(
+			std::wstring text, std::vector<size_t> indices, SearchNode* node, uint32_t flatNode)
+			: text(std::move(text)), indices(std::move(indices)), node(node), flatNode(flatNode)
 		{
 		}
 
 		std::wstring text;
 		std::vector<size_t> indices;
 		SearchNode* node;
+		uint32_t flatNode;
+	};
+
+	// path of the flat search that either matches the whole query or still needs to be searched
+	// below its node, starting at queryPos
+	struct FlatSearchItem
+	{
+		SearchPath path;
+		size_t queryPos;
 	};
 
+	// result in the order it was created in, together with the score and index of the path it was
+	// found below
+	struct PathResult
+	{
+		int pathScore;
+		size_t pathIndex;
+		SearchResult result;
+	};
+
+	// indices with more nodes are searched in parallel, below that starting threads costs more
+	// than it saves
+	static const size_t s_minParallelSearchNodeCount = 20000;
+	// sessions don't keep more paths, which only happens for the first characters of a query
+	static const size_t s_maxSessionPathCount = 100000;
+
+public:
+	// keeps the paths found in the flat arrays for the last query of a session, a query extending
+	// that query can only match below these paths, which is the case for each typed character
+	class SearchSession
+	{
+	public:
+		SearchSession();
+		void clear();
+
+	private:
+		friend class SearchIndex;
+
+		const SearchIndex* m_index;
+		size_t m_revision;
+		std::wstring m_lowerQuery;
+		NodeTypeSet m_acceptedNodeTypes;
+		std::vector<SearchPath> m_paths;
+	};
+
+private:
 	void populateEdgeGate(SearchEdge* e);
+	// only reads the trie, so it can run while the index is searched
+	void pack(FlatArrays* flatArrays) const;
+
 	void searchRecursive(
 		const SearchPath& path,
 		const std::wstring& remainingQuery,
 		NodeTypeSet acceptedNodeTypes,
 		std::vector<SearchIndex::SearchPath>* results) const;
+	void searchFlatRecursive(
+		const SearchPath& path,
+		const std::wstring& query,
+		size_t queryPos,
+		const std::vector<FlatGate>& queryGates,
+		NodeTypeSet acceptedNodeTypes,
+		std::vector<SearchIndex::SearchPath>* results) const;
+	// returns false if the search was cancelled, paths receives all found paths if passed
+	bool searchFlat(
+		std::vector<FlatSearchItem> items,
+		const std::wstring& query,
+		const std::vector<FlatGate>& queryGates,
+		NodeTypeSet acceptedNodeTypes,
+		size_t maxResultCount,
+		size_t threadCount,
+		const std::function<bool()>& isCancelled,
+		std::vector<SearchPath>* paths,
+		std::multiset<SearchResult>* searchResults) const;
+	FlatSearchItem continueFlatPath(const SearchPath& path, const std::wstring& query) const;
+	SearchPath followFlatEdge(
+		const SearchPath& path,
+		const FlatEdge& edge,
+		const std::wstring& query,
+		size_t* queryPos) const;
 
-	std::multiset<SearchResult> createScoredResults(
+	std::vector<Id> getAcceptedElementIds(
+		const SearchPath& path, NodeTypeSet acceptedNodeTypes) const;
+	void addChildPaths(const SearchPath& path, std::vector<SearchPath>* paths) const;
+
+	std::vector<PathResult> createScoredResults(
 		const std::vector<SearchPath>& paths,
 		NodeTypeSet acceptedNodeTypes,
 		size_t maxResultCount) const;
@@ -122,6 +268,17 @@ private:
 	std::vector<std::unique_ptr<SearchNode>> m_nodes;
 	std::vector<std::unique_ptr<SearchEdge>> m_edges;
 	SearchNode* m_root;
+	bool m_setupFinished;
+	// changes with each change of the trie or the flat arrays, so sessions of older states are
+	// not continued
+	size_t m_revision;
+
+	// the flat arrays are packed by finishSetup() and repack(), searches hold the mutex shared, so
+	// the repacked arrays are only swapped in once no search uses the previous ones
+	const bool m_flatteningEnabled;
+	std::atomic<bool> m_flattened;
+	mutable std::shared_timed_mutex m_flatArraysMutex;
+	FlatArrays m_flatArrays;
 };
 
 #endif	  // SEARCH_INDEX_H
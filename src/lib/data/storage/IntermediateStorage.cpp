@@ -1,9 +1,43 @@
 #include "IntermediateStorage.h"
 
+#include <functional>
+
 #include "LocationType.h"
 #include "utility.h"
 
-IntermediateStorage::IntermediateStorage(): m_nextId(1) {}
+namespace
+{
+size_t getIdHash(Id id)
+{
+	return std::hash<Id>()(id);
+}
+
+size_t getNodeHash(const StorageNodeData& nodeData)
+{
+	return std::hash<std::string>()(nodeData.serializedName);
+}
+
+size_t getFileHash(const StorageFile& file)
+{
+	return std::hash<std::string>()(file.filePath);
+}
+
+size_t getEdgeHash(const StorageEdgeData& edgeData)
+{
+	size_t hash = std::hash<int>()(edgeData.type);
+	hash = HashIndex::combineHashes(hash, getIdHash(edgeData.sourceNodeId));
+	return HashIndex::combineHashes(hash, getIdHash(edgeData.targetNodeId));
+}
+
+size_t getErrorHash(const StorageErrorData& errorData)
+{
+	size_t hash = std::hash<std::wstring>()(errorData.message);
+	hash = HashIndex::combineHashes(hash, std::hash<std::wstring>()(errorData.translationUnit));
+	return HashIndex::combineHashes(hash, (errorData.fatal ? 2 : 0) + (errorData.indexed ? 1 : 0));
+}
+}	 // namespace
+
+IntermediateStorage::IntermediateStorage(): m_nextId(1), m_indexingDuration(0.0f) {}
 
 void IntermediateStorage::clear()
 {
@@ -29,6 +63,7 @@ void IntermediateStorage::clear()
 	m_errors.clear();
 
 	m_nextId = 1;
+	m_indexingDuration = 0.0f;
 }
 
 size_t IntermediateStorage::getByteSize(size_t stringSize) const
@@ -75,6 +110,13 @@ size_t IntermediateStorage::getSourceLocationCount() const
 	return m_sourceLocations.size();
 }
 
+size_t IntermediateStorage::getElementCount() const
+{
+	return m_nodes.size() + m_files.size() + m_symbols.size() + m_edges.size() +
+		m_localSymbols.size() + m_sourceLocations.size() + m_occurrences.size() +
+		m_componentAccesses.size() + m_elementComponents.size() + m_errors.size();
+}
+
 bool IntermediateStorage::hasFatalErrors() const
 {
 	for (const StorageErrorData& error: m_errors)
@@ -118,10 +160,10 @@ void IntermediateStorage::setFilesWithErrorsIncomplete()
 
 std::pair<Id, bool> IntermediateStorage::addNode(const StorageNodeData& nodeData)
 {
-	auto it = m_nodesIndex.find(nodeData);
-	if (it != m_nodesIndex.end())
+	const size_t position = findNode(nodeData);
+	if (position != HashIndex::s_noPosition)
 	{
-		StorageNode& storedNode = m_nodes[it->second];
+		StorageNode& storedNode = m_nodes[position];
 		if (storedNode.type < nodeData.type)
 		{
 			storedNode.type = nodeData.type;
@@ -131,13 +173,16 @@ std::pair<Id, bool> IntermediateStorage::addNode(const StorageNodeData& nodeData
 
 	Id nodeId = m_nextId++;
 	m_nodes.emplace_back(nodeId, nodeData);
-	m_nodesIndex.emplace(nodeData, m_nodes.size() - 1);
-	m_nodeIdIndex.emplace(nodeId, m_nodes.size() - 1);
+	m_nodesIndex.insert(getNodeHash(nodeData), m_nodes.size() - 1);
+	m_nodeIdIndex.insert(getIdHash(nodeId), m_nodes.size() - 1);
 	return std::make_pair(nodeId, true);
 }
 
 std::vector<Id> IntermediateStorage::addNodes(const std::vector<StorageNode>& nodes)
 {
+	m_nodesIndex.reserve(m_nodes.size() + nodes.size());
+	m_nodeIdIndex.reserve(m_nodes.size() + nodes.size());
+
 	std::vector<Id> nodeIds;
 	nodeIds.reserve(nodes.size());
 	for (const StorageNode& node: nodes)
@@ -149,10 +194,11 @@ std::vector<Id> IntermediateStorage::addNodes(const std::vector<StorageNode>& no
 
 void IntermediateStorage::setNodeType(Id nodeId, int nodeType)
 {
-	auto it = m_nodeIdIndex.find(nodeId);
-	if (it != m_nodeIdIndex.end() && m_nodes[it->second].type < nodeType)
+	const size_t position = m_nodeIdIndex.find(
+		getIdHash(nodeId), [this, nodeId](size_t i) { return m_nodes[i].id == nodeId; });
+	if (position != HashIndex::s_noPosition && m_nodes[position].type < nodeType)
 	{
-		m_nodes[it->second].type = nodeType;
+		m_nodes[position].type = nodeType;
 	}
 }
 
@@ -168,10 +214,10 @@ void IntermediateStorage::addSymbols(const std::vector<StorageSymbol>& symbols)
 
 void IntermediateStorage::addFile(const StorageFile& file)
 {
-	auto it = m_filesIndex.find(file);
-	if (it != m_filesIndex.end())
+	const size_t position = findFile(file);
+	if (position != HashIndex::s_noPosition)
 	{
-		StorageFile& storedFile = m_files[it->second];
+		StorageFile& storedFile = m_files[position];
 
 		if (file.indexed)
 		{
@@ -190,37 +236,40 @@ void IntermediateStorage::addFile(const StorageFile& file)
 	}
 	else
 	{
-		m_filesIndex.emplace(file, m_files.size());
-		m_filesIdIndex.emplace(file.id, m_files.size());
+		m_filesIndex.insert(getFileHash(file), m_files.size());
+		m_filesIdIndex.insert(getIdHash(file.id), m_files.size());
 		m_files.emplace_back(file);
 	}
 }
 
 void IntermediateStorage::setFileLanguage(Id fileId, const std::wstring& languageIdentifier)
 {
-	auto it = m_filesIdIndex.find(fileId);
-	if (it != m_filesIdIndex.end())
+	const size_t position = m_filesIdIndex.find(
+		getIdHash(fileId), [this, fileId](size_t i) { return m_files[i].id == fileId; });
+	if (position != HashIndex::s_noPosition)
 	{
-		m_files[it->second].languageIdentifier = languageIdentifier;
+		m_files[position].languageIdentifier = languageIdentifier;
 	}
 }
 
 Id IntermediateStorage::addEdge(const StorageEdgeData& edgeData)
 {
-	auto it = m_edgesIndex.find(edgeData);
-	if (it != m_edgesIndex.end())
+	const size_t position = findEdge(edgeData);
+	if (position != HashIndex::s_noPosition)
 	{
-		return m_edges[it->second].id;
+		return m_edges[position].id;
 	}
 
 	Id edgeId = m_nextId++;
 	m_edges.emplace_back(edgeId, edgeData);
-	m_edgesIndex.emplace(edgeData, m_edges.size() - 1);
+	m_edgesIndex.insert(getEdgeHash(edgeData), m_edges.size() - 1);
 	return edgeId;
 }
 
 std::vector<Id> IntermediateStorage::addEdges(const std::vector<StorageEdge>& edges)
 {
+	m_edgesIndex.reserve(m_edges.size() + edges.size());
+
 	std::vector<Id> edgeIds;
 	edgeIds.reserve(edges.size());
 	for (const StorageEdge& edge: edges)
@@ -310,15 +359,15 @@ void IntermediateStorage::addElementComponents(const std::vector<StorageElementC
 
 Id IntermediateStorage::addError(const StorageErrorData& errorData)
 {
-	auto it = m_errorsIndex.find(errorData);
-	if (it != m_errorsIndex.end())
+	const size_t position = findError(errorData);
+	if (position != HashIndex::s_noPosition)
 	{
-		return m_errors[it->second].id;
+		return m_errors[position].id;
 	}
 
 	Id errorId = m_nextId++;
 	m_errors.emplace_back(errorId, errorData);
-	m_errorsIndex.emplace(errorData, m_errors.size() - 1);
+	m_errorsIndex.insert(getErrorHash(errorData), m_errors.size() - 1);
 	return errorId;
 }
 
@@ -378,10 +427,12 @@ void IntermediateStorage::setStorageNodes(std::vector<StorageNode> storageNodes)
 
 	m_nodesIndex.clear();
 	m_nodeIdIndex.clear();
+	m_nodesIndex.reserve(m_nodes.size());
+	m_nodeIdIndex.reserve(m_nodes.size());
 	for (size_t i = 0; i < m_nodes.size(); i++)
 	{
-		m_nodesIndex.emplace(m_nodes[i], i);
-		m_nodeIdIndex.emplace(m_nodes[i].id, i);
+		m_nodesIndex.insert(getNodeHash(m_nodes[i]), i);
+		m_nodeIdIndex.insert(getIdHash(m_nodes[i].id), i);
 	}
 }
 
@@ -391,10 +442,12 @@ void IntermediateStorage::setStorageFiles(std::vector<StorageFile> storageFiles)
 
 	m_filesIndex.clear();
 	m_filesIdIndex.clear();
+	m_filesIndex.reserve(m_files.size());
+	m_filesIdIndex.reserve(m_files.size());
 	for (size_t i = 0; i < m_files.size(); i++)
 	{
-		m_filesIndex.emplace(m_files[i], i);
-		m_filesIdIndex.emplace(m_files[i].id, i);
+		m_filesIndex.insert(getFileHash(m_files[i]), i);
+		m_filesIdIndex.insert(getIdHash(m_files[i].id), i);
 	}
 }
 
@@ -408,9 +461,10 @@ void IntermediateStorage::setStorageEdges(std::vector<StorageEdge> storageEdges)
 	m_edges = std::move(storageEdges);
 
 	m_edgesIndex.clear();
+	m_edgesIndex.reserve(m_edges.size());
 	for (size_t i = 0; i < m_edges.size(); i++)
 	{
-		m_edgesIndex.emplace(m_edges[i], i);
+		m_edgesIndex.insert(getEdgeHash(m_edges[i]), i);
 	}
 }
 
@@ -444,9 +498,10 @@ void IntermediateStorage::setErrors(std::vector<StorageError> errors)
 	m_errors = std::move(errors);
 
 	m_errorsIndex.clear();
+	m_errorsIndex.reserve(m_errors.size());
 	for (size_t i = 0; i < m_errors.size(); i++)
 	{
-		m_errorsIndex.emplace(m_errors[i], i);
+		m_errorsIndex.insert(getErrorHash(m_errors[i]), i);
 	}
 }
 
@@ -459,3 +514,45 @@ void IntermediateStorage::setNextId(const Id nextId)
 {
 	m_nextId = nextId;
 }
+
+float IntermediateStorage::getIndexingDuration() const
+{
+	return m_indexingDuration;
+}
+
+void IntermediateStorage::setIndexingDuration(float indexingDuration)
+{
+	m_indexingDuration = indexingDuration;
+}
+
+size_t IntermediateStorage::findNode(const StorageNodeData& nodeData) const
+{
+	return m_nodesIndex.find(getNodeHash(nodeData), [this, &nodeData](size_t i) {
+		return m_nodes[i].serializedName == nodeData.serializedName;
+	});
+}
+
+size_t IntermediateStorage::findFile(const StorageFile& file) const
+{
+	return m_filesIndex.find(
+		getFileHash(file), [this, &file](size_t i) { return m_files[i].filePath == file.filePath; });
+}
+
+size_t IntermediateStorage::findEdge(const StorageEdgeData& edgeData) const
+{
+	return m_edgesIndex.find(getEdgeHash(edgeData), [this, &edgeData](size_t i) {
+		const StorageEdge& edge = m_edges[i];
+		return edge.type == edgeData.type && edge.sourceNodeId == edgeData.sourceNodeId &&
+			edge.targetNodeId == edgeData.targetNodeId;
+	});
+}
+
+size_t IntermediateStorage::findError(const StorageErrorData& errorData) const
+{
+	return m_errorsIndex.find(getErrorHash(errorData), [this, &errorData](size_t i) {
+		const StorageError& error = m_errors[i];
+		return error.message == errorData.message &&
+			error.translationUnit == errorData.translationUnit && error.fatal == errorData.fatal &&
+			error.indexed == errorData.indexed;
+	});
+}
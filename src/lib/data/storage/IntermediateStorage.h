@@ -5,8 +5,11 @@
 #include <memory>
 #include <set>
 
+#include "HashIndex.h"
 #include "Storage.h"
 
+// Collects the data of indexed files until it is injected into the persistent storage. Nodes,
+// files, edges and errors are kept in vectors and deduplicated through hash indices on them.
 class IntermediateStorage: public Storage
 {
 public:
@@ -16,6 +19,7 @@ public:
 
 	size_t getByteSize(size_t stringSize) const;
 	size_t getSourceLocationCount() const;
+	size_t getElementCount() const;
 
 	bool hasFatalErrors() const;
 	void setAllFilesIncomplete();
@@ -67,18 +71,27 @@ public:
 	Id getNextId() const;
 	void setNextId(const Id nextId);
 
+	// wall time the indexer spent on producing this storage, used for indexing statistics
+	float getIndexingDuration() const;
+	void setIndexingDuration(float indexingDuration);
+
 private:
-	std::map<StorageNodeData, size_t> m_nodesIndex;
-	std::map<Id, size_t> m_nodeIdIndex;
+	size_t findNode(const StorageNodeData& nodeData) const;
+	size_t findFile(const StorageFile& file) const;
+	size_t findEdge(const StorageEdgeData& edgeData) const;
+	size_t findError(const StorageErrorData& errorData) const;
+
+	HashIndex m_nodesIndex;	   // by serialized name
+	HashIndex m_nodeIdIndex;
 	std::vector<StorageNode> m_nodes;
 
-	std::map<StorageFile, size_t> m_filesIndex;	   // this is used to prevent duplicates (unique)
-	std::map<Id, size_t> m_filesIdIndex;
+	HashIndex m_filesIndex;	   // by file path, this is used to prevent duplicates (unique)
+	HashIndex m_filesIdIndex;
 	std::vector<StorageFile> m_files;
 
 	std::vector<StorageSymbol> m_symbols;
 
-	std::map<StorageEdgeData, size_t> m_edgesIndex;
+	HashIndex m_edgesIndex;
 	std::vector<StorageEdge> m_edges;
 
 	std::set<StorageLocalSymbol> m_localSymbols;
@@ -90,10 +103,11 @@ private:
 	std::set<StorageComponentAccess> m_componentAccesses;
 	std::set<StorageElementComponent> m_elementComponents;
 
-	std::map<StorageErrorData, size_t> m_errorsIndex;	 // this is used to prevent duplicates (unique)
+	HashIndex m_errorsIndex;	// this is used to prevent duplicates (unique)
 	std::vector<StorageError> m_errors;
 
 	Id m_nextId;
+	float m_indexingDuration;
 };
 
 #endif	  // INTERMEDIATE_STORAGE_H
@@ -1,7 +1,10 @@
 #include "PersistentStorage.h"
 
+#include <algorithm>
+#include <iterator>
 #include <queue>
 #include <sstream>
+#include <unordered_set>
 
 #include "AccessKind.h"
 #include "ApplicationSettings.h"
@@ -29,6 +32,79 @@
 #include "utility.h"
 #include "utilityApp.h"
 
+namespace
+{
+std::wstring getSymbolSearchName(const std::string& serializedName, DefinitionKind defKind)
+{
+	const NameHierarchy nameHierarchy = NameHierarchy::deserialize(serializedName);
+
+	// we don't use the signature here, so elements with the same signature share the same node.
+	std::wstring name = nameHierarchy.getQualifiedName();
+
+	// replace template arguments with .. to avoid clutter in search results and have different
+	// template specializations share the same node.
+	if (defKind == DEFINITION_NONE &&
+		nameHierarchy.getDelimiter() == nameDelimiterTypeToString(NAME_DELIMITER_CXX))
+	{
+		name = utility::replaceBetween(name, L'<', L'>', L"..");
+	}
+
+	return name;
+}
+
+// locks the caches shared for reading or exclusively for changing them, public methods call each
+// other, so a thread that already holds the lock of the storage keeps it instead of locking again
+class CacheLock
+{
+public:
+	CacheLock(std::shared_timed_mutex& mutex, bool exclusive)
+		: m_mutex(mutex), m_exclusive(exclusive), m_previousMutex(s_heldMutex)
+	{
+		if (m_previousMutex == &m_mutex)
+		{
+			return;
+		}
+
+		if (m_exclusive)
+		{
+			m_mutex.lock();
+		}
+		else
+		{
+			m_mutex.lock_shared();
+		}
+		s_heldMutex = &m_mutex;
+	}
+
+	~CacheLock()
+	{
+		if (m_previousMutex == &m_mutex)
+		{
+			return;
+		}
+
+		s_heldMutex = m_previousMutex;
+		if (m_exclusive)
+		{
+			m_mutex.unlock();
+		}
+		else
+		{
+			m_mutex.unlock_shared();
+		}
+	}
+
+private:
+	static thread_local const std::shared_timed_mutex* s_heldMutex;
+
+	std::shared_timed_mutex& m_mutex;
+	const bool m_exclusive;
+	const std::shared_timed_mutex* const m_previousMutex;
+};
+
+thread_local const std::shared_timed_mutex* CacheLock::s_heldMutex = nullptr;
+}	 // namespace
+
 PersistentStorage::PersistentStorage(const FilePath& dbPath, const FilePath& bookmarkPath)
 	: m_sqliteIndexStorage(dbPath), m_sqliteBookmarkStorage(bookmarkPath)
 {
@@ -152,17 +228,22 @@ void PersistentStorage::addElementComponents(const std::vector<StorageElementCom
 
 Id PersistentStorage::addError(const StorageErrorData& data)
 {
+	invalidateErrorIndex();
 	return m_sqliteIndexStorage.addError(data).id;
 }
 
 void PersistentStorage::removeElement(const Id id)
 {
 	m_sqliteIndexStorage.removeElement(id);
+	invalidateFileReferenceGraphs();
+	invalidateErrorIndex();
 }
 
 void PersistentStorage::removeElements(const std::vector<Id>& ids)
 {
 	m_sqliteIndexStorage.removeElements(ids);
+	invalidateFileReferenceGraphs();
+	invalidateErrorIndex();
 }
 
 void PersistentStorage::removeOccurrence(const StorageOccurrence& occurrence)
@@ -178,6 +259,8 @@ void PersistentStorage::removeOccurrences(const std::vector<StorageOccurrence>&
 void PersistentStorage::removeElementsWithoutOccurrences(const std::vector<Id>& elementIds)
 {
 	m_sqliteIndexStorage.removeElementsWithoutOccurrences(elementIds);
+	invalidateFileReferenceGraphs();
+	invalidateErrorIndex();
 }
 
 const std::vector<StorageNode>& PersistentStorage::getStorageNodes() const
@@ -249,6 +332,8 @@ void PersistentStorage::startInjection()
 void PersistentStorage::finishInjection()
 {
 	m_sqliteIndexStorage.commitTransaction();
+	invalidateFileReferenceGraphs();
+	invalidateErrorIndex();
 
 	afterErrorRecording();
 }
@@ -256,10 +341,49 @@ void PersistentStorage::finishInjection()
 void PersistentStorage::rollbackInjection()
 {
 	m_sqliteIndexStorage.rollbackTransaction();
+	invalidateErrorIndex();
 
 	afterErrorRecording();
 }
 
+bool PersistentStorage::startInPlaceRefresh()
+{
+	if (!m_sqliteIndexStorage.enableWriteAheadLog())
+	{
+		return false;
+	}
+
+	m_sqliteIndexStorage.startChangeTracking();
+	m_sqliteIndexStorage.beginTransaction();
+	return true;
+}
+
+void PersistentStorage::commitInPlaceRefresh()
+{
+	TRACE();
+
+	m_sqliteIndexStorage.commitTransaction();
+
+	m_sqliteIndexStorage.stopChangeTracking();
+
+	// moves the changes into the database file, so it is complete if copied or replaced later on
+	m_sqliteIndexStorage.checkpointWriteAheadLog();
+}
+
+void PersistentStorage::rollbackInPlaceRefresh()
+{
+	m_sqliteIndexStorage.rollbackTransaction();
+	m_sqliteIndexStorage.stopChangeTracking();
+	m_sqliteIndexStorage.checkpointWriteAheadLog();
+}
+
+StorageChanges PersistentStorage::getInPlaceRefreshChanges() const
+{
+	TRACE();
+
+	return m_sqliteIndexStorage.getTrackedChanges();
+}
+
 void PersistentStorage::beforeErrorRecording()
 {
 	m_preInjectionErrorCount = m_sqliteIndexStorage.getErrorCount();
@@ -273,13 +397,23 @@ void PersistentStorage::beforeErrorRecording()
 
 void PersistentStorage::afterErrorRecording()
 {
-	std::vector<ErrorInfo> errors = m_sqliteIndexStorage.getAllErrorInfos();
-	if (m_preInjectionErrorCount < errors.size())
+	ErrorCountInfo errorCount;
+	std::vector<ErrorInfo> newErrors;
+	{
+		std::lock_guard<std::mutex> lock(m_errorIndexMutex);
+		const ErrorIndex& errorIndex = getErrorIndex();
+
+		errorCount = errorIndex.getErrorCount();
+		if (m_preInjectionErrorCount < errorCount.total)
+		{
+			newErrors = errorIndex.getErrorsAfter(
+				m_preInjectionErrorCount - m_preIndexingErrorCount);
+		}
+	}
+
+	if (m_preInjectionErrorCount < errorCount.total)
 	{
-		ErrorCountInfo errorCount(errors);
-		errors.erase(
-			errors.begin(), errors.begin() + m_preInjectionErrorCount - m_preIndexingErrorCount);
-		MessageErrorCountUpdate(errorCount, errors).dispatch();
+		MessageErrorCountUpdate(errorCount, newErrors).dispatch();
 		m_preIndexingErrorCount = 0;
 	}
 }
@@ -345,6 +479,8 @@ void PersistentStorage::clear()
 
 void PersistentStorage::clearCaches()
 {
+	CacheLock cacheLock(m_cacheMutex, true);
+
 	m_symbolIndex.clear();
 	m_fileIndex.clear();
 
@@ -354,16 +490,24 @@ void PersistentStorage::clearCaches()
 	m_fileNodeComplete.clear();
 	m_fileNodeIndexed.clear();
 	m_fileNodeLanguage.clear();
+	m_fileSearchNames.clear();
 	m_symbolDefinitionKinds.clear();
+	m_nodeTable.clear();
 
 	m_hierarchyCache.clear();
 	m_fullTextSearchIndex.clear();
 	m_fullTextSearchCodec = "";
+
+	invalidateFileReferenceGraphs();
+	invalidateErrorIndex();
+	invalidateOverviewNodeIds();
 }
 
 std::set<FilePath> PersistentStorage::getReferenced(const std::set<FilePath>& filePaths) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::set<FilePath> referenced;
 
 	utility::append(referenced, getReferencedByIncludes(filePaths));
@@ -375,6 +519,8 @@ std::set<FilePath> PersistentStorage::getReferenced(const std::set<FilePath>& fi
 std::set<FilePath> PersistentStorage::getReferencing(const std::set<FilePath>& filePaths) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::set<FilePath> referencing;
 
 	utility::append(referencing, getReferencingByIncludes(filePaths));
@@ -388,6 +534,7 @@ void PersistentStorage::clearAllErrors()
 	TRACE();
 
 	m_sqliteIndexStorage.removeAllErrors();
+	invalidateErrorIndex();
 }
 
 void PersistentStorage::clearFileElements(
@@ -407,6 +554,8 @@ void PersistentStorage::clearFileElements(
 		m_sqliteIndexStorage.removeElementsWithLocationInFiles(fileNodeIds, updateStatusCallback);
 		m_sqliteIndexStorage.removeElements(fileNodeIds);
 		m_sqliteIndexStorage.commitTransaction();
+		invalidateFileReferenceGraphs();
+		invalidateErrorIndex();
 		updateStatusCallback(100);
 	}
 }
@@ -414,6 +563,7 @@ void PersistentStorage::clearFileElements(
 std::vector<FileInfo> PersistentStorage::getFileInfoForAllFiles() const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::vector<FileInfo> fileInfos;
 
@@ -424,7 +574,7 @@ std::vector<FileInfo> PersistentStorage::getFileInfoForAllFiles() const
 			modificationTime = boost::posix_time::time_from_string(file.modificationTime);
 		}
 
-		fileInfos.emplace_back(FilePath(file.filePath), modificationTime);
+		fileInfos.emplace_back(FilePath(utility::decodeFromUtf8(file.filePath)), modificationTime);
 	});
 
 	return fileInfos;
@@ -433,6 +583,7 @@ std::vector<FileInfo> PersistentStorage::getFileInfoForAllFiles() const
 std::set<FilePath> PersistentStorage::getIncompleteFiles() const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::set<FilePath> incompleteFiles;
 	for (auto p: m_fileNodeComplete)
@@ -448,6 +599,8 @@ std::set<FilePath> PersistentStorage::getIncompleteFiles() const
 
 bool PersistentStorage::getFilePathIndexed(const FilePath& path) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	Id fileId = getFileNodeId(path);
 	if (fileId)
 	{
@@ -460,6 +613,7 @@ bool PersistentStorage::getFilePathIndexed(const FilePath& path) const
 void PersistentStorage::buildCaches()
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, true);
 
 	clearCaches();
 
@@ -467,6 +621,164 @@ void PersistentStorage::buildCaches()
 	buildSearchIndex();
 	buildMemberEdgeIdOrderMap();
 	buildHierarchyCache();
+
+	// the overview is the first thing shown after opening a project
+	std::lock_guard<std::mutex> lock(m_overviewNodeIdsMutex);
+	getOverviewNodeIds();
+}
+
+void PersistentStorage::applyChanges(const StorageChanges& changes)
+{
+	TRACE();
+
+	if (changes.empty())
+	{
+		return;
+	}
+
+	LOG_INFO(
+		"Updating caches for " + std::to_string(changes.nodeIds.size()) + " changed nodes and " +
+		std::to_string(changes.edgeIds.size()) + " changed edges");
+
+	// the database is read before locking, so other threads only wait for the cache updates
+	const std::vector<StorageNode> nodes = m_sqliteIndexStorage.getAllByIds<StorageNode>(
+		changes.nodeIds);
+	const std::vector<StorageFile> files = m_sqliteIndexStorage.getAllByIds<StorageFile>(
+		changes.nodeIds);
+	const std::vector<StorageSymbol> symbols = m_sqliteIndexStorage.getAllByIds<StorageSymbol>(
+		changes.nodeIds);
+	const std::vector<StorageEdge> edges = m_sqliteIndexStorage.getAllByIds<StorageEdge>(
+		changes.edgeIds);
+
+	std::vector<Id> previousFileIds;
+	{
+		CacheLock cacheLock(m_cacheMutex, true);
+
+		// remove the previous state while the caches still describe it
+		bool memberEdgesChanged = false;
+		for (const StorageEdge& edge: changes.previousEdges)
+		{
+			if (edge.type == Edge::typeToInt(Edge::EDGE_MEMBER))
+			{
+				m_hierarchyCache.removeConnection(edge.id, edge.sourceNodeId, edge.targetNodeId);
+				memberEdgesChanged = true;
+			}
+			else if (edge.type == Edge::typeToInt(Edge::EDGE_INHERITANCE))
+			{
+				m_hierarchyCache.removeInheritance(edge.id, edge.sourceNodeId);
+			}
+		}
+
+		std::unordered_set<Id> existingNodeIds;
+		for (const StorageNode& node: nodes)
+		{
+			existingNodeIds.insert(node.id);
+		}
+
+		for (const StorageNode& node: changes.previousNodes)
+		{
+			removeNodeFromSearchIndex(node);
+
+			if (m_fileNodePaths.find(node.id) != m_fileNodePaths.end())
+			{
+				removeFileFromCaches(node.id);
+				previousFileIds.push_back(node.id);
+			}
+
+			m_symbolDefinitionKinds.erase(node.id);
+
+			if (existingNodeIds.find(node.id) == existingNodeIds.end())
+			{
+				m_hierarchyCache.removeNode(node.id);
+				m_nodeTable.removeNode(node.id);
+			}
+		}
+
+		// add the current state of the changed elements
+		for (const StorageFile& file: files)
+		{
+			addFileToCaches(file);
+		}
+
+		for (const StorageSymbol& symbol: symbols)
+		{
+			m_symbolDefinitionKinds[symbol.id] = intToDefinitionKind(symbol.definitionKind);
+		}
+
+		for (const StorageNode& node: nodes)
+		{
+			addNodeToSearchIndex(node);
+			m_nodeTable.addNode(node);
+
+			auto it = m_symbolDefinitionKinds.find(node.id);
+			m_hierarchyCache.updateNode(
+				node.id,
+				NodeType(intToNodeKind(node.type)).isVisibleAsParentInGraph(),
+				it != m_symbolDefinitionKinds.end() && it->second == DEFINITION_IMPLICIT);
+		}
+
+		std::vector<StorageEdge> memberEdges;
+		for (const StorageEdge& edge: edges)
+		{
+			if (edge.type == Edge::typeToInt(Edge::EDGE_MEMBER))
+			{
+				memberEdges.push_back(edge);
+			}
+			else if (edge.type == Edge::typeToInt(Edge::EDGE_INHERITANCE))
+			{
+				m_hierarchyCache.createInheritance(edge.id, edge.sourceNodeId, edge.targetNodeId);
+			}
+		}
+
+		if (!memberEdges.empty())
+		{
+			addMemberEdgesToHierarchyCache(memberEdges);
+			memberEdgesChanged = true;
+		}
+
+		// the order depends on the locations of all members, so it is cheaper to rebuild
+		if (memberEdgesChanged && m_hasJavaFiles)
+		{
+			m_memberEdgeIdOrderMap.clear();
+			buildMemberEdgeIdOrderMap();
+		}
+
+		// changed parents or definition kinds also affect unchanged nodes, so the overview nodes
+		// are recomputed from the updated caches once the overview is shown again
+		invalidateOverviewNodeIds();
+
+		// imports depend on the locations of the imported elements, so both graphs are rebuilt
+		// lazily
+		invalidateFileReferenceGraphs();
+		invalidateErrorIndex();
+	}
+
+	// the tabs keep searching the changed tries until the repacked flat arrays are swapped in
+	{
+		CacheLock cacheLock(m_cacheMutex, false);
+		m_symbolIndex.repack();
+		m_fileIndex.repack();
+	}
+
+	std::lock_guard<std::mutex> lock(m_fullTextSearchMutex);
+	if (!m_fullTextSearchCodec.empty())
+	{
+		for (Id fileId: previousFileIds)
+		{
+			m_fullTextSearchIndex.removeFile(fileId);
+		}
+
+		TextCodec codec(m_fullTextSearchCodec);
+		for (const StorageFile& file: files)
+		{
+			if (file.indexed)
+			{
+				m_fullTextSearchIndex.addFile(
+					file.id,
+					codec.decode(m_sqliteIndexStorage.getFileContentById(file.id)->getText()));
+			}
+		}
+	}
 }
 
 void PersistentStorage::optimizeMemory()
@@ -481,17 +793,23 @@ void PersistentStorage::optimizeMemory()
 
 Id PersistentStorage::getNodeIdForFileNode(const FilePath& filePath) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	return getFileNodeId(filePath);
 }
 
 Id PersistentStorage::getNodeIdForNameHierarchy(const NameHierarchy& nameHierarchy) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	return m_sqliteIndexStorage.getNodeBySerializedName(NameHierarchy::serialize(nameHierarchy)).id;
 }
 
 std::vector<Id> PersistentStorage::getNodeIdsForNameHierarchies(
 	const std::vector<NameHierarchy> nameHierarchies) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::vector<Id> nodeIds;
 	for (const NameHierarchy& name: nameHierarchies)
 	{
@@ -507,6 +825,13 @@ std::vector<Id> PersistentStorage::getNodeIdsForNameHierarchies(
 NameHierarchy PersistentStorage::getNameHierarchyForNodeId(Id nodeId) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
+
+	std::shared_ptr<const NameHierarchy> nameHierarchy = m_nodeTable.getNameHierarchy(nodeId);
+	if (nameHierarchy)
+	{
+		return *nameHierarchy;
+	}
 
 	return NameHierarchy::deserialize(
 		m_sqliteIndexStorage.getFirstById<StorageNode>(nodeId).serializedName);
@@ -516,11 +841,12 @@ std::vector<NameHierarchy> PersistentStorage::getNameHierarchiesForNodeIds(
 	const std::vector<Id>& nodeIds) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::vector<NameHierarchy> nameHierarchies;
-	for (const StorageNode& storageNode: m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIds))
+	for (const StorageNode& storageNode: getStorageNodesByIds(nodeIds))
 	{
-		nameHierarchies.push_back(NameHierarchy::deserialize(storageNode.serializedName));
+		nameHierarchies.push_back(*getNameHierarchyForStorageNode(storageNode));
 	}
 	return nameHierarchies;
 }
@@ -528,6 +854,8 @@ std::vector<NameHierarchy> PersistentStorage::getNameHierarchiesForNodeIds(
 std::map<Id, std::pair<Id, NameHierarchy>> PersistentStorage::getNodeIdToParentFileMap(
 	const std::vector<Id>& nodeIds) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::map<Id, std::pair<Id, NameHierarchy>> nodeIdToParentFileMap;
 
 	std::shared_ptr<SourceLocationCollection> locations =
@@ -573,11 +901,19 @@ std::map<Id, std::pair<Id, NameHierarchy>> PersistentStorage::getNodeIdToParentF
 
 NodeType PersistentStorage::getNodeTypeForNodeWithId(Id nodeId) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
+	if (m_nodeTable.containsNode(nodeId))
+	{
+		return NodeType(intToNodeKind(m_nodeTable.getNodeType(nodeId)));
+	}
 	return NodeType(intToNodeKind(m_sqliteIndexStorage.getFirstById<StorageNode>(nodeId).type));
 }
 
 StorageEdge PersistentStorage::getEdgeById(Id edgeId) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	return m_sqliteIndexStorage.getEdgeById(edgeId);
 }
 
@@ -585,6 +921,7 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 	const std::wstring& searchTerm, bool caseSensitive) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::shared_ptr<SourceLocationCollection> collection =
 		std::make_shared<SourceLocationCollection>();
@@ -704,15 +1041,25 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 }
 
 std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
-	const std::wstring& query, NodeTypeSet acceptedNodeTypes, bool acceptCommands) const
+	const std::wstring& query,
+	NodeTypeSet acceptedNodeTypes,
+	bool acceptCommands,
+	const AutocompletionRequest& request) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	// search in indices
 	const size_t maxResultsCount = static_cast<size_t>(std::pow(3, query.size() + 3));
 	const size_t maxBestScoredResultsLength = 100;
 	const size_t maxMatchesReturned = 1000;
 
+	// only longer result lists are shown early, so short ones don't get shown twice
+	const size_t maxFirstMatchesCount = 20;
+	const size_t minResultsCountForFirstMatches = 200;
+
+	auto isCancelled = [&request]() { return request.isCancelled && request.isCancelled(); };
+
 	// create SearchMatches
 	std::vector<SearchMatch> matches;
 
@@ -720,13 +1067,50 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 			 .getWithMatchingRemoved([](const NodeType& type) { return type.isFile(); })
 			 .isEmpty())
 	{
-		matches = getAutocompletionSymbolMatches(
-			query, acceptedNodeTypes, maxResultsCount, maxBestScoredResultsLength);
+		// the first matches are shown before the found results are rescored
+		std::function<void(const std::multiset<SearchResult>&)> onFoundResults;
+		if (request.onFirstMatches)
+		{
+			onFoundResults = [&](const std::multiset<SearchResult>& foundResults) {
+				if (foundResults.size() >= minResultsCountForFirstMatches && !isCancelled())
+				{
+					auto end = foundResults.begin();
+					std::advance(end, maxFirstMatchesCount);
+					request.onFirstMatches(getAutocompletionSymbolMatches(
+						std::vector<SearchResult>(foundResults.begin(), end), acceptedNodeTypes));
+				}
+			};
+		}
+
+		std::vector<SearchResult> results;
+		{
+			std::unique_lock<std::mutex> lock(m_searchSessionMutex, std::try_to_lock);
+			results = m_symbolIndex.search(
+				query,
+				acceptedNodeTypes,
+				maxResultsCount,
+				maxBestScoredResultsLength,
+				lock.owns_lock() ? &m_symbolSearchSession : nullptr,
+				request.isCancelled,
+				onFoundResults);
+		}
+
+		if (isCancelled())
+		{
+			return {};
+		}
+
+		matches = getAutocompletionSymbolMatches(results, acceptedNodeTypes);
 	}
 
 	if (acceptedNodeTypes.containsMatching([](const NodeType& type) { return type.isFile(); }))
 	{
-		utility::append(matches, getAutocompletionFileMatches(query, maxResultsCount));
+		utility::append(matches, getAutocompletionFileMatches(query, maxResultsCount, request));
+	}
+
+	if (isCancelled())
+	{
+		return {};
 	}
 
 	if (acceptCommands)
@@ -799,14 +1183,9 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(
 }
 
 std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(
-	const std::wstring& query,
-	const NodeTypeSet& acceptedNodeTypes,
-	size_t maxResultsCount,
-	size_t maxBestScoredResultsLength) const
+	const std::vector<SearchResult>& results, const NodeTypeSet& acceptedNodeTypes) const
 {
-	// search in indices
-	const std::vector<SearchResult> results = m_symbolIndex.search(
-		query, acceptedNodeTypes, maxResultsCount, maxBestScoredResultsLength);
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	// fetch StorageNodes for node ids
 	std::map<Id, StorageNode> storageNodeMap;
@@ -818,7 +1197,7 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(
 			elementIds.insert(elementIds.end(), result.elementIds.begin(), result.elementIds.end());
 		}
 
-		for (const StorageNode& node: m_sqliteIndexStorage.getAllByIds<StorageNode>(elementIds))
+		for (const StorageNode& node: getStorageNodesByIds(elementIds))
 		{
 			storageNodeMap.emplace(node.id, node);
 		}
@@ -838,7 +1217,7 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(
 				StorageNode* node = &storageNodeMap[elementId];
 
 				match.tokenIds.push_back(elementId);
-				match.tokenNames.push_back(NameHierarchy::deserialize(node->serializedName));
+				match.tokenNames.push_back(*getNameHierarchyForStorageNode(*node));
 
 				if (!match.hasChildren &&
 					acceptedNodeTypes ==
@@ -862,7 +1241,7 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(
 		match.name = result.text;
 		match.text = result.text;
 
-		NameHierarchy name = NameHierarchy::deserialize(firstNode->serializedName);
+		const NameHierarchy& name = match.tokenNames.front();
 		if (name.getQualifiedName() == match.name)
 		{
 			const size_t idx = m_hierarchyCache.getIndexOfLastVisibleParentNode(firstNode->id);
@@ -891,13 +1270,24 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(
 }
 
 std::vector<SearchMatch> PersistentStorage::getAutocompletionFileMatches(
-	const std::wstring& query, size_t maxResultsCount) const
+	const std::wstring& query, size_t maxResultsCount, const AutocompletionRequest& request) const
 {
-	const std::vector<SearchResult> results = m_fileIndex.search(
-		query,
-		NodeTypeSet::all().getWithMatchingKept([](const NodeType& type) { return type.isFile(); }),
-		maxResultsCount,
-		100);
+	CacheLock cacheLock(m_cacheMutex, false);
+
+	const NodeTypeSet fileTypes = NodeTypeSet::all().getWithMatchingKept(
+		[](const NodeType& type) { return type.isFile(); });
+
+	std::vector<SearchResult> results;
+	{
+		std::unique_lock<std::mutex> lock(m_searchSessionMutex, std::try_to_lock);
+		results = m_fileIndex.search(
+			query,
+			fileTypes,
+			maxResultsCount,
+			100,
+			lock.owns_lock() ? &m_fileSearchSession : nullptr,
+			request.isCancelled);
+	}
 
 	// create SearchMatches
 	std::vector<SearchMatch> matches;
@@ -939,6 +1329,8 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionFileMatches(
 std::vector<SearchMatch> PersistentStorage::getAutocompletionCommandMatches(
 	const std::wstring& query, NodeTypeSet acceptedNodeTypes) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	// search in indices
 	const std::vector<SearchResult> results = m_commandIndex.search(query, NodeTypeSet::all(), 0);
 
@@ -978,6 +1370,7 @@ std::vector<SearchMatch> PersistentStorage::getSearchMatchesForTokenIds(
 	const std::vector<Id>& elementIds) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	// todo: what if all these elements share the same node in the searchindex?
 	// In that case there should be only one search match.
@@ -985,7 +1378,7 @@ std::vector<SearchMatch> PersistentStorage::getSearchMatchesForTokenIds(
 
 	// fetch StorageNodes for node ids
 	std::map<Id, StorageNode> storageNodeMap;
-	for (StorageNode& node: m_sqliteIndexStorage.getAllByIds<StorageNode>(elementIds))
+	for (StorageNode& node: getStorageNodesByIds(elementIds))
 	{
 		storageNodeMap.emplace(node.id, node);
 	}
@@ -1000,7 +1393,7 @@ std::vector<SearchMatch> PersistentStorage::getSearchMatchesForTokenIds(
 		StorageNode node = storageNodeMap[elementId];
 
 		SearchMatch match;
-		const NameHierarchy nameHierarchy = NameHierarchy::deserialize(node.serializedName);
+		const NameHierarchy nameHierarchy = *getNameHierarchyForStorageNode(node);
 		match.name = nameHierarchy.getQualifiedName();
 		match.text = nameHierarchy.getRawName();
 
@@ -1023,51 +1416,43 @@ std::vector<SearchMatch> PersistentStorage::getSearchMatchesForTokenIds(
 std::shared_ptr<Graph> PersistentStorage::getGraphForAll() const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
+
+	std::lock_guard<std::mutex> lock(m_overviewNodeIdsMutex);
 
 	std::shared_ptr<Graph> graph = std::make_shared<Graph>();
-	const size_t sdk_size = m_symbolDefinitionKinds.size();
-	m_sqliteIndexStorage.forEach<StorageNode>([&, sdk_size](StorageNode&& storageNode) {
-		const NodeType type(intToNodeKind(storageNode.type));
+	for (Id nodeId: getOverviewNodeIds())
+	{
+		// the names of all overview nodes would replace the cached names of the recent queries
+		const NodeType type(intToNodeKind(m_nodeTable.getNodeType(nodeId)));
+		std::shared_ptr<const NameHierarchy> nameHierarchy =
+			m_nodeTable.getNameHierarchyWithoutCaching(nodeId);
 		if (type.isFile())
 		{
-			auto fn_it = m_fileNodeIndexed.find(storageNode.id);
-			if (fn_it != m_fileNodeIndexed.end() && fn_it->second)
-			{
-				addFileNodeToGraph(storageNode, graph.get());
-			}
+			addFileNodeToGraph(nodeId, *nameHierarchy, graph.get());
 		}
 		else
 		{
-			bool showNode = true;
-			if (sdk_size)
-			{
-				auto it = m_symbolDefinitionKinds.find(storageNode.id);
-				showNode = (it != m_symbolDefinitionKinds.end() && it->second == DEFINITION_EXPLICIT);
-			}
-			if (showNode &&
-				(type.isPackage() ||
-				 !m_hierarchyCache.isChildOfVisibleNodeOrInvisible(storageNode.id)))
-			{
-				addNodeToGraph(storageNode, type, graph.get(), false);
-			}
+			addNodeToGraph(nodeId, type, *nameHierarchy, graph.get(), false);
 		}
-	});
+	}
 	return graph;
 }
 
 std::shared_ptr<Graph> PersistentStorage::getGraphForNodeTypes(NodeTypeSet nodeTypes) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::vector<Id> tokenIds;
 
-	m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
-		if (nodeTypes.contains(NodeType(intToNodeKind(node.type))))
+	m_nodeTable.forEachNode([&](Id nodeId, int nodeType) {
+		if (nodeTypes.contains(NodeType(intToNodeKind(nodeType))))
 		{
-			auto it = m_symbolDefinitionKinds.find(node.id);
+			auto it = m_symbolDefinitionKinds.find(nodeId);
 			if (it != m_symbolDefinitionKinds.end() && it->second == DEFINITION_EXPLICIT)
 			{
-				tokenIds.push_back(node.id);
+				tokenIds.push_back(nodeId);
 			}
 		}
 	});
@@ -1090,6 +1475,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 	const std::vector<Id>& tokenIds, const std::vector<Id>& expandedNodeIds, bool* isActiveNamespace) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::vector<Id> ids(tokenIds);
 	bool isPackage = false;
@@ -1105,7 +1491,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 	if (tokenIds.size() == 1)
 	{
 		const Id elementId = tokenIds[0];
-		const StorageNode node = m_sqliteIndexStorage.getFirstById<StorageNode>(elementId);
+		const StorageNode node = getStorageNodeById(elementId);
 
 		if (node.id > 0)
 		{
@@ -1181,7 +1567,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 			}
 			symbolIds.insert(symbol.id);
 		}
-		for (const StorageNode& node: m_sqliteIndexStorage.getAllByIds<StorageNode>(ids))
+		for (const StorageNode& node: getStorageNodesByIds(ids))
 		{
 			if (symbolIds.find(node.id) == symbolIds.end())
 			{
@@ -1262,6 +1648,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(
 std::shared_ptr<Graph> PersistentStorage::getGraphForChildrenOfNodeId(Id nodeId) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::vector<Id> nodeIds;
 	std::vector<Id> edgeIds;
@@ -1287,6 +1674,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(
 	bool directed) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::set<Id> nodeIds;
 	std::set<Id> edgeIds;
@@ -1374,8 +1762,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(
 
 		if (nodeTypes != 0)
 		{
-			for (const StorageNode& node:
-				 m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIdsToCheck))
+			for (const StorageNode& node: getStorageNodesByIds(nodeIdsToCheck))
 			{
 				NodeKind kind = intToNodeKind(node.type);
 				if (kind & nodeTypes || (kind == NODE_SYMBOL && nodeNonIndexed))
@@ -1501,6 +1888,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(
 NodeKindMask PersistentStorage::getAvailableNodeTypes() const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	NodeKindMask mask = 0;
 	for (int type: m_sqliteIndexStorage.getAvailableNodeTypes())
@@ -1513,6 +1901,7 @@ NodeKindMask PersistentStorage::getAvailableNodeTypes() const
 Edge::TypeMask PersistentStorage::getAvailableEdgeTypes() const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	Edge::TypeMask mask = 0;
 	for (int type: m_sqliteIndexStorage.getAvailableEdgeTypes())
@@ -1526,6 +1915,7 @@ Edge::TypeMask PersistentStorage::getAvailableEdgeTypes() const
 std::vector<Id> PersistentStorage::getActiveTokenIdsForId(Id tokenId, Id* declarationId) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::vector<Id> activeTokenIds;
 
@@ -1555,6 +1945,7 @@ std::vector<Id> PersistentStorage::getActiveTokenIdsForId(Id tokenId, Id* declar
 std::vector<Id> PersistentStorage::getNodeIdsForLocationIds(const std::vector<Id>& locationIds) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::set<Id> nodeIds;
 	std::set<Id> implicitNodeIds;
@@ -1594,6 +1985,7 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsF
 	const std::vector<Id>& tokenIds) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::map<Id, FilePath> filePaths;
 	std::vector<Id> nonFileIds;
@@ -1700,6 +2092,7 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsF
 	const std::vector<Id>& locationIds) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::shared_ptr<SourceLocationCollection> collection =
 		std::make_shared<SourceLocationCollection>();
@@ -1741,6 +2134,7 @@ std::shared_ptr<SourceLocationFile> PersistentStorage::getSourceLocationsForFile
 	const FilePath& filePath) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	return m_sqliteIndexStorage.getSourceLocationsForFile(filePath)->getFilteredByTypes(
 		{LOCATION_TOKEN, LOCATION_SCOPE, LOCATION_QUALIFIER, LOCATION_LOCAL_SYMBOL, LOCATION_UNSOLVED});
@@ -1750,6 +2144,7 @@ std::shared_ptr<SourceLocationFile> PersistentStorage::getSourceLocationsForLine
 	const FilePath& filePath, size_t startLine, size_t endLine) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	return m_sqliteIndexStorage.getSourceLocationsForLinesInFile(filePath, startLine, endLine)
 		->getFilteredByLines(startLine, endLine)
@@ -1765,6 +2160,7 @@ std::shared_ptr<SourceLocationFile> PersistentStorage::getSourceLocationsOfTypeI
 	const FilePath& filePath, LocationType type) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	return m_sqliteIndexStorage.getSourceLocationsOfTypeInFile(filePath, type);
 }
@@ -1773,6 +2169,7 @@ std::shared_ptr<TextAccess> PersistentStorage::getFileContent(
 	const FilePath& filePath, bool showsErrors) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::shared_ptr<TextAccess> fileContent = m_sqliteIndexStorage.getFileContentByPath(
 		filePath.wstr());
@@ -1785,6 +2182,8 @@ std::shared_ptr<TextAccess> PersistentStorage::getFileContent(
 
 bool PersistentStorage::hasContentForFile(const FilePath& filePath) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::shared_ptr<TextAccess> fileContent = m_sqliteIndexStorage.getFileContentByPath(
 		filePath.wstr());
 	if (fileContent->getLineCount() > 0)
@@ -1796,23 +2195,31 @@ bool PersistentStorage::hasContentForFile(const FilePath& filePath) const
 
 FileInfo PersistentStorage::getFileInfoForFileId(Id id) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	StorageFile storageFile = m_sqliteIndexStorage.getFirstById<StorageFile>(id);
-	return FileInfo(FilePath(storageFile.filePath), storageFile.modificationTime);
+	return FileInfo(
+		FilePath(utility::decodeFromUtf8(storageFile.filePath)), storageFile.modificationTime);
 }
 
 FileInfo PersistentStorage::getFileInfoForFilePath(const FilePath& filePath) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	return getFileInfoForFileId(getFileNodeId(filePath));
 }
 
 std::vector<FileInfo> PersistentStorage::getFileInfosForFilePaths(
 	const std::vector<FilePath>& filePaths) const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::vector<FileInfo> fileInfos;
 
 	for (const StorageFile& file: m_sqliteIndexStorage.getFilesByPaths(filePaths))
 	{
-		fileInfos.push_back(FileInfo(FilePath(file.filePath), file.modificationTime));
+		fileInfos.push_back(
+			FileInfo(FilePath(utility::decodeFromUtf8(file.filePath)), file.modificationTime));
 	}
 
 	return fileInfos;
@@ -1821,6 +2228,7 @@ std::vector<FileInfo> PersistentStorage::getFileInfosForFilePaths(
 StorageStats PersistentStorage::getStorageStats() const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	StorageStats stats;
 
@@ -1838,85 +2246,63 @@ StorageStats PersistentStorage::getStorageStats() const
 
 ErrorCountInfo PersistentStorage::getErrorCount() const
 {
-	return ErrorCountInfo(m_sqliteIndexStorage.getAllErrorInfos());
+	CacheLock cacheLock(m_cacheMutex, false);
+
+	std::lock_guard<std::mutex> lock(m_errorIndexMutex);
+	return getErrorIndex().getErrorCount();
 }
 
 std::vector<ErrorInfo> PersistentStorage::getErrorsLimited(const ErrorFilter& filter) const
 {
-	return filter.filterErrors(m_sqliteIndexStorage.getAllErrorInfos());
+	CacheLock cacheLock(m_cacheMutex, false);
+
+	std::lock_guard<std::mutex> lock(m_errorIndexMutex);
+	return getErrorIndex().getErrors(filter);
 }
 
 std::vector<ErrorInfo> PersistentStorage::getErrorsForFileLimited(
 	const ErrorFilter& filter, const FilePath& filePath) const
 {
-	Id fileId = getFileNodeId(filePath);
-	std::set<Id> fileIds = {fileId};
+	CacheLock cacheLock(m_cacheMutex, false);
 
-	std::unordered_map<Id, std::set<Id>> includedMap = getFileIdToIncludedFileIdMap();
-	std::set<Id> fileIdsToProcess = includedMap[getFileNodeId(filePath)];
-	std::set<Id> processedFileIds;
+	const Id fileId = getFileNodeId(filePath);
 
-	while (fileIdsToProcess.size())
+	std::set<Id> fileIds;
 	{
-		std::set<Id> nextFileIdsToProcess;
-		for (Id id: fileIdsToProcess)
-		{
-			if (fileIds.insert(id).second)
-			{
-				utility::append(nextFileIdsToProcess, includedMap[id]);
-			}
-		}
-		fileIdsToProcess = nextFileIdsToProcess;
+		std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+		fileIds = getIncludeGraph().getReferenced({fileId});
 	}
+	fileIds.insert(fileId);
 
-	std::vector<ErrorInfo> res;
-
-	std::vector<ErrorInfo> errors = m_sqliteIndexStorage.getAllErrorInfos();
-	for (const ErrorInfo& error: errors)
+	std::vector<ErrorInfo> errors;
 	{
-		if (filter.filter(error) &&
-			fileIds.find(getFileNodeId(FilePath(error.filePath))) != fileIds.end())
-		{
-			res.push_back(error);
-		}
+		std::lock_guard<std::mutex> lock(m_errorIndexMutex);
+		errors = getErrorIndex().getErrorsForFiles(filter, fileIds);
 	}
 
-	if (res.empty())
+	if (errors.empty())
 	{
-		std::unordered_map<Id, std::set<Id>> includingMap = getFileIdToIncludingFileIdMap();
-		fileIds.clear();
-
-		fileIdsToProcess = includingMap[fileId];
-		while (fileIdsToProcess.size())
 		{
-			std::set<Id> nextFileIdsToProcess;
-			for (Id id: fileIdsToProcess)
-			{
-				if (fileIds.insert(id).second)
-				{
-					utility::append(nextFileIdsToProcess, includingMap[id]);
-				}
-			}
-			fileIdsToProcess = nextFileIdsToProcess;
+			std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+			fileIds = getIncludeGraph().getReferencing({fileId});
 		}
 
-		for (const ErrorInfo& error: errors)
-		{
-			if (error.fatal && filter.filter(error) &&
-				fileIds.find(getFileNodeId(FilePath(error.filePath))) != fileIds.end())
-			{
-				res.push_back(error);
-			}
-		}
+		ErrorFilter fatalFilter = filter;
+		fatalFilter.error = false;
+		fatalFilter.unindexedError = false;
+
+		std::lock_guard<std::mutex> lock(m_errorIndexMutex);
+		errors = getErrorIndex().getErrorsForFiles(fatalFilter, fileIds);
 	}
 
-	return res;
+	return errors;
 }
 
 std::shared_ptr<SourceLocationCollection> PersistentStorage::getErrorSourceLocations(
 	const std::vector<ErrorInfo>& errors) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	std::shared_ptr<SourceLocationCollection> collection =
 		std::make_shared<SourceLocationCollection>();
@@ -1955,8 +2341,8 @@ Id PersistentStorage::addNodeBookmark(const NodeBookmark& bookmark)
 
 	for (const Id& nodeId: bookmark.getNodeIds())
 	{
-		m_sqliteBookmarkStorage.addBookmarkedNode(
-			StorageBookmarkedNodeData(id, m_sqliteIndexStorage.getNodeById(nodeId).serializedName));
+		m_sqliteBookmarkStorage.addBookmarkedNode(StorageBookmarkedNodeData(
+			id, utility::decodeFromUtf8(m_sqliteIndexStorage.getNodeById(nodeId).serializedName)));
 	}
 
 	return id;
@@ -1980,8 +2366,10 @@ Id PersistentStorage::addEdgeBookmark(const EdgeBookmark& bookmark)
 		m_sqliteBookmarkStorage.addBookmarkedEdge(StorageBookmarkedEdgeData(
 			id,
 			// todo: optimization for multiple edges in same bookmark: use a local cache here
-			m_sqliteIndexStorage.getNodeById(storageEdge.sourceNodeId).serializedName,
-			m_sqliteIndexStorage.getNodeById(storageEdge.targetNodeId).serializedName,
+			utility::decodeFromUtf8(
+				m_sqliteIndexStorage.getNodeById(storageEdge.sourceNodeId).serializedName),
+			utility::decodeFromUtf8(
+				m_sqliteIndexStorage.getNodeById(storageEdge.targetNodeId).serializedName),
 			storageEdge.type,
 			sourceNodeActive));
 	}
@@ -2026,6 +2414,8 @@ void PersistentStorage::removeBookmarkCategory(Id id)
 
 std::vector<NodeBookmark> PersistentStorage::getAllNodeBookmarks() const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::unordered_map<Id, StorageBookmarkCategory> bookmarkCategories;
 	for (const StorageBookmarkCategory& bookmarkCategory:
 		 m_sqliteBookmarkStorage.getAllBookmarkCategories())
@@ -2037,7 +2427,9 @@ std::vector<NodeBookmark> PersistentStorage::getAllNodeBookmarks() const
 	for (const StorageBookmarkedNode& bookmarkedNode: m_sqliteBookmarkStorage.getAllBookmarkedNodes())
 	{
 		bookmarkIdToBookmarkedNodeIds[bookmarkedNode.bookmarkId].push_back(
-			m_sqliteIndexStorage.getNodeBySerializedName(bookmarkedNode.serializedNodeName).id);
+			m_sqliteIndexStorage
+				.getNodeBySerializedName(utility::encodeToUtf8(bookmarkedNode.serializedNodeName))
+				.id);
 	}
 
 	std::vector<NodeBookmark> nodeBookmarks;
@@ -2066,6 +2458,8 @@ std::vector<NodeBookmark> PersistentStorage::getAllNodeBookmarks() const
 
 std::vector<EdgeBookmark> PersistentStorage::getAllEdgeBookmarks() const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::unordered_map<Id, StorageBookmarkCategory> bookmarkCategories;
 	for (const StorageBookmarkCategory& bookmarkCategory:
 		 m_sqliteBookmarkStorage.getAllBookmarkCategories())
@@ -2082,7 +2476,9 @@ std::vector<EdgeBookmark> PersistentStorage::getAllEdgeBookmarks() const
 	std::vector<EdgeBookmark> edgeBookmarks;
 
 	UnorderedCache<std::wstring, Id> nodeIdCache([&](const std::wstring& serializedNodeName) {
-		return m_sqliteIndexStorage.getNodeBySerializedName(serializedNodeName).id;
+		return m_sqliteIndexStorage
+			.getNodeBySerializedName(utility::encodeToUtf8(serializedNodeName))
+			.id;
 	});
 
 	for (const StorageBookmark& storageBookmark: m_sqliteBookmarkStorage.getAllBookmarks())
@@ -2126,6 +2522,8 @@ std::vector<EdgeBookmark> PersistentStorage::getAllEdgeBookmarks() const
 
 std::vector<BookmarkCategory> PersistentStorage::getAllBookmarkCategories() const
 {
+	CacheLock cacheLock(m_cacheMutex, false);
+
 	std::vector<BookmarkCategory> categories;
 	for (const StorageBookmarkCategory& storageBookmarkCategoriy:
 		 m_sqliteBookmarkStorage.getAllBookmarkCategories())
@@ -2140,6 +2538,7 @@ TooltipInfo PersistentStorage::getTooltipInfoForTokenIds(
 	const std::vector<Id>& tokenIds, TooltipOrigin origin) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	TooltipInfo info;
 
@@ -2231,6 +2630,7 @@ TooltipInfo PersistentStorage::getTooltipInfoForTokenIds(
 TooltipSnippet PersistentStorage::getTooltipSnippetForNode(const StorageNode& node) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	const NameHierarchy nameHierarchy = NameHierarchy::deserialize(node.serializedName);
 	TooltipSnippet snippet;
@@ -2486,6 +2886,7 @@ TooltipInfo PersistentStorage::getTooltipInfoForSourceLocationIdsAndLocalSymbolI
 	const std::vector<Id>& locationIds, const std::vector<Id>& localSymbolIds) const
 {
 	TRACE();
+	CacheLock cacheLock(m_cacheMutex, false);
 
 	const TextCodec codec(ApplicationSettings::getInstance()->getTextEncoding());
 
@@ -2640,178 +3041,208 @@ std::wstring PersistentStorage::getFileNodeLanguage(Id fileId) const
 	return L"";
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToIncludingFileIdMap() const
+StorageNode PersistentStorage::getStorageNodeById(Id nodeId) const
 {
-	std::unordered_map<Id, std::set<Id>> fileIdToIncludingFileIdMap;
-
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](StorageEdge&& edge) {
-			fileIdToIncludingFileIdMap[edge.targetNodeId].insert(edge.sourceNodeId);
-		});
-
-	return fileIdToIncludingFileIdMap;
+	std::vector<StorageNode> nodes;
+	if (m_nodeTable.getNodes({nodeId}, &nodes).empty())
+	{
+		return nodes.front();
+	}
+	return m_sqliteIndexStorage.getFirstById<StorageNode>(nodeId);
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToIncludedFileIdMap() const
+std::vector<StorageNode> PersistentStorage::getStorageNodesByIds(
+	const std::vector<Id>& nodeIds) const
 {
-	std::unordered_map<Id, std::set<Id>> fileIdToIncludingFileIdMap;
+	std::vector<StorageNode> nodes;
+	const std::vector<Id> missingNodeIds = m_nodeTable.getNodes(nodeIds, &nodes);
+	if (missingNodeIds.empty())
+	{
+		return nodes;
+	}
 
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](StorageEdge&& edge) {
-			fileIdToIncludingFileIdMap[edge.sourceNodeId].insert(edge.targetNodeId);
-		});
+	for (StorageNode& node: m_sqliteIndexStorage.getAllByIds<StorageNode>(missingNodeIds))
+	{
+		nodes.push_back(std::move(node));
+	}
+	std::sort(nodes.begin(), nodes.end(), [](const StorageNode& a, const StorageNode& b) {
+		return a.id < b.id;
+	});
+	return nodes;
+}
 
-	return fileIdToIncludingFileIdMap;
+std::shared_ptr<const NameHierarchy> PersistentStorage::getNameHierarchyForStorageNode(
+	const StorageNode& node) const
+{
+	std::shared_ptr<const NameHierarchy> nameHierarchy = m_nodeTable.getNameHierarchy(node.id);
+	if (!nameHierarchy)
+	{
+		nameHierarchy = std::make_shared<const NameHierarchy>(
+			NameHierarchy::deserialize(node.serializedName));
+	}
+	return nameHierarchy;
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToImportingFileIdMap() const
+const FileReferenceGraph& PersistentStorage::getIncludeGraph() const
 {
-	std::unordered_map<Id, std::set<Id>> fileIdToImportingFileIdMap;
+	if (!m_includeGraphValid)
 	{
-		std::vector<Id> importedElementIds;
-		std::map<Id, std::set<Id>> elementIdToImportingFileIds;
+		TRACE("build include graph");
 
+		m_includeGraph.clear();
 		m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-			Edge::typeToInt(Edge::EDGE_IMPORT),
-			[&importedElementIds, &elementIdToImportingFileIds](StorageEdge&& edge) {
-				importedElementIds.push_back(edge.targetNodeId);
-				elementIdToImportingFileIds[edge.targetNodeId].insert(edge.sourceNodeId);
+			Edge::typeToInt(Edge::EDGE_INCLUDE), [this](StorageEdge&& edge) {
+				m_includeGraph.addReference(edge.sourceNodeId, edge.targetNodeId);
 			});
+		m_includeGraph.finish();
+		m_includeGraphValid = true;
 
-		std::unordered_map<Id, Id> importedElementIdToFileNodeId;
-		{
-			std::vector<Id> importedSourceLocationIds;
-			std::unordered_map<Id, Id> importedSourceLocationToElementIds;
-			for (const StorageOccurrence& occurrence:
-				 m_sqliteIndexStorage.getOccurrencesForElementIds(importedElementIds))
-			{
-				importedSourceLocationIds.push_back(occurrence.sourceLocationId);
-				importedSourceLocationToElementIds[occurrence.sourceLocationId] = occurrence.elementId;
-			}
+		LOG_INFO(
+			"Built include graph of " + std::to_string(m_includeGraph.getFileCount()) +
+			" files with " + std::to_string(m_includeGraph.getComponentCount()) + " components");
+	}
 
-			for (const StorageSourceLocation& sourceLocation:
-				 m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(importedSourceLocationIds))
-			{
-				auto it = importedSourceLocationToElementIds.find(sourceLocation.id);
-				if (it != importedSourceLocationToElementIds.end())
-				{
-					importedElementIdToFileNodeId[it->second] = sourceLocation.fileNodeId;
-				}
-			}
+	return m_includeGraph;
+}
+
+const FileReferenceGraph& PersistentStorage::getImportGraph() const
+{
+	if (m_importGraphValid)
+	{
+		return m_importGraph;
+	}
+
+	TRACE("build import graph");
+
+	std::vector<Id> importedElementIds;
+	std::map<Id, std::set<Id>> elementIdToImportingFileIds;
+
+	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
+		Edge::typeToInt(Edge::EDGE_IMPORT),
+		[&importedElementIds, &elementIdToImportingFileIds](StorageEdge&& edge) {
+			importedElementIds.push_back(edge.targetNodeId);
+			elementIdToImportingFileIds[edge.targetNodeId].insert(edge.sourceNodeId);
+		});
+
+	std::unordered_map<Id, Id> importedElementIdToFileNodeId;
+	{
+		std::vector<Id> importedSourceLocationIds;
+		std::unordered_map<Id, Id> importedSourceLocationToElementIds;
+		for (const StorageOccurrence& occurrence:
+			 m_sqliteIndexStorage.getOccurrencesForElementIds(importedElementIds))
+		{
+			importedSourceLocationIds.push_back(occurrence.sourceLocationId);
+			importedSourceLocationToElementIds[occurrence.sourceLocationId] = occurrence.elementId;
 		}
 
-		for (const auto& it: elementIdToImportingFileIds)
+		for (const StorageSourceLocation& sourceLocation:
+			 m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(importedSourceLocationIds))
 		{
-			auto importedFileIt = importedElementIdToFileNodeId.find(it.first);
-			if (importedFileIt != importedElementIdToFileNodeId.end())
+			auto it = importedSourceLocationToElementIds.find(sourceLocation.id);
+			if (it != importedSourceLocationToElementIds.end())
 			{
-				fileIdToImportingFileIdMap[importedFileIt->second].insert(
-					it.second.begin(), it.second.end());
+				importedElementIdToFileNodeId[it->second] = sourceLocation.fileNodeId;
 			}
 		}
 	}
-	return fileIdToImportingFileIdMap;
-}
 
-std::set<Id> PersistentStorage::getReferenced(
-	const std::set<Id>& ids, std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const
-{
-	std::unordered_map<Id, std::set<Id>> idToReferencedIdMap;
-	for (const auto& it: idToReferencingIdMap)
+	m_importGraph.clear();
+	for (const auto& it: elementIdToImportingFileIds)
 	{
-		for (Id referencingId: it.second)
+		auto importedFileIt = importedElementIdToFileNodeId.find(it.first);
+		if (importedFileIt != importedElementIdToFileNodeId.end())
 		{
-			idToReferencedIdMap[referencingId].insert(it.first);
+			for (Id importingFileId: it.second)
+			{
+				m_importGraph.addReference(importingFileId, importedFileIt->second);
+			}
 		}
 	}
+	m_importGraph.finish();
+	m_importGraphValid = true;
 
-	return getReferencing(ids, idToReferencedIdMap);
+	return m_importGraph;
 }
 
-std::set<Id> PersistentStorage::getReferencing(
-	const std::set<Id>& ids, std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const
+const ErrorIndex& PersistentStorage::getErrorIndex() const
 {
-	std::set<Id> referencingIds;
-
-	std::set<Id> processingIds = ids;
-	std::set<Id> processedIds;
-
-	while (!processingIds.empty())
+	if (!m_errorIndexValid)
 	{
-		std::set<Id> tempIds = processingIds;
-		utility::append(processedIds, processingIds);
-		processingIds.clear();
+		TRACE("build error index");
 
-		for (Id id: tempIds)
-		{
-			utility::append(referencingIds, idToReferencingIdMap[id]);
-			for (Id referencingId: idToReferencingIdMap[id])
-			{
-				if (processedIds.find(referencingId) == processedIds.end())
-				{
-					processingIds.insert(referencingId);
-				}
-			}
-		}
+		m_errorIndex.clear();
+		m_sqliteIndexStorage.forEachErrorInfo(
+			[this](ErrorInfo&& error, Id fileId) { m_errorIndex.addError(error, fileId); });
+		m_errorIndexValid = true;
 	}
 
-	return referencingIds;
+	return m_errorIndex;
 }
 
-std::set<FilePath> PersistentStorage::getReferencedByIncludes(const std::set<FilePath>& filePaths) const
+void PersistentStorage::invalidateErrorIndex()
 {
-	const std::set<Id> ids = getReferenced(
-		getFileNodeIds(filePaths), getFileIdToIncludingFileIdMap());
+	std::lock_guard<std::mutex> lock(m_errorIndexMutex);
+	m_errorIndex.clear();
+	m_errorIndexValid = false;
+}
 
+void PersistentStorage::invalidateFileReferenceGraphs()
+{
+	std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+	m_includeGraph.clear();
+	m_importGraph.clear();
+	m_includeGraphValid = false;
+	m_importGraphValid = false;
+}
+
+std::set<FilePath> PersistentStorage::getFileNodePaths(const std::set<Id>& fileIds) const
+{
 	std::set<FilePath> paths;
-	for (Id id: ids)
-	{	 // TODO: performance optimize: use just one request for all ids!
+	for (Id id: fileIds)
+	{
 		paths.insert(getFileNodePath(id));
 	}
-
 	return paths;
 }
 
-std::set<FilePath> PersistentStorage::getReferencedByImports(const std::set<FilePath>& filePaths) const
+std::set<FilePath> PersistentStorage::getReferencedByIncludes(const std::set<FilePath>& filePaths) const
 {
-	const std::set<Id> ids = getReferenced(
-		getFileNodeIds(filePaths), getFileIdToImportingFileIdMap());
-
-	std::set<FilePath> paths;
-	for (Id id: ids)
+	std::set<Id> ids;
 	{
-		paths.insert(getFileNodePath(id));
+		std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+		ids = getIncludeGraph().getReferenced(getFileNodeIds(filePaths));
 	}
+	return getFileNodePaths(ids);
+}
 
-	return paths;
+std::set<FilePath> PersistentStorage::getReferencedByImports(const std::set<FilePath>& filePaths) const
+{
+	std::set<Id> ids;
+	{
+		std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+		ids = getImportGraph().getReferenced(getFileNodeIds(filePaths));
+	}
+	return getFileNodePaths(ids);
 }
 
 std::set<FilePath> PersistentStorage::getReferencingByIncludes(const std::set<FilePath>& filePaths) const
 {
-	const std::set<Id> ids = getReferencing(
-		getFileNodeIds(filePaths), getFileIdToIncludingFileIdMap());
-
-	std::set<FilePath> paths;
-	for (Id id: ids)
+	std::set<Id> ids;
 	{
-		paths.insert(getFileNodePath(id));
+		std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+		ids = getIncludeGraph().getReferencing(getFileNodeIds(filePaths));
 	}
-
-	return paths;
+	return getFileNodePaths(ids);
 }
 
 std::set<FilePath> PersistentStorage::getReferencingByImports(const std::set<FilePath>& filePaths) const
 {
-	const std::set<Id> ids = getReferencing(
-		getFileNodeIds(filePaths), getFileIdToImportingFileIdMap());
-
-	std::set<FilePath> paths;
-	for (Id id: ids)
+	std::set<Id> ids;
 	{
-		paths.insert(getFileNodePath(id));
+		std::lock_guard<std::mutex> lock(m_fileReferenceGraphMutex);
+		ids = getImportGraph().getReferencing(getFileNodeIds(filePaths));
 	}
-
-	return paths;
+	return getFileNodePaths(ids);
 }
 
 void PersistentStorage::addNodesToGraph(
@@ -2840,30 +3271,36 @@ void PersistentStorage::addNodesToGraph(
 		return;
 	}
 
-	for (const StorageNode& storageNode: m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIds))
+	for (const StorageNode& storageNode: getStorageNodesByIds(nodeIds))
 	{
 		const NodeType type(intToNodeKind(storageNode.type));
 		if (type.isFile())
 		{
-			addFileNodeToGraph(storageNode, graph);
+			addFileNodeToGraph(
+				storageNode.id, *getNameHierarchyForStorageNode(storageNode), graph);
 		}
 		else
 		{
-			addNodeToGraph(storageNode, type, graph, addChildCount);
+			addNodeToGraph(
+				storageNode.id,
+				type,
+				*getNameHierarchyForStorageNode(storageNode),
+				graph,
+				addChildCount);
 		}
 	}
 }
 
-void PersistentStorage::addFileNodeToGraph(const StorageNode& storageNode, Graph* const graph) const
+void PersistentStorage::addFileNodeToGraph(
+	Id nodeId, const NameHierarchy& nameHierarchy, Graph* const graph) const
 {
-	NameHierarchy nameHierarchy = NameHierarchy::deserialize(storageNode.serializedName);
 	const FilePath filePath(nameHierarchy.getRawName());
 
-	bool complete = getFileNodeComplete(storageNode.id);
-	bool indexed = getFileNodeIndexed(storageNode.id);
+	bool complete = getFileNodeComplete(nodeId);
+	bool indexed = getFileNodeIndexed(nodeId);
 
 	Node* node = graph->createNode(
-		storageNode.id,
+		nodeId,
 		NodeType(NODE_FILE),
 		NameHierarchy(filePath.fileName(), NAME_DELIMITER_FILE),
 		indexed ? DEFINITION_EXPLICIT : DEFINITION_NONE);
@@ -2871,21 +3308,24 @@ void PersistentStorage::addFileNodeToGraph(const StorageNode& storageNode, Graph
 }
 
 void PersistentStorage::addNodeToGraph(
-	const StorageNode& newNode, const NodeType& type, Graph* graph, bool addChildCount) const
+	Id nodeId,
+	const NodeType& type,
+	NameHierarchy nameHierarchy,
+	Graph* graph,
+	bool addChildCount) const
 {
-	NameHierarchy nameHierarchy = NameHierarchy::deserialize(newNode.serializedName);
 	DefinitionKind defKind = DEFINITION_NONE;
-	auto it = m_symbolDefinitionKinds.find(newNode.id);
+	auto it = m_symbolDefinitionKinds.find(nodeId);
 	if (it != m_symbolDefinitionKinds.end())
 	{
 		defKind = it->second;
 	}
 
-	Node* node = graph->createNode(newNode.id, type, std::move(nameHierarchy), defKind);
+	Node* node = graph->createNode(nodeId, type, std::move(nameHierarchy), defKind);
 
 	if (addChildCount)
 	{
-		node->setChildCount(m_hierarchyCache.getFirstChildIdsCountForNodeId(newNode.id));
+		node->setChildCount(m_hierarchyCache.getFirstChildIdsCountForNodeId(nodeId));
 	}
 }
 
@@ -3241,21 +3681,8 @@ void PersistentStorage::buildFilePathMaps()
 {
 	TRACE();
 
-	m_sqliteIndexStorage.forEach<StorageFile>([&](StorageFile&& file) {
-		const FilePath path(file.filePath);
-
-		m_fileNodeIds.emplace(path, file.id);
-		m_lowerCasefileNodeIds.emplace(path.getLowerCase(), file.id);
-		m_fileNodePaths.emplace(file.id, path);
-		m_fileNodeComplete.emplace(file.id, file.complete);
-		m_fileNodeIndexed.emplace(file.id, file.indexed);
-		m_fileNodeLanguage.emplace(file.id, file.languageIdentifier);
-
-		if (!m_hasJavaFiles && path.extension() == L".java")
-		{
-			m_hasJavaFiles = true;
-		}
-	});
+	m_sqliteIndexStorage.forEach<StorageFile>(
+		[this](StorageFile&& file) { addFileToCaches(file); });
 
 	m_sqliteIndexStorage.forEach<StorageSymbol>([&](StorageSymbol&& symbol) {
 		m_symbolDefinitionKinds.emplace(symbol.id, intToDefinitionKind(symbol.definitionKind));
@@ -3266,55 +3693,10 @@ void PersistentStorage::buildSearchIndex()
 {
 	TRACE();
 
-	const FilePath dbPath = getIndexDbFilePath();
-
-	m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
-		const NodeType type(intToNodeKind(node.type));
-		if (type.isFile())
-		{
-			bool indexed = getFileNodeIndexed(node.id);
-			if (!indexed)
-			{
-				return;
-			}
-
-			auto it = m_fileNodePaths.find(node.id);
-			if (it != m_fileNodePaths.end())
-			{
-				FilePath filePath(it->second);
-
-				if (filePath.exists())
-				{
-					filePath.makeRelativeTo(dbPath);
-				}
-
-				m_fileIndex.addNode(node.id, filePath.wstr(), type);
-			}
-		}
-		else
-		{
-			auto it = m_symbolDefinitionKinds.find(node.id);
-			const DefinitionKind defKind =
-				(it != m_symbolDefinitionKinds.end() ? it->second : DEFINITION_NONE);
-			if (defKind != DEFINITION_IMPLICIT)
-			{
-				const NameHierarchy nameHierarchy = NameHierarchy::deserialize(node.serializedName);
-
-				// we don't use the signature here, so elements with the same signature share the
-				// same node.
-				std::wstring name = nameHierarchy.getQualifiedName();
-
-				// replace template arguments with .. to avoid clutter in search results and have
-				// different template specializations share the same node.
-				if (defKind == DEFINITION_NONE &&
-					nameHierarchy.getDelimiter() == nameDelimiterTypeToString(NAME_DELIMITER_CXX))
-				{
-					name = utility::replaceBetween(name, L'<', L'>', L"..");
-				}
-
-				m_symbolIndex.addNode(node.id, std::move(name), type);
-			}
-		}
+	// fills the node table in the same pass over all nodes
+	m_sqliteIndexStorage.forEach<StorageNode>([this](StorageNode&& node) {
+		addNodeToSearchIndex(node);
+		m_nodeTable.addNode(node);
 	});
 
 	m_symbolIndex.finishSetup();
@@ -3439,14 +3821,77 @@ void PersistentStorage::buildHierarchyCache()
 {
 	TRACE();
 
-	std::vector<Id> sourceNodeIds;
 	std::vector<StorageEdge> memberEdges;
+	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
+		Edge::typeToInt(Edge::EDGE_MEMBER),
+		[&memberEdges](StorageEdge&& edge) { memberEdges.emplace_back(edge); });
+
+	addMemberEdgesToHierarchyCache(memberEdges);
 
 	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_MEMBER), [&sourceNodeIds, &memberEdges](StorageEdge&& edge) {
-			sourceNodeIds.push_back(edge.sourceNodeId);
-			memberEdges.emplace_back(edge);
+		Edge::typeToInt(Edge::EDGE_INHERITANCE), [this](StorageEdge&& edge) {
+			m_hierarchyCache.createInheritance(edge.id, edge.sourceNodeId, edge.targetNodeId);
 		});
+}
+
+const std::vector<Id>& PersistentStorage::getOverviewNodeIds() const
+{
+	if (m_overviewNodeIdsValid)
+	{
+		return m_overviewNodeIds;
+	}
+
+	TRACE("build overview node ids");
+
+	m_overviewNodeIds.clear();
+
+	const size_t sdk_size = m_symbolDefinitionKinds.size();
+	m_nodeTable.forEachNode([&, sdk_size](Id nodeId, int nodeType) {
+		const NodeType type(intToNodeKind(nodeType));
+		if (type.isFile())
+		{
+			auto fn_it = m_fileNodeIndexed.find(nodeId);
+			if (fn_it != m_fileNodeIndexed.end() && fn_it->second)
+			{
+				m_overviewNodeIds.push_back(nodeId);
+			}
+		}
+		else
+		{
+			bool showNode = true;
+			if (sdk_size)
+			{
+				auto it = m_symbolDefinitionKinds.find(nodeId);
+				showNode = (it != m_symbolDefinitionKinds.end() && it->second == DEFINITION_EXPLICIT);
+			}
+			if (showNode &&
+				(type.isPackage() || !m_hierarchyCache.isChildOfVisibleNodeOrInvisible(nodeId)))
+			{
+				m_overviewNodeIds.push_back(nodeId);
+			}
+		}
+	});
+
+	std::sort(m_overviewNodeIds.begin(), m_overviewNodeIds.end());
+	m_overviewNodeIdsValid = true;
+
+	return m_overviewNodeIds;
+}
+
+void PersistentStorage::invalidateOverviewNodeIds()
+{
+	std::lock_guard<std::mutex> lock(m_overviewNodeIdsMutex);
+	m_overviewNodeIds.clear();
+	m_overviewNodeIdsValid = false;
+}
+
+void PersistentStorage::addMemberEdgesToHierarchyCache(const std::vector<StorageEdge>& memberEdges)
+{
+	std::vector<Id> sourceNodeIds;
+	for (const StorageEdge& edge: memberEdges)
+	{
+		sourceNodeIds.push_back(edge.sourceNodeId);
+	}
 
 	std::set<Id> invisibleParentSourceNodeIds;
 
@@ -3488,9 +3933,106 @@ void PersistentStorage::buildHierarchyCache()
 			sourceIsImplicit,
 			targetIsImplicit);
 	}
+}
 
-	m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-		Edge::typeToInt(Edge::EDGE_INHERITANCE), [this](StorageEdge&& edge) {
-			m_hierarchyCache.createInheritance(edge.id, edge.sourceNodeId, edge.targetNodeId);
-		});
+void PersistentStorage::addNodeToSearchIndex(const StorageNode& node)
+{
+	const NodeType type(intToNodeKind(node.type));
+	if (type.isFile())
+	{
+		if (!getFileNodeIndexed(node.id))
+		{
+			return;
+		}
+
+		auto it = m_fileNodePaths.find(node.id);
+		if (it != m_fileNodePaths.end())
+		{
+			FilePath filePath(it->second);
+
+			if (filePath.exists())
+			{
+				filePath.makeRelativeTo(getIndexDbFilePath());
+			}
+
+			m_fileIndex.addNode(node.id, filePath.wstr(), type);
+			m_fileSearchNames[node.id] = filePath.wstr();
+		}
+	}
+	else
+	{
+		auto it = m_symbolDefinitionKinds.find(node.id);
+		const DefinitionKind defKind =
+			(it != m_symbolDefinitionKinds.end() ? it->second : DEFINITION_NONE);
+		if (defKind != DEFINITION_IMPLICIT)
+		{
+			m_symbolIndex.addNode(node.id, getSymbolSearchName(node.serializedName, defKind), type);
+		}
+	}
+}
+
+void PersistentStorage::removeNodeFromSearchIndex(const StorageNode& node)
+{
+	if (NodeType(intToNodeKind(node.type)).isFile())
+	{
+		auto it = m_fileSearchNames.find(node.id);
+		if (it != m_fileSearchNames.end())
+		{
+			m_fileIndex.removeNode(node.id, it->second);
+			m_fileSearchNames.erase(it);
+		}
+	}
+	else
+	{
+		auto it = m_symbolDefinitionKinds.find(node.id);
+		const DefinitionKind defKind =
+			(it != m_symbolDefinitionKinds.end() ? it->second : DEFINITION_NONE);
+		if (defKind != DEFINITION_IMPLICIT)
+		{
+			m_symbolIndex.removeNode(node.id, getSymbolSearchName(node.serializedName, defKind));
+		}
+	}
+}
+
+void PersistentStorage::addFileToCaches(const StorageFile& file)
+{
+	const FilePath path(utility::decodeFromUtf8(file.filePath));
+
+	m_fileNodeIds.emplace(path, file.id);
+	m_lowerCasefileNodeIds.emplace(path.getLowerCase(), file.id);
+	m_fileNodePaths.emplace(file.id, path);
+	m_fileNodeComplete.emplace(file.id, file.complete);
+	m_fileNodeIndexed.emplace(file.id, file.indexed);
+	m_fileNodeLanguage.emplace(file.id, file.languageIdentifier);
+
+	if (!m_hasJavaFiles && path.extension() == L".java")
+	{
+		m_hasJavaFiles = true;
+	}
+}
+
+void PersistentStorage::removeFileFromCaches(Id fileId)
+{
+	auto it = m_fileNodePaths.find(fileId);
+	if (it == m_fileNodePaths.end())
+	{
+		return;
+	}
+
+	auto idIt = m_fileNodeIds.find(it->second);
+	if (idIt != m_fileNodeIds.end() && idIt->second == fileId)
+	{
+		m_fileNodeIds.erase(idIt);
+	}
+
+	idIt = m_lowerCasefileNodeIds.find(it->second.getLowerCase());
+	if (idIt != m_lowerCasefileNodeIds.end() && idIt->second == fileId)
+	{
+		m_lowerCasefileNodeIds.erase(idIt);
+	}
+
+	m_fileNodePaths.erase(it);
+	m_fileNodeComplete.erase(fileId);
+	m_fileNodeIndexed.erase(fileId);
+	m_fileNodeLanguage.erase(fileId);
 }
@@ -2,10 +2,14 @@
 #define PERSISTENT_STORAGE_H
 
 #include <memory>
+#include <shared_mutex>
 #include <vector>
 
+#include "ErrorIndex.h"
+#include "FileReferenceGraph.h"
 #include "FullTextSearchIndex.h"
 #include "HierarchyCache.h"
+#include "NodeTable.h"
 #include "SearchIndex.h"
 #include "SqliteBookmarkStorage.h"
 #include "SqliteIndexStorage.h"
@@ -59,6 +63,14 @@ public:
 	void finishInjection() override;
 	void rollbackInjection();
 
+	// keeps all changes of an in-place refresh in one transaction on the write ahead log, so other
+	// storages of the same database keep showing the current state until the refresh is committed,
+	// returns false without starting the refresh if the write ahead log is not available
+	bool startInPlaceRefresh();
+	void commitInPlaceRefresh();
+	void rollbackInPlaceRefresh();
+	StorageChanges getInPlaceRefreshChanges() const;
+
 	void beforeErrorRecording();
 	void afterErrorRecording();
 
@@ -90,6 +102,9 @@ public:
 
 	void buildCaches();
 
+	// updates the caches for elements changed by another storage of the same database
+	void applyChanges(const StorageChanges& changes);
+
 	void optimizeMemory();
 
 	// StorageAccess implementation
@@ -111,14 +126,16 @@ public:
 		const std::wstring& searchTerm, bool caseSensitive) const override;
 
 	std::vector<SearchMatch> getAutocompletionMatches(
-		const std::wstring& query, NodeTypeSet acceptedNodeTypes, bool acceptCommands) const override;
+		const std::wstring& query,
+		NodeTypeSet acceptedNodeTypes,
+		bool acceptCommands,
+		const AutocompletionRequest& request) const override;
 	std::vector<SearchMatch> getAutocompletionSymbolMatches(
+		const std::vector<SearchResult>& results, const NodeTypeSet& acceptedNodeTypes) const;
+	std::vector<SearchMatch> getAutocompletionFileMatches(
 		const std::wstring& query,
-		const NodeTypeSet& acceptedNodeTypes,
 		size_t maxResultsCount,
-		size_t maxBestScoredResultsLength) const;
-	std::vector<SearchMatch> getAutocompletionFileMatches(
-		const std::wstring& query, size_t maxResultsCount) const;
+		const AutocompletionRequest& request) const;
 	std::vector<SearchMatch> getAutocompletionCommandMatches(
 		const std::wstring& query, NodeTypeSet acceptedNodeTypes) const;
 	std::vector<SearchMatch> getSearchMatchesForTokenIds(const std::vector<Id>& elementIds) const override;
@@ -218,15 +235,28 @@ private:
 	bool getFileNodeIndexed(Id fileId) const;
 	std::wstring getFileNodeLanguage(Id fileId) const;
 
-	std::unordered_map<Id, std::set<Id>> getFileIdToIncludingFileIdMap() const;
-	std::unordered_map<Id, std::set<Id>> getFileIdToIncludedFileIdMap() const;
-	std::unordered_map<Id, std::set<Id>> getFileIdToImportingFileIdMap() const;
-	std::set<Id> getReferenced(
-		const std::set<Id>& filePaths,
-		std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const;
-	std::set<Id> getReferencing(
-		const std::set<Id>& filePaths,
-		std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const;
+	// take the nodes from the node table and only query the database for the others, the nodes are
+	// ordered by id
+	StorageNode getStorageNodeById(Id nodeId) const;
+	std::vector<StorageNode> getStorageNodesByIds(const std::vector<Id>& nodeIds) const;
+	std::shared_ptr<const NameHierarchy> getNameHierarchyForStorageNode(
+		const StorageNode& node) const;
+
+	// both graphs are built on first use and kept until the stored edges change, requires holding
+	// m_fileReferenceGraphMutex
+	const FileReferenceGraph& getIncludeGraph() const;
+	const FileReferenceGraph& getImportGraph() const;
+	void invalidateFileReferenceGraphs();
+
+	// built on first use and kept until the stored errors change, requires holding m_errorIndexMutex
+	const ErrorIndex& getErrorIndex() const;
+	void invalidateErrorIndex();
+
+	// built on first use from the caches and kept until they change, requires holding
+	// m_overviewNodeIdsMutex
+	const std::vector<Id>& getOverviewNodeIds() const;
+	void invalidateOverviewNodeIds();
+	std::set<FilePath> getFileNodePaths(const std::set<Id>& fileIds) const;
 
 	std::set<FilePath> getReferencedByIncludes(const std::set<FilePath>& filePaths) const;
 	std::set<FilePath> getReferencedByImports(const std::set<FilePath>& filePaths) const;
@@ -241,9 +271,14 @@ private:
 		const std::vector<Id>& edgeIds,
 		Graph* graphh,
 		bool addChildCount) const;
-	inline void addFileNodeToGraph(const StorageNode& storageNode, Graph* const graph) const;
+	inline void addFileNodeToGraph(
+		Id nodeId, const NameHierarchy& nameHierarchy, Graph* const graph) const;
 	void addNodeToGraph(
-		const StorageNode& newNode, const NodeType& type, Graph* graph, bool addChildCount) const;
+		Id nodeId,
+		const NodeType& type,
+		NameHierarchy nameHierarchy,
+		Graph* graph,
+		bool addChildCount) const;
 	void addAggregationEdgesToGraph(
 		Id nodeId, const std::vector<StorageEdge>& edgesToAggregate, Graph* graph) const;
 	void addFileContentsToGraph(Id fileId, Graph* graph) const;
@@ -258,6 +293,12 @@ private:
 	void buildFullTextSearchIndex() const;
 	void buildMemberEdgeIdOrderMap();
 	void buildHierarchyCache();
+	void addMemberEdgesToHierarchyCache(const std::vector<StorageEdge>& memberEdges);
+
+	void addNodeToSearchIndex(const StorageNode& node);
+	void removeNodeFromSearchIndex(const StorageNode& node);
+	void addFileToCaches(const StorageFile& file);
+	void removeFileFromCaches(Id fileId);
 
 	bool m_preIndexingErrorCountSet = false;
 	size_t m_preIndexingErrorCount = 0;
@@ -267,6 +308,12 @@ private:
 	SearchIndex m_symbolIndex;
 	SearchIndex m_fileIndex;
 
+	// continued by the autocompletion queries while a query is typed, only one query uses them at a
+	// time, others search without a session
+	mutable SearchIndex::SearchSession m_symbolSearchSession;
+	mutable SearchIndex::SearchSession m_fileSearchSession;
+	mutable std::mutex m_searchSessionMutex;
+
 	mutable FullTextSearchIndex m_fullTextSearchIndex;
 	mutable std::string m_fullTextSearchCodec;
 	mutable std::mutex m_fullTextSearchMutex;
@@ -274,18 +321,39 @@ private:
 	SqliteIndexStorage m_sqliteIndexStorage;
 	SqliteBookmarkStorage m_sqliteBookmarkStorage;
 
+	// held shared by the public queries and exclusively while the caches below are built or
+	// changed, so applyChanges on the app thread does not race with queries of the tabs
+	mutable std::shared_timed_mutex m_cacheMutex;
+
 	std::map<FilePath, Id> m_fileNodeIds;
 	std::map<FilePath, Id> m_lowerCasefileNodeIds;
 	std::map<Id, FilePath> m_fileNodePaths;
 	std::map<Id, bool> m_fileNodeComplete;
 	std::unordered_map<Id, bool> m_fileNodeIndexed;
 	std::map<Id, std::wstring> m_fileNodeLanguage;
+	std::unordered_map<Id, std::wstring> m_fileSearchNames;
 
 	std::unordered_map<Id, DefinitionKind> m_symbolDefinitionKinds;
+	NodeTable m_nodeTable;
 	std::map<Id, Id> m_memberEdgeIdOrderMap;
 
 	HierarchyCache m_hierarchyCache;
 
+	// nodes shown by the overview graph ordered by id, computed from the caches above
+	mutable std::vector<Id> m_overviewNodeIds;
+	mutable bool m_overviewNodeIdsValid = false;
+	mutable std::mutex m_overviewNodeIdsMutex;
+
+	mutable FileReferenceGraph m_includeGraph;
+	mutable FileReferenceGraph m_importGraph;
+	mutable bool m_includeGraphValid = false;
+	mutable bool m_importGraphValid = false;
+	mutable std::mutex m_fileReferenceGraphMutex;
+
+	mutable ErrorIndex m_errorIndex;
+	mutable bool m_errorIndexValid = false;
+	mutable std::mutex m_errorIndexMutex;
+
 	bool m_hasJavaFiles = false;
 };
 
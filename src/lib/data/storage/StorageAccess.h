@@ -7,6 +7,7 @@
 
 #include "types.h"
 
+#include "AutocompletionRequest.h"
 #include "BookmarkCategory.h"
 #include "EdgeBookmark.h"
 #include "ErrorCountInfo.h"
@@ -53,7 +54,10 @@ public:
 	virtual std::shared_ptr<SourceLocationCollection> getFullTextSearchLocations(
 		const std::wstring& searchTerm, bool caseSensitive) const = 0;
 	virtual std::vector<SearchMatch> getAutocompletionMatches(
-		const std::wstring& query, NodeTypeSet acceptedNodeTypes, bool acceptCommands) const = 0;
+		const std::wstring& query,
+		NodeTypeSet acceptedNodeTypes,
+		bool acceptCommands,
+		const AutocompletionRequest& request) const = 0;
 	virtual std::vector<SearchMatch> getSearchMatchesForTokenIds(
 		const std::vector<Id>& tokenIds) const = 0;
 
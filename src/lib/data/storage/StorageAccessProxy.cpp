@@ -170,11 +170,12 @@ DEF_GETTER_2(
 	bool,
 	std::shared_ptr<SourceLocationCollection>,
 	std::make_shared<SourceLocationCollection>())
-DEF_GETTER_3(
+DEF_GETTER_4(
 	getAutocompletionMatches,
 	const std::wstring&,
 	NodeTypeSet,
 	bool,
+	const AutocompletionRequest&,
 	std::vector<SearchMatch>,
 	std::vector<SearchMatch>())
 DEF_GETTER_1(
@@ -0,0 +1,29 @@
+#ifndef STORAGE_CHANGES_H
+#define STORAGE_CHANGES_H
+
+#include <vector>
+
+#include "StorageEdge.h"
+#include "StorageNode.h"
+#include "types.h"
+
+// Elements a storage changed since it started tracking changes. Caches built from the previous
+// state can be updated by removing the previous state of these elements and adding them again if
+// they still exist.
+struct StorageChanges
+{
+	bool empty() const
+	{
+		return nodeIds.empty() && edgeIds.empty();
+	}
+
+	// nodes with changed node, symbol or file data
+	std::vector<Id> nodeIds;
+	// state before the first change, only contains the elements that existed
+	std::vector<StorageNode> previousNodes;
+
+	std::vector<Id> edgeIds;
+	std::vector<StorageEdge> previousEdges;
+};
+
+#endif	  // STORAGE_CHANGES_H
@@ -1,33 +1,109 @@
 #include "StorageProvider.h"
 
+#include <algorithm>
+
 #include "logging.h"
 
+const size_t StorageProvider::s_defaultMemoryBudget = 1073741824 /* 1 GB */;
+const size_t StorageProvider::s_minimumTargetByteSize = 67108864 /* 64 MB */;
+const double StorageProvider::s_queuedInjectionSeconds = 10.0;
+const double StorageProvider::s_injectionSpeedSmoothing = 0.3;
+
+StorageProvider::StorageProvider()
+	: m_byteSize(0), m_memoryBudget(s_defaultMemoryBudget), m_injectionBytesPerSecond(0.0)
+{
+}
+
 int StorageProvider::getStorageCount() const
 {
 	std::lock_guard<std::mutex> lock(m_storagesMutex);
 	return static_cast<int>(m_storages.size());
 }
 
+size_t StorageProvider::getByteSize() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_byteSize;
+}
+
+void StorageProvider::setMemoryBudget(size_t byteSize)
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	m_memoryBudget = byteSize;
+}
+
+size_t StorageProvider::getMemoryBudget() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_memoryBudget;
+}
+
+void StorageProvider::recordInjection(size_t byteSize, float seconds)
+{
+	if (seconds <= 0.0f)
+	{
+		return;
+	}
+
+	const double bytesPerSecond = byteSize / seconds;
+
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	if (m_injectionBytesPerSecond <= 0.0)
+	{
+		m_injectionBytesPerSecond = bytesPerSecond;
+	}
+	else
+	{
+		m_injectionBytesPerSecond += s_injectionSpeedSmoothing *
+			(bytesPerSecond - m_injectionBytesPerSecond);
+	}
+}
+
+double StorageProvider::getInjectionBytesPerSecond() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_injectionBytesPerSecond;
+}
+
+size_t StorageProvider::getTargetByteSize() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return getTargetByteSizeUnlocked();
+}
+
+bool StorageProvider::isAboveTargetByteSize() const
+{
+	std::lock_guard<std::mutex> lock(m_storagesMutex);
+	return m_byteSize > getTargetByteSizeUnlocked();
+}
+
 void StorageProvider::clear()
 {
 	std::lock_guard<std::mutex> lock(m_storagesMutex);
-	return m_storages.clear();
+	m_storages.clear();
+	m_byteSize = 0;
 }
 
 void StorageProvider::insert(std::shared_ptr<IntermediateStorage> storage)
+{
+	insert(storage, storage->getByteSize(sizeof(std::wstring)));
+}
+
+void StorageProvider::insert(std::shared_ptr<IntermediateStorage> storage, size_t byteSize)
 {
 	const std::size_t storageSize = storage->getSourceLocationCount();
-	std::list<std::shared_ptr<IntermediateStorage>>::iterator it;
+	std::list<QueuedStorage>::iterator it;
 
 	std::lock_guard<std::mutex> lock(m_storagesMutex);
 	for (it = m_storages.begin(); it != m_storages.end(); it++)
 	{
-		if ((*it)->getSourceLocationCount() < storageSize)
+		if (it->storage->getSourceLocationCount() < storageSize)
 		{
 			break;
 		}
 	}
-	m_storages.insert(it, storage);
+	m_storages.insert(it, {storage, byteSize});
+	m_byteSize += byteSize;
 }
 
 std::shared_ptr<IntermediateStorage> StorageProvider::consumeSecondLargestStorage()
@@ -37,9 +113,10 @@ std::shared_ptr<IntermediateStorage> StorageProvider::consumeSecondLargestStorag
 		std::lock_guard<std::mutex> lock(m_storagesMutex);
 		if (m_storages.size() > 1)
 		{
-			std::list<std::shared_ptr<IntermediateStorage>>::iterator it = m_storages.begin();
+			std::list<QueuedStorage>::iterator it = m_storages.begin();
 			it++;
-			ret = *it;
+			ret = it->storage;
+			m_byteSize -= it->byteSize;
 			m_storages.erase(it);
 		}
 	}
@@ -53,7 +130,8 @@ std::shared_ptr<IntermediateStorage> StorageProvider::consumeLargestStorage()
 		std::lock_guard<std::mutex> lock(m_storagesMutex);
 		if (!m_storages.empty())
 		{
-			ret = m_storages.front();
+			ret = m_storages.front().storage;
+			m_byteSize -= m_storages.front().byteSize;
 			m_storages.pop_front();
 		}
 	}
@@ -66,10 +144,31 @@ void StorageProvider::logCurrentState() const
 	std::string logString = "Storages waiting for injection:";
 	{
 		std::lock_guard<std::mutex> lock(m_storagesMutex);
-		for (const std::shared_ptr<IntermediateStorage>& storage: m_storages)
+		for (const QueuedStorage& queuedStorage: m_storages)
 		{
-			logString += " " + std::to_string(storage->getSourceLocationCount()) + ";";
+			logString += " " + std::to_string(queuedStorage.storage->getSourceLocationCount()) + ";";
 		}
+		logString += " bytes: " + std::to_string(m_byteSize) + "/" +
+			std::to_string(getTargetByteSizeUnlocked()) + " (budget " +
+			std::to_string(m_memoryBudget) + ")";
 	}
 	LOG_INFO(logString);
 }
+
+size_t StorageProvider::getTargetByteSizeUnlocked() const
+{
+	if (m_injectionBytesPerSecond <= 0.0)
+	{
+		// nothing injected yet, so there is nothing to adapt to
+		return m_memoryBudget;
+	}
+
+	const double targetByteSize = m_injectionBytesPerSecond * s_queuedInjectionSeconds;
+	if (targetByteSize >= m_memoryBudget)
+	{
+		return m_memoryBudget;
+	}
+
+	return std::max(
+		static_cast<size_t>(targetByteSize), std::min(s_minimumTargetByteSize, m_memoryBudget));
+}
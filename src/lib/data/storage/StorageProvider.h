@@ -6,14 +6,34 @@
 #include <memory>
 #include <mutex>
 
+// Holds the intermediate storages waiting to be merged and injected. The storages are accounted
+// against a memory budget. How much of the budget should be filled adapts to the measured
+// injection speed: only the amount of data that can be injected within a few seconds is kept
+// queued, so fast injection lets the indexers run ahead while slow injection throttles them early.
 class StorageProvider
 {
 public:
+	StorageProvider();
+
 	int getStorageCount() const;
 
+	// sum of the byte sizes of all queued storages
+	size_t getByteSize() const;
+
+	void setMemoryBudget(size_t byteSize);
+	size_t getMemoryBudget() const;
+
+	void recordInjection(size_t byteSize, float seconds);
+	double getInjectionBytesPerSecond() const;
+
+	// byte size of queued storages that keeps injection busy without exceeding the memory budget
+	size_t getTargetByteSize() const;
+	bool isAboveTargetByteSize() const;
+
 	void clear();
 
 	void insert(std::shared_ptr<IntermediateStorage> storage);
+	void insert(std::shared_ptr<IntermediateStorage> storage, size_t byteSize);
 
 	// returns empty shared_ptr if no storages available
 	std::shared_ptr<IntermediateStorage> consumeSecondLargestStorage();
@@ -24,7 +44,23 @@ public:
 	void logCurrentState() const;
 
 private:
-	std::list<std::shared_ptr<IntermediateStorage>> m_storages;	   // larger storages are in front
+	struct QueuedStorage
+	{
+		std::shared_ptr<IntermediateStorage> storage;
+		size_t byteSize;
+	};
+
+	static const size_t s_defaultMemoryBudget;
+	static const size_t s_minimumTargetByteSize;
+	static const double s_queuedInjectionSeconds;
+	static const double s_injectionSpeedSmoothing;
+
+	size_t getTargetByteSizeUnlocked() const;
+
+	std::list<QueuedStorage> m_storages;	// larger storages are in front
+	size_t m_byteSize;
+	size_t m_memoryBudget;
+	double m_injectionBytesPerSecond;
 	mutable std::mutex m_storagesMutex;
 };
 
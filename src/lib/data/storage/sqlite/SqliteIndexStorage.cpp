@@ -8,6 +8,7 @@
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
+#include "TimeStamp.h"
 #include "logging.h"
 #include "utilityString.h"
 
@@ -25,6 +26,44 @@ std::pair<std::wstring, std::wstring> splitLocalSymbolName(const std::wstring& n
 
 	return std::make_pair(name.substr(0, pos), name.substr(pos + 1, name.size() - pos - 2));
 }
+
+// name and definition of the triggers filling node_change and edge_change, the first change of an
+// element is kept, so the tables hold the state from before tracking started
+std::vector<std::pair<std::string, std::string>> getChangeTrackingTriggers()
+{
+	const std::string insertNode =
+		"INSERT OR IGNORE INTO node_change VALUES(NEW.id, 0, 0, NULL); ";
+	const std::string keepNode =
+		"INSERT OR IGNORE INTO node_change VALUES(OLD.id, 1, OLD.type, OLD.serialized_name); ";
+
+	// symbol and file data are part of the node state
+	const std::string keepNodeOfNew =
+		"INSERT OR IGNORE INTO node_change "
+		"	SELECT id, 1, type, serialized_name FROM main.node WHERE id == NEW.id; ";
+	const std::string keepNodeOfOld =
+		"INSERT OR IGNORE INTO node_change "
+		"	SELECT id, 1, type, serialized_name FROM main.node WHERE id == OLD.id; ";
+
+	const std::string insertEdge =
+		"INSERT OR IGNORE INTO edge_change VALUES(NEW.id, 0, 0, 0, 0); ";
+	const std::string keepEdge =
+		"INSERT OR IGNORE INTO edge_change "
+		"	VALUES(OLD.id, 1, OLD.type, OLD.source_node_id, OLD.target_node_id); ";
+
+	return {
+		{"node_change_insert", "AFTER INSERT ON node BEGIN " + insertNode + "END"},
+		{"node_change_update", "BEFORE UPDATE ON node BEGIN " + keepNode + "END"},
+		{"node_change_delete", "BEFORE DELETE ON node BEGIN " + keepNode + "END"},
+		{"symbol_change_insert", "BEFORE INSERT ON symbol BEGIN " + keepNodeOfNew + "END"},
+		{"symbol_change_update", "BEFORE UPDATE ON symbol BEGIN " + keepNodeOfOld + "END"},
+		{"symbol_change_delete", "BEFORE DELETE ON symbol BEGIN " + keepNodeOfOld + "END"},
+		{"file_change_insert", "BEFORE INSERT ON file BEGIN " + keepNodeOfNew + "END"},
+		{"file_change_update", "BEFORE UPDATE ON file BEGIN " + keepNodeOfOld + "END"},
+		{"file_change_delete", "BEFORE DELETE ON file BEGIN " + keepNodeOfOld + "END"},
+		{"edge_change_insert", "AFTER INSERT ON edge BEGIN " + insertEdge + "END"},
+		{"edge_change_update", "BEFORE UPDATE ON edge BEGIN " + keepEdge + "END"},
+		{"edge_change_delete", "BEFORE DELETE ON edge BEGIN " + keepEdge + "END"}};
+}
 }	 // namespace
 
 size_t SqliteIndexStorage::getStorageVersion()
@@ -45,7 +84,6 @@ size_t SqliteIndexStorage::getStaticVersion() const
 void SqliteIndexStorage::setMode(const StorageModeType mode)
 {
 	m_tempNodeNameIndex.clear();
-	m_tempWNodeNameIndex.clear();
 	m_tempNodeTypes.clear();
 	m_tempEdgeIndex.clear();
 	m_tempLocalSymbolIndex.clear();
@@ -83,19 +121,14 @@ Id SqliteIndexStorage::addNode(const StorageNodeData& data)
 
 std::vector<Id> SqliteIndexStorage::addNodes(const std::vector<StorageNode>& nodes)
 {
-	if (m_tempNodeNameIndex.empty() && m_tempWNodeNameIndex.empty())
+	if (m_tempNodeNameIndex.empty())
 	{
-		forEach<StorageNode>([this](StorageNode&& node) {
-			std::string name = utility::encodeToUtf8(node.serializedName);
-			if (name.size() != node.serializedName.size())
-			{
-				m_tempWNodeNameIndex.add(node.serializedName, static_cast<uint32_t>(node.id));
-			}
-			else
-			{
-				m_tempNodeNameIndex.add(name, static_cast<uint32_t>(node.id));
-			}
+		const size_t nodeCount = static_cast<size_t>(getNodeCount()) + nodes.size();
+		m_tempNodeNameIndex.reserve(nodeCount);
+		m_tempNodeTypes.reserve(nodeCount);
 
+		forEach<StorageNode>([this](StorageNode&& node) {
+			m_tempNodeNameIndex.add(node.serializedName, static_cast<uint32_t>(node.id));
 			m_tempNodeTypes.emplace(static_cast<uint32_t>(node.id), node.type);
 		});
 	}
@@ -105,47 +138,28 @@ std::vector<Id> SqliteIndexStorage::addNodes(const std::vector<StorageNode>& nod
 	for (size_t i = 0; i < nodes.size(); i++)
 	{
 		const StorageNodeData& data = nodes[i];
-		std::string name = utility::encodeToUtf8(data.serializedName);
+		const Id nodeId = m_tempNodeNameIndex.find(data.serializedName);
+		if (nodeId)
 		{
-			Id nodeId;
-			if (name.size() != data.serializedName.size())
-			{
-				nodeId = m_tempWNodeNameIndex.find(data.serializedName);
-			}
-			else
+			auto it = m_tempNodeTypes.find(static_cast<uint32_t>(nodeId));
+			if (it != m_tempNodeTypes.end() && it->second < data.type)
 			{
-				nodeId = m_tempNodeNameIndex.find(name);
+				setNodeType(data.type, nodeId);
+				m_tempNodeTypes[static_cast<uint32_t>(nodeId)] = data.type;
 			}
 
-			if (nodeId)
-			{
-				auto it = m_tempNodeTypes.find(static_cast<uint32_t>(nodeId));
-				if (it != m_tempNodeTypes.end() && it->second < data.type)
-				{
-					setNodeType(data.type, nodeId);
-					m_tempNodeTypes[static_cast<uint32_t>(nodeId)] = data.type;
-				}
-
-				nodeIds[i] = nodeId;
-			}
-			else
-			{
-				executeStatement(m_insertElementStmt);
-				const Id id = static_cast<Id>(m_database.lastRowId());
+			nodeIds[i] = nodeId;
+		}
+		else
+		{
+			executeStatement(m_insertElementStmt);
+			const Id id = static_cast<Id>(m_database.lastRowId());
 
-				nodesToInsert.emplace_back(id, data);
-				nodeIds[i] = id;
+			nodesToInsert.emplace_back(id, data);
+			nodeIds[i] = id;
 
-				if (name.size() != data.serializedName.size())
-				{
-					m_tempWNodeNameIndex.add(data.serializedName, static_cast<uint32_t>(id));
-				}
-				else
-				{
-					m_tempNodeNameIndex.add(name, static_cast<uint32_t>(id));
-				}
-				m_tempNodeTypes.emplace(static_cast<uint32_t>(id), data.type);
-			}
+			m_tempNodeNameIndex.add(data.serializedName, static_cast<uint32_t>(id));
+			m_tempNodeTypes.emplace(static_cast<uint32_t>(id), data.type);
 		}
 	}
 
@@ -169,12 +183,12 @@ bool SqliteIndexStorage::addSymbols(const std::vector<StorageSymbol>& symbols)
 
 bool SqliteIndexStorage::addFile(const StorageFile& data)
 {
-	if (getFileByPath(data.filePath).id != 0)
+	if (doGetFirst<StorageFile>("WHERE file.path == '" + data.filePath + "'").id != 0)
 	{
 		return false;
 	}
 
-	FilePath filePath(data.filePath);
+	FilePath filePath(utility::decodeFromUtf8(data.filePath));
 
 	std::string modificationTime(data.modificationTime);
 	if (modificationTime.empty())
@@ -193,7 +207,7 @@ bool SqliteIndexStorage::addFile(const StorageFile& data)
 	bool success = false;
 	{
 		m_insertFileStmt.bind(1, int(data.id));
-		m_insertFileStmt.bind(2, utility::encodeToUtf8(data.filePath).c_str());
+		m_insertFileStmt.bind(2, data.filePath.c_str());
 		m_insertFileStmt.bind(3, utility::encodeToUtf8(data.languageIdentifier).c_str());
 		m_insertFileStmt.bind(4, modificationTime.c_str());
 		m_insertFileStmt.bind(5, data.indexed);
@@ -500,147 +514,197 @@ void SqliteIndexStorage::removeElementsWithoutOccurrences(const std::vector<Id>&
 void SqliteIndexStorage::removeElementsWithLocationInFiles(
 	const std::vector<Id>& fileIds, std::function<void(int)> updateStatusCallback)
 {
-	if (updateStatusCallback != nullptr)
-	{
-		updateStatusCallback(1);
-	}
-
-	// preparing
-	executeStatement("DROP TABLE IF EXISTS main.element_id_to_clear;");
-
-	if (updateStatusCallback != nullptr)
-	{
-		updateStatusCallback(2);
+	// every step starts from the cleared files or elements stored in temporary tables and reaches
+	// the other tables through their primary keys or the indices of the clear mode, so the work
+	// done depends on the amount of cleared data instead of the size of the database
+	const std::vector<std::pair<std::string, std::string>> steps = {
+		{"collect elements located in files",
+		 "INSERT INTO temp.element_id_to_clear "
+		 "	SELECT DISTINCT occurrence.element_id "
+		 "	FROM temp.file_id_to_clear "
+		 "	INNER JOIN source_location ON ("
+		 "		source_location.file_node_id = file_id_to_clear.id"
+		 "	) "
+		 "	INNER JOIN occurrence ON ("
+		 "		occurrence.source_location_id = source_location.id"
+		 "	);"},
+		{"delete edges located in files",
+		 "DELETE FROM element WHERE id IN ("
+		 "	SELECT edge.id FROM temp.element_id_to_clear "
+		 "	INNER JOIN edge ON (edge.id = element_id_to_clear.id)"
+		 ");"},
+		{"delete edges originating from elements located in files",
+		 "DELETE FROM element WHERE id IN ("
+		 "	SELECT edge.id FROM temp.element_id_to_clear "
+		 "	INNER JOIN edge ON (edge.source_node_id = element_id_to_clear.id)"
+		 ");"},
+		// deleted elements can be disregarded and files are cleared by the caller
+		{"skip deleted elements and files",
+		 "DELETE FROM temp.element_id_to_clear WHERE "
+		 "	NOT EXISTS (SELECT * FROM element WHERE element.id = element_id_to_clear.id) OR "
+		 "	EXISTS (SELECT * FROM file WHERE file.id = element_id_to_clear.id);"},
+		// also deletes the respective occurrences
+		{"delete source locations in files",
+		 "DELETE FROM source_location WHERE file_node_id IN ("
+		 "	SELECT id FROM temp.file_id_to_clear"
+		 ");"},
+		{"keep elements with remaining occurrences",
+		 "DELETE FROM temp.element_id_to_clear WHERE EXISTS ("
+		 "	SELECT * FROM occurrence WHERE occurrence.element_id = element_id_to_clear.id"
+		 ");"},
+		{"keep elements with remaining edges pointing to them",
+		 "DELETE FROM temp.element_id_to_clear WHERE EXISTS ("
+		 "	SELECT * FROM edge WHERE edge.target_node_id = element_id_to_clear.id"
+		 ");"},
+		{"delete remaining elements",
+		 "DELETE FROM element WHERE id IN ("
+		 "	SELECT id FROM temp.element_id_to_clear"
+		 ");"}};
+
+	const TimeStamp start = TimeStamp::now();
+
+	// indices of the clear mode that are missing are only created for this call
+	std::vector<SqliteDatabaseIndex> temporaryIndices;
+	for (std::pair<int, SqliteDatabaseIndex>& index: getIndices())
+	{
+		if ((index.first & STORAGE_MODE_CLEAR) && !hasIndex(index.second.getName()))
+		{
+			index.second.createOnDatabase(m_database);
+			temporaryIndices.push_back(index.second);
+		}
 	}
 
+	executeStatement("DROP TABLE IF EXISTS temp.file_id_to_clear;");
+	executeStatement("DROP TABLE IF EXISTS temp.element_id_to_clear;");
+	executeStatement(
+		"CREATE TEMP TABLE file_id_to_clear("
+		"id INTEGER NOT NULL, "
+		"PRIMARY KEY(id));");
 	executeStatement(
-		"CREATE TABLE IF NOT EXISTS element_id_to_clear("
+		"CREATE TEMP TABLE element_id_to_clear("
 		"id INTEGER NOT NULL, "
 		"PRIMARY KEY(id));");
 
-	if (updateStatusCallback != nullptr)
+	CppSQLite3Statement insertFileIdStmt = m_database.compileStatement(
+		"INSERT OR IGNORE INTO temp.file_id_to_clear(id) VALUES(?);");
+	for (Id fileId: fileIds)
 	{
-		updateStatusCallback(3);
+		insertFileIdStmt.bind(1, int(fileId));
+		executeStatement(insertFileIdStmt);
 	}
 
-	// store ids of all elements located in fileIds into element_id_to_clear
-	executeStatement(
-		"INSERT INTO element_id_to_clear "
-		"	SELECT occurrence.element_id "
-		"	FROM occurrence "
-		"	INNER JOIN source_location ON ("
-		"		occurrence.source_location_id = source_location.id"
-		"	) "
-		"	WHERE source_location.file_node_id IN (" +
-		utility::join(utility::toStrings(fileIds), ',') +
-		")"
-		"	GROUP BY (occurrence.element_id)");
-
-	if (updateStatusCallback != nullptr)
+	for (size_t i = 0; i < steps.size(); i++)
 	{
-		updateStatusCallback(4);
-	}
+		const TimeStamp stepStart = TimeStamp::now();
 
-	// delete all edges in element_id_to_clear
-	executeStatement(
-		"DELETE FROM element WHERE element.id IN "
-		"	(SELECT element_id_to_clear.id FROM element_id_to_clear INNER JOIN edge ON "
-		"(element_id_to_clear.id = edge.id))");
+		executeStatement(steps[i].second);
 
-	if (updateStatusCallback != nullptr)
-	{
-		updateStatusCallback(30);
+		LOG_INFO(
+			"Clearing " + std::to_string(fileIds.size()) + " files: " + steps[i].first + " (" +
+			std::to_string(executeStatementScalar("SELECT changes();", 0)) + " rows) took " +
+			std::to_string(TimeStamp::now().deltaMS(stepStart)) + " ms");
+
+		if (updateStatusCallback != nullptr)
+		{
+			updateStatusCallback(static_cast<int>((i + 1) * 90 / steps.size()));
+		}
 	}
 
-	// delete all edges originating from element_id_to_clear
-	executeStatement(
-		"DELETE FROM element WHERE element.id IN (SELECT id FROM edge WHERE source_node_id IN "
-		"(SELECT id FROM element_id_to_clear))");
+	executeStatement("DROP TABLE IF EXISTS temp.file_id_to_clear;");
+	executeStatement("DROP TABLE IF EXISTS temp.element_id_to_clear;");
 
-	if (updateStatusCallback != nullptr)
+	for (SqliteDatabaseIndex& index: temporaryIndices)
 	{
-		updateStatusCallback(31);
+		index.removeFromDatabase(m_database);
 	}
 
-	// remove all non existing ids from element_id_to_clear (they have been cleared by now and we
-	// can disregard them)
-	executeStatement(
-		"DELETE FROM element_id_to_clear WHERE id NOT IN ("
-		"	SELECT id FROM element"
-		")");
+	LOG_INFO(
+		"Clearing " + std::to_string(fileIds.size()) + " files took " +
+		std::to_string(TimeStamp::now().deltaMS(start)) + " ms");
+}
 
-	if (updateStatusCallback != nullptr)
-	{
-		updateStatusCallback(33);
-	}
+void SqliteIndexStorage::removeAllErrors()
+{
+	executeStatement("DELETE FROM error;");
+}
 
-	// remove all files from element_id_to_clear (they will be cleared later)
+void SqliteIndexStorage::startChangeTracking()
+{
 	executeStatement(
-		"DELETE FROM element_id_to_clear WHERE id IN ("
-		"	SELECT id FROM file"
-		")");
-
-	if (updateStatusCallback != nullptr)
-	{
-		updateStatusCallback(34);
-	}
+		"CREATE TEMP TABLE IF NOT EXISTS node_change("
+		"id INTEGER NOT NULL, "
+		"existed INTEGER NOT NULL, "
+		"type INTEGER NOT NULL, "
+		"serialized_name TEXT, "
+		"PRIMARY KEY(id));");
 
-	// delete source locations from fileIds (this also deletes the respective occurrences)
 	executeStatement(
-		"DELETE FROM source_location WHERE file_node_id IN (" +
-		utility::join(utility::toStrings(fileIds), ',') + ");");
+		"CREATE TEMP TABLE IF NOT EXISTS edge_change("
+		"id INTEGER NOT NULL, "
+		"existed INTEGER NOT NULL, "
+		"type INTEGER NOT NULL, "
+		"source_node_id INTEGER NOT NULL, "
+		"target_node_id INTEGER NOT NULL, "
+		"PRIMARY KEY(id));");
 
-	if (updateStatusCallback != nullptr)
+	for (const std::pair<std::string, std::string>& trigger: getChangeTrackingTriggers())
 	{
-		updateStatusCallback(45);
+		executeStatement(
+			"CREATE TEMP TRIGGER IF NOT EXISTS " + trigger.first + " " + trigger.second + ";");
 	}
+}
 
-	// remove all ids from element_id_to_clear that still have occurrences
-	executeStatement(
-		"DELETE FROM element_id_to_clear WHERE id IN ("
-		"	SELECT element_id_to_clear.id FROM element_id_to_clear INNER JOIN occurrence ON "
-		"		element_id_to_clear.id = occurrence.element_id"
-		")");
-
-	if (updateStatusCallback != nullptr)
+void SqliteIndexStorage::stopChangeTracking()
+{
+	for (const std::pair<std::string, std::string>& trigger: getChangeTrackingTriggers())
 	{
-		updateStatusCallback(59);
+		executeStatement("DROP TRIGGER IF EXISTS temp." + trigger.first + ";");
 	}
 
-	// remove all ids from element_id_to_clear that still have an edge pointing to them
-	executeStatement(
-		"DELETE FROM element_id_to_clear WHERE id IN ("
-		"	SELECT target_node_id FROM edge"
-		")");
+	executeStatement("DROP TABLE IF EXISTS temp.node_change;");
+	executeStatement("DROP TABLE IF EXISTS temp.edge_change;");
+}
 
-	if (updateStatusCallback != nullptr)
+StorageChanges SqliteIndexStorage::getTrackedChanges() const
+{
+	StorageChanges changes;
+
+	CppSQLite3Query nodeQuery = executeQuery(
+		"SELECT id, existed, type, serialized_name FROM temp.node_change;");
+	while (!nodeQuery.eof())
 	{
-		updateStatusCallback(74);
-	}
+		const Id id = nodeQuery.getIntField(0, 0);
+		changes.nodeIds.push_back(id);
 
-	// delete all elements that are still listed in element_id_to_clear
-	executeStatement(
-		"DELETE FROM element WHERE EXISTS ("
-		"	SELECT * FROM element_id_to_clear WHERE element.id = element_id_to_clear.id"
-		")");
+		if (nodeQuery.getIntField(1, 0))
+		{
+			changes.previousNodes.emplace_back(
+				id, nodeQuery.getIntField(2, 0), nodeQuery.getStringField(3, ""));
+		}
 
-	if (updateStatusCallback != nullptr)
-	{
-		updateStatusCallback(87);
+		nodeQuery.nextRow();
 	}
 
-	// cleaning up
-	executeStatement("DROP TABLE IF EXISTS main.element_id_to_clear;");
-
-	if (updateStatusCallback != nullptr)
+	CppSQLite3Query edgeQuery = executeQuery(
+		"SELECT id, existed, type, source_node_id, target_node_id FROM temp.edge_change;");
+	while (!edgeQuery.eof())
 	{
-		updateStatusCallback(89);
+		const Id id = edgeQuery.getIntField(0, 0);
+		changes.edgeIds.push_back(id);
+
+		if (edgeQuery.getIntField(1, 0))
+		{
+			changes.previousEdges.emplace_back(
+				id,
+				edgeQuery.getIntField(2, 0),
+				edgeQuery.getIntField(3, 0),
+				edgeQuery.getIntField(4, 0));
+		}
+
+		edgeQuery.nextRow();
 	}
-}
 
-void SqliteIndexStorage::removeAllErrors()
-{
-	executeStatement("DELETE FROM error;");
+	return changes;
 }
 
 bool SqliteIndexStorage::isEdge(Id elementId) const
@@ -771,12 +835,12 @@ StorageNode SqliteIndexStorage::getNodeById(Id id) const
 	return StorageNode();
 }
 
-StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& serializedName) const
+StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::string& serializedName) const
 {
 	CppSQLite3Statement stmt = m_database.compileStatement(
 		"SELECT id, type, serialized_name FROM node WHERE serialized_name == ? LIMIT 1;");
 
-	stmt.bind(1, utility::encodeToUtf8(serializedName).c_str());
+	stmt.bind(1, serializedName.c_str());
 	CppSQLite3Query q = executeQuery(stmt);
 
 	if (!q.eof())
@@ -787,7 +851,7 @@ StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& seri
 
 		if (id != 0 && type != -1)
 		{
-			return StorageNode(id, type, utility::decodeFromUtf8(name));
+			return StorageNode(id, type, name);
 		}
 	}
 
@@ -890,7 +954,8 @@ void SqliteIndexStorage::setFileIndexed(Id fileId, bool indexed)
 		" WHERE id == " + std::to_string(fileId) + ";");
 }
 
-void SqliteIndexStorage::setFileCompleteIfNoError(Id fileId, const std::wstring& filePath, bool complete)
+void SqliteIndexStorage::setFileCompleteIfNoError(
+	Id fileId, const std::string& filePath, bool complete)
 {
 	bool fileHasErrors = doGetFirst<StorageSourceLocation>(
 							 "WHERE file_node_id == " + std::to_string(fileId) +
@@ -1069,10 +1134,16 @@ std::vector<StorageElementComponent> SqliteIndexStorage::getElementComponentsByE
 std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const
 {
 	std::vector<ErrorInfo> errorInfos;
+	forEachErrorInfo(
+		[&errorInfos](ErrorInfo&& errorInfo, Id) { errorInfos.push_back(std::move(errorInfo)); });
+	return errorInfos;
+}
 
+void SqliteIndexStorage::forEachErrorInfo(std::function<void(ErrorInfo&&, Id)> func) const
+{
 	CppSQLite3Query q = executeQuery(
 		"SELECT error.id, error.message, error.fatal, error.indexed, error.translation_unit, "
-		"file.path, source_location.start_line, source_location.start_column "
+		"file.path, source_location.start_line, source_location.start_column, file.id "
 		"FROM occurrence "
 		"INNER JOIN error ON (error.id = occurrence.element_id) "
 		"INNER JOIN source_location ON (source_location.id = occurrence.source_location_id) "
@@ -1090,6 +1161,7 @@ std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const
 		const std::string filePath = q.getStringField(5, "");
 		const int lineNumber = q.getIntField(6, -1);
 		const int columnNumber = q.getIntField(7, -1);
+		const Id fileId = q.getIntField(8, 0);
 
 		if (id != 0)
 		{
@@ -1106,21 +1178,21 @@ std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const
 				errorIdCount.emplace(id, 1);
 			}
 
-			errorInfos.push_back(ErrorInfo(
-				errorId,
-				utility::decodeFromUtf8(message),
-				utility::decodeFromUtf8(filePath),
-				lineNumber,
-				columnNumber,
-				utility::decodeFromUtf8(translationUnit),
-				fatal,
-				indexed));
+			func(
+				ErrorInfo(
+					errorId,
+					utility::decodeFromUtf8(message),
+					utility::decodeFromUtf8(filePath),
+					lineNumber,
+					columnNumber,
+					utility::decodeFromUtf8(translationUnit),
+					fatal,
+					indexed),
+				fileId);
 		}
 
 		q.nextRow();
 	}
-
-	return errorInfos;
 }
 
 int SqliteIndexStorage::getNodeCount() const
@@ -1189,20 +1261,20 @@ std::vector<std::pair<int, SqliteDatabaseIndex>> SqliteIndexStorage::getIndices(
 		STORAGE_MODE_CLEAR,
 		SqliteDatabaseIndex(
 			"element_component_foreign_key_index", "element_component(element_id)")));
+
+	// duplicates of the indices above that are not used in any mode anymore, they are only listed
+	// to be removed from existing databases
 	indices.push_back(std::make_pair(
-		STORAGE_MODE_CLEAR,
-		SqliteDatabaseIndex("edge_source_foreign_key_index", "edge(source_node_id)")));
+		0, SqliteDatabaseIndex("edge_source_foreign_key_index", "edge(source_node_id)")));
 	indices.push_back(std::make_pair(
-		STORAGE_MODE_CLEAR,
-		SqliteDatabaseIndex("edge_target_foreign_key_index", "edge(target_node_id)")));
+		0, SqliteDatabaseIndex("edge_target_foreign_key_index", "edge(target_node_id)")));
 	indices.push_back(std::make_pair(
-		STORAGE_MODE_CLEAR,
+		0,
 		SqliteDatabaseIndex("source_location_foreign_key_index", "source_location(file_node_id)")));
 	indices.push_back(std::make_pair(
-		STORAGE_MODE_CLEAR,
-		SqliteDatabaseIndex("occurrence_element_foreign_key_index", "occurrence(element_id)")));
+		0, SqliteDatabaseIndex("occurrence_element_foreign_key_index", "occurrence(element_id)")));
 	indices.push_back(std::make_pair(
-		STORAGE_MODE_CLEAR,
+		0,
 		SqliteDatabaseIndex(
 			"occurrence_source_location_foreign_key_index", "occurrence(source_location_id)")));
 
@@ -1361,7 +1433,7 @@ void SqliteIndexStorage::setupPrecompiledStatements()
 			[](CppSQLite3Statement& stmt, const StorageNode& node, size_t index) {
 				stmt.bind(int(index) * 3 + 1, int(node.id));
 				stmt.bind(int(index) * 3 + 2, int(node.type));
-				stmt.bind(int(index) * 3 + 3, utility::encodeToUtf8(node.serializedName).c_str());
+				stmt.bind(int(index) * 3 + 3, node.serializedName.c_str());
 			},
 			m_database);
 		m_insertEdgeBatchStatement.compile(
@@ -1484,7 +1556,7 @@ void SqliteIndexStorage::forEach<StorageNode>(
 
 		if (id != 0 && type != -1)
 		{
-			func(StorageNode(id, type, utility::decodeFromUtf8(serializedName)));
+			func(StorageNode(id, type, serializedName));
 		}
 
 		q.nextRow();
@@ -1531,7 +1603,7 @@ void SqliteIndexStorage::forEach<StorageFile>(
 		{
 			func(StorageFile(
 				id,
-				utility::decodeFromUtf8(filePath),
+				filePath,
 				utility::decodeFromUtf8(languageIdentifier),
 				modificationTime,
 				indexed,
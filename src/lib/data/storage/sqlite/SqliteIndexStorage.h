@@ -3,13 +3,15 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ErrorInfo.h"
+#include "InternedStringTable.h"
 #include "LocationType.h"
-#include "LowMemoryStringMap.h"
 #include "SqliteDatabaseIndex.h"
 #include "SqliteStorage.h"
+#include "StorageChanges.h"
 #include "StorageComponentAccess.h"
 #include "StorageEdge.h"
 #include "StorageElementComponent.h"
@@ -79,6 +81,12 @@ public:
 
 	void removeAllErrors();
 
+	// records the previous state of all nodes and edges changed by this connection in temporary
+	// tables, other connections are not affected
+	void startChangeTracking();
+	void stopChangeTracking();
+	StorageChanges getTrackedChanges() const;
+
 	bool isEdge(Id elementId) const;
 	bool isNode(Id elementId) const;
 	bool isFile(Id elementId) const;
@@ -99,7 +107,7 @@ public:
 	std::vector<StorageEdge> getEdgesByTargetsType(const std::vector<Id>& targetIds, int type) const;
 
 	StorageNode getNodeById(Id id) const;
-	StorageNode getNodeBySerializedName(const std::wstring& serializedName) const;
+	StorageNode getNodeBySerializedName(const std::string& serializedName) const;
 
 	std::vector<int> getAvailableNodeTypes() const;
 	std::vector<int> getAvailableEdgeTypes() const;
@@ -111,7 +119,7 @@ public:
 	std::shared_ptr<TextAccess> getFileContentById(Id fileId) const;
 
 	void setFileIndexed(Id fileId, bool indexed);
-	void setFileCompleteIfNoError(Id fileId, const std::wstring& filePath, bool complete);
+	void setFileCompleteIfNoError(Id fileId, const std::string& filePath, bool complete);
 	void setNodeType(int type, Id nodeId);
 
 	std::shared_ptr<SourceLocationFile> getSourceLocationsForFile(
@@ -136,6 +144,8 @@ public:
 		const std::vector<Id>& elementIds) const;
 
 	std::vector<ErrorInfo> getAllErrorInfos() const;
+	// passes each error with the id of the file node it is located in
+	void forEachErrorInfo(std::function<void(ErrorInfo&&, Id)> func) const;
 
 	template <typename ResultType>
 	std::vector<ResultType> getAll() const
@@ -264,9 +274,8 @@ private:
 	template <typename StorageType>
 	void forEach(const std::string& query, std::function<void(StorageType&&)> func) const;
 
-	LowMemoryStringMap<std::string, uint32_t, 0> m_tempNodeNameIndex;
-	LowMemoryStringMap<std::wstring, uint32_t, 0> m_tempWNodeNameIndex;
-	std::map<uint32_t, int> m_tempNodeTypes;
+	InternedStringTable m_tempNodeNameIndex;
+	std::unordered_map<uint32_t, int> m_tempNodeTypes;
 	std::map<StorageEdgeData, uint32_t> m_tempEdgeIndex;
 	std::map<std::wstring, std::map<std::wstring, uint32_t>> m_tempLocalSymbolIndex;
 	std::map<uint32_t, std::map<TempSourceLocation, uint32_t>> m_tempSourceLocationIndices;
@@ -74,21 +74,67 @@ void SqliteStorage::setVersion(size_t version)
 
 void SqliteStorage::beginTransaction()
 {
-	executeStatement("BEGIN TRANSACTION;");
+	// the outermost savepoint starts a transaction and releasing it commits the transaction
+	if (executeStatement("SAVEPOINT storage_transaction;"))
+	{
+		m_transactionDepth++;
+	}
 }
 
 void SqliteStorage::commitTransaction()
 {
-	executeStatement("COMMIT TRANSACTION;");
+	if (executeStatement("RELEASE SAVEPOINT storage_transaction;"))
+	{
+		m_transactionDepth--;
+	}
 }
 
 void SqliteStorage::rollbackTransaction()
 {
-	executeStatement("ROLLBACK TRANSACTION;");
+	if (executeStatement("ROLLBACK TO SAVEPOINT storage_transaction;") &&
+		executeStatement("RELEASE SAVEPOINT storage_transaction;"))
+	{
+		m_transactionDepth--;
+	}
+}
+
+bool SqliteStorage::isInTransaction() const
+{
+	return m_transactionDepth > 0;
+}
+
+bool SqliteStorage::enableWriteAheadLog()
+{
+	// the pragma returns the journal mode that is in effect afterwards
+	CppSQLite3Query q = executeQuery("PRAGMA journal_mode=WAL;");
+
+	std::string journalMode;
+	if (!q.eof())
+	{
+		journalMode = utility::toLowerCase(std::string(q.getStringField(0, "")));
+	}
+
+	if (journalMode != "wal")
+	{
+		LOG_WARNING("Write ahead log not enabled, journal mode is: \"" + journalMode + "\"");
+		return false;
+	}
+	return true;
+}
+
+void SqliteStorage::checkpointWriteAheadLog()
+{
+	executeStatement("PRAGMA wal_checkpoint(TRUNCATE);");
 }
 
 void SqliteStorage::optimizeMemory() const
 {
+	if (isInTransaction())
+	{
+		LOG_INFO("Skipping database vacuum within transaction");
+		return;
+	}
+
 	executeStatement("VACUUM;");
 }
 
@@ -261,6 +307,19 @@ bool SqliteStorage::hasTable(const std::string& tableName) const
 	return false;
 }
 
+bool SqliteStorage::hasIndex(const std::string& indexName) const
+{
+	CppSQLite3Query q = executeQuery(
+		"SELECT name FROM sqlite_master WHERE type='index' AND name='" + indexName + "';");
+
+	if (!q.eof())
+	{
+		return q.getStringField(0, "") == indexName;
+	}
+
+	return false;
+}
+
 std::string SqliteStorage::getMetaValue(const std::string& key) const
 {
 	if (hasTable("meta"))
@@ -21,10 +21,18 @@ public:
 	size_t getVersion() const;
 	void setVersion(size_t version);
 
+	// transactions are savepoints, so they can be nested
 	void beginTransaction();
 	void commitTransaction();
 	void rollbackTransaction();
+	bool isInTransaction() const;
 
+	// lets other connections keep reading the last committed state while this one writes, returns
+	// false if the database stays in another journal mode, e.g. on file systems without shared memory
+	bool enableWriteAheadLog();
+	void checkpointWriteAheadLog();
+
+	// does nothing within a transaction
 	void optimizeMemory() const;
 
 	FilePath getDbFilePath() const;
@@ -47,6 +55,7 @@ protected:
 	CppSQLite3Query executeQuery(CppSQLite3Statement& statement) const;
 
 	bool hasTable(const std::string& tableName) const;
+	bool hasIndex(const std::string& indexName) const;
 
 	std::string getMetaValue(const std::string& key) const;
 	void insertOrUpdateMetaValue(const std::string& key, const std::string& value);
@@ -63,6 +72,7 @@ private:
 	std::vector<std::pair<int, SqliteDatabaseIndex>> m_indices;
 
 	bool m_precompiledStatementsInitialized = false;
+	int m_transactionDepth = 0;
 
 	friend SqliteStorageMigration;
 };
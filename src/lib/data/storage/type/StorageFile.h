@@ -9,7 +9,7 @@ struct StorageFile
 {
 	StorageFile()
 		: id(0)
-		, filePath(L"")
+		, filePath("")
 		, languageIdentifier(L"")
 		, modificationTime("")
 		, indexed(true)
@@ -19,7 +19,7 @@ struct StorageFile
 
 	StorageFile(
 		Id id,
-		std::wstring filePath,
+		std::string filePath,
 		std::wstring languageIdentifier,
 		std::string modificationTime,
 		bool indexed,
@@ -39,7 +39,7 @@ struct StorageFile
 	}
 
 	Id id;
-	std::wstring filePath;
+	std::string filePath;	 // UTF-8 encoded
 	std::wstring languageIdentifier;
 	std::string modificationTime;
 	bool indexed;
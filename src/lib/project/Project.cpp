@@ -41,6 +41,7 @@
 #include "TaskReturnSuccessIf.h"
 #include "TaskSetValue.h"
 #include "TextAccess.h"
+#include "TimeStamp.h"
 #include "utility.h"
 #include "utilityApp.h"
 #include "utilityFile.h"
@@ -542,16 +543,39 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 	const FilePath indexDbFilePath = m_settings->getDBFilePath();
 	const FilePath tempIndexDbFilePath = m_settings->getTempDBFilePath();
 
-	if (info.mode != REFRESH_ALL_FILES)
+	bool inPlaceRefresh = canRefreshInPlace(info);
+	std::shared_ptr<PersistentStorage> tempStorage;
+	if (inPlaceRefresh)
 	{
-		// store the indexed data into the temp db but keep the current state to allow browsing
-		// while indexing
-		FileSystem::copyFile(indexDbFilePath, tempIndexDbFilePath);
+		LOG_INFO("Refreshing index database in place");
+
+		tempStorage = std::make_shared<PersistentStorage>(
+			indexDbFilePath, m_storage->getBookmarkDbFilePath());
+		tempStorage->setup();
+
+		// the current state stays visible to m_storage until the refresh is committed, an
+		// unexpected shutdown rolls back all changes
+		if (!tempStorage->startInPlaceRefresh())
+		{
+			LOG_WARNING("Refreshing index database in place failed, refreshing a copy instead");
+			tempStorage.reset();
+			inPlaceRefresh = false;
+		}
 	}
 
-	std::shared_ptr<PersistentStorage> tempStorage = std::make_shared<PersistentStorage>(
-		tempIndexDbFilePath, m_storage->getBookmarkDbFilePath());
-	tempStorage->setup();
+	if (!tempStorage)
+	{
+		if (info.mode != REFRESH_ALL_FILES)
+		{
+			// store the indexed data into the temp db but keep the current state to allow browsing
+			// while indexing
+			FileSystem::copyFile(indexDbFilePath, tempIndexDbFilePath);
+		}
+
+		tempStorage = std::make_shared<PersistentStorage>(
+			tempIndexDbFilePath, m_storage->getBookmarkDbFilePath());
+		tempStorage->setup();
+	}
 
 	std::shared_ptr<TaskGroupSequence> taskSequential = std::make_shared<TaskGroupSequence>();
 
@@ -621,6 +645,17 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 			indexerThreadCount, static_cast<int>(indexerCommandProvider->size()));
 
 		std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+		{
+			const int memoryBudgetMb = ApplicationSettings::getInstance()->getIndexingMemoryBudgetMb();
+			if (memoryBudgetMb > 0)
+			{
+				storageProvider->setMemoryBudget(static_cast<size_t>(memoryBudgetMb) * 1048576);
+			}
+			else if (const size_t physicalMemorySize = utility::getPhysicalMemorySize())
+			{
+				storageProvider->setMemoryBudget(physicalMemorySize / 4);
+			}
+		}
 		// add tasks for setting some variables on the blackboard that are used during indexing
 		taskSequential->addTask(
 			std::make_shared<TaskSetValue<bool>>("indexer_threads_started", false));
@@ -735,16 +770,36 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
 	taskSequential->addTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
 		std::make_shared<TaskGroupSequence>()->addChildTasks(
 			std::make_shared<TaskFindKeyOnBlackboard>("keep_database"),
-			std::make_shared<TaskLambda>([dialogView, this]() {
-				Task::dispatch(TabId::app(), std::make_shared<TaskLambda>([dialogView, this]() {
-								   swapToTempStorage(dialogView);
-							   }));
+			std::make_shared<TaskLambda>([dialogView, inPlaceRefresh, tempStorage, this]() {
+				Task::dispatch(
+					TabId::app(),
+					std::make_shared<TaskLambda>([dialogView, inPlaceRefresh, tempStorage, this]() {
+						if (inPlaceRefresh)
+						{
+							applyInPlaceRefresh(tempStorage);
+						}
+						else
+						{
+							swapToTempStorage(dialogView);
+						}
+					}));
 			})),
 		std::make_shared<TaskGroupSequence>()->addChildTasks(
 			std::make_shared<TaskFindKeyOnBlackboard>("discard_database"),
-			std::make_shared<TaskLambda>([this]() {
+			std::make_shared<TaskLambda>([inPlaceRefresh, tempStorage, this]() {
 				Task::dispatch(
-					TabId::app(), std::make_shared<TaskLambda>([this]() { discardTempStorage(); }));
+					TabId::app(),
+					std::make_shared<TaskLambda>([inPlaceRefresh, tempStorage, this]() {
+						if (inPlaceRefresh)
+						{
+							LOG_INFO("Discarding in place refreshed indexing data");
+							tempStorage->rollbackInPlaceRefresh();
+						}
+						else
+						{
+							discardTempStorage();
+						}
+					}));
 			}))));
 
 	taskSequential->addTask(std::make_shared<TaskLambda>([dialogView, this]() {
@@ -840,6 +895,24 @@ void Project::discardTempStorage()
 	}
 }
 
+void Project::applyInPlaceRefresh(std::shared_ptr<PersistentStorage> refreshedStorage)
+{
+	LOG_INFO("Committing in place refreshed indexing data");
+
+	const StorageChanges changes = refreshedStorage->getInPlaceRefreshChanges();
+	refreshedStorage->commitInPlaceRefresh();
+
+	// the current storage reads the same database, so only its caches need to catch up
+	TimeStamp start = TimeStamp::now();
+	m_storage->applyChanges(changes);
+	LOG_INFO(
+		"Updated caches in " + std::to_string(TimeStamp::durationSeconds(start)) + " seconds");
+
+	m_storageCache->clear();
+	m_storageCache->setSubject(m_storage);
+	m_state = PROJECT_STATE_LOADED;
+}
+
 bool Project::hasCxxSourceGroup() const
 {
 #if BUILD_CXX_LANGUAGE_PACKAGE
@@ -856,3 +929,31 @@ bool Project::hasCxxSourceGroup() const
 #endif	  // BUILD_CXX_LANGUAGE_PACKAGE
 	return false;
 }
+
+bool Project::canRefreshInPlace(const RefreshInfo& info) const
+{
+	if (info.mode == REFRESH_ALL_FILES ||
+		!ApplicationSettings::getInstance()->getInPlaceRefreshEnabled())
+	{
+		return false;
+	}
+
+	for (const std::shared_ptr<SourceGroup>& sourceGroup: m_sourceGroups)
+	{
+		if (sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED)
+		{
+			// custom commands write to the temp database from their own processes
+			if (sourceGroup->getType() == SOURCE_GROUP_CUSTOM_COMMAND)
+			{
+				return false;
+			}
+#if BUILD_PYTHON_LANGUAGE_PACKAGE
+			if (sourceGroup->getType() == SOURCE_GROUP_PYTHON_EMPTY)
+			{
+				return false;
+			}
+#endif	  // BUILD_PYTHON_LANGUAGE_PACKAGE
+		}
+	}
+	return true;
+}
@@ -70,8 +70,10 @@ private:
 		const FilePath& tempIndexDbFilePath,
 		std::shared_ptr<DialogView> dialogView);
 	void discardTempStorage();
+	void applyInPlaceRefresh(std::shared_ptr<PersistentStorage> refreshedStorage);
 
 	bool hasCxxSourceGroup() const;
+	bool canRefreshInPlace(const RefreshInfo& info) const;
 
 	std::shared_ptr<ProjectSettings> m_settings;
 	StorageCache* const m_storageCache;
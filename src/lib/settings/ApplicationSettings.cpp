@@ -337,6 +337,16 @@ void ApplicationSettings::setVerboseIndexerLoggingEnabled(bool value)
 	setValue<bool>("application/verbose_indexer_logging_enabled", value);
 }
 
+bool ApplicationSettings::getTracingEnabled() const
+{
+	return getValue<bool>("application/tracing_enabled", false);
+}
+
+void ApplicationSettings::setTracingEnabled(bool value)
+{
+	setValue<bool>("application/tracing_enabled", value);
+}
+
 FilePath ApplicationSettings::getLogDirectoryPath() const
 {
 	return FilePath(getValue<std::wstring>(
@@ -389,6 +399,26 @@ void ApplicationSettings::setMultiProcessIndexingEnabled(bool enabled)
 	setValue<bool>("indexing/multi_process_indexing", enabled);
 }
 
+int ApplicationSettings::getIndexingMemoryBudgetMb() const
+{
+	return getValue<int>("indexing/memory_budget_mb", 0);
+}
+
+void ApplicationSettings::setIndexingMemoryBudgetMb(const int megabytes)
+{
+	setValue<int>("indexing/memory_budget_mb", megabytes);
+}
+
+bool ApplicationSettings::getInPlaceRefreshEnabled() const
+{
+	return getValue<bool>("indexing/in_place_refresh", true);
+}
+
+void ApplicationSettings::setInPlaceRefreshEnabled(bool enabled)
+{
+	setValue<bool>("indexing/in_place_refresh", enabled);
+}
+
 FilePath ApplicationSettings::getJavaPath() const
 {
 	return FilePath(getValue<std::wstring>("indexing/java/java_path", L""));
@@ -409,6 +439,16 @@ void ApplicationSettings::setHasPrefilledJavaPath(bool v)
 	setValue<bool>("indexing/java/has_prefilled_java_path", v);
 }
 
+int ApplicationSettings::getJavaIndexerBatchSize() const
+{
+	return getValue<int>("indexing/java/indexer_batch_size", 8);
+}
+
+void ApplicationSettings::setJavaIndexerBatchSize(int size)
+{
+	setValue<int>("indexing/java/indexer_batch_size", size);
+}
+
 std::vector<FilePath> ApplicationSettings::getJreSystemLibraryPaths() const
 {
 	return getPathValues("indexing/java/jre_system_library_paths/jre_system_library_path");
@@ -82,6 +82,9 @@ public:
 	bool getVerboseIndexerLoggingEnabled() const;
 	void setVerboseIndexerLoggingEnabled(bool loggingEnabled);
 
+	bool getTracingEnabled() const;
+	void setTracingEnabled(bool tracingEnabled);
+
 	FilePath getLogDirectoryPath() const;
 	void setLogDirectoryPath(const FilePath& path);
 
@@ -98,6 +101,14 @@ public:
 	bool getMultiProcessIndexingEnabled() const;
 	void setMultiProcessIndexingEnabled(bool enabled);
 
+	// memory for indexed data waiting to be stored, 0 uses a quarter of the physical memory
+	int getIndexingMemoryBudgetMb() const;
+	void setIndexingMemoryBudgetMb(const int megabytes);
+
+	// refresh the index database within a transaction instead of indexing into a copy of it
+	bool getInPlaceRefreshEnabled() const;
+	void setInPlaceRefreshEnabled(bool enabled);
+
 	FilePath getJavaPath() const;
 	void setJavaPath(const FilePath& path);
 
@@ -107,6 +118,10 @@ public:
 	int getJavaMaximumMemory() const;
 	void setJavaMaximumMemory(int size);
 
+	// number of java source files parsed with one shared parser environment, 1 disables batching
+	int getJavaIndexerBatchSize() const;
+	void setJavaIndexerBatchSize(int size);
+
 	std::vector<FilePath> getJreSystemLibraryPaths() const;
 	std::vector<FilePath> getJreSystemLibraryPathsExpanded() const;
 	bool setJreSystemLibraryPaths(const std::vector<FilePath>& jreSystemLibraryPaths);
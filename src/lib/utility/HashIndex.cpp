@@ -0,0 +1,80 @@
+#include "HashIndex.h"
+
+const size_t HashIndex::s_noPosition = static_cast<size_t>(-1);
+
+size_t HashIndex::combineHashes(size_t seed, size_t hash)
+{
+	return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+HashIndex::HashIndex(): m_size(0), m_shift(64) {}
+
+void HashIndex::clear()
+{
+	m_slots.clear();
+	m_size = 0;
+	m_shift = 64;
+}
+
+void HashIndex::reserve(size_t count)
+{
+	// keeps the load factor at or below 0.75
+	size_t slotCount = 16;
+	while (slotCount * 3 < count * 4)
+	{
+		slotCount <<= 1;
+	}
+
+	if (slotCount > m_slots.size())
+	{
+		rehash(slotCount);
+	}
+}
+
+size_t HashIndex::size() const
+{
+	return m_size;
+}
+
+void HashIndex::insert(size_t hash, size_t position)
+{
+	reserve(m_size + 1);
+
+	const size_t mask = m_slots.size() - 1;
+	size_t i = getSlotIndex(hash);
+	while (m_slots[i].position != s_noPosition)
+	{
+		i = (i + 1) & mask;
+	}
+
+	m_slots[i].hash = hash;
+	m_slots[i].position = position;
+	m_size++;
+}
+
+size_t HashIndex::getSlotIndex(size_t hash) const
+{
+	// fibonacci hashing spreads sequential values like ids over the whole index
+	return static_cast<size_t>((uint64_t(hash) * 0x9e3779b97f4a7c15ull) >> m_shift);
+}
+
+void HashIndex::rehash(size_t slotCount)
+{
+	std::vector<Slot> slots(slotCount, Slot {0, s_noPosition});
+	slots.swap(m_slots);
+
+	m_shift = 64;
+	for (size_t count = slotCount; count > 1; count >>= 1)
+	{
+		m_shift--;
+	}
+
+	m_size = 0;
+	for (const Slot& slot: slots)
+	{
+		if (slot.position != s_noPosition)
+		{
+			insert(slot.hash, slot.position);
+		}
+	}
+}
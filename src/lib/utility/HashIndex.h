@@ -0,0 +1,70 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open addressing hash index that maps precomputed hashes to positions in a vector the caller
+// keeps the elements in. The hashes are stored next to the positions, so growing the index never
+// recomputes them and most probes of other elements are rejected without comparing elements.
+// Elements can't be removed, the index needs to be cleared and rebuilt instead.
+class HashIndex
+{
+public:
+	static const size_t s_noPosition;
+
+	static size_t combineHashes(size_t seed, size_t hash);
+
+	HashIndex();
+
+	void clear();
+	void reserve(size_t count);
+	size_t size() const;
+
+	// returns the position of the first element with this hash that isEqual accepts
+	template <typename EqualFunctor>
+	size_t find(size_t hash, EqualFunctor isEqual) const;
+
+	// does not check if an equal element was inserted before
+	void insert(size_t hash, size_t position);
+
+private:
+	struct Slot
+	{
+		size_t hash;
+		size_t position;	// s_noPosition marks an empty slot
+	};
+
+	size_t getSlotIndex(size_t hash) const;
+	void rehash(size_t slotCount);
+
+	std::vector<Slot> m_slots;
+	size_t m_size;
+	uint32_t m_shift;
+};
+
+template <typename EqualFunctor>
+size_t HashIndex::find(size_t hash, EqualFunctor isEqual) const
+{
+	if (m_slots.empty())
+	{
+		return s_noPosition;
+	}
+
+	const size_t mask = m_slots.size() - 1;
+	for (size_t i = getSlotIndex(hash);; i = (i + 1) & mask)
+	{
+		const Slot& slot = m_slots[i];
+		if (slot.position == s_noPosition)
+		{
+			return s_noPosition;
+		}
+		if (slot.hash == hash && isEqual(slot.position))
+		{
+			return slot.position;
+		}
+	}
+}
+
+#endif	  // HASH_INDEX_H
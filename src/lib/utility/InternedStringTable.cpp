@@ -0,0 +1,235 @@
+#include "InternedStringTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+const size_t s_blockByteSize = 64 * 1024;
+const size_t s_groupSize = 8;
+const uint8_t s_emptyControl = 0x80;
+
+const uint64_t s_lowBits = 0x0101010101010101ull;
+const uint64_t s_highBits = 0x8080808080808080ull;
+
+uint8_t getControl(uint64_t hash)
+{
+	return static_cast<uint8_t>(hash & 0x7f);
+}
+
+size_t getGroupIndex(uint64_t hash, size_t groupCount)
+{
+	return static_cast<size_t>(hash >> 7) & (groupCount - 1);
+}
+
+uint64_t loadGroup(const uint8_t* controls)
+{
+	// assembled byte by byte to keep slot i in byte i independent of endianness
+	uint64_t group = 0;
+	for (size_t i = 0; i < s_groupSize; i++)
+	{
+		group |= uint64_t(controls[i]) << (i * 8);
+	}
+	return group;
+}
+
+// sets the high bit of each byte equal to control, may also set it for bytes following a match
+uint64_t matchControl(uint64_t group, uint8_t control)
+{
+	const uint64_t x = group ^ (s_lowBits * control);
+	return (x - s_lowBits) & ~x & s_highBits;
+}
+
+uint64_t matchEmpty(uint64_t group)
+{
+	return group & s_highBits;
+}
+}	 // namespace
+
+InternedStringTable::InternedStringTable()
+	: m_blockByteSize(0), m_freeBlockData(nullptr), m_freeBlockByteSize(0)
+{
+}
+
+void InternedStringTable::clear()
+{
+	m_blocks.clear();
+	m_blockByteSize = 0;
+	m_freeBlockData = nullptr;
+	m_freeBlockByteSize = 0;
+
+	m_entries.clear();
+	m_controls.clear();
+	m_slotEntries.clear();
+}
+
+bool InternedStringTable::empty() const
+{
+	return m_entries.empty();
+}
+
+size_t InternedStringTable::size() const
+{
+	return m_entries.size();
+}
+
+void InternedStringTable::reserve(size_t count)
+{
+	m_entries.reserve(count);
+	reserveSlots(count);
+}
+
+void InternedStringTable::add(const std::string& str, uint32_t value)
+{
+	reserveSlots(m_entries.size() + 1);
+
+	const uint32_t entryIndex = static_cast<uint32_t>(m_entries.size());
+	m_entries.push_back({store(str), static_cast<uint32_t>(str.size()), value});
+	insertSlot(getHash(str.data(), str.size()), entryIndex);
+}
+
+uint32_t InternedStringTable::find(const std::string& str) const
+{
+	if (m_controls.empty())
+	{
+		return 0;
+	}
+
+	const uint64_t hash = getHash(str.data(), str.size());
+	const uint8_t control = getControl(hash);
+	const size_t groupCount = m_controls.size() / s_groupSize;
+
+	size_t groupIndex = getGroupIndex(hash, groupCount);
+	for (size_t step = 1;; step++)
+	{
+		const size_t firstSlot = groupIndex * s_groupSize;
+		const uint64_t group = loadGroup(&m_controls[firstSlot]);
+
+		const uint64_t matches = matchControl(group, control);
+		for (size_t i = 0; matches && i < s_groupSize; i++)
+		{
+			if (matches & (0x80ull << (i * 8)))
+			{
+				const Entry& entry = m_entries[m_slotEntries[firstSlot + i]];
+				if (entry.size == str.size() &&
+					(entry.size == 0 || std::memcmp(entry.data, str.data(), entry.size) == 0))
+				{
+					return entry.value;
+				}
+			}
+		}
+
+		if (matchEmpty(group))
+		{
+			return 0;
+		}
+
+		// triangular probing visits every group once if the group count is a power of 2
+		groupIndex = (groupIndex + step) & (groupCount - 1);
+	}
+}
+
+size_t InternedStringTable::getByteSize() const
+{
+	return m_blockByteSize + m_blocks.capacity() * sizeof(std::unique_ptr<char[]>) +
+		m_entries.capacity() * sizeof(Entry) + m_controls.capacity() +
+		m_slotEntries.capacity() * sizeof(uint32_t);
+}
+
+uint64_t InternedStringTable::getHash(const char* data, size_t size)
+{
+	uint64_t hash = 0xcbf29ce484222325ull ^ size;
+
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t chunk;
+		std::memcpy(&chunk, data + i, 8);
+		hash = (hash ^ chunk) * 0x9e3779b97f4a7c15ull;
+		hash ^= hash >> 32;
+	}
+
+	uint64_t tail = 0;
+	for (size_t shift = 0; i < size; i++, shift += 8)
+	{
+		tail |= uint64_t(static_cast<uint8_t>(data[i])) << shift;
+	}
+	hash = (hash ^ tail) * 0x9e3779b97f4a7c15ull;
+
+	hash ^= hash >> 29;
+	hash *= 0xbf58476d1ce4e5b9ull;
+	return hash ^ (hash >> 32);
+}
+
+const char* InternedStringTable::store(const std::string& str)
+{
+	if (str.size() > m_freeBlockByteSize)
+	{
+		const size_t blockByteSize = std::max(s_blockByteSize, str.size());
+		m_blocks.emplace_back(new char[blockByteSize]);
+		m_blockByteSize += blockByteSize;
+		m_freeBlockData = m_blocks.back().get();
+		m_freeBlockByteSize = blockByteSize;
+	}
+
+	char* data = m_freeBlockData;
+	if (str.size())
+	{
+		std::memcpy(data, str.data(), str.size());
+	}
+	m_freeBlockData += str.size();
+	m_freeBlockByteSize -= str.size();
+	return data;
+}
+
+void InternedStringTable::reserveSlots(size_t count)
+{
+	// keeps the load factor at or below 0.875
+	size_t groupCount = 2;
+	while (groupCount * s_groupSize * 7 < count * 8)
+	{
+		groupCount <<= 1;
+	}
+
+	if (groupCount * s_groupSize > m_controls.size())
+	{
+		rehash(groupCount);
+	}
+}
+
+void InternedStringTable::insertSlot(uint64_t hash, uint32_t entryIndex)
+{
+	const size_t groupCount = m_controls.size() / s_groupSize;
+
+	size_t groupIndex = getGroupIndex(hash, groupCount);
+	for (size_t step = 1;; step++)
+	{
+		const size_t firstSlot = groupIndex * s_groupSize;
+		if (matchEmpty(loadGroup(&m_controls[firstSlot])))
+		{
+			for (size_t i = 0; i < s_groupSize; i++)
+			{
+				if (m_controls[firstSlot + i] == s_emptyControl)
+				{
+					m_controls[firstSlot + i] = getControl(hash);
+					m_slotEntries[firstSlot + i] = entryIndex;
+					return;
+				}
+			}
+		}
+
+		groupIndex = (groupIndex + step) & (groupCount - 1);
+	}
+}
+
+void InternedStringTable::rehash(size_t groupCount)
+{
+	m_controls.assign(groupCount * s_groupSize, s_emptyControl);
+	m_slotEntries.assign(groupCount * s_groupSize, 0);
+
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		const Entry& entry = m_entries[i];
+		insertSlot(getHash(entry.data, entry.size), static_cast<uint32_t>(i));
+	}
+}
@@ -0,0 +1,61 @@
+#ifndef INTERNED_STRING_TABLE_H
+#define INTERNED_STRING_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Map of string - value pairs for large sets of unique strings like serialized node names.
+// The characters are copied into large arena blocks, so adding a string does not allocate. Lookups
+// go through an open addressing index in the style of swiss tables: each slot has a control byte
+// holding 7 bits of the hash, and a probe checks the control bytes of 8 slots at once, so strings
+// are only compared for slots with a matching control byte.
+// Compared to LowMemoryStringMap this uses more memory for strings with long common suffixes, but
+// adding and finding a string costs a single hash instead of a traversal per character.
+class InternedStringTable
+{
+public:
+	InternedStringTable();
+
+	void clear();
+	bool empty() const;
+	size_t size() const;
+	void reserve(size_t count);
+
+	// does not check if the string was added before, 0 can't be stored as value
+	void add(const std::string& str, uint32_t value);
+
+	// returns 0 if the string was not added
+	uint32_t find(const std::string& str) const;
+
+	// returns the number of bytes used to store this table
+	size_t getByteSize() const;
+
+private:
+	struct Entry
+	{
+		const char* data;
+		uint32_t size;
+		uint32_t value;
+	};
+
+	static uint64_t getHash(const char* data, size_t size);
+
+	const char* store(const std::string& str);
+	void reserveSlots(size_t count);
+	void insertSlot(uint64_t hash, uint32_t entryIndex);
+	void rehash(size_t groupCount);
+
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	size_t m_blockByteSize;
+	char* m_freeBlockData;
+	size_t m_freeBlockByteSize;
+
+	std::vector<Entry> m_entries;
+	std::vector<uint8_t> m_controls;
+	std::vector<uint32_t> m_slotEntries;
+};
+
+#endif	  // INTERNED_STRING_TABLE_H
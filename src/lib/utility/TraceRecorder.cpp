@@ -0,0 +1,297 @@
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+
+#include "FilePath.h"
+#include "FileSystem.h"
+#include "logging.h"
+
+namespace
+{
+const size_t EVENT_CHUNK_SIZE = 16384;
+const size_t MAX_CHUNK_COUNT_PER_THREAD = 128;
+
+std::string escapeJson(const std::string& str)
+{
+	std::string escaped;
+	escaped.reserve(str.size());
+
+	for (char c: str)
+	{
+		switch (c)
+		{
+		case '"':
+			escaped += "\\\"";
+			break;
+		case '\\':
+			escaped += "\\\\";
+			break;
+		case '\n':
+			escaped += "\\n";
+			break;
+		case '\t':
+			escaped += "\\t";
+			break;
+		default:
+			escaped += c;
+		}
+	}
+
+	return escaped;
+}
+}	 // namespace
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+
+TraceRecorder* TraceRecorder::getInstance()
+{
+	// initialized once even if multiple threads call this at the same time
+	static TraceRecorder s_instance;
+	return &s_instance;
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+	// create the instance before any thread can record to it
+	getInstance();
+
+	s_enabled = enabled;
+}
+
+size_t TraceRecorder::registerEventName(
+	const std::string& eventName, const std::string& functionName)
+{
+	TraceRecorder* recorder = getInstance();
+
+	std::lock_guard<std::mutex> lock(recorder->m_eventNamesMutex);
+	recorder->m_eventNames.push_back(std::make_pair(eventName, functionName));
+	return recorder->m_eventNames.size() - 1;
+}
+
+unsigned long long TraceRecorder::getTimeMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+bool TraceRecorder::mergeChromeTraces(
+	const std::vector<FilePath>& sourceFilePaths, const FilePath& targetFilePath)
+{
+	std::ofstream targetStream(targetFilePath.str(), std::ios::app);
+	if (!targetStream.is_open())
+	{
+		LOG_ERROR(L"Unable to write trace file: " + targetFilePath.wstr());
+		return false;
+	}
+
+	for (const FilePath& sourceFilePath: sourceFilePaths)
+	{
+		std::ifstream sourceStream(sourceFilePath.str());
+		if (!sourceStream.is_open())
+		{
+			continue;
+		}
+
+		// events are written in the json array format, which allows a trailing comma and a
+		// missing closing bracket, so the events of all files can simply be appended
+		std::string line;
+		while (std::getline(sourceStream, line))
+		{
+			if (!line.empty() && line != "[")
+			{
+				targetStream << line << '\n';
+			}
+		}
+
+		sourceStream.close();
+		FileSystem::remove(sourceFilePath);
+	}
+
+	return true;
+}
+
+void TraceRecorder::setProcessName(const std::string& processName)
+{
+	m_processName = processName;
+}
+
+void TraceRecorder::recordEvent(
+	size_t nameId, unsigned long long startTime, unsigned long long duration)
+{
+	getThreadBuffer()->add({nameId, startTime, duration});
+}
+
+bool TraceRecorder::exportChromeTrace(const FilePath& filePath)
+{
+	const bool fileExists = filePath.exists();
+
+	std::ofstream stream(filePath.str(), std::ios::app);
+	if (!stream.is_open())
+	{
+		LOG_ERROR(L"Unable to write trace file: " + filePath.wstr());
+		return false;
+	}
+
+	const unsigned long processId = static_cast<unsigned long>(
+		boost::interprocess::ipcdetail::get_current_process_id());
+
+	if (!fileExists)
+	{
+		stream << "[\n";
+	}
+
+	if (!m_processName.empty())
+	{
+		stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << processId
+			   << ",\"args\":{\"name\":\"" << escapeJson(m_processName) << "\"}},\n";
+	}
+
+	std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+	{
+		std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+		threadBuffers = m_threadBuffers;
+	}
+
+	std::vector<std::pair<std::string, std::string>> eventNames;
+	{
+		std::lock_guard<std::mutex> lock(m_eventNamesMutex);
+		eventNames = m_eventNames;
+	}
+
+	size_t eventCount = 0;
+	size_t droppedEventCount = 0;
+
+	std::vector<Event> events;
+	for (const std::shared_ptr<ThreadBuffer>& buffer: threadBuffers)
+	{
+		events.clear();
+		buffer->collect(events);
+
+		eventCount += events.size();
+		droppedEventCount += buffer->droppedEventCount.load(std::memory_order_relaxed);
+
+		for (const Event& event: events)
+		{
+			const std::pair<std::string, std::string>& name = eventNames[event.nameId];
+
+			stream << "{\"name\":\""
+				   << escapeJson(name.first.empty() ? name.second : name.first)
+				   << "\",\"cat\":\"sourcetrail\",\"ph\":\"X\",\"ts\":" << event.startTime
+				   << ",\"dur\":" << event.duration << ",\"pid\":" << processId
+				   << ",\"tid\":" << buffer->threadIndex << ",\"args\":{\"function\":\""
+				   << escapeJson(name.second) << "\"}},\n";
+		}
+	}
+
+	LOG_INFO_STREAM(
+		<< "Exported " << eventCount << " trace events to " << filePath.str() << ", dropped "
+		<< droppedEventCount << " events");
+
+	return true;
+}
+
+TraceRecorder::ThreadBuffer::ThreadBuffer(size_t threadIndex)
+	: threadIndex(threadIndex)
+	, droppedEventCount(0)
+	, m_currentChunk(new Event[EVENT_CHUNK_SIZE])
+	, m_currentEventCount(0)
+	, m_exportedEventCount(0)
+	, m_chunkCount(1)
+{
+}
+
+void TraceRecorder::ThreadBuffer::add(const Event& event)
+{
+	size_t index = m_currentEventCount.load(std::memory_order_relaxed);
+
+	if (index == EVENT_CHUNK_SIZE)
+	{
+		std::lock_guard<std::mutex> lock(m_chunksMutex);
+		if (!startNextChunk())
+		{
+			droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		index = 0;
+	}
+
+	m_currentChunk[index] = event;
+	m_currentEventCount.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::ThreadBuffer::collect(std::vector<Event>& events)
+{
+	std::lock_guard<std::mutex> lock(m_chunksMutex);
+
+	for (std::pair<std::unique_ptr<Event[]>, size_t>& chunk: m_fullChunks)
+	{
+		for (size_t i = chunk.second; i < EVENT_CHUNK_SIZE; i++)
+		{
+			events.push_back(chunk.first[i]);
+		}
+
+		// one chunk is kept for reuse, the others are given back
+		if (m_freeChunks.empty())
+		{
+			m_freeChunks.push_back(std::move(chunk.first));
+		}
+		else
+		{
+			m_chunkCount--;
+		}
+	}
+	m_fullChunks.clear();
+
+	const size_t eventCount = m_currentEventCount.load(std::memory_order_acquire);
+	for (size_t i = m_exportedEventCount; i < eventCount; i++)
+	{
+		events.push_back(m_currentChunk[i]);
+	}
+	m_exportedEventCount = eventCount;
+}
+
+bool TraceRecorder::ThreadBuffer::startNextChunk()
+{
+	std::unique_ptr<Event[]> chunk;
+	if (!m_freeChunks.empty())
+	{
+		chunk = std::move(m_freeChunks.back());
+		m_freeChunks.pop_back();
+	}
+	else if (m_chunkCount < MAX_CHUNK_COUNT_PER_THREAD)
+	{
+		chunk.reset(new Event[EVENT_CHUNK_SIZE]);
+		m_chunkCount++;
+	}
+	else
+	{
+		return false;	 // the events are not exported often enough
+	}
+
+	m_fullChunks.push_back(std::make_pair(std::move(m_currentChunk), m_exportedEventCount));
+	m_currentChunk = std::move(chunk);
+	m_currentEventCount.store(0, std::memory_order_relaxed);
+	m_exportedEventCount = 0;
+	return true;
+}
+
+TraceRecorder::TraceRecorder() {}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer()
+{
+	thread_local std::shared_ptr<ThreadBuffer> s_buffer;
+
+	if (!s_buffer)
+	{
+		std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+		s_buffer = std::make_shared<ThreadBuffer>(m_threadBuffers.size() + 1);
+		m_threadBuffers.push_back(s_buffer);
+	}
+
+	return s_buffer.get();
+}
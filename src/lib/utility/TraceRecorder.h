@@ -0,0 +1,125 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FilePath;
+
+// Runtime switchable counterpart of the compile time Tracer. Events are identified by static name
+// ids that get registered once per call site and are appended to a buffer owned by the recording
+// thread, so recording does not take any lock. The collected events can be exported in the Chrome
+// trace event format, which can be opened in chrome://tracing or the Perfetto UI.
+class TraceRecorder
+{
+public:
+	static TraceRecorder* getInstance();
+
+	static inline bool isEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	static void setEnabled(bool enabled);
+
+	static size_t registerEventName(const std::string& eventName, const std::string& functionName);
+
+	static unsigned long long getTimeMicroseconds();
+
+	// merges trace files written by exportChromeTrace into one file and removes the merged files
+	static bool mergeChromeTraces(
+		const std::vector<FilePath>& sourceFilePaths, const FilePath& targetFilePath);
+
+	void setProcessName(const std::string& processName);
+
+	void recordEvent(size_t nameId, unsigned long long startTime, unsigned long long duration);
+
+	// writes all events recorded since the last export
+	bool exportChromeTrace(const FilePath& filePath);
+
+private:
+	struct Event
+	{
+		size_t nameId;
+		unsigned long long startTime;
+		unsigned long long duration;
+	};
+
+	class ThreadBuffer
+	{
+	public:
+		ThreadBuffer(size_t threadIndex);
+
+		void add(const Event& event);
+		void collect(std::vector<Event>& events);
+
+		const size_t threadIndex;
+		// counted by the recording thread and read by the exporting thread
+		std::atomic<size_t> droppedEventCount;
+
+	private:
+		// replaces the full current chunk with a recycled or new one, requires holding m_chunksMutex
+		bool startNextChunk();
+
+		// only written by the recording thread while holding m_chunksMutex
+		std::unique_ptr<Event[]> m_currentChunk;
+		std::atomic<size_t> m_currentEventCount;
+		size_t m_exportedEventCount;	// of the current chunk
+
+		// full chunks with the number of their events that were already exported
+		std::vector<std::pair<std::unique_ptr<Event[]>, size_t>> m_fullChunks;
+		std::vector<std::unique_ptr<Event[]>> m_freeChunks;
+		size_t m_chunkCount;
+		std::mutex m_chunksMutex;
+	};
+
+	static std::atomic<bool> s_enabled;
+
+	TraceRecorder();
+	TraceRecorder(const TraceRecorder&) = delete;
+	void operator=(const TraceRecorder&) = delete;
+
+	ThreadBuffer* getThreadBuffer();
+
+	std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;
+	std::mutex m_threadBuffersMutex;
+
+	std::vector<std::pair<std::string, std::string>> m_eventNames;
+	std::mutex m_eventNamesMutex;
+
+	std::string m_processName;
+};
+
+
+class ScopedTraceRecord
+{
+public:
+	ScopedTraceRecord(size_t nameId);
+	~ScopedTraceRecord();
+
+private:
+	const size_t m_nameId;
+	unsigned long long m_startTime;
+};
+
+inline ScopedTraceRecord::ScopedTraceRecord(size_t nameId): m_nameId(nameId), m_startTime(0)
+{
+	if (TraceRecorder::isEnabled())
+	{
+		m_startTime = TraceRecorder::getTimeMicroseconds();
+	}
+}
+
+inline ScopedTraceRecord::~ScopedTraceRecord()
+{
+	if (m_startTime && TraceRecorder::isEnabled())
+	{
+		TraceRecorder::getInstance()->recordEvent(
+			m_nameId, m_startTime, TraceRecorder::getTimeMicroseconds() - m_startTime);
+	}
+}
+
+#endif	  // TRACE_RECORDER_H
@@ -236,6 +236,11 @@ void CommandLineParser::setShallowIndexingRequested(bool enabled)
 	m_shallowIndexingRequested = enabled;
 }
 
+void CommandLineParser::setStatsJsonFilePath(const FilePath& filePath)
+{
+	m_statsJsonFilePath = filePath;
+}
+
 const FilePath& CommandLineParser::getProjectFilePath() const
 {
 	return m_projectFile;
@@ -251,4 +256,9 @@ bool CommandLineParser::getShallowIndexingRequested() const
 	return m_shallowIndexingRequested;
 }
 
+const FilePath& CommandLineParser::getStatsJsonFilePath() const
+{
+	return m_statsJsonFilePath;
+}
+
 }	 // namespace commandline
@@ -35,12 +35,14 @@ public:
 	void fullRefresh();
 	void incompleteRefresh();
 	void setShallowIndexingRequested(bool enabled = true);
+	void setStatsJsonFilePath(const FilePath& filePath);
 
 	const FilePath& getProjectFilePath() const;
 	void setProjectFile(const FilePath& filepath);
 
 	RefreshMode getRefreshMode() const;
 	bool getShallowIndexingRequested() const;
+	const FilePath& getStatsJsonFilePath() const;
 
 private:
 	void processProjectfile();
@@ -56,6 +58,7 @@ private:
 	FilePath m_projectFile;
 	RefreshMode m_refreshMode = REFRESH_UPDATED_FILES;
 	bool m_shallowIndexingRequested = false;
+	FilePath m_statsJsonFilePath;
 
 	bool m_quit = false;
 	bool m_withoutGUI = false;
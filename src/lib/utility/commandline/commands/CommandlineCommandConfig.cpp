@@ -87,12 +87,24 @@ void CommandlineCommandConfig::setup()
 		"use-processes,p",
 		po::value<bool>(),
 		"Enable C/C++ Indexer threads to run in different processes. <true/false>")(
+		"indexing-memory-budget,b",
+		po::value<int>(),
+		"Set the memory in MB used for indexed data waiting to be stored (0 uses a quarter of "
+		"the physical memory)")(
+		"in-place-refresh,r",
+		po::value<bool>(),
+		"Refresh the index database within a transaction instead of indexing into a copy of it. "
+		"<true/false>")(
 		"logging-enabled,l", po::value<bool>(), "Enable file/console logging <true/false>")(
 		"verbose-indexer-logging-enabled,L",
 		po::value<bool>(),
 		"Enable additional log of abstract syntax tree during the indexing. <true/false> WARNINIG "
 		"Slows down "
 		"indexing speed")(
+		"tracing-enabled,T",
+		po::value<bool>(),
+		"Record trace events of the app and indexer processes and write them to the log directory "
+		"in the Chrome trace event format. <true/false>")(
 		"jvm-path,j", po::value<std::string>(), "Path to the location of the jvm library")(
 		"maven-path,m", po::value<std::string>(), "Path to the maven binary")(
 		"jre-system-library-paths,J",
@@ -148,9 +160,12 @@ CommandlineCommand::ReturnStatus CommandlineCommandConfig::parse(std::vector<std
 		std::cout << "Sourcetrail Settings:\n"
 				  << "\n  indexer-threads: " << settings->getIndexerThreadCount()
 				  << "\n  use-processes: " << settings->getMultiProcessIndexingEnabled()
+				  << "\n  indexing-memory-budget: " << settings->getIndexingMemoryBudgetMb()
+				  << "\n  in-place-refresh: " << settings->getInPlaceRefreshEnabled()
 				  << "\n  logging-enabled: " << settings->getLoggingEnabled()
 				  << "\n  verbose-indexer-logging-enabled: "
 				  << settings->getVerboseIndexerLoggingEnabled()
+				  << "\n  tracing-enabled: " << settings->getTracingEnabled()
 				  << "\n  jvm-path: " << settings->getJavaPath().str()
 				  << "\n  maven-path: " << settings->getMavenPath().str();
 		printVector("global-header-search-paths", settings->getHeaderSearchPaths());
@@ -167,8 +182,13 @@ CommandlineCommand::ReturnStatus CommandlineCommandConfig::parse(std::vector<std
 		"verbose-indexer-logging-enabled",
 		settings,
 		vm);
+	parseAndSetValue(&ApplicationSettings::setTracingEnabled, "tracing-enabled", settings, vm);
 
 	parseAndSetValue(&ApplicationSettings::setIndexerThreadCount, "indexer-threads", settings, vm);
+	parseAndSetValue(
+		&ApplicationSettings::setIndexingMemoryBudgetMb, "indexing-memory-budget", settings, vm);
+	parseAndSetValue(
+		&ApplicationSettings::setInPlaceRefreshEnabled, "in-place-refresh", settings, vm);
 
 	parseAndSetValue(&ApplicationSettings::setMavenPath, "maven-path", settings, vm);
 	parseAndSetValue(&ApplicationSettings::setJavaPath, "jvm-path", settings, vm);
@@ -24,6 +24,7 @@ void CommandlineCommandIndex::setup()
 		("incomplete,i", "Also reindex incomplete files (files with errors)")
 		("full,f", "Index full project (omit to only index new/changed files)")
 		("shallow,s", "Build a shallow index is supported by the project")
+		("stats-json", po::value<std::string>(), "Write indexing statistics to this JSON file")
 		("project-file", po::value<std::string>(), "Project file to index (.srctrlprj)");
 
 	m_options.add(options);
@@ -68,6 +69,11 @@ CommandlineCommand::ReturnStatus CommandlineCommandIndex::parse(std::vector<std:
 		m_parser->setShallowIndexingRequested();
 	}
 
+	if (vm.count("stats-json"))
+	{
+		m_parser->setStatsJsonFilePath(FilePath(vm["stats-json"].as<std::string>()).makeAbsolute());
+	}
+
 	if (vm.count("project-file"))
 	{
 		m_parser->setProjectFile(FilePath(vm["project-file"].as<std::string>()));
@@ -0,0 +1,156 @@
+#include "InterprocessEvent.h"
+
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include "SharedMemory.h"
+#include "SharedMemoryGarbageCollector.h"
+#include "logging.h"
+
+const uint32_t InterprocessEvent::s_magic = 0x53455654;
+const size_t InterprocessEvent::s_lockTimeoutMilliseconds = 1000;
+
+InterprocessEvent::InterprocessEvent(const std::string& name, bool isOwner)
+	: m_name(SharedMemory::checkName(name))
+	, m_isOwner(isOwner)
+	, m_data(nullptr)
+	, m_seenNotificationCount(0)
+	, m_mutexUnavailable(false)
+{
+	const std::string memoryName = SharedMemory::getPrefixedMemoryName(m_name);
+
+	try
+	{
+		if (m_isOwner)
+		{
+			SharedMemoryGarbageCollector* collector = SharedMemoryGarbageCollector::getInstance();
+			if (collector)
+			{
+				collector->registerSharedMemory(m_name);
+			}
+
+			SharedMemory::deleteSharedMemory(m_name);
+
+			boost::interprocess::permissions permissions;
+			permissions.set_unrestricted();
+
+			m_memory = boost::interprocess::shared_memory_object(
+				boost::interprocess::create_only,
+				memoryName.c_str(),
+				boost::interprocess::read_write,
+				permissions);
+			m_memory.truncate(sizeof(Data));
+			m_region = boost::interprocess::mapped_region(m_memory, boost::interprocess::read_write);
+
+			m_data = new (m_region.get_address()) Data();
+			m_data->notificationCount.store(0, std::memory_order_relaxed);
+			m_data->magic.store(s_magic, std::memory_order_release);
+		}
+		else
+		{
+			m_memory = boost::interprocess::shared_memory_object(
+				boost::interprocess::open_only, memoryName.c_str(), boost::interprocess::read_write);
+			m_region = boost::interprocess::mapped_region(m_memory, boost::interprocess::read_write);
+
+			m_data = static_cast<Data*>(m_region.get_address());
+			if (m_region.get_size() < sizeof(Data) ||
+				m_data->magic.load(std::memory_order_acquire) != s_magic)
+			{
+				throw boost::interprocess::interprocess_exception("invalid interprocess event");
+			}
+		}
+	}
+	catch (boost::interprocess::interprocess_exception& e)
+	{
+		LOG_ERROR_STREAM(
+			<< "boost exception thrown at interprocess event creation - " << memoryName << ": "
+			<< e.what());
+		throw e;
+	}
+
+	m_seenNotificationCount = m_data->notificationCount.load(std::memory_order_acquire);
+}
+
+InterprocessEvent::~InterprocessEvent()
+{
+	if (!m_isOwner)
+	{
+		return;
+	}
+
+	try
+	{
+		SharedMemoryGarbageCollector* collector = SharedMemoryGarbageCollector::getInstance();
+		if (collector)
+		{
+			collector->unregisterSharedMemory(m_name);
+		}
+
+		SharedMemory::deleteSharedMemory(m_name);
+	}
+	catch (boost::interprocess::interprocess_exception& e)
+	{
+		LOG_ERROR_STREAM(
+			<< "boost exception thrown at interprocess event destruction - " << m_name << ": "
+			<< e.what());
+	}
+}
+
+void InterprocessEvent::notify()
+{
+	{
+		Lock lock = lockMutex();
+		m_data->notificationCount.fetch_add(1, std::memory_order_acq_rel);
+	}
+	m_data->condition.notify_all();
+}
+
+bool InterprocessEvent::wait(size_t timeoutMilliseconds)
+{
+	const boost::posix_time::ptime timeout = boost::posix_time::microsec_clock::universal_time() +
+		boost::posix_time::milliseconds(timeoutMilliseconds);
+
+	Lock lock = lockMutex();
+	while (m_data->notificationCount.load(std::memory_order_acquire) == m_seenNotificationCount)
+	{
+		if (!lock.owns())
+		{
+			// without the mutex the condition can't be waited for, so the count is polled
+			if (boost::posix_time::microsec_clock::universal_time() >= timeout)
+			{
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		else if (!m_data->condition.timed_wait(lock, timeout))
+		{
+			return false;
+		}
+	}
+
+	m_seenNotificationCount = m_data->notificationCount.load(std::memory_order_acquire);
+	return true;
+}
+
+InterprocessEvent::Lock InterprocessEvent::lockMutex()
+{
+	if (m_mutexUnavailable)
+	{
+		return Lock(m_data->mutex, boost::interprocess::defer_lock);
+	}
+
+	Lock lock(
+		m_data->mutex,
+		boost::posix_time::microsec_clock::universal_time() +
+			boost::posix_time::milliseconds(s_lockTimeoutMilliseconds));
+	if (!lock.owns() && !m_mutexUnavailable.exchange(true))
+	{
+		LOG_WARNING_STREAM(
+			<< "unable to lock mutex of interprocess event " << m_name
+			<< ", falling back to polling");
+	}
+	return lock;
+}
@@ -0,0 +1,61 @@
+#ifndef INTERPROCESS_EVENT_H
+#define INTERPROCESS_EVENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+// Wakes up threads of other processes waiting for something to change, so they don't need to poll
+// shared memory. Each notification wakes up all waiting instances. A notification sent while an
+// instance was not waiting lets its next wait return immediately, so it can't be missed between
+// checking the shared state and starting to wait. The owning instance creates and deletes the event.
+// If the mutex of the event can't be locked, e.g. because a process died while holding it, the
+// instance falls back to polling the notification count instead of taking over the mutex.
+class InterprocessEvent
+{
+public:
+	InterprocessEvent(const std::string& name, bool isOwner);
+	~InterprocessEvent();
+
+	void notify();
+
+	// returns false if there was no notification within the timeout
+	bool wait(size_t timeoutMilliseconds);
+
+private:
+	struct Data
+	{
+		std::atomic<uint32_t> magic;
+		boost::interprocess::interprocess_mutex mutex;
+		boost::interprocess::interprocess_condition condition;
+		std::atomic<uint64_t> notificationCount;
+	};
+
+	using Lock = boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>;
+
+	static const uint32_t s_magic;
+	static const size_t s_lockTimeoutMilliseconds;
+
+	// the mutex is only held for a few instructions, so if it can't be locked within the timeout
+	// the process holding it most likely got killed. The returned lock doesn't own the mutex then
+	// and this instance stops using the mutex.
+	Lock lockMutex();
+
+	const std::string m_name;
+	const bool m_isOwner;
+
+	boost::interprocess::shared_memory_object m_memory;
+	boost::interprocess::mapped_region m_region;
+	Data* m_data;
+
+	uint64_t m_seenNotificationCount;
+	std::atomic<bool> m_mutexUnavailable;
+};
+
+#endif	  // INTERPROCESS_EVENT_H
@@ -125,6 +125,11 @@ void SharedMemory::deleteSharedMemory(const std::string& name)
 	boost::interprocess::named_mutex::remove((s_mutexNamePrefix + name).c_str());
 }
 
+std::string SharedMemory::getPrefixedMemoryName(const std::string& name)
+{
+	return s_memoryNamePrefix + name;
+}
+
 SharedMemory::SharedMemory(const std::string& name, size_t initialMemorySize, AccessMode mode)
 	: m_name(checkName(name)), m_mode(mode), m_initialMemorySize(initialMemorySize)
 {
@@ -258,7 +263,7 @@ bool SharedMemory::checkSharedMutex()
 
 std::string SharedMemory::getMemoryName() const
 {
-	return s_memoryNamePrefix + m_name;
+	return getPrefixedMemoryName(m_name);
 }
 
 std::string SharedMemory::getMutexName() const
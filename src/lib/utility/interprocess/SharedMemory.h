@@ -45,6 +45,7 @@ public:
 	static std::string checkName(const std::string& name);
 	static std::string checkSharedMemory(const std::string& name);
 	static void deleteSharedMemory(const std::string& name);
+	static std::string getPrefixedMemoryName(const std::string& name);
 
 	SharedMemory(const std::string& name, size_t initialMemorySize, AccessMode mode);
 	~SharedMemory();
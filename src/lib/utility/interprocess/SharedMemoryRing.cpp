@@ -0,0 +1,366 @@
+#include "SharedMemoryRing.h"
+
+#include <cstring>
+#include <new>
+
+#include "SharedMemory.h"
+#include "SharedMemoryGarbageCollector.h"
+#include "logging.h"
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory ring requires lock-free 64 bit atomics");
+
+const uint32_t SharedMemoryRing::s_magic = 0x53524e47;
+
+size_t SharedMemoryRing::getRequiredPoolSize(const Record& record)
+{
+	size_t byteCount = 0;
+	for (const std::vector<std::string>& strings: record.fields)
+	{
+		byteCount += alignof(StringRef) + strings.size() * sizeof(StringRef);
+		for (const std::string& str: strings)
+		{
+			byteCount += str.size();
+		}
+	}
+	return byteCount;
+}
+
+SharedMemoryRing::SharedMemoryRing(
+	const std::string& name, size_t capacity, size_t poolSize, bool isOwner)
+	: m_name(SharedMemory::checkName(name)), m_isOwner(isOwner)
+{
+	const std::string memoryName = SharedMemory::getPrefixedMemoryName(m_name);
+
+	try
+	{
+		if (m_isOwner)
+		{
+			size_t slotCount = 1;
+			while (slotCount < capacity)
+			{
+				slotCount <<= 1;
+			}
+			poolSize = std::min<size_t>(poolSize, UINT32_MAX);
+
+			SharedMemoryGarbageCollector* collector = SharedMemoryGarbageCollector::getInstance();
+			if (collector)
+			{
+				collector->registerSharedMemory(m_name);
+			}
+
+			SharedMemory::deleteSharedMemory(m_name);
+
+			boost::interprocess::permissions permissions;
+			permissions.set_unrestricted();
+
+			m_memory = boost::interprocess::shared_memory_object(
+				boost::interprocess::create_only,
+				memoryName.c_str(),
+				boost::interprocess::read_write,
+				permissions);
+			m_memory.truncate(getPoolOffset(slotCount) + poolSize);
+			m_region = boost::interprocess::mapped_region(m_memory, boost::interprocess::read_write);
+
+			m_header = new (m_region.get_address()) Header();
+			m_header->slotCount = static_cast<uint32_t>(slotCount);
+			m_header->poolSize = poolSize;
+			m_header->readPosition.store(0, std::memory_order_relaxed);
+			m_header->writePosition.store(0, std::memory_order_relaxed);
+			m_header->closed.store(0, std::memory_order_relaxed);
+
+			m_slots = reinterpret_cast<Slot*>(
+				static_cast<char*>(m_region.get_address()) + getSlotsOffset());
+			for (size_t i = 0; i < slotCount; i++)
+			{
+				Slot* slot = new (m_slots + i) Slot();
+				slot->sequence.store(i, std::memory_order_relaxed);
+			}
+
+			m_header->magic.store(s_magic, std::memory_order_release);
+		}
+		else
+		{
+			m_memory = boost::interprocess::shared_memory_object(
+				boost::interprocess::open_only, memoryName.c_str(), boost::interprocess::read_write);
+			m_region = boost::interprocess::mapped_region(m_memory, boost::interprocess::read_write);
+
+			m_header = static_cast<Header*>(m_region.get_address());
+			if (m_region.get_size() < sizeof(Header) ||
+				m_header->magic.load(std::memory_order_acquire) != s_magic ||
+				m_region.get_size() < getPoolOffset(m_header->slotCount) + m_header->poolSize)
+			{
+				throw boost::interprocess::interprocess_exception("invalid shared memory ring");
+			}
+
+			m_slots = reinterpret_cast<Slot*>(
+				static_cast<char*>(m_region.get_address()) + getSlotsOffset());
+		}
+	}
+	catch (boost::interprocess::interprocess_exception& e)
+	{
+		LOG_ERROR_STREAM(
+			<< "boost exception thrown at shared memory ring creation - " << memoryName << ": "
+			<< e.what());
+		throw e;
+	}
+
+	m_pool = static_cast<char*>(m_region.get_address()) + getPoolOffset(m_header->slotCount);
+	m_mask = m_header->slotCount - 1;
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+	if (!m_isOwner)
+	{
+		return;
+	}
+
+	try
+	{
+		SharedMemoryGarbageCollector* collector = SharedMemoryGarbageCollector::getInstance();
+		if (collector)
+		{
+			collector->unregisterSharedMemory(m_name);
+		}
+
+		SharedMemory::deleteSharedMemory(m_name);
+	}
+	catch (boost::interprocess::interprocess_exception& e)
+	{
+		LOG_ERROR_STREAM(
+			<< "boost exception thrown at shared memory ring destruction - " << m_name << ": "
+			<< e.what());
+	}
+}
+
+bool SharedMemoryRing::isOwner() const
+{
+	return m_isOwner;
+}
+
+size_t SharedMemoryRing::getCapacity() const
+{
+	return m_header->slotCount;
+}
+
+size_t SharedMemoryRing::getPoolSize() const
+{
+	return m_header->poolSize;
+}
+
+size_t SharedMemoryRing::getRecordPoolSize() const
+{
+	return getPoolSize() / s_poolGenerationCount;
+}
+
+bool SharedMemoryRing::tryPush(const Record& record)
+{
+	if (!m_isOwner || record.fields.size() > s_maxFieldCount)
+	{
+		return false;
+	}
+
+	const uint64_t position = m_writePosition;
+	Slot& slot = m_slots[position & m_mask];
+
+	if (position - m_header->readPosition.load(std::memory_order_acquire) >= m_header->slotCount)
+	{
+		return false;	 // the slot was not popped yet, the ring is full
+	}
+
+	if (!reservePool(getRequiredPoolSize(record)))
+	{
+		return false;
+	}
+
+	slot.type = record.type;
+	slot.fieldCount = static_cast<uint32_t>(record.fields.size());
+	for (size_t i = 0; i < record.fields.size(); i++)
+	{
+		slot.fields[i] = addStringList(record.fields[i]);
+	}
+	m_poolGenerationEnds[m_poolGeneration] = position + 1;
+
+	slot.sequence.store(position + 1, std::memory_order_release);
+	m_header->writePosition.store(position + 1, std::memory_order_release);
+	m_writePosition = position + 1;
+
+	return true;
+}
+
+bool SharedMemoryRing::tryPop(Record& record)
+{
+	uint64_t position = m_header->readPosition.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		const Slot& slot = m_slots[position & m_mask];
+
+		const int64_t difference = static_cast<int64_t>(
+			slot.sequence.load(std::memory_order_acquire) - (position + 1));
+		if (difference < 0)
+		{
+			return false;
+		}
+		else if (difference > 0)
+		{
+			position = m_header->readPosition.load(std::memory_order_acquire);
+			continue;
+		}
+
+		// the record is copied before it is claimed, the producer only overwrites the slot and its
+		// strings after the read position moved past it, in which case claiming fails and the
+		// possibly torn copy is dropped
+		bool valid = slot.fieldCount <= s_maxFieldCount;
+
+		record.type = slot.type;
+		record.fields.resize(valid ? slot.fieldCount : 0);
+		for (size_t i = 0; i < record.fields.size(); i++)
+		{
+			valid = valid && readStringList(slot.fields[i], record.fields[i]);
+		}
+
+		if (m_header->readPosition.compare_exchange_strong(
+				position, position + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			if (!valid)
+			{
+				LOG_ERROR("Shared memory ring " + m_name + " contains an invalid record.");
+				record.fields.clear();
+			}
+			return true;
+		}
+	}
+}
+
+size_t SharedMemoryRing::size() const
+{
+	const uint64_t readPosition = m_header->readPosition.load(std::memory_order_acquire);
+	const uint64_t writePosition = m_header->writePosition.load(std::memory_order_acquire);
+	return writePosition > readPosition ? static_cast<size_t>(writePosition - readPosition) : 0;
+}
+
+void SharedMemoryRing::clear()
+{
+	Record record;
+	while (tryPop(record))
+		;
+}
+
+void SharedMemoryRing::close()
+{
+	m_header->closed.store(1, std::memory_order_release);
+}
+
+bool SharedMemoryRing::isClosed() const
+{
+	return m_header->closed.load(std::memory_order_acquire) != 0;
+}
+
+size_t SharedMemoryRing::getSlotsOffset()
+{
+	return (sizeof(Header) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+}
+
+size_t SharedMemoryRing::getPoolOffset(size_t slotCount)
+{
+	return getSlotsOffset() + slotCount * sizeof(Slot);
+}
+
+bool SharedMemoryRing::reservePool(size_t byteCount)
+{
+	const size_t generationSize = getRecordPoolSize();
+	if (m_poolUsed + byteCount <= (m_poolGeneration + 1) * generationSize)
+	{
+		return true;
+	}
+
+	if (byteCount > generationSize)
+	{
+		LOG_ERROR_STREAM(
+			<< "Record of " << byteCount << " bytes exceeds the string pool of shared memory ring "
+			<< m_name << ".");
+		return false;
+	}
+
+	// strings of a generation can only be overwritten when all records referencing them were popped
+	const size_t nextGeneration = (m_poolGeneration + 1) % s_poolGenerationCount;
+	if (m_header->readPosition.load(std::memory_order_acquire) <
+		m_poolGenerationEnds[nextGeneration])
+	{
+		return false;
+	}
+
+	m_poolGeneration = nextGeneration;
+	m_poolUsed = nextGeneration * generationSize;
+	m_internedStrings.clear();
+	return true;
+}
+
+uint32_t SharedMemoryRing::allocatePool(size_t byteCount, size_t alignment)
+{
+	const size_t offset = (m_poolUsed + alignment - 1) / alignment * alignment;
+	m_poolUsed = offset + byteCount;
+	return static_cast<uint32_t>(offset);
+}
+
+SharedMemoryRing::StringRef SharedMemoryRing::addString(const std::string& str)
+{
+	auto it = m_internedStrings.find(str);
+	if (it != m_internedStrings.end())
+	{
+		return it->second;
+	}
+
+	StringRef ref;
+	ref.offset = allocatePool(str.size(), 1);
+	ref.length = static_cast<uint32_t>(str.size());
+	std::memcpy(m_pool + ref.offset, str.data(), str.size());
+
+	m_internedStrings.emplace(str, ref);
+	return ref;
+}
+
+SharedMemoryRing::StringListRef SharedMemoryRing::addStringList(const std::vector<std::string>& strings)
+{
+	std::vector<StringRef> refs;
+	refs.reserve(strings.size());
+	for (const std::string& str: strings)
+	{
+		refs.push_back(addString(str));
+	}
+
+	StringListRef ref;
+	ref.offset = allocatePool(refs.size() * sizeof(StringRef), alignof(StringRef));
+	ref.count = static_cast<uint32_t>(refs.size());
+	if (!refs.empty())
+	{
+		std::memcpy(m_pool + ref.offset, refs.data(), refs.size() * sizeof(StringRef));
+	}
+	return ref;
+}
+
+bool SharedMemoryRing::readStringList(const StringListRef& ref, std::vector<std::string>& strings) const
+{
+	const uint64_t poolSize = m_header->poolSize;
+	if (uint64_t(ref.offset) + uint64_t(ref.count) * sizeof(StringRef) > poolSize)
+	{
+		return false;
+	}
+
+	strings.clear();
+	strings.reserve(ref.count);
+
+	for (uint32_t i = 0; i < ref.count; i++)
+	{
+		StringRef str;
+		std::memcpy(&str, m_pool + ref.offset + i * sizeof(StringRef), sizeof(StringRef));
+		if (uint64_t(str.offset) + str.length > poolSize)
+		{
+			return false;
+		}
+		strings.emplace_back(m_pool + str.offset, str.length);
+	}
+
+	return true;
+}
@@ -0,0 +1,123 @@
+#ifndef SHARED_MEMORY_RING_H
+#define SHARED_MEMORY_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+// Lock-free single producer / multiple consumer queue of fixed-size records in shared memory.
+// The segment is mapped once when the ring is constructed and stays mapped for its lifetime, so
+// pushing and popping neither takes a named mutex nor re-opens the mapping. Strings of a record
+// are stored in a pool next to the slots and are deduplicated by the producer. The pool is split
+// into two generations that are filled alternately, a generation is reused as soon as all records
+// referencing it were popped, while the records of the other generation are still queued.
+// Consumers copy a record before claiming it, so a consumer that dies at any point never blocks the
+// producer.
+// Only the owning instance may push, any number of instances in other processes or threads may pop.
+class SharedMemoryRing
+{
+public:
+	static const size_t s_maxFieldCount = 6;
+
+	struct Record
+	{
+		uint32_t type = 0;
+		std::vector<std::vector<std::string>> fields;	 // at most s_maxFieldCount
+	};
+
+	static size_t getRequiredPoolSize(const Record& record);
+
+	SharedMemoryRing(const std::string& name, size_t capacity, size_t poolSize, bool isOwner);
+	~SharedMemoryRing();
+
+	bool isOwner() const;
+
+	size_t getCapacity() const;
+	size_t getPoolSize() const;
+
+	// maximum pool size a single record may require
+	size_t getRecordPoolSize() const;
+
+	// returns false if the ring is full or the pool has no space left until older records are popped
+	bool tryPush(const Record& record);
+
+	// returns false if the ring is empty
+	bool tryPop(Record& record);
+
+	size_t size() const;
+	void clear();
+
+	// marks that no more records will be pushed, an empty ring is then final for the consumers
+	void close();
+	bool isClosed() const;
+
+private:
+	struct StringRef
+	{
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	struct StringListRef
+	{
+		uint32_t offset;	// offset of a StringRef array in the pool
+		uint32_t count;
+	};
+
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence;
+		uint32_t type;
+		uint32_t fieldCount;
+		StringListRef fields[s_maxFieldCount];
+	};
+
+	struct Header
+	{
+		std::atomic<uint32_t> magic;
+		uint32_t slotCount;
+		uint64_t poolSize;
+
+		alignas(64) std::atomic<uint64_t> readPosition;
+		alignas(64) std::atomic<uint64_t> writePosition;
+		std::atomic<uint32_t> closed;
+	};
+
+	static const uint32_t s_magic;
+	static const size_t s_poolGenerationCount = 2;
+
+	static size_t getSlotsOffset();
+	static size_t getPoolOffset(size_t slotCount);
+
+	bool reservePool(size_t byteCount);
+	uint32_t allocatePool(size_t byteCount, size_t alignment);
+	StringRef addString(const std::string& str);
+	StringListRef addStringList(const std::vector<std::string>& strings);
+
+	bool readStringList(const StringListRef& ref, std::vector<std::string>& strings) const;
+
+	const std::string m_name;
+	const bool m_isOwner;
+
+	boost::interprocess::shared_memory_object m_memory;
+	boost::interprocess::mapped_region m_region;
+
+	Header* m_header = nullptr;
+	Slot* m_slots = nullptr;
+	char* m_pool = nullptr;
+	uint64_t m_mask = 0;
+
+	// producer state, only used by the owner
+	uint64_t m_writePosition = 0;
+	size_t m_poolGeneration = 0;
+	size_t m_poolUsed = 0;
+	uint64_t m_poolGenerationEnds[s_poolGenerationCount] = {};	  // position after the last record
+	std::map<std::string, StringRef> m_internedStrings;
+};
+
+#endif	  // SHARED_MEMORY_RING_H
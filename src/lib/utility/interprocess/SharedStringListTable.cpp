@@ -0,0 +1,234 @@
+#include "SharedStringListTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "SharedMemory.h"
+#include "SharedMemoryGarbageCollector.h"
+#include "logging.h"
+
+const uint32_t SharedStringListTable::s_magic = 0x53534c54;
+
+SharedStringListTable::SharedStringListTable(
+	const std::string& name, size_t capacity, size_t dataSize, bool isOwner)
+	: m_name(SharedMemory::checkName(name)), m_isOwner(isOwner)
+{
+	const std::string memoryName = SharedMemory::getPrefixedMemoryName(m_name);
+
+	try
+	{
+		if (m_isOwner)
+		{
+			capacity = std::min<size_t>(capacity, UINT32_MAX);
+
+			SharedMemoryGarbageCollector* collector = SharedMemoryGarbageCollector::getInstance();
+			if (collector)
+			{
+				collector->registerSharedMemory(m_name);
+			}
+
+			SharedMemory::deleteSharedMemory(m_name);
+
+			boost::interprocess::permissions permissions;
+			permissions.set_unrestricted();
+
+			m_memory = boost::interprocess::shared_memory_object(
+				boost::interprocess::create_only,
+				memoryName.c_str(),
+				boost::interprocess::read_write,
+				permissions);
+			m_memory.truncate(getDataOffset(capacity) + dataSize);
+			m_region = boost::interprocess::mapped_region(m_memory, boost::interprocess::read_write);
+
+			m_header = new (m_region.get_address()) Header();
+			m_header->capacity = static_cast<uint32_t>(capacity);
+			m_header->dataSize = dataSize;
+			m_header->listCount.store(0, std::memory_order_relaxed);
+
+			m_header->magic.store(s_magic, std::memory_order_release);
+		}
+		else
+		{
+			m_memory = boost::interprocess::shared_memory_object(
+				boost::interprocess::open_only, memoryName.c_str(), boost::interprocess::read_write);
+			m_region = boost::interprocess::mapped_region(m_memory, boost::interprocess::read_write);
+
+			m_header = static_cast<Header*>(m_region.get_address());
+			if (m_region.get_size() < sizeof(Header) ||
+				m_header->magic.load(std::memory_order_acquire) != s_magic ||
+				m_region.get_size() < getDataOffset(m_header->capacity) + m_header->dataSize)
+			{
+				throw boost::interprocess::interprocess_exception(
+					"invalid shared string list table");
+			}
+		}
+	}
+	catch (boost::interprocess::interprocess_exception& e)
+	{
+		LOG_ERROR_STREAM(
+			<< "boost exception thrown at shared string list table creation - " << memoryName
+			<< ": " << e.what());
+		throw e;
+	}
+
+	m_lists = reinterpret_cast<ListRef*>(
+		static_cast<char*>(m_region.get_address()) + getListsOffset());
+	m_data = static_cast<char*>(m_region.get_address()) + getDataOffset(m_header->capacity);
+}
+
+SharedStringListTable::~SharedStringListTable()
+{
+	if (!m_isOwner)
+	{
+		return;
+	}
+
+	try
+	{
+		SharedMemoryGarbageCollector* collector = SharedMemoryGarbageCollector::getInstance();
+		if (collector)
+		{
+			collector->unregisterSharedMemory(m_name);
+		}
+
+		SharedMemory::deleteSharedMemory(m_name);
+	}
+	catch (boost::interprocess::interprocess_exception& e)
+	{
+		LOG_ERROR_STREAM(
+			<< "boost exception thrown at shared string list table destruction - " << m_name
+			<< ": " << e.what());
+	}
+}
+
+bool SharedStringListTable::isOwner() const
+{
+	return m_isOwner;
+}
+
+size_t SharedStringListTable::getCapacity() const
+{
+	return m_header->capacity;
+}
+
+size_t SharedStringListTable::getDataSize() const
+{
+	return m_header->dataSize;
+}
+
+size_t SharedStringListTable::size() const
+{
+	return m_header->listCount.load(std::memory_order_acquire);
+}
+
+bool SharedStringListTable::tryAdd(const std::vector<std::string>& strings, uint32_t& id)
+{
+	if (!m_isOwner)
+	{
+		return false;
+	}
+
+	const uint32_t listCount = m_header->listCount.load(std::memory_order_relaxed);
+	if (listCount >= m_header->capacity)
+	{
+		return false;
+	}
+
+	size_t byteCount = sizeof(uint32_t) * (strings.size() + 1);
+	for (const std::string& str: strings)
+	{
+		if (str.size() > UINT32_MAX)
+		{
+			return false;
+		}
+		byteCount += str.size();
+	}
+
+	const size_t offset = (m_dataUsed + alignof(uint32_t) - 1) / alignof(uint32_t) *
+		alignof(uint32_t);
+	if (offset + byteCount > m_header->dataSize)
+	{
+		return false;
+	}
+
+	char* data = m_data + offset;
+	const uint32_t stringCount = static_cast<uint32_t>(strings.size());
+	std::memcpy(data, &stringCount, sizeof(uint32_t));
+	data += sizeof(uint32_t);
+
+	for (const std::string& str: strings)
+	{
+		const uint32_t length = static_cast<uint32_t>(str.size());
+		std::memcpy(data, &length, sizeof(uint32_t));
+		data += sizeof(uint32_t);
+	}
+
+	for (const std::string& str: strings)
+	{
+		std::memcpy(data, str.data(), str.size());
+		data += str.size();
+	}
+
+	m_lists[listCount].offset = offset;
+	m_lists[listCount].byteCount = byteCount;
+	m_dataUsed = offset + byteCount;
+
+	// readers only access lists below the published count
+	m_header->listCount.store(listCount + 1, std::memory_order_release);
+
+	id = listCount;
+	return true;
+}
+
+bool SharedStringListTable::get(uint32_t id, std::vector<std::string>& strings) const
+{
+	if (id >= m_header->listCount.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	const ListRef ref = m_lists[id];
+	const uint64_t dataSize = m_header->dataSize;
+	if (ref.offset + ref.byteCount > dataSize || ref.byteCount < sizeof(uint32_t))
+	{
+		return false;
+	}
+
+	const char* data = m_data + ref.offset;
+	uint32_t stringCount = 0;
+	std::memcpy(&stringCount, data, sizeof(uint32_t));
+
+	uint64_t dataOffset = sizeof(uint32_t) * (uint64_t(stringCount) + 1);
+	if (dataOffset > ref.byteCount)
+	{
+		return false;
+	}
+
+	strings.clear();
+	strings.reserve(stringCount);
+
+	for (uint32_t i = 0; i < stringCount; i++)
+	{
+		uint32_t length = 0;
+		std::memcpy(&length, data + sizeof(uint32_t) * (i + 1), sizeof(uint32_t));
+		if (dataOffset + length > ref.byteCount)
+		{
+			return false;
+		}
+		strings.emplace_back(data + dataOffset, length);
+		dataOffset += length;
+	}
+
+	return true;
+}
+
+size_t SharedStringListTable::getListsOffset()
+{
+	return (sizeof(Header) + alignof(ListRef) - 1) / alignof(ListRef) * alignof(ListRef);
+}
+
+size_t SharedStringListTable::getDataOffset(size_t capacity)
+{
+	return getListsOffset() + capacity * sizeof(ListRef);
+}
@@ -0,0 +1,69 @@
+#ifndef SHARED_STRING_LIST_TABLE_H
+#define SHARED_STRING_LIST_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+// Append-only table of string lists in shared memory. A list is copied into the table once and is
+// referenced by its id afterwards, so data that many records have in common doesn't need to be
+// passed with each of them. Lists are never removed, once the table is full no more lists can be
+// added. Only the owning instance may add lists, any number of instances may read them.
+class SharedStringListTable
+{
+public:
+	SharedStringListTable(const std::string& name, size_t capacity, size_t dataSize, bool isOwner);
+	~SharedStringListTable();
+
+	bool isOwner() const;
+
+	size_t getCapacity() const;
+	size_t getDataSize() const;
+	size_t size() const;
+
+	// returns false if the table has no space left for the list
+	bool tryAdd(const std::vector<std::string>& strings, uint32_t& id);
+
+	// returns false if no valid list was added with this id
+	bool get(uint32_t id, std::vector<std::string>& strings) const;
+
+private:
+	struct ListRef
+	{
+		uint64_t offset;	// offset of the string count, followed by the string lengths and data
+		uint64_t byteCount;
+	};
+
+	struct Header
+	{
+		std::atomic<uint32_t> magic;
+		uint32_t capacity;
+		uint64_t dataSize;
+
+		alignas(64) std::atomic<uint32_t> listCount;
+	};
+
+	static const uint32_t s_magic;
+
+	static size_t getListsOffset();
+	static size_t getDataOffset(size_t capacity);
+
+	const std::string m_name;
+	const bool m_isOwner;
+
+	boost::interprocess::shared_memory_object m_memory;
+	boost::interprocess::mapped_region m_region;
+
+	Header* m_header = nullptr;
+	ListRef* m_lists = nullptr;
+	char* m_data = nullptr;
+
+	// producer state, only used by the owner
+	size_t m_dataUsed = 0;
+};
+
+#endif	  // SHARED_STRING_LIST_TABLE_H
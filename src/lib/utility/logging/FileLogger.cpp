@@ -54,6 +54,7 @@ FileLogger::FileLogger()
 	, m_maxLogFileCount(0)
 	, m_currentLogLineCount(0)
 	, m_currentLogFileCount(0)
+	, m_isBatching(false)
 {
 	updateLogFileName();
 }
@@ -65,6 +66,7 @@ FilePath FileLogger::getLogFilePath() const
 
 void FileLogger::setLogFilePath(const FilePath& filePath)
 {
+	m_fileStream.close();
 	m_currentLogFilePath = filePath;
 	m_logFileName = L"";
 }
@@ -79,6 +81,7 @@ void FileLogger::setFileName(const std::wstring& fileName)
 {
 	if (fileName != m_logFileName)
 	{
+		m_fileStream.close();
 		m_logFileName = fileName;
 		m_currentLogLineCount = 0;
 		m_currentLogFileCount = 0;
@@ -101,6 +104,17 @@ void FileLogger::logError(const LogMessage& message)
 	logMessage("ERROR", message);
 }
 
+void FileLogger::beginBatch()
+{
+	m_isBatching = true;
+}
+
+void FileLogger::endBatch()
+{
+	m_isBatching = false;
+	m_fileStream.close();
+}
+
 void FileLogger::setMaxLogLineCount(unsigned int lineCount)
 {
 	m_maxLogLineCount = lineCount;
@@ -154,25 +168,33 @@ void FileLogger::updateLogFileName()
 
 	if (fileChanged)
 	{
+		m_fileStream.close();
 		FileSystem::remove(m_currentLogFilePath);
 	}
 }
 
 void FileLogger::logMessage(const std::string& type, const LogMessage& message)
 {
-	std::ofstream fileStream;
-	fileStream.open(m_currentLogFilePath.str(), std::ios::app);
-	fileStream << message.getTimeString("%H:%M:%S") << " | ";
-	fileStream << message.threadId << " | ";
+	if (!m_fileStream.is_open())
+	{
+		m_fileStream.open(m_currentLogFilePath.str(), std::ios::app);
+	}
+
+	m_fileStream << message.getTimeString("%H:%M:%S") << " | ";
+	m_fileStream << message.threadId << " | ";
 
 	if (message.filePath.size())
 	{
-		fileStream << message.getFileName() << ':' << message.line << ' ' << message.functionName
-				   << "() | ";
+		m_fileStream << message.getFileName() << ':' << message.line << ' '
+					 << message.functionName << "() | ";
 	}
 
-	fileStream << type << ": " << utility::encodeToUtf8(message.message) << std::endl;
-	fileStream.close();
+	m_fileStream << type << ": " << utility::encodeToUtf8(message.message) << '\n';
+
+	if (!m_isBatching)
+	{
+		m_fileStream.close();
+	}
 
 	m_currentLogLineCount++;
 	if (m_maxLogFileCount > 0)
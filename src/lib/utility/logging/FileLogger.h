@@ -1,6 +1,7 @@
 #ifndef FILE_LOGGER_H
 #define FILE_LOGGER_H
 
+#include <fstream>
 #include <string>
 
 #include "FilePath.h"
@@ -32,6 +33,9 @@ private:
 	void logWarning(const LogMessage& message) override;
 	void logError(const LogMessage& message) override;
 
+	void beginBatch() override;
+	void endBatch() override;
+
 	void logMessage(const std::string& type, const LogMessage& message);
 	void updateLogFileName();
 
@@ -43,6 +47,10 @@ private:
 	unsigned int m_maxLogFileCount;
 	unsigned int m_currentLogLineCount;
 	unsigned int m_currentLogFileCount;
+
+	// kept open while a batch of messages is written
+	std::ofstream m_fileStream;
+	bool m_isBatching;
 };
 
 #endif	  // FILE_LOGGER_H
@@ -6,7 +6,6 @@
 #include "Version.h"
 #include "logging.h"
 #include "utilityApp.h"
-#include "utilityString.h"
 
 std::shared_ptr<LogManager> LogManager::getInstance()
 {
@@ -53,6 +52,16 @@ bool LogManager::getLoggingEnabled() const
 	return m_loggingEnabled;
 }
 
+void LogManager::setLoggingAsync(bool async)
+{
+	m_logManagerImplementation.setAsync(async);
+}
+
+void LogManager::flush()
+{
+	m_logManagerImplementation.flush();
+}
+
 void LogManager::addLogger(std::shared_ptr<Logger> logger)
 {
 	m_logManagerImplementation.addLogger(logger);
@@ -90,20 +99,20 @@ int LogManager::getLoggerCount() const
 
 void LogManager::logInfo(
 	const std::string& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
 	if (m_loggingEnabled)
 	{
-		m_logManagerImplementation.logInfo(utility::decodeFromUtf8(message), file, function, line);
+		m_logManagerImplementation.logInfo(message, file, function, line);
 	}
 }
 
 void LogManager::logInfo(
 	const std::wstring& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
 	if (m_loggingEnabled)
@@ -114,20 +123,20 @@ void LogManager::logInfo(
 
 void LogManager::logWarning(
 	const std::string& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
 	if (m_loggingEnabled)
 	{
-		m_logManagerImplementation.logWarning(utility::decodeFromUtf8(message), file, function, line);
+		m_logManagerImplementation.logWarning(message, file, function, line);
 	}
 }
 
 void LogManager::logWarning(
 	const std::wstring& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
 	if (m_loggingEnabled)
@@ -138,20 +147,20 @@ void LogManager::logWarning(
 
 void LogManager::logError(
 	const std::string& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
 	if (m_loggingEnabled)
 	{
-		m_logManagerImplementation.logError(utility::decodeFromUtf8(message), file, function, line);
+		m_logManagerImplementation.logError(message, file, function, line);
 	}
 }
 
 void LogManager::logError(
 	const std::wstring& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
 	if (m_loggingEnabled)
@@ -17,6 +17,9 @@ public:
 	void setLoggingEnabled(bool enabled);
 	bool getLoggingEnabled() const;
 
+	void setLoggingAsync(bool async);
+	void flush();
+
 	void addLogger(std::shared_ptr<Logger> logger);
 	void removeLogger(std::shared_ptr<Logger> logger);
 	void removeLoggersByType(const std::string& type);
@@ -27,33 +30,33 @@ public:
 
 	void logInfo(
 		const std::string& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logInfo(
 		const std::wstring& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logWarning(
 		const std::string& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logWarning(
 		const std::wstring& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logError(
 		const std::string& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logError(
 		const std::wstring& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 
 private:
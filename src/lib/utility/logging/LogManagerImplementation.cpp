@@ -1,10 +1,37 @@
 #include "LogManagerImplementation.h"
 
 #include <algorithm>
+#include <chrono>
 
-LogManagerImplementation::LogManagerImplementation() {}
+#include "utilityString.h"
+
+namespace
+{
+const size_t MESSAGE_BUFFER_CAPACITY = 4096;
+const int WRITER_INTERVAL_MS = 20;
+
+size_t getNextInstanceId()
+{
+	static std::atomic<size_t> s_nextInstanceId(1);
+	return s_nextInstanceId++;
+}
+}	 // namespace
+
+LogManagerImplementation::LogManagerImplementation()
+	: m_instanceId(getNextInstanceId())
+	, m_async(false)
+	, m_queueingThreadCount(0)
+	, m_nextSequenceNumber(0)
+	, m_stopWriter(false)
+{
+}
 
 LogManagerImplementation::LogManagerImplementation(const LogManagerImplementation& other)
+	: m_instanceId(getNextInstanceId())
+	, m_async(false)
+	, m_queueingThreadCount(0)
+	, m_nextSequenceNumber(0)
+	, m_stopWriter(false)
 {
 	m_loggers = other.m_loggers;
 }
@@ -14,7 +41,10 @@ void LogManagerImplementation::operator=(const LogManagerImplementation& other)
 	m_loggers = other.m_loggers;
 }
 
-LogManagerImplementation::~LogManagerImplementation() {}
+LogManagerImplementation::~LogManagerImplementation()
+{
+	setAsync(false);
+}
 
 void LogManagerImplementation::addLogger(std::shared_ptr<Logger> logger)
 {
@@ -82,53 +112,150 @@ int LogManagerImplementation::getLoggerCount() const
 	return static_cast<int>(m_loggers.size());
 }
 
+void LogManagerImplementation::logInfo(
+	const std::string& message,
+	const char* file,
+	const char* function,
+	const unsigned int line)
+{
+	logMessage(LOG_TYPE_INFO, message, file, function, line);
+}
+
 void LogManagerImplementation::logInfo(
 	const std::wstring& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
-	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
-	for (unsigned int i = 0; i < m_loggers.size(); i++)
-	{
-		m_loggers[i]->onInfo(
-			LogMessage(message, file, function, line, getTime(), std::this_thread::get_id()));
-	}
+	logMessage(LOG_TYPE_INFO, message, file, function, line);
+}
+
+void LogManagerImplementation::logWarning(
+	const std::string& message,
+	const char* file,
+	const char* function,
+	const unsigned int line)
+{
+	logMessage(LOG_TYPE_WARNING, message, file, function, line);
 }
 
 void LogManagerImplementation::logWarning(
 	const std::wstring& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
-	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
-	for (unsigned int i = 0; i < m_loggers.size(); i++)
-	{
-		m_loggers[i]->onWarning(
-			LogMessage(message, file, function, line, getTime(), std::this_thread::get_id()));
-	}
+	logMessage(LOG_TYPE_WARNING, message, file, function, line);
+}
+
+void LogManagerImplementation::logError(
+	const std::string& message,
+	const char* file,
+	const char* function,
+	const unsigned int line)
+{
+	logMessage(LOG_TYPE_ERROR, message, file, function, line);
 }
 
 void LogManagerImplementation::logError(
 	const std::wstring& message,
-	const std::string& file,
-	const std::string& function,
+	const char* file,
+	const char* function,
 	const unsigned int line)
 {
-	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
-	for (unsigned int i = 0; i < m_loggers.size(); i++)
+	logMessage(LOG_TYPE_ERROR, message, file, function, line);
+}
+
+void LogManagerImplementation::setAsync(bool async)
+{
+	std::unique_lock<std::mutex> lock(m_writerMutex);
+
+	if (async == m_async)
+	{
+		return;
+	}
+
+	if (async)
 	{
-		m_loggers[i]->onError(
-			LogMessage(message, file, function, line, getTime(), std::this_thread::get_id()));
+		m_stopWriter = false;
+		m_async = true;
+		m_writerThread = std::thread(&LogManagerImplementation::runWriter, this);
 	}
+	else
+	{
+		// new messages are logged synchronously from now on, but threads that already saw async
+		// mode may still be queueing and need the writer to make room in their buffers
+		m_async = false;
+		lock.unlock();
+		while (m_queueingThreadCount > 0)
+		{
+			std::this_thread::yield();
+		}
+
+		lock.lock();
+		m_stopWriter = true;
+		lock.unlock();
+
+		m_writerCondition.notify_one();
+		m_writerThread.join();
+
+		writeQueuedMessages();
+	}
+}
+
+bool LogManagerImplementation::isAsync() const
+{
+	return m_async;
 }
 
-tm LogManagerImplementation::getTime()
+void LogManagerImplementation::flush()
 {
-	time_t time;
-	std::time(&time);
+	writeQueuedMessages();
+}
+
+LogManagerImplementation::MessageBuffer::MessageBuffer(size_t capacity)
+	: m_slots(capacity), m_head(0), m_tail(0)
+{
+}
+
+bool LogManagerImplementation::MessageBuffer::push(QueuedLogMessage& message)
+{
+	const size_t tail = m_tail.load(std::memory_order_relaxed);
+	if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size())
+	{
+		return false;
+	}
+
+	m_slots[tail % m_slots.size()] = std::move(message);
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
 
+void LogManagerImplementation::MessageBuffer::popAll(std::vector<QueuedLogMessage>& messages)
+{
+	const size_t head = m_head.load(std::memory_order_relaxed);
+	const size_t tail = m_tail.load(std::memory_order_acquire);
+
+	for (size_t i = head; i < tail; i++)
+	{
+		messages.push_back(std::move(m_slots[i % m_slots.size()]));
+	}
+
+	m_head.store(tail, std::memory_order_release);
+}
+
+size_t LogManagerImplementation::MessageBuffer::size() const
+{
+	return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+}
+
+size_t LogManagerImplementation::MessageBuffer::capacity() const
+{
+	return m_slots.size();
+}
+
+tm LogManagerImplementation::getTime(time_t time)
+{
 #pragma warning(push)
 #pragma warning(disable : 4996)
 	tm result = *std::localtime(&time);	   // this is done because localtime returns a pointer to a
@@ -137,3 +264,208 @@ tm LogManagerImplementation::getTime()
 
 	return result;
 }
+
+void LogManagerImplementation::logMessage(
+	LogType type,
+	const std::string& message,
+	const char* file,
+	const char* function,
+	const unsigned int line)
+{
+	if (tryQueueMessage(type, &message, nullptr, file, function, line))
+	{
+		return;
+	}
+
+	logMessage(type, utility::decodeFromUtf8(message), file, function, line);
+}
+
+void LogManagerImplementation::logMessage(
+	LogType type,
+	const std::wstring& message,
+	const char* file,
+	const char* function,
+	const unsigned int line)
+{
+	if (tryQueueMessage(type, nullptr, &message, file, function, line))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
+	writeMessage(
+		type,
+		LogMessage(
+			message, file, function, line, getTime(std::time(nullptr)), std::this_thread::get_id()));
+}
+
+bool LogManagerImplementation::tryQueueMessage(
+	LogType type,
+	const std::string* message,
+	const std::wstring* wideMessage,
+	const char* file,
+	const char* function,
+	const unsigned int line)
+{
+	m_queueingThreadCount++;
+	if (!m_async)
+	{
+		m_queueingThreadCount--;
+		return false;
+	}
+
+	MessageBuffer* buffer = getThreadMessageBuffer();
+
+	QueuedLogMessage queuedMessage {
+		type,
+		message ? *message : std::string(),
+		wideMessage ? *wideMessage : std::wstring(),
+		file,
+		function,
+		line,
+		std::time(nullptr),
+		std::this_thread::get_id(),
+		m_nextSequenceNumber++};
+
+	while (!buffer->push(queuedMessage))
+	{
+		// buffer is full, wait for the writer instead of dropping the message
+		m_writerCondition.notify_one();
+		std::this_thread::yield();
+	}
+
+	if (type == LOG_TYPE_ERROR)
+	{
+		// errors often precede crashes, so they don't wait for the writer
+		writeQueuedMessages();
+	}
+	else if (buffer->size() > buffer->capacity() / 2)
+	{
+		m_writerCondition.notify_one();
+	}
+
+	m_queueingThreadCount--;
+	return true;
+}
+
+void LogManagerImplementation::writeMessage(LogType type, const LogMessage& logEntry)
+{
+	for (unsigned int i = 0; i < m_loggers.size(); i++)
+	{
+		switch (type)
+		{
+		case LOG_TYPE_INFO:
+			m_loggers[i]->onInfo(logEntry);
+			break;
+		case LOG_TYPE_WARNING:
+			m_loggers[i]->onWarning(logEntry);
+			break;
+		case LOG_TYPE_ERROR:
+			m_loggers[i]->onError(logEntry);
+			break;
+		}
+	}
+}
+
+LogManagerImplementation::MessageBuffer* LogManagerImplementation::getThreadMessageBuffer()
+{
+	thread_local size_t s_instanceId = 0;
+	thread_local std::shared_ptr<MessageBuffer> s_buffer;
+
+	if (s_instanceId != m_instanceId || !s_buffer)
+	{
+		s_buffer = std::make_shared<MessageBuffer>(MESSAGE_BUFFER_CAPACITY);
+		s_instanceId = m_instanceId;
+
+		std::lock_guard<std::mutex> lock(m_messageBuffersMutex);
+		m_messageBuffers.push_back(s_buffer);
+	}
+
+	return s_buffer.get();
+}
+
+void LogManagerImplementation::runWriter()
+{
+	std::unique_lock<std::mutex> lock(m_writerMutex);
+	while (!m_stopWriter)
+	{
+		m_writerCondition.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS));
+
+		lock.unlock();
+		writeQueuedMessages();
+		lock.lock();
+	}
+	lock.unlock();
+
+	writeQueuedMessages();
+}
+
+void LogManagerImplementation::writeQueuedMessages()
+{
+	std::lock_guard<std::mutex> writeLock(m_writeMutex);
+
+	std::vector<QueuedLogMessage> messages;
+	{
+		std::lock_guard<std::mutex> lock(m_messageBuffersMutex);
+		for (size_t i = 0; i < m_messageBuffers.size(); i++)
+		{
+			// buffers only referenced here belong to threads that stopped logging to this instance
+			const bool isOrphaned = m_messageBuffers[i].use_count() == 1;
+
+			m_messageBuffers[i]->popAll(messages);
+
+			if (isOrphaned)
+			{
+				m_messageBuffers.erase(m_messageBuffers.begin() + i);
+				i--;
+			}
+		}
+	}
+
+	if (messages.empty())
+	{
+		return;
+	}
+
+	std::sort(
+		messages.begin(),
+		messages.end(),
+		[](const QueuedLogMessage& a, const QueuedLogMessage& b) {
+			return a.sequenceNumber < b.sequenceNumber;
+		});
+
+	std::lock_guard<std::mutex> lockGuardLogger(m_loggerMutex);
+
+	for (unsigned int i = 0; i < m_loggers.size(); i++)
+	{
+		m_loggers[i]->beginBatch();
+	}
+
+	time_t lastTime = 0;
+	tm lastTm = getTime(lastTime);
+
+	for (const QueuedLogMessage& message: messages)
+	{
+		if (message.time != lastTime)
+		{
+			lastTime = message.time;
+			lastTm = getTime(lastTime);
+		}
+
+		writeMessage(
+			message.type,
+			LogMessage(
+				message.wideMessage.empty() ? utility::decodeFromUtf8(message.message)
+											: message.wideMessage,
+				message.file,
+				message.function,
+				message.line,
+				lastTm,
+				message.threadId));
+	}
+
+	for (unsigned int i = 0; i < m_loggers.size(); i++)
+	{
+		m_loggers[i]->endBatch();
+	}
+}
@@ -2,8 +2,12 @@
 #define LOG_MANAGER_IMPLEMENTATION_H
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Logger.h"
@@ -29,28 +33,136 @@ public:
 	Logger* getLogger(std::shared_ptr<Logger> logger);
 	Logger* getLoggerByType(const std::string& type);
 
+	// utf-8 messages are decoded by the writer in async mode. file and function are expected to be
+	// string literals like __FILE__ and __FUNCTION__, so they are not copied when queueing.
+	void logInfo(
+		const std::string& message,
+		const char* file,
+		const char* function,
+		const unsigned int line);
 	void logInfo(
 		const std::wstring& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
+		const unsigned int line);
+	void logWarning(
+		const std::string& message,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logWarning(
 		const std::wstring& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
+		const unsigned int line);
+	void logError(
+		const std::string& message,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 	void logError(
 		const std::wstring& message,
-		const std::string& file,
-		const std::string& function,
+		const char* file,
+		const char* function,
 		const unsigned int line);
 
+	// When enabled, messages are queued in a lock-free buffer of the logging thread and passed to
+	// the loggers in batches by a background thread, so logging threads never wait for file I/O.
+	// Errors are still passed to the loggers before logError returns, together with all messages
+	// queued before them, so the messages leading to a crash are not lost.
+	void setAsync(bool async);
+	bool isAsync() const;
+
+	// Blocks until all messages queued so far have been passed to the loggers.
+	void flush();
+
 private:
-	tm getTime();
+	enum LogType
+	{
+		LOG_TYPE_INFO,
+		LOG_TYPE_WARNING,
+		LOG_TYPE_ERROR
+	};
+
+	// only holds the arguments of a log call, the LogMessage is built by the writer
+	struct QueuedLogMessage
+	{
+		LogType type;
+		std::string message;	// only one of the messages is set
+		std::wstring wideMessage;
+		const char* file;
+		const char* function;
+		unsigned int line;
+		time_t time;
+		std::thread::id threadId;
+		size_t sequenceNumber;
+	};
+
+	// single producer (the logging thread) single consumer (the writer) ring buffer
+	class MessageBuffer
+	{
+	public:
+		MessageBuffer(size_t capacity);
+
+		bool push(QueuedLogMessage& message);
+		void popAll(std::vector<QueuedLogMessage>& messages);
+
+		size_t size() const;
+		size_t capacity() const;
+
+	private:
+		std::vector<QueuedLogMessage> m_slots;
+		std::atomic<size_t> m_head;
+		std::atomic<size_t> m_tail;
+	};
+
+	static tm getTime(time_t time);
+
+	void logMessage(
+		LogType type,
+		const std::string& message,
+		const char* file,
+		const char* function,
+		const unsigned int line);
+	void logMessage(
+		LogType type,
+		const std::wstring& message,
+		const char* file,
+		const char* function,
+		const unsigned int line);
+	// returns false if messages are not queued and have to be written right away
+	bool tryQueueMessage(
+		LogType type,
+		const std::string* message,
+		const std::wstring* wideMessage,
+		const char* file,
+		const char* function,
+		const unsigned int line);
+	// requires holding m_loggerMutex
+	void writeMessage(LogType type, const LogMessage& logEntry);
+	MessageBuffer* getThreadMessageBuffer();
+
+	void runWriter();
+	void writeQueuedMessages();
 
 	std::vector<std::shared_ptr<Logger>> m_loggers;
 
 	mutable std::mutex m_loggerMutex;
+
+	const size_t m_instanceId;
+	std::atomic<bool> m_async;
+	// threads that may still queue a message, disabling async mode waits for them to finish
+	std::atomic<size_t> m_queueingThreadCount;
+	std::atomic<size_t> m_nextSequenceNumber;
+
+	std::vector<std::shared_ptr<MessageBuffer>> m_messageBuffers;
+	std::mutex m_messageBuffersMutex;
+	std::mutex m_writeMutex;
+
+	std::thread m_writerThread;
+	bool m_stopWriter;
+	std::mutex m_writerMutex;
+	std::condition_variable m_writerCondition;
 };
 
 #endif	  // LOG_MANAGER_IMPLEMENTATION_H
@@ -45,3 +45,7 @@ void Logger::onError(const LogMessage& message)
 		logError(message);
 	}
 }
+
+void Logger::beginBatch() {}
+
+void Logger::endBatch() {}
@@ -31,6 +31,10 @@ public:
 	void onWarning(const LogMessage& message);
 	void onError(const LogMessage& message);
 
+	// called around a group of messages that are passed to the logger at once
+	virtual void beginBatch();
+	virtual void endBatch();
+
 private:
 	virtual void logInfo(const LogMessage& message) = 0;
 	virtual void logWarning(const LogMessage& message) = 0;
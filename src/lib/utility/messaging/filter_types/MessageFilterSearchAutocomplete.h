@@ -1,6 +1,8 @@
 #ifndef MESSAGE_FILTER_SEARCH_AUTOCOMPLETE_H
 #define MESSAGE_FILTER_SEARCH_AUTOCOMPLETE_H
 
+#include <memory>
+
 #include "MessageFilter.h"
 #include "MessageSearchAutocomplete.h"
 
@@ -8,24 +10,36 @@ class MessageFilterSearchAutocomplete: public MessageFilter
 {
 	void filter(MessageQueue::MessageBufferType* messageBuffer) override
 	{
-		if (messageBuffer->size() < 2)
+		if (messageBuffer->empty())
+		{
+			return;
+		}
+
+		std::shared_ptr<MessageBase> message = messageBuffer->front();
+		if (message->getType() != MessageSearchAutocomplete::getStaticType())
 		{
 			return;
 		}
 
-		MessageBase* message = messageBuffer->front().get();
-		if (message->getType() == MessageSearchAutocomplete::getStaticType())
+		for (auto it = messageBuffer->begin() + 1; it != messageBuffer->end(); it++)
 		{
-			for (auto it = messageBuffer->begin() + 1; it != messageBuffer->end(); it++)
+			if ((*it)->getType() == MessageSearchAutocomplete::getStaticType())
 			{
-				if ((*it)->getType() == MessageSearchAutocomplete::getStaticType())
-				{
-					messageBuffer->pop_front();
-					return;
-				}
+				messageBuffer->pop_front();
+				return;
 			}
 		}
+
+		// the message is sent next, which makes the last sent query stale if it is still handled
+		std::shared_ptr<MessageBase> lastMessage = m_lastMessage.lock();
+		if (lastMessage && lastMessage != message)
+		{
+			static_cast<MessageSearchAutocomplete*>(lastMessage.get())->cancel();
+		}
+		m_lastMessage = message;
 	}
+
+	std::weak_ptr<MessageBase> m_lastMessage;
 };
 
 #endif	  // MESSAGE_FILTER_SEARCH_AUTOCOMPLETE_H
@@ -1,6 +1,9 @@
 #ifndef MESSAGE_SEARCH_AUTOCOMPLETE_H
 #define MESSAGE_SEARCH_AUTOCOMPLETE_H
 
+#include <atomic>
+#include <memory>
+
 #include "Message.h"
 #include "Node.h"
 #include "NodeTypeSet.h"
@@ -10,7 +13,9 @@ class MessageSearchAutocomplete: public Message<MessageSearchAutocomplete>
 {
 public:
 	MessageSearchAutocomplete(const std::wstring& query, NodeTypeSet acceptedNodeTypes)
-		: query(query), acceptedNodeTypes(acceptedNodeTypes)
+		: query(query)
+		, acceptedNodeTypes(acceptedNodeTypes)
+		, m_cancelled(std::make_shared<std::atomic<bool>>(false))
 	{
 		setSchedulerId(TabId::currentTab());
 	}
@@ -35,8 +40,22 @@ public:
 		os << L"]";
 	}
 
+	// called once a newer query is sent, copies of the message share the flag
+	void cancel()
+	{
+		*m_cancelled = true;
+	}
+
+	bool isCancelled() const
+	{
+		return *m_cancelled;
+	}
+
 	const std::wstring query;
 	const NodeTypeSet acceptedNodeTypes;
+
+private:
+	std::shared_ptr<std::atomic<bool>> m_cancelled;
 };
 
 #endif	  // MESSAGE_SEARCH_AUTOCOMPLETE_H
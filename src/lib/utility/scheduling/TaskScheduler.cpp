@@ -5,6 +5,7 @@
 
 #include "ScopedFunctor.h"
 #include "logging.h"
+#include "tracing.h"
 
 TaskScheduler::TaskScheduler(Id schedulerId)
 	: m_schedulerId(schedulerId)
@@ -155,7 +156,10 @@ void TaskScheduler::processTasks()
 					}
 				}
 
-				state = runner->update(m_schedulerId);
+				{
+					TRACE("task update");
+					state = runner->update(m_schedulerId);
+				}
 				if (state != Task::STATE_RUNNING)
 				{
 					break;
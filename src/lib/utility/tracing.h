@@ -12,6 +12,7 @@
 
 #include "FilePath.h"
 #include "TimeStamp.h"
+#include "TraceRecorder.h"
 #include "types.h"
 #include "utilityString.h"
 
@@ -148,7 +149,12 @@ ScopedTrace<TracerType>::~ScopedTrace()
 
 
 #else
-#	define TRACE(__name__)
+// records to the TraceRecorder, which costs a single flag check while recording is disabled
+#	define TRACE(__name__)                                                                        \
+		static const size_t __trace_name_id__ = TraceRecorder::registerEventName(                  \
+			std::string(__name__), __FUNCTION__);                                                  \
+		ScopedTraceRecord __trace__(__trace_name_id__)
+
 #	define PRINT_TRACES()
 #endif
 
@@ -81,26 +81,8 @@ void CxxIndexerCommandProvider::addCommand(const std::shared_ptr<IndexerCommandC
 		}
 	}
 
-	{
-		const std::vector<std::wstring>& compilerFlags = command->getCompilerFlags();
-		representation->m_compilerFlagIds.reserve(compilerFlags.size());
-		for (const std::wstring& compilerFlag: compilerFlags)
-		{
-			std::unordered_map<std::wstring, Id>::const_iterator it = m_compilerFlagsToIds.find(
-				compilerFlag);
-			if (it != m_compilerFlagsToIds.end())
-			{
-				representation->m_compilerFlagIds.emplace_back(it->second);
-			}
-			else
-			{
-				const Id id = getId();
-				m_compilerFlagsToIds.emplace(compilerFlag, id);
-				m_idsToCompilerFlags.emplace(id, compilerFlag);
-				representation->m_compilerFlagIds.emplace_back(id);
-			}
-		}
-	}
+	representation->m_compilerFlagSetId = getCompilerFlagSetId(command->getSharedCompilerFlags());
+	representation->m_sourceFileArgument = command->getSourceFileArgument();
 
 	m_commands.emplace(command->getSourceFilePath(), representation);
 }
@@ -183,7 +165,7 @@ void CxxIndexerCommandProvider::logStats() const
 	LOG_INFO("\texclude filter count: " + std::to_string(m_idsToExcludeFilters.size()));
 	LOG_INFO("\tinclude filter count: " + std::to_string(m_idsToIncludeFilters.size()));
 	LOG_INFO("\tworking directory count: " + std::to_string(m_idsToWorkingDirectories.size()));
-	LOG_INFO("\tcompiler flag count: " + std::to_string(m_idsToCompilerFlags.size()));
+	LOG_INFO("\tcompiler flag set count: " + std::to_string(m_idsToCompilerFlagSets.size()));
 }
 
 Id CxxIndexerCommandProvider::getId()
@@ -191,6 +173,34 @@ Id CxxIndexerCommandProvider::getId()
 	return m_nextId++;
 }
 
+Id CxxIndexerCommandProvider::getCompilerFlagSetId(
+	std::shared_ptr<const std::vector<std::wstring>> compilerFlags)
+{
+	{
+		std::map<const std::vector<std::wstring>*, Id>::const_iterator it =
+			m_storedCompilerFlagSetsToIds.find(compilerFlags.get());
+		if (it != m_storedCompilerFlagSetsToIds.end())
+		{
+			return it->second;
+		}
+	}
+
+	{
+		std::map<const std::vector<std::wstring>*, Id, CompilerFlagSetLess>::const_iterator it =
+			m_compilerFlagSetsToIds.find(compilerFlags.get());
+		if (it != m_compilerFlagSetsToIds.end())
+		{
+			return it->second;
+		}
+	}
+
+	const Id id = getId();
+	m_idsToCompilerFlagSets.emplace(id, compilerFlags);
+	m_storedCompilerFlagSetsToIds.emplace(compilerFlags.get(), id);
+	m_compilerFlagSetsToIds.emplace(compilerFlags.get(), id);
+	return id;
+}
+
 std::shared_ptr<IndexerCommandCxx> CxxIndexerCommandProvider::represetationToCommand(
 	const FilePath& sourceFilePath, std::shared_ptr<CommandRepresentation> representation)
 {
@@ -214,12 +224,12 @@ std::shared_ptr<IndexerCommandCxx> CxxIndexerCommandProvider::represetationToCom
 
 	FilePath workingDirectory = m_idsToWorkingDirectories[representation->m_workingDirectoryId];
 
-	std::vector<std::wstring> compilerFlags;
-	for (const Id id: representation->m_compilerFlagIds)
-	{
-		compilerFlags.push_back(m_idsToCompilerFlags[id]);
-	}
-
 	return std::make_shared<IndexerCommandCxx>(
-		sourceFilePath, indexedPaths, excludeFilters, includeFilters, workingDirectory, compilerFlags);
+		sourceFilePath,
+		indexedPaths,
+		excludeFilters,
+		includeFilters,
+		workingDirectory,
+		m_idsToCompilerFlagSets[representation->m_compilerFlagSetId],
+		representation->m_sourceFileArgument);
 }
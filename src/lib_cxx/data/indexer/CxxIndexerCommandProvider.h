@@ -4,7 +4,7 @@
 #include <map>
 #include <set>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "IndexerCommandProvider.h"
 #include "types.h"
@@ -31,10 +31,21 @@ private:
 		std::set<Id> m_excludeFilterIds;
 		std::set<Id> m_includeFilterIds;
 		Id m_workingDirectoryId;
-		std::vector<Id> m_compilerFlagIds;
+		Id m_compilerFlagSetId;
+		std::wstring m_sourceFileArgument;
+	};
+
+	struct CompilerFlagSetLess
+	{
+		bool operator()(
+			const std::vector<std::wstring>* a, const std::vector<std::wstring>* b) const
+		{
+			return *a < *b;
+		}
 	};
 
 	Id getId();
+	Id getCompilerFlagSetId(std::shared_ptr<const std::vector<std::wstring>> compilerFlags);
 	std::shared_ptr<IndexerCommandCxx> represetationToCommand(
 		const FilePath& sourceFilePath, std::shared_ptr<CommandRepresentation> representation);
 
@@ -50,8 +61,12 @@ private:
 	std::map<std::wstring, Id> m_includeFiltersToIds;
 	std::map<Id, FilePath> m_idsToWorkingDirectories;
 	std::map<FilePath, Id> m_workingDirectoriesToIds;
-	std::map<Id, std::wstring> m_idsToCompilerFlags;
-	std::unordered_map<std::wstring, Id> m_compilerFlagsToIds;
+
+	// each distinct set of compiler flags is stored once and shared by all commands using it,
+	// flags that are already shared are found by address without comparing them
+	std::map<Id, std::shared_ptr<const std::vector<std::wstring>>> m_idsToCompilerFlagSets;
+	std::map<const std::vector<std::wstring>*, Id> m_storedCompilerFlagSetsToIds;
+	std::map<const std::vector<std::wstring>*, Id, CompilerFlagSetLess> m_compilerFlagSetsToIds;
 };
 
 #endif	  // CXX_INDEXER_COMMAND_PROVIDER_H
@@ -110,6 +110,9 @@ IndexerCommandType IndexerCommandCxx::getStaticIndexerCommandType()
 {
 	return INDEXER_COMMAND_CXX;
 }
+
+const wchar_t* IndexerCommandCxx::s_sourceFileArgumentPlaceholder = L"%{SOURCE_FILE_ARGUMENT}";
+
 IndexerCommandCxx::IndexerCommandCxx(
 	const FilePath& sourceFilePath,
 	const std::set<FilePath>& indexedPaths,
@@ -117,12 +120,32 @@ IndexerCommandCxx::IndexerCommandCxx(
 	const std::set<FilePathFilter>& includeFilters,
 	const FilePath& workingDirectory,
 	const std::vector<std::wstring>& compilerFlags)
+	: IndexerCommandCxx(
+		  sourceFilePath,
+		  indexedPaths,
+		  excludeFilters,
+		  includeFilters,
+		  workingDirectory,
+		  std::make_shared<const std::vector<std::wstring>>(compilerFlags),
+		  L"")
+{
+}
+
+IndexerCommandCxx::IndexerCommandCxx(
+	const FilePath& sourceFilePath,
+	const std::set<FilePath>& indexedPaths,
+	const std::set<FilePathFilter>& excludeFilters,
+	const std::set<FilePathFilter>& includeFilters,
+	const FilePath& workingDirectory,
+	std::shared_ptr<const std::vector<std::wstring>> compilerFlags,
+	const std::wstring& sourceFileArgument)
 	: IndexerCommand(sourceFilePath)
 	, m_indexedPaths(indexedPaths)
 	, m_excludeFilters(excludeFilters)
 	, m_includeFilters(includeFilters)
 	, m_workingDirectory(workingDirectory)
 	, m_compilerFlags(compilerFlags)
+	, m_sourceFileArgument(sourceFileArgument)
 {
 }
 
@@ -150,10 +173,9 @@ size_t IndexerCommandCxx::getByteSize(size_t stringSize) const
 		size += stringSize + utility::encodeToUtf8(filter.wstr()).size();
 	}
 
-	for (const std::wstring& flag: m_compilerFlags)
-	{
-		size += stringSize + flag.size();
-	}
+	// the compiler flags are not counted, they are shared between the commands of a target and
+	// passed to the indexers once per distinct flag set
+	size += m_sourceFileArgument.size();
 
 	return size;
 }
@@ -173,11 +195,32 @@ const std::set<FilePathFilter>& IndexerCommandCxx::getIncludeFilters() const
 	return m_includeFilters;
 }
 
-const std::vector<std::wstring>& IndexerCommandCxx::getCompilerFlags() const
+std::vector<std::wstring> IndexerCommandCxx::getCompilerFlags() const
+{
+	std::vector<std::wstring> compilerFlags = *m_compilerFlags;
+	if (!m_sourceFileArgument.empty())
+	{
+		for (std::wstring& compilerFlag: compilerFlags)
+		{
+			if (compilerFlag == s_sourceFileArgumentPlaceholder)
+			{
+				compilerFlag = m_sourceFileArgument;
+			}
+		}
+	}
+	return compilerFlags;
+}
+
+std::shared_ptr<const std::vector<std::wstring>> IndexerCommandCxx::getSharedCompilerFlags() const
 {
 	return m_compilerFlags;
 }
 
+const std::wstring& IndexerCommandCxx::getSourceFileArgument() const
+{
+	return m_sourceFileArgument;
+}
+
 const FilePath& IndexerCommandCxx::getWorkingDirectory() const
 {
 	return m_workingDirectory;
@@ -216,7 +259,7 @@ QJsonObject IndexerCommandCxx::doSerialize() const
 	}
 	{
 		QJsonArray compilerFlagsArray;
-		for (const std::wstring& compilerFlag: m_compilerFlags)
+		for (const std::wstring& compilerFlag: getCompilerFlags())
 		{
 			compilerFlagsArray.append(QString::fromStdWString(compilerFlag));
 		}
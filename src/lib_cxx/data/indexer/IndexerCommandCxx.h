@@ -1,6 +1,7 @@
 #ifndef INDEXER_COMMAND_CXX_H
 #define INDEXER_COMMAND_CXX_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,9 @@ public:
 
 	static IndexerCommandType getStaticIndexerCommandType();
 
+	// stands in for the source file argument in compiler flags that are shared between commands
+	static const wchar_t* s_sourceFileArgumentPlaceholder;
+
 	IndexerCommandCxx(
 		const FilePath& sourceFilePath,
 		const std::set<FilePath>& indexedPaths,
@@ -38,13 +42,26 @@ public:
 		const FilePath& workingDirectory,
 		const std::vector<std::wstring>& compilerFlags);
 
+	// the compiler flags may be shared with other commands, the source file argument replaces the
+	// placeholder in them
+	IndexerCommandCxx(
+		const FilePath& sourceFilePath,
+		const std::set<FilePath>& indexedPaths,
+		const std::set<FilePathFilter>& excludeFilters,
+		const std::set<FilePathFilter>& includeFilters,
+		const FilePath& workingDirectory,
+		std::shared_ptr<const std::vector<std::wstring>> compilerFlags,
+		const std::wstring& sourceFileArgument);
+
 	IndexerCommandType getIndexerCommandType() const override;
 	size_t getByteSize(size_t stringSize) const override;
 
 	const std::set<FilePath>& getIndexedPaths() const;
 	const std::set<FilePathFilter>& getExcludeFilters() const;
 	const std::set<FilePathFilter>& getIncludeFilters() const;
-	const std::vector<std::wstring>& getCompilerFlags() const;
+	std::vector<std::wstring> getCompilerFlags() const;
+	std::shared_ptr<const std::vector<std::wstring>> getSharedCompilerFlags() const;
+	const std::wstring& getSourceFileArgument() const;
 	const FilePath& getWorkingDirectory() const;
 
 protected:
@@ -55,7 +72,8 @@ private:
 	std::set<FilePathFilter> m_excludeFilters;
 	std::set<FilePathFilter> m_includeFilters;
 	FilePath m_workingDirectory;
-	std::vector<std::wstring> m_compilerFlags;
+	std::shared_ptr<const std::vector<std::wstring>> m_compilerFlags;
+	std::wstring m_sourceFileArgument;
 };
 
 #endif	  // INDEXER_COMMAND_CXXL_H
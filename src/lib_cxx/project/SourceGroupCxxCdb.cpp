@@ -6,6 +6,7 @@
 #include "Application.h"
 #include "ApplicationSettings.h"
 #include "ClangInvocationInfo.h"
+#include "CompilationDatabaseEntries.h"
 #include "CxxCompilationDatabaseSingle.h"
 #include "CxxIndexerCommandProvider.h"
 #include "IndexerCommandCxx.h"
@@ -108,39 +109,32 @@ std::shared_ptr<IndexerCommandProvider> SourceGroupCxxCdb::getIndexerCommandProv
 		m_settings->getExcludeFiltersExpandedAndAbsolute());
 	const std::set<FilePath>& sourceFilePaths = getAllSourceFilePaths(cdb);
 
-	for (const clang::tooling::CompileCommand& command: cdb->getAllCompileCommands())
-	{
-		FilePath sourcePath = FilePath(utility::decodeFromUtf8(command.Filename)).makeCanonical();
-		if (!sourcePath.isAbsolute())
-		{
-			sourcePath = FilePath(utility::decodeFromUtf8(command.Directory + '/' + command.Filename))
-							 .makeCanonical();
-			if (!sourcePath.isAbsolute())
-			{
-				sourcePath = cdbPath.getParentDirectory().getConcatenated(sourcePath).makeCanonical();
-			}
-		}
-
-		if (info.filesToIndex.find(sourcePath) != info.filesToIndex.end() &&
-			sourceFilePaths.find(sourcePath) != sourceFilePaths.end())
-		{
-			std::vector<std::wstring> cdbFlags = utility::convert<std::string, std::wstring>(
-				command.CommandLine, [](const std::string& s) { return utility::decodeFromUtf8(s); });
-
+	const utility::CompilationDatabaseEntries entries(
+		cdb, cdbPath, [&includePchFlags, &compilerFlags](std::vector<std::wstring>& cdbFlags) {
+			const size_t cdbFlagCount = cdbFlags.size();
 			utility::removeIncludePchFlag(cdbFlags);
 
-			if (command.CommandLine.size() != cdbFlags.size())
+			if (cdbFlagCount != cdbFlags.size())
 			{
 				utility::append(cdbFlags, includePchFlags);
 			}
 
+			utility::append(cdbFlags, compilerFlags);
+		});
+
+	for (const utility::CompilationDatabaseEntries::Entry& entry: entries.getEntries())
+	{
+		if (info.filesToIndex.find(entry.sourceFilePath) != info.filesToIndex.end() &&
+			sourceFilePaths.find(entry.sourceFilePath) != sourceFilePaths.end())
+		{
 			provider->addCommand(std::make_shared<IndexerCommandCxx>(
-				sourcePath,
-				utility::concat(indexedHeaderPaths, {sourcePath}),
+				entry.sourceFilePath,
+				utility::concat(indexedHeaderPaths, {entry.sourceFilePath}),
 				excludeFilters,
 				std::set<FilePathFilter>(),
-				FilePath(utility::decodeFromUtf8(command.Directory)),
-				utility::concat(cdbFlags, compilerFlags)));
+				entry.workingDirectory,
+				entry.compilerFlags,
+				entry.sourceFileArgument));
 		}
 	}
 
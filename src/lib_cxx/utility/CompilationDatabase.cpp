@@ -5,6 +5,7 @@
 #include <clang/Tooling/CompilationDatabase.h>
 #include <clang/Tooling/JSONCompilationDatabase.h>
 
+#include "CompilationDatabaseEntries.h"
 #include "FilePath.h"
 #include "logging.h"
 #include "utility.h"
@@ -54,7 +55,11 @@ void utility::CompilationDatabase::init()
 		return;
 	}
 
-	std::vector<clang::tooling::CompileCommand> commands = cdb->getAllCompileCommands();
+	const CompilationDatabaseEntries entries(cdb, m_filePath);
+
+	// commands of the same target share their flag set, so each one only needs to be scanned once
+	std::set<std::pair<std::wstring, const std::vector<std::wstring>*>> scannedCommands;
+
 	std::set<FilePath> frameworkHeaders;
 	std::set<FilePath> systemHeaders;
 	std::set<FilePath> headers;
@@ -64,16 +69,22 @@ void utility::CompilationDatabase::init()
 		const std::wstring systemIncludeFlag = L"-isystem";
 		const std::wstring quoteFlag = L"-iquote";
 		const std::wstring includeFlag = L"-I";
-		for (clang::tooling::CompileCommand& command: commands)
+		for (const CompilationDatabaseEntries::Entry& entry: entries.getEntries())
 		{
-			const std::wstring commandDirectory = utility::decodeFromUtf8(command.Directory);
-			for (size_t i = 0; i < command.CommandLine.size(); i++)
+			const std::wstring commandDirectory = entry.workingDirectory.wstr();
+			const std::vector<std::wstring>& commandLine = *entry.compilerFlags;
+			if (!scannedCommands.emplace(commandDirectory, &commandLine).second)
+			{
+				continue;
+			}
+
+			for (size_t i = 0; i < commandLine.size(); i++)
 			{
-				std::wstring argument = utility::decodeFromUtf8(command.CommandLine[i]);
-				if (i + 1 < command.CommandLine.size() &&
-					!utility::isPrefix<std::string>("-", command.CommandLine[i + 1]))
+				std::wstring argument = commandLine[i];
+				if (i + 1 < commandLine.size() &&
+					!utility::isPrefix<std::wstring>(L"-", commandLine[i + 1]))
 				{
-					argument += utility::decodeFromUtf8(command.CommandLine[++i]);
+					argument += commandLine[++i];
 				}
 
 				if (utility::isPrefix(frameworkIncludeFlag, argument))
@@ -0,0 +1,168 @@
+#include "CompilationDatabaseEntries.h"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
+#include <clang/Tooling/JSONCompilationDatabase.h>
+
+#include "IndexerCommandCxx.h"
+#include "TimeStamp.h"
+#include "logging.h"
+#include "utilityApp.h"
+#include "utilityString.h"
+
+namespace
+{
+struct NormalizedCommand
+{
+	utility::CompilationDatabaseEntries::Entry entry;
+	std::vector<std::wstring> compilerFlags;
+	std::wstring compilerFlagsKey;
+};
+
+// these flags are followed by a file that is only written when building, not when indexing
+bool isOutputFlag(const std::string& argument)
+{
+	return argument == "-o" || argument == "-MF" || argument == "-MT" || argument == "-MQ";
+}
+
+void normalizeCommand(
+	const clang::tooling::CompileCommand& command,
+	const FilePath& cdbDirectory,
+	const utility::CompilationDatabaseEntries::CompilerFlagsTransform& transform,
+	NormalizedCommand& normalizedCommand)
+{
+	FilePath sourcePath = FilePath(utility::decodeFromUtf8(command.Filename)).makeCanonical();
+	if (!sourcePath.isAbsolute())
+	{
+		sourcePath = FilePath(utility::decodeFromUtf8(command.Directory + '/' + command.Filename))
+						 .makeCanonical();
+		if (!sourcePath.isAbsolute())
+		{
+			sourcePath = cdbDirectory.getConcatenated(sourcePath).makeCanonical();
+		}
+	}
+
+	normalizedCommand.entry.sourceFilePath = sourcePath;
+	normalizedCommand.entry.workingDirectory = FilePath(utility::decodeFromUtf8(command.Directory));
+
+	std::vector<std::wstring>& compilerFlags = normalizedCommand.compilerFlags;
+	compilerFlags.reserve(command.CommandLine.size());
+	for (size_t i = 0; i < command.CommandLine.size(); i++)
+	{
+		const std::string& argument = command.CommandLine[i];
+		if (isOutputFlag(argument))
+		{
+			i++;
+		}
+		else if (argument == command.Filename)
+		{
+			compilerFlags.push_back(IndexerCommandCxx::s_sourceFileArgumentPlaceholder);
+			normalizedCommand.entry.sourceFileArgument = utility::decodeFromUtf8(argument);
+		}
+		else
+		{
+			compilerFlags.push_back(utility::decodeFromUtf8(argument));
+		}
+	}
+
+	if (transform)
+	{
+		transform(compilerFlags);
+	}
+
+	for (const std::wstring& compilerFlag: compilerFlags)
+	{
+		normalizedCommand.compilerFlagsKey += compilerFlag;
+		normalizedCommand.compilerFlagsKey.push_back(L'\0');
+	}
+}
+}	 // namespace
+
+const size_t utility::CompilationDatabaseEntries::s_chunkSize = 4096;
+
+utility::CompilationDatabaseEntries::CompilationDatabaseEntries(
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb,
+	const FilePath& cdbPath,
+	CompilerFlagsTransform transform)
+	: m_compilerFlagSetCount(0)
+{
+	if (!cdb)
+	{
+		return;
+	}
+
+	const TimeStamp start = TimeStamp::now();
+	const FilePath cdbDirectory = cdbPath.getParentDirectory();
+	const size_t threadCount = static_cast<size_t>(std::max(utility::getIdealThreadCount(), 1));
+
+	std::unordered_map<std::wstring, std::shared_ptr<const std::vector<std::wstring>>>
+		compilerFlagSets;
+
+	const std::vector<std::string> files = cdb->getAllFiles();
+	for (size_t chunkStart = 0; chunkStart < files.size(); chunkStart += s_chunkSize)
+	{
+		std::vector<clang::tooling::CompileCommand> commands;
+		for (size_t i = chunkStart; i < std::min(chunkStart + s_chunkSize, files.size()); i++)
+		{
+			for (clang::tooling::CompileCommand& command: cdb->getCompileCommands(files[i]))
+			{
+				commands.push_back(std::move(command));
+			}
+		}
+
+		std::vector<NormalizedCommand> normalizedCommands(commands.size());
+		{
+			const size_t chunkThreadCount = std::min(threadCount, commands.size());
+			std::vector<std::thread> threads;
+			for (size_t t = 0; t < chunkThreadCount; t++)
+			{
+				threads.emplace_back([&, t]() {
+					for (size_t i = t; i < commands.size(); i += chunkThreadCount)
+					{
+						normalizeCommand(
+							commands[i], cdbDirectory, transform, normalizedCommands[i]);
+					}
+				});
+			}
+			for (std::thread& thread: threads)
+			{
+				thread.join();
+			}
+		}
+
+		m_entries.reserve(m_entries.size() + normalizedCommands.size());
+		for (NormalizedCommand& normalizedCommand: normalizedCommands)
+		{
+			std::shared_ptr<const std::vector<std::wstring>>& compilerFlags =
+				compilerFlagSets[normalizedCommand.compilerFlagsKey];
+			if (!compilerFlags)
+			{
+				compilerFlags = std::make_shared<const std::vector<std::wstring>>(
+					std::move(normalizedCommand.compilerFlags));
+			}
+
+			normalizedCommand.entry.compilerFlags = compilerFlags;
+			m_entries.push_back(std::move(normalizedCommand.entry));
+		}
+	}
+
+	m_compilerFlagSetCount = compilerFlagSets.size();
+
+	LOG_INFO(
+		"Loaded " + std::to_string(m_entries.size()) + " compile commands with " +
+		std::to_string(m_compilerFlagSetCount) + " distinct command lines in " +
+		std::to_string(TimeStamp::durationSeconds(start)) + " seconds");
+}
+
+const std::vector<utility::CompilationDatabaseEntries::Entry>& utility::CompilationDatabaseEntries::
+	getEntries() const
+{
+	return m_entries;
+}
+
+size_t utility::CompilationDatabaseEntries::getCompilerFlagSetCount() const
+{
+	return m_compilerFlagSetCount;
+}
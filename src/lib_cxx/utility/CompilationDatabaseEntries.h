@@ -0,0 +1,56 @@
+#ifndef UTILITY_COMPILATION_DATABASE_ENTRIES_H
+#define UTILITY_COMPILATION_DATABASE_ENTRIES_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FilePath.h"
+
+namespace clang
+{
+namespace tooling
+{
+class JSONCompilationDatabase;
+}
+}	 // namespace clang
+
+namespace utility
+{
+// Normalized compile commands of a JSON compilation database. Clang expands the commands in chunks,
+// so only a part of them is held twice in memory, and each chunk is normalized on all cores.
+// Arguments that differ between files of the same target are taken out of the command line: the
+// source file is replaced by IndexerCommandCxx::s_sourceFileArgumentPlaceholder and output files
+// are dropped. Identical command lines then share a single flag set.
+class CompilationDatabaseEntries
+{
+public:
+	struct Entry
+	{
+		FilePath sourceFilePath;	// absolute and canonical
+		FilePath workingDirectory;
+		std::shared_ptr<const std::vector<std::wstring>> compilerFlags;
+		std::wstring sourceFileArgument;
+	};
+
+	// applied to each command line on the worker threads, before the command lines are compared
+	typedef std::function<void(std::vector<std::wstring>&)> CompilerFlagsTransform;
+
+	CompilationDatabaseEntries(
+		std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb,
+		const FilePath& cdbPath,
+		CompilerFlagsTransform transform = CompilerFlagsTransform());
+
+	const std::vector<Entry>& getEntries() const;
+	size_t getCompilerFlagSetCount() const;
+
+private:
+	static const size_t s_chunkSize;
+
+	std::vector<Entry> m_entries;
+	size_t m_compilerFlagSetCount;
+};
+}	 // namespace utility
+
+#endif	  // UTILITY_COMPILATION_DATABASE_ENTRIES_H
@@ -236,6 +236,18 @@ void QtDialogView::updateIndexingDialog(
 	});
 }
 
+void QtDialogView::updateIndexingMemoryUsage(
+	size_t usedByteSize, size_t budgetByteSize, bool throttled)
+{
+	m_onQtThread([=]() {
+		if (QtIndexingProgressDialog* window = dynamic_cast<QtIndexingProgressDialog*>(
+				m_windowStack.getTopWindow()))
+		{
+			window->updateMemoryUsage(usedByteSize, budgetByteSize, throttled);
+		}
+	});
+}
+
 void QtDialogView::updateCustomIndexingDialog(
 	size_t startedFileCount,
 	size_t finishedFileCount,
@@ -50,6 +50,8 @@ public:
 		size_t finishedFileCount,
 		size_t totalFileCount,
 		const std::vector<FilePath>& sourcePaths) override;
+	void updateIndexingMemoryUsage(
+		size_t usedByteSize, size_t budgetByteSize, bool throttled) override;
 	void updateCustomIndexingDialog(
 		size_t startedFileCount,
 		size_t finishedFileCount,
@@ -6,7 +6,10 @@
 #include "MessageIndexingInterrupted.h"
 
 QtIndexingProgressDialog::QtIndexingProgressDialog(bool hideable, QWidget* parent)
-	: QtProgressBarDialog(0.38f, true, parent), m_filePathLabel(nullptr), m_errorWidget(nullptr)
+	: QtProgressBarDialog(0.38f, true, parent)
+	, m_filePathLabel(nullptr)
+	, m_memoryLabel(nullptr)
+	, m_errorWidget(nullptr)
 {
 	setSizeGripStyle(false);
 
@@ -17,6 +20,12 @@ QtIndexingProgressDialog::QtIndexingProgressDialog(bool hideable, QWidget* paren
 	m_filePathLabel->setAlignment(Qt::AlignRight);
 	m_layout->addWidget(m_filePathLabel);
 
+	m_memoryLabel = new QLabel();
+	m_memoryLabel->setObjectName(QStringLiteral("filePath"));
+	m_memoryLabel->setAlignment(Qt::AlignRight);
+	m_memoryLabel->hide();
+	m_layout->addWidget(m_memoryLabel);
+
 	m_layout->addSpacing(12);
 	m_errorWidget = QtIndexingDialog::createErrorWidget(m_layout);
 
@@ -94,6 +103,24 @@ void QtIndexingProgressDialog::updateErrorCount(size_t errorCount, size_t fatalC
 	}
 }
 
+void QtIndexingProgressDialog::updateMemoryUsage(
+	size_t usedByteSize, size_t budgetByteSize, bool throttled)
+{
+	if (m_memoryLabel && budgetByteSize)
+	{
+		const size_t megabyte = 1048576;
+		QString str = "Queued data: " + QString::number(usedByteSize / megabyte) + "/" +
+			QString::number(budgetByteSize / megabyte) + " MB";
+		if (throttled)
+		{
+			str += QLatin1String(" (throttled)");
+		}
+
+		m_memoryLabel->setText(str);
+		m_memoryLabel->show();
+	}
+}
+
 void QtIndexingProgressDialog::onHidePressed()
 {
 	emit visibleChanged(false);
@@ -15,6 +15,7 @@ public:
 
 	void updateIndexingProgress(size_t fileCount, size_t totalFileCount, const FilePath& sourcePath);
 	void updateErrorCount(size_t errorCount, size_t fatalCount);
+	void updateMemoryUsage(size_t usedByteSize, size_t budgetByteSize, bool throttled);
 
 protected:
 	void closeEvent(QCloseEvent* event) override;
@@ -25,6 +26,7 @@ private:
 	void onStopPressed();
 
 	QLabel* m_filePathLabel;
+	QLabel* m_memoryLabel;
 	QWidget* m_errorWidget;
 	QString m_sourcePath;
 };
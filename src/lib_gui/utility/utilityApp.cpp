@@ -9,6 +9,15 @@
 #include <QThread>
 #include <qprocessordetection.h>
 
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <unistd.h>
+#endif
+
 #include "AppPath.h"
 #include "ApplicationSettings.h"
 #include "UserPaths.h"
@@ -276,6 +285,27 @@ int utility::getIdealThreadCount()
 	return std::max(1, threadCount);
 }
 
+size_t utility::getPhysicalMemorySize()
+{
+#ifdef _WIN32
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if (GlobalMemoryStatusEx(&status))
+	{
+		return static_cast<size_t>(status.ullTotalPhys);
+	}
+	return 0;
+#else
+	const long pageCount = sysconf(_SC_PHYS_PAGES);
+	const long pageSize = sysconf(_SC_PAGE_SIZE);
+	if (pageCount <= 0 || pageSize <= 0)
+	{
+		return 0;
+	}
+	return static_cast<size_t>(pageCount) * static_cast<size_t>(pageSize);
+#endif
+}
+
 OsType utility::getOsType()
 {
 	if (QSysInfo::windowsVersion() != QSysInfo::WV_None)
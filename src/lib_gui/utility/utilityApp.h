@@ -26,6 +26,9 @@ int executeProcessAndGetExitCode(
 void killRunningProcesses();
 int getIdealThreadCount();
 
+// returns 0 if the size of the physical memory is unknown
+size_t getPhysicalMemorySize();
+
 OsType getOsType();
 std::string getOsTypeString();
 ApplicationArchitectureType getApplicationArchitectureType();
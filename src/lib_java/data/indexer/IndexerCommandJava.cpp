@@ -50,6 +50,25 @@ std::vector<FilePath> IndexerCommandJava::getClassPath() const
 	return m_classPath;
 }
 
+bool IndexerCommandJava::sharesEnvironmentWith(const IndexerCommandJava& other) const
+{
+	if (m_languageStandard != other.m_languageStandard ||
+		m_classPath.size() != other.m_classPath.size())
+	{
+		return false;
+	}
+
+	// comparing the strings is enough and avoids hitting the file system for each entry
+	for (size_t i = 0; i < m_classPath.size(); i++)
+	{
+		if (m_classPath[i].wstr() != other.m_classPath[i].wstr())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 QJsonObject IndexerCommandJava::doSerialize() const
 {
 	QJsonObject jsonObject = IndexerCommand::doSerialize();
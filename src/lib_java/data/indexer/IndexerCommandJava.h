@@ -26,6 +26,9 @@ public:
 	void setClassPath(std::vector<FilePath> classPath);
 	std::vector<FilePath> getClassPath() const;
 
+	// commands with the same language standard and classpath can be parsed in one batch
+	bool sharesEnvironmentWith(const IndexerCommandJava& other) const;
+
 protected:
 	QJsonObject doSerialize() const override;
 
@@ -1,12 +1,75 @@
 #include "IndexerJava.h"
 
+#include <algorithm>
+
+#include "ApplicationSettings.h"
 #include "JavaParser.h"
 
+IndexerJava::IndexerJava()
+	: m_batchSize(static_cast<size_t>(
+		  std::max(ApplicationSettings::getInstance()->getJavaIndexerBatchSize(), 1)))
+{
+}
+
 IndexerJava::~IndexerJava()
 {
 	JavaParser::clearCaches();
 }
 
+size_t IndexerJava::getBatchSize(IndexerCommandType type) const
+{
+	return type == getSupportedIndexerCommandType() ? m_batchSize : 1;
+}
+
+void IndexerJava::indexBatch(
+	const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+	CommandStartedCallback onStarted,
+	CommandFinishedCallback onFinished)
+{
+	size_t i = 0;
+	while (i < indexerCommands.size())
+	{
+		std::vector<std::shared_ptr<IndexerCommandJava>> batch;
+		if (std::shared_ptr<IndexerCommandJava> first =
+				std::dynamic_pointer_cast<IndexerCommandJava>(indexerCommands[i]))
+		{
+			batch.push_back(first);
+			while (i + batch.size() < indexerCommands.size())
+			{
+				std::shared_ptr<IndexerCommandJava> next =
+					std::dynamic_pointer_cast<IndexerCommandJava>(indexerCommands[i + batch.size()]);
+				if (!next || !first->sharesEnvironmentWith(*next))
+				{
+					break;
+				}
+				batch.push_back(next);
+			}
+		}
+
+		if (batch.size() < 2)
+		{
+			IndexerBase::indexBatch({indexerCommands[i]}, onStarted, onFinished);
+			i++;
+			continue;
+		}
+		i += batch.size();
+
+		std::shared_ptr<IntermediateStorage> storage;
+		JavaParser(nullptr, getIndexerStateInfo())
+			.buildIndex(
+				batch,
+				[&](std::shared_ptr<IndexerCommandJava> indexerCommand) {
+					onStarted(indexerCommand);
+					storage = std::make_shared<IntermediateStorage>();
+					return std::make_shared<ParserClientImpl>(storage.get());
+				},
+				[&](std::shared_ptr<IndexerCommandJava> indexerCommand) {
+					onFinished(indexerCommand, finishStorage(storage));
+					storage.reset();
+				});
+	}
+}
+
 void IndexerJava::doIndex(
 	std::shared_ptr<IndexerCommandJava> indexerCommand,
 	std::shared_ptr<ParserClientImpl> parserClient,
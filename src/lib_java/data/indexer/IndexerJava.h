@@ -9,13 +9,24 @@ struct IndexerStateInfo;
 class IndexerJava: public Indexer<IndexerCommandJava>
 {
 public:
+	IndexerJava();
 	virtual ~IndexerJava();
 
+	size_t getBatchSize(IndexerCommandType type) const override;
+
+	// commands that share their environment are parsed together, the others one by one
+	void indexBatch(
+		const std::vector<std::shared_ptr<IndexerCommand>>& indexerCommands,
+		CommandStartedCallback onStarted,
+		CommandFinishedCallback onFinished) override;
+
 private:
 	void doIndex(
 		std::shared_ptr<IndexerCommandJava> indexerCommand,
 		std::shared_ptr<ParserClientImpl> parserClient,
 		std::shared_ptr<IndexerStateInfo> m_indexerStateInfo) override;
+
+	const size_t m_batchSize;
 };
 
 #endif	  // INDEXER_JAVA_H
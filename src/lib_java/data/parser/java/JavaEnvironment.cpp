@@ -73,6 +73,31 @@ bool JavaEnvironment::callStaticVoidMethod(
 	return false;
 }
 
+bool JavaEnvironment::callStaticVoidMethod(
+	std::string className,
+	std::string methodName,
+	int arg1,
+	const std::string& arg2,
+	const std::string& arg3,
+	const std::string& arg4,
+	int arg5)
+{
+	jclass javaClass = getJavaClass(className);
+	jmethodID javaMethodId = getJavaStaticMethod(
+		javaClass, methodName, "(ILjava/lang/String;Ljava/lang/String;Ljava/lang/String;I)V");
+	if (javaMethodId != nullptr)
+	{
+		jint jarg1 = arg1;
+		jstring jarg2 = m_env->NewStringUTF(arg2.c_str());
+		jstring jarg3 = m_env->NewStringUTF(arg3.c_str());
+		jstring jarg4 = m_env->NewStringUTF(arg4.c_str());
+		jint jarg5 = arg5;
+		m_env->CallStaticVoidMethod(javaClass, javaMethodId, jarg1, jarg2, jarg3, jarg4, jarg5);
+		return true;
+	}
+	return false;
+}
+
 bool JavaEnvironment::callStaticStringMethod(
 	std::string className, std::string methodName, std::string& ret, const std::string& arg1)
 {
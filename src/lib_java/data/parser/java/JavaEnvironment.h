@@ -48,6 +48,14 @@ public:
 		std::string arg4,
 		std::string arg5,
 		int arg6);
+	bool callStaticVoidMethod(
+		std::string className,
+		std::string methodName,
+		int arg1,
+		const std::string& arg2,
+		const std::string& arg3,
+		const std::string& arg4,
+		int arg5);
 	bool callStaticStringMethod(
 		std::string className, std::string methodName, std::string& ret, const std::string& arg1);
 	bool callStaticStringMethod(
@@ -1,5 +1,7 @@
 #include "JavaParser.h"
 
+#include <cstring>
+
 #include <jni.h>
 
 #include "ApplicationSettings.h"
@@ -14,6 +16,71 @@
 #include "utilityJava.h"
 #include "utilityString.h"
 
+namespace
+{
+// reads the values of a record batch, which are written in native byte order
+class RecordBatchReader
+{
+public:
+	RecordBatchReader(const char* data, size_t byteCount)
+		: m_data(data), m_byteCount(byteCount), m_position(0)
+	{
+	}
+
+	bool atEnd() const
+	{
+		return m_position >= m_byteCount;
+	}
+
+	bool readInt(int& value)
+	{
+		int32_t rawValue = 0;
+		if (m_byteCount - m_position < sizeof(rawValue))
+		{
+			return false;
+		}
+
+		std::memcpy(&rawValue, m_data + m_position, sizeof(rawValue));
+		m_position += sizeof(rawValue);
+		value = rawValue;
+		return true;
+	}
+
+	bool readString(std::string& str)
+	{
+		int length = 0;
+		if (!readInt(length) || length < 0 || m_byteCount - m_position < size_t(length))
+		{
+			return false;
+		}
+
+		str.assign(m_data + m_position, length);
+		m_position += length;
+		return true;
+	}
+
+	bool readLocation(Id fileId, ParseLocation& location)
+	{
+		int beginLine = 0;
+		int beginColumn = 0;
+		int endLine = 0;
+		int endColumn = 0;
+		if (!readInt(beginLine) || !readInt(beginColumn) || !readInt(endLine) || !readInt(endColumn))
+		{
+			return false;
+		}
+
+		location = ParseLocation(fileId, beginLine, beginColumn, endLine, endColumn);
+		return true;
+	}
+
+private:
+	const char* m_data;
+	const size_t m_byteCount;
+	size_t m_position;
+};
+}	 // namespace
+
 void JavaParser::clearCaches()
 {
 	std::shared_ptr<JavaEnvironmentFactory> factory = JavaEnvironmentFactory::getInstance();
@@ -49,32 +116,9 @@ JavaParser::JavaParser(
 		methods.push_back({"logWarning", "(ILjava/lang/String;)V", (void*)&JavaParser::LogWarning});
 		methods.push_back({"logError", "(ILjava/lang/String;)V", (void*)&JavaParser::LogError});
 		methods.push_back(
-			{"recordSymbol", "(ILjava/lang/String;III)V", (void*)&JavaParser::RecordSymbol});
-		methods.push_back(
-			{"recordSymbolWithLocation",
-			 "(ILjava/lang/String;IIIIIII)V",
-			 (void*)&JavaParser::RecordSymbolWithLocation});
-		methods.push_back(
-			{"recordSymbolWithLocationAndScope",
-			 "(ILjava/lang/String;IIIIIIIIIII)V",
-			 (void*)&JavaParser::RecordSymbolWithLocationAndScope});
-		methods.push_back(
-			{"recordSymbolWithLocationAndScopeAndSignature",
-			 "(ILjava/lang/String;IIIIIIIIIIIIIII)V",
-			 (void*)&JavaParser::RecordSymbolWithLocationAndScopeAndSignature});
-		methods.push_back(
-			{"recordReference",
-			 "(IILjava/lang/String;Ljava/lang/String;IIII)V",
-			 (void*)&JavaParser::RecordReference});
-		methods.push_back(
-			{"recordQualifierLocation",
-			 "(ILjava/lang/String;IIII)V",
-			 (void*)&JavaParser::RecordQualifierLocation});
-		methods.push_back(
-			{"recordLocalSymbol", "(ILjava/lang/String;IIII)V", (void*)&JavaParser::RecordLocalSymbol});
-		methods.push_back({"recordComment", "(IIIII)V", (void*)&JavaParser::RecordComment});
-		methods.push_back(
-			{"recordError", "(ILjava/lang/String;IIIIII)V", (void*)&JavaParser::RecordError});
+			{"recordBatch", "(ILjava/nio/ByteBuffer;I)V", (void*)&JavaParser::RecordBatch});
+		methods.push_back({"startFile", "(ILjava/lang/String;)Z", (void*)&JavaParser::StartFile});
+		methods.push_back({"finishFile", "(I)V", (void*)&JavaParser::FinishFile});
 
 		m_javaEnvironment->registerNativeMethods("com/sourcetrail/JavaIndexer", methods);
 	}
@@ -91,17 +135,10 @@ JavaParser::~JavaParser()
 
 void JavaParser::buildIndex(std::shared_ptr<IndexerCommandJava> indexerCommand)
 {
-	std::string classPath = "";
-	for (const FilePath& path: indexerCommand->getClassPath())
-	{
-		// the separator used here should be the same as the one used in JavaIndexer.java
-		classPath += path.str() + ";";
-	}
-
 	buildIndex(
 		indexerCommand->getSourceFilePath(),
 		indexerCommand->getLanguageStandard(),
-		classPath,
+		getClassPathString(indexerCommand),
 		TextAccess::createFromFile(indexerCommand->getSourceFilePath()));
 }
 
@@ -110,6 +147,88 @@ void JavaParser::buildIndex(const FilePath& filePath, std::shared_ptr<TextAccess
 	buildIndex(filePath, L"12", "", textAccess);
 }
 
+void JavaParser::buildIndex(
+	const std::vector<std::shared_ptr<IndexerCommandJava>>& indexerCommands,
+	FileStartedCallback onFileStarted,
+	FileFinishedCallback onFileFinished)
+{
+	if (indexerCommands.empty())
+	{
+		return;
+	}
+
+	m_onFileStarted = onFileStarted;
+	m_onFileFinished = onFileFinished;
+
+	std::string sourceFilePaths;
+	for (const std::shared_ptr<IndexerCommandJava>& indexerCommand: indexerCommands)
+	{
+		const std::string sourceFilePath = indexerCommand->getSourceFilePath().str();
+		m_pendingCommands[sourceFilePath] = indexerCommand;
+
+		// the separator used here should be the same as the one used in JavaIndexer.java
+		sourceFilePaths += sourceFilePath + ";";
+	}
+
+	if (m_javaEnvironment)
+	{
+		m_javaEnvironment->callStaticVoidMethod(
+			"com/sourcetrail/JavaIndexer",
+			"processFiles",
+			m_id,
+			sourceFilePaths,
+			utility::encodeToUtf8(indexerCommands.front()->getLanguageStandard()),
+			getClassPathString(indexerCommands.front()),
+			getVerbose());
+	}
+
+	// the java side did not finish the last file if it stopped with an exception
+	finishBatchedFile();
+
+	// files that were not delivered by the batch, e.g. after an exception, are indexed on their own
+	for (const std::shared_ptr<IndexerCommandJava>& indexerCommand: indexerCommands)
+	{
+		if (m_indexerStateInfo->indexingInterrupted)
+		{
+			break;
+		}
+
+		if (m_pendingCommands.erase(indexerCommand->getSourceFilePath().str()) > 0)
+		{
+			LOG_WARNING(
+				L"File was not indexed within its batch, indexing it on its own: " +
+				indexerCommand->getSourceFilePath().wstr());
+
+			startBatchedFile(indexerCommand);
+			buildIndex(indexerCommand);
+			finishBatchedFile();
+		}
+	}
+
+	m_pendingCommands.clear();
+	m_onFileStarted = nullptr;
+	m_onFileFinished = nullptr;
+}
+
+std::string JavaParser::getClassPathString(std::shared_ptr<IndexerCommandJava> indexerCommand)
+{
+	std::string classPath = "";
+	for (const FilePath& path: indexerCommand->getClassPath())
+	{
+		// the separator used here should be the same as the one used in JavaIndexer.java
+		classPath += path.str() + ";";
+	}
+	return classPath;
+}
+
+int JavaParser::getVerbose()
+{
+	return ApplicationSettings::getInstance()->getLoggingEnabled() &&
+			ApplicationSettings::getInstance()->getVerboseIndexerLoggingEnabled()
+		? 1
+		: 0;
+}
+
 void JavaParser::buildIndex(
 	const FilePath& sourceFilePath,
 	const std::wstring& languageStandard,
@@ -118,18 +237,11 @@ void JavaParser::buildIndex(
 {
 	if (m_javaEnvironment)
 	{
-		m_currentFilePath = sourceFilePath;
-		m_currentFileId = m_client->recordFile(sourceFilePath, true);
-		m_client->recordFileLanguage(m_currentFileId, L"java");
+		startFile(sourceFilePath);
 
 		// remove tabs because they screw with javaparser's location resolver
 		std::string fileContent = utility::replace(textAccess->getText(), "\t", " ");
 
-		int verbose = ApplicationSettings::getInstance()->getLoggingEnabled() &&
-				ApplicationSettings::getInstance()->getVerboseIndexerLoggingEnabled()
-			? 1
-			: 0;
-
 		m_javaEnvironment->callStaticVoidMethod(
 			"com/sourcetrail/JavaIndexer",
 			"processFile",
@@ -138,7 +250,36 @@ void JavaParser::buildIndex(
 			fileContent,
 			utility::encodeToUtf8(languageStandard),
 			classPath,
-			verbose);
+			getVerbose());
+	}
+}
+
+void JavaParser::startFile(const FilePath& sourceFilePath)
+{
+	m_currentFilePath = sourceFilePath;
+	m_currentFileId = m_client->recordFile(sourceFilePath, true);
+	m_symbolNameToIdMap.clear();
+	m_batchStrings.clear();
+	m_batchSymbolIds.clear();
+	m_client->recordFileLanguage(m_currentFileId, L"java");
+}
+
+void JavaParser::startBatchedFile(std::shared_ptr<IndexerCommandJava> indexerCommand)
+{
+	finishBatchedFile();
+
+	m_currentCommand = indexerCommand;
+	m_client = m_onFileStarted(indexerCommand);
+}
+
+void JavaParser::finishBatchedFile()
+{
+	if (m_currentCommand)
+	{
+		std::shared_ptr<IndexerCommandJava> indexerCommand = m_currentCommand;
+		m_currentCommand.reset();
+		m_client.reset();
+		m_onFileFinished(indexerCommand);
 	}
 }
 
@@ -171,173 +312,255 @@ void JavaParser::doLogError(jstring jError)
 	LOG_ERROR_STREAM_BARE(<< "Indexer - " << m_javaEnvironment->toStdString(jError));
 }
 
-void JavaParser::doRecordSymbol(jstring jSymbolName, jint jSymbolKind, jint jAccess, jint jDefinitionKind)
+bool JavaParser::doStartFile(jstring jFilePath)
 {
-	Id symbolId = getOrCreateSymbolId(jSymbolName);
-	m_client->recordSymbolKind(symbolId, intToSymbolKind(jSymbolKind));
-	m_client->recordAccessKind(symbolId, intToAccessKind(jAccess));
-	m_client->recordDefinitionKind(symbolId, intToDefinitionKind(jDefinitionKind));
-}
+	const std::string filePath = m_javaEnvironment->toStdString(jFilePath);
+	std::map<std::string, std::shared_ptr<IndexerCommandJava>>::iterator it =
+		m_pendingCommands.find(filePath);
+	if (it == m_pendingCommands.end())
+	{
+		LOG_ERROR("Indexer - received file that is not part of the batch: " + filePath);
+		return false;
+	}
 
-void JavaParser::doRecordSymbolWithLocation(
-	jstring jSymbolName,
-	jint jSymbolKind,
-	jint beginLine,
-	jint beginColumn,
-	jint endLine,
-	jint endColumn,
-	jint jAccess,
-	jint jDefinitionKind)
-{
-	Id symbolId = getOrCreateSymbolId(jSymbolName);
-	m_client->recordSymbolKind(symbolId, intToSymbolKind(jSymbolKind));
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn),
-		ParseLocationType::TOKEN);
-	m_client->recordAccessKind(symbolId, intToAccessKind(jAccess));
-	m_client->recordDefinitionKind(symbolId, intToDefinitionKind(jDefinitionKind));
-}
+	std::shared_ptr<IndexerCommandJava> indexerCommand = it->second;
+	m_pendingCommands.erase(it);
 
-void JavaParser::doRecordSymbolWithLocationAndScope(
-	jstring jSymbolName,
-	jint jSymbolKind,
-	jint beginLine,
-	jint beginColumn,
-	jint endLine,
-	jint endColumn,
-	jint scopeBeginLine,
-	jint scopeBeginColumn,
-	jint scopeEndLine,
-	jint scopeEndColumn,
-	jint jAccess,
-	jint jDefinitionKind)
-{
-	Id symbolId = getOrCreateSymbolId(jSymbolName);
-	m_client->recordSymbolKind(symbolId, intToSymbolKind(jSymbolKind));
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn),
-		ParseLocationType::TOKEN);
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(m_currentFileId, scopeBeginLine, scopeBeginColumn, scopeEndLine, scopeEndColumn),
-		ParseLocationType::SCOPE);
-	m_client->recordAccessKind(symbolId, intToAccessKind(jAccess));
-	m_client->recordDefinitionKind(symbolId, intToDefinitionKind(jDefinitionKind));
+	startBatchedFile(indexerCommand);
+	startFile(indexerCommand->getSourceFilePath());
+	return true;
 }
 
-void JavaParser::doRecordSymbolWithLocationAndScopeAndSignature(
-	jstring jSymbolName,
-	jint jSymbolKind,
-	jint beginLine,
-	jint beginColumn,
-	jint endLine,
-	jint endColumn,
-	jint scopeBeginLine,
-	jint scopeBeginColumn,
-	jint scopeEndLine,
-	jint scopeEndColumn,
-	jint signatureBeginLine,
-	jint signatureBeginColumn,
-	jint signatureEndLine,
-	jint signatureEndColumn,
-	jint jAccess,
-	jint jDefinitionKind)
+void JavaParser::doFinishFile()
 {
-	Id symbolId = getOrCreateSymbolId(jSymbolName);
-	m_client->recordSymbolKind(symbolId, intToSymbolKind(jSymbolKind));
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn),
-		ParseLocationType::TOKEN);
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(m_currentFileId, scopeBeginLine, scopeBeginColumn, scopeEndLine, scopeEndColumn),
-		ParseLocationType::SCOPE);
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(
-			m_currentFileId, signatureBeginLine, signatureBeginColumn, signatureEndLine, signatureEndColumn),
-		ParseLocationType::SIGNATURE);
-	m_client->recordAccessKind(symbolId, intToAccessKind(jAccess));
-	m_client->recordDefinitionKind(symbolId, intToDefinitionKind(jDefinitionKind));
+	finishBatchedFile();
 }
 
-void JavaParser::doRecordReference(
-	jint jReferenceKind,
-	jstring jReferencedName,
-	jstring jContextName,
-	jint beginLine,
-	jint beginColumn,
-	jint endLine,
-	jint endColumn)
+void JavaParser::RecordBatch(
+	JNIEnv* env, jobject objectOrClass, jint parserId, jobject buffer, jint byteCount)
 {
-	m_client->recordReference(
-		intToReferenceKind(jReferenceKind),
-		getOrCreateSymbolId(jReferencedName),
-		getOrCreateSymbolId(jContextName),
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn));
+	std::map<int, JavaParser*>::iterator it = s_parsers.find(int(parserId));
+	if (it == s_parsers.end())
+	{
+		LOG_ERROR("parser with id " + std::to_string(parserId) + " not found");
+		return;
+	}
+
+	const char* data = static_cast<const char*>(env->GetDirectBufferAddress(buffer));
+	if (!data || byteCount < 0 || env->GetDirectBufferCapacity(buffer) < byteCount)
+	{
+		LOG_ERROR("parser with id " + std::to_string(parserId) + " received an invalid record buffer");
+		return;
+	}
+
+	it->second->doRecordBatch(data, size_t(byteCount));
 }
 
-void JavaParser::doRecordQualifierLocation(
-	jstring jQualifierName, jint beginLine, jint beginColumn, jint endLine, jint endColumn)
+void JavaParser::doRecordBatch(const char* data, size_t byteCount)
 {
-	Id symbolId = getOrCreateSymbolId(jQualifierName);
-	m_client->recordLocation(
-		symbolId,
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn),
-		ParseLocationType::QUALIFIER);
+	RecordBatchReader reader(data, byteCount);
+
+	while (!reader.atEnd())
+	{
+		int recordType = 0;
+		bool valid = reader.readInt(recordType);
+
+		int stringId = 0;
+		ParseLocation location;
+
+		switch (valid ? recordType : -1)
+		{
+		case RECORD_STRING:
+		{
+			std::string str;
+			valid = reader.readString(str);
+			if (valid)
+			{
+				m_batchStrings.push_back(std::move(str));
+				m_batchSymbolIds.push_back(0);
+			}
+			break;
+		}
+		case RECORD_SYMBOL:
+		case RECORD_SYMBOL_WITH_LOCATION:
+		case RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE:
+		case RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE_AND_SIGNATURE:
+		{
+			// each of these record types adds another location to the previous one
+			int symbolKind = 0;
+			int access = 0;
+			int definitionKind = 0;
+			ParseLocation scopeLocation;
+			ParseLocation signatureLocation;
+			valid = reader.readInt(stringId) && reader.readInt(symbolKind) &&
+				(recordType < RECORD_SYMBOL_WITH_LOCATION ||
+				 reader.readLocation(m_currentFileId, location)) &&
+				(recordType < RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE ||
+				 reader.readLocation(m_currentFileId, scopeLocation)) &&
+				(recordType < RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE_AND_SIGNATURE ||
+				 reader.readLocation(m_currentFileId, signatureLocation)) &&
+				reader.readInt(access) && reader.readInt(definitionKind) &&
+				recordBatchSymbol(
+					stringId,
+					symbolKind,
+					access,
+					definitionKind,
+					location,
+					scopeLocation,
+					signatureLocation);
+			break;
+		}
+		case RECORD_REFERENCE:
+		{
+			int referenceKind = 0;
+			int contextStringId = 0;
+			valid = reader.readInt(referenceKind) && reader.readInt(stringId) &&
+				reader.readInt(contextStringId) && reader.readLocation(m_currentFileId, location);
+			if (valid)
+			{
+				const Id referencedSymbolId = getOrCreateBatchSymbolId(stringId);
+				const Id contextSymbolId = getOrCreateBatchSymbolId(contextStringId);
+				valid = referencedSymbolId && contextSymbolId;
+				if (valid)
+				{
+					m_client->recordReference(
+						intToReferenceKind(referenceKind), referencedSymbolId, contextSymbolId, location);
+				}
+			}
+			break;
+		}
+		case RECORD_QUALIFIER_LOCATION:
+		{
+			valid = reader.readInt(stringId) && reader.readLocation(m_currentFileId, location);
+			const Id symbolId = valid ? getOrCreateBatchSymbolId(stringId) : 0;
+			valid = symbolId;
+			if (valid)
+			{
+				m_client->recordLocation(symbolId, location, ParseLocationType::QUALIFIER);
+			}
+			break;
+		}
+		case RECORD_LOCAL_SYMBOL:
+		{
+			valid = reader.readInt(stringId) && reader.readLocation(m_currentFileId, location);
+			const std::string* name = valid ? getBatchString(stringId) : nullptr;
+			valid = name;
+			if (valid)
+			{
+				m_client->recordLocalSymbol(
+					NameHierarchy::deserialize(*name).getQualifiedName(), location);
+			}
+			break;
+		}
+		case RECORD_COMMENT:
+			valid = reader.readLocation(m_currentFileId, location);
+			if (valid)
+			{
+				m_client->recordComment(location);
+			}
+			break;
+		case RECORD_ERROR:
+		{
+			int fatal = 0;
+			int indexed = 0;
+			valid = reader.readInt(stringId) && reader.readInt(fatal) && reader.readInt(indexed) &&
+				reader.readLocation(m_currentFileId, location);
+			const std::string* message = valid ? getBatchString(stringId) : nullptr;
+			valid = message;
+			if (valid)
+			{
+				m_client->recordError(
+					utility::decodeFromUtf8(*message),
+					fatal,
+					indexed,
+					FilePath(),
+					ParseLocation(m_currentFileId, location.startLineNumber, location.startColumnNumber));
+			}
+			break;
+		}
+		default:
+			valid = false;
+			break;
+		}
+
+		if (!valid)
+		{
+			LOG_ERROR(
+				L"Unable to decode the indexed records of file " + m_currentFilePath.wstr() +
+				L", the remaining records are skipped.");
+			return;
+		}
+	}
 }
 
-void JavaParser::doRecordLocalSymbol(
-	jstring jSymbolName, jint beginLine, jint beginColumn, jint endLine, jint endColumn)
+bool JavaParser::recordBatchSymbol(
+	int stringId,
+	int symbolKind,
+	int access,
+	int definitionKind,
+	const ParseLocation& location,
+	const ParseLocation& scopeLocation,
+	const ParseLocation& signatureLocation)
 {
-	m_client->recordLocalSymbol(
-		NameHierarchy::deserialize(
-			utility::decodeFromUtf8(m_javaEnvironment->toStdString(jSymbolName)))
-			.getQualifiedName(),
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn));
+	const Id symbolId = getOrCreateBatchSymbolId(stringId);
+	if (!symbolId)
+	{
+		return false;
+	}
+
+	m_client->recordSymbolKind(symbolId, intToSymbolKind(symbolKind));
+	if (location.isValid())
+	{
+		m_client->recordLocation(symbolId, location, ParseLocationType::TOKEN);
+	}
+	if (scopeLocation.isValid())
+	{
+		m_client->recordLocation(symbolId, scopeLocation, ParseLocationType::SCOPE);
+	}
+	if (signatureLocation.isValid())
+	{
+		m_client->recordLocation(symbolId, signatureLocation, ParseLocationType::SIGNATURE);
+	}
+	m_client->recordAccessKind(symbolId, intToAccessKind(access));
+	m_client->recordDefinitionKind(symbolId, intToDefinitionKind(definitionKind));
+	return true;
 }
 
-void JavaParser::doRecordComment(jint beginLine, jint beginColumn, jint endLine, jint endColumn)
+const std::string* JavaParser::getBatchString(int stringId) const
 {
-	m_client->recordComment(
-		ParseLocation(m_currentFileId, beginLine, beginColumn, endLine, endColumn));
+	if (stringId < 0 || size_t(stringId) >= m_batchStrings.size())
+	{
+		return nullptr;
+	}
+	return &m_batchStrings[stringId];
 }
 
-void JavaParser::doRecordError(
-	jstring jMessage,
-	jint jFatal,
-	jint jIndexed,
-	jint beginLine,
-	jint beginColumn,
-	jint endLine,
-	jint endColumn)
+Id JavaParser::getOrCreateBatchSymbolId(int stringId)
 {
-	bool fatal = jFatal;
-	bool indexed = jIndexed;
-
-	m_client->recordError(
-		utility::decodeFromUtf8(m_javaEnvironment->toStdString(jMessage)),
-		fatal,
-		indexed,
-		FilePath(),
-		ParseLocation(m_currentFileId, beginLine, beginColumn));
+	const std::string* serializedName = getBatchString(stringId);
+	if (!serializedName)
+	{
+		return 0;
+	}
+
+	Id& symbolId = m_batchSymbolIds[stringId];
+	if (!symbolId)
+	{
+		symbolId = getOrCreateSymbolId(*serializedName);
+	}
+	return symbolId;
 }
 
-Id JavaParser::getOrCreateSymbolId(jstring jSymbolName)
+Id JavaParser::getOrCreateSymbolId(const std::string& serializedName)
 {
-	std::string name = m_javaEnvironment->toStdString(jSymbolName);
-
-	auto it = m_symbolNameToIdMap.find(name);
+	auto it = m_symbolNameToIdMap.find(serializedName);
 	if (it != m_symbolNameToIdMap.end())
 	{
 		return it->second;
 	}
 
-	Id symbolId = m_client->recordSymbol(NameHierarchy::deserialize(utility::decodeFromUtf8(name)));
+	Id symbolId = m_client->recordSymbol(NameHierarchy::deserialize(serializedName));
 
-	m_symbolNameToIdMap.emplace(name, symbolId);
+	m_symbolNameToIdMap.emplace(serializedName, symbolId);
 	return symbolId;
 }
@@ -1,9 +1,11 @@
 #ifndef JAVA_PARSER_H
 #define JAVA_PARSER_H
 
+#include <functional>
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "FilePath.h"
 #include "IndexerCommandJava.h"
@@ -30,10 +32,15 @@ typedef _jstring* jstring;
 
 class FilePath;
 class TextAccess;
+struct ParseLocation;
 
 class JavaParser: public Parser
 {
 public:
+	typedef std::function<std::shared_ptr<ParserClient>(std::shared_ptr<IndexerCommandJava>)>
+		FileStartedCallback;
+	typedef std::function<void(std::shared_ptr<IndexerCommandJava>)> FileFinishedCallback;
+
 	static void clearCaches();
 
 	JavaParser(std::shared_ptr<ParserClient> client, std::shared_ptr<IndexerStateInfo> indexerStateInfo);
@@ -42,13 +49,27 @@ public:
 	void buildIndex(std::shared_ptr<IndexerCommandJava> indexerCommand);
 	void buildIndex(const FilePath& filePath, std::shared_ptr<TextAccess> textAccess);
 
+	// Parses the source files of commands that share their environment with a single parser
+	// environment. The records of each file go to the client returned by the started callback.
+	void buildIndex(
+		const std::vector<std::shared_ptr<IndexerCommandJava>>& indexerCommands,
+		FileStartedCallback onFileStarted,
+		FileFinishedCallback onFileFinished);
+
 private:
+	static std::string getClassPathString(std::shared_ptr<IndexerCommandJava> indexerCommand);
+	static int getVerbose();
+
 	void buildIndex(
 		const FilePath& sourceFilePath,
 		const std::wstring& languageStandard,
 		const std::string& classPath,
 		std::shared_ptr<TextAccess> textAccess);
 
+	void startFile(const FilePath& sourceFilePath);
+	void startBatchedFile(std::shared_ptr<IndexerCommandJava> indexerCommand);
+	void finishBatchedFile();
+
 // This macro makes available a variable T, the passed-in t. blablabla TODO: write somethign real here
 #define MAKE_PARAMS_0()
 #define MAKE_PARAMS_1(t1) , t1 arg1
@@ -191,45 +212,26 @@ private:
 	DEF_RELAYING_METHOD_1(LogInfo, jstring)
 	DEF_RELAYING_METHOD_1(LogWarning, jstring)
 	DEF_RELAYING_METHOD_1(LogError, jstring)
-	DEF_RELAYING_METHOD_4(RecordSymbol, jstring, jint, jint, jint)
-	DEF_RELAYING_METHOD_8(RecordSymbolWithLocation, jstring, jint, jint, jint, jint, jint, jint, jint)
-	DEF_RELAYING_METHOD_12(
-		RecordSymbolWithLocationAndScope,
-		jstring,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint)
-	DEF_RELAYING_METHOD_16(
-		RecordSymbolWithLocationAndScopeAndSignature,
-		jstring,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint,
-		jint)
-	DEF_RELAYING_METHOD_7(RecordReference, jint, jstring, jstring, jint, jint, jint, jint)
-	DEF_RELAYING_METHOD_5(RecordQualifierLocation, jstring, jint, jint, jint, jint)
-	DEF_RELAYING_METHOD_5(RecordLocalSymbol, jstring, jint, jint, jint, jint)
-	DEF_RELAYING_METHOD_4(RecordComment, jint, jint, jint, jint)
-	DEF_RELAYING_METHOD_7(RecordError, jstring, jint, jint, jint, jint, jint, jint)
+
+	DEF_RELAYING_METHOD_0(FinishFile)
+
+	static void RecordBatch(
+		JNIEnv* env, jobject objectOrClass, jint parserId, jobject buffer, jint byteCount);
+
+	static bool StartFile(JNIEnv* env, jobject objectOrClass, jint parserId, jstring jFilePath)
+	{
+		std::map<int, JavaParser*>::iterator it = s_parsers.find(int(parserId));
+		if (it != s_parsers.end())
+		{
+			return it->second->doStartFile(jFilePath);
+		}
+		else
+		{
+			LOG_ERROR("parser with id " + std::to_string(parserId) + " not found");
+		}
+
+		return false;
+	}
 
 	static bool GetInterrupted(JNIEnv* env, jobject objectOrClass, jint parserId)
 	{
@@ -259,73 +261,40 @@ private:
 
 	void doLogError(jstring jError);
 
-	void doRecordSymbol(jstring jSymbolName, jint jSymbolKind, jint jAccess, jint jDefinitionKind);
-
-	void doRecordSymbolWithLocation(
-		jstring jSymbolName,
-		jint jSymbolKind,
-		jint beginLine,
-		jint beginColumn,
-		jint endLine,
-		jint endColumn,
-		jint jAccess,
-		jint jDefinitionKind);
-
-	void doRecordSymbolWithLocationAndScope(
-		jstring jSymbolName,
-		jint jSymbolKind,
-		jint beginLine,
-		jint beginColumn,
-		jint endLine,
-		jint endColumn,
-		jint scopeBeginLine,
-		jint scopeBeginColumn,
-		jint scopeEndLine,
-		jint scopeEndColumn,
-		jint jAccess,
-		jint jDefinitionKind);
-
-	void doRecordSymbolWithLocationAndScopeAndSignature(
-		jstring jSymbolName,
-		jint jSymbolKind,
-		jint beginLine,
-		jint beginColumn,
-		jint endLine,
-		jint endColumn,
-		jint scopeBeginLine,
-		jint scopeBeginColumn,
-		jint scopeEndLine,
-		jint scopeEndColumn,
-		jint signatureBeginLine,
-		jint signatureBeginColumn,
-		jint signatureEndLine,
-		jint signatureEndColumn,
-		jint jAccess,
-		jint jDefinitionKind);
-
-	void doRecordReference(
-		jint jReferenceKind,
-		jstring jReferencedName,
-		jstring jContextName,
-		jint beginLine,
-		jint beginColumn,
-		jint endLine,
-		jint endColumn);
-	void doRecordQualifierLocation(
-		jstring jQualifierName, jint beginLine, jint beginColumn, jint endLine, jint endColumn);
-	void doRecordLocalSymbol(
-		jstring jSymbolName, jint beginLine, jint beginColumn, jint endLine, jint endColumn);
-	void doRecordComment(jint beginLine, jint beginColumn, jint endLine, jint endColumn);
-	void doRecordError(
-		jstring jMessage,
-		jint jFatal,
-		jint jIndexed,
-		jint beginLine,
-		jint beginColumn,
-		jint endLine,
-		jint endColumn);
-
-	Id getOrCreateSymbolId(jstring jSymbolName);
+	bool doStartFile(jstring jFilePath);
+
+	void doFinishFile();
+
+	// needs to match the record types of RecordBuffer.java
+	enum RecordType
+	{
+		RECORD_STRING = 0,
+		RECORD_SYMBOL = 1,
+		RECORD_SYMBOL_WITH_LOCATION = 2,
+		RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE = 3,
+		RECORD_SYMBOL_WITH_LOCATION_AND_SCOPE_AND_SIGNATURE = 4,
+		RECORD_REFERENCE = 5,
+		RECORD_QUALIFIER_LOCATION = 6,
+		RECORD_LOCAL_SYMBOL = 7,
+		RECORD_COMMENT = 8,
+		RECORD_ERROR = 9
+	};
+
+	// decodes the records written by RecordBuffer.java
+	void doRecordBatch(const char* data, size_t byteCount);
+
+	Id getOrCreateSymbolId(const std::string& serializedName);
+	// locations that are not valid were not part of the record
+	bool recordBatchSymbol(
+		int stringId,
+		int symbolKind,
+		int access,
+		int definitionKind,
+		const ParseLocation& location,
+		const ParseLocation& scopeLocation,
+		const ParseLocation& signatureLocation);
+	const std::string* getBatchString(int stringId) const;
+	Id getOrCreateBatchSymbolId(int stringId);
 
 	std::shared_ptr<JavaEnvironment> m_javaEnvironment;
 	std::shared_ptr<IndexerStateInfo> m_indexerStateInfo;
@@ -335,6 +304,16 @@ private:
 	Id m_currentFileId;
 
 	std::map<std::string, Id> m_symbolNameToIdMap;
+
+	// strings of the current file's record batches and the ids of the symbols they name
+	std::vector<std::string> m_batchStrings;
+	std::vector<Id> m_batchSymbolIds;
+
+	// commands of the file batch that have not been started yet, by source file path
+	std::map<std::string, std::shared_ptr<IndexerCommandJava>> m_pendingCommands;
+	std::shared_ptr<IndexerCommandJava> m_currentCommand;
+	FileStartedCallback m_onFileStarted;
+	FileFinishedCallback m_onFileFinished;
 };
 
 #endif	  // JAVA_PARSER_H
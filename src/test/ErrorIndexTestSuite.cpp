@@ -0,0 +1,85 @@
+#include "catch.hpp"
+
+#include "ErrorIndex.h"
+
+namespace
+{
+ErrorInfo createError(Id id, bool fatal, bool indexed, const std::wstring& translationUnit)
+{
+	return ErrorInfo(id, L"message", L"file.cpp", 1, 1, translationUnit, fatal, indexed);
+}
+
+std::vector<Id> getErrorIds(const std::vector<ErrorInfo>& errors)
+{
+	std::vector<Id> ids;
+	for (const ErrorInfo& error: errors)
+	{
+		ids.push_back(error.id);
+	}
+	return ids;
+}
+}	 // namespace
+
+TEST_CASE("error index counts errors by fatal flag")
+{
+	ErrorIndex index;
+	index.addError(createError(1, false, true, L"a.cpp"), 10);
+	index.addError(createError(2, true, true, L"a.cpp"), 10);
+	index.addError(createError(3, true, false, L"b.cpp"), 11);
+
+	ErrorFilter filter;
+	filter.fatal = false;
+
+	REQUIRE(index.getErrorCount().total == 3);
+	REQUIRE(index.getErrorCount().fatal == 2);
+	REQUIRE(index.getErrorCount(ErrorFilter()) == 3);
+	REQUIRE(index.getErrorCount(filter) == 2);
+}
+
+TEST_CASE("error index returns filtered errors in order of addition up to the limit")
+{
+	ErrorIndex index;
+	for (Id id = 1; id <= 10; id++)
+	{
+		index.addError(createError(id, id % 2 == 0, id % 3 != 0, L"a.cpp"), 10);
+	}
+
+	ErrorFilter filter;
+	REQUIRE(
+		getErrorIds(index.getErrors(filter)) == std::vector<Id>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+
+	filter.limit = 4;
+	REQUIRE(getErrorIds(index.getErrors(filter)) == std::vector<Id>({1, 2, 3, 4}));
+
+	filter.fatal = false;
+	filter.unindexedFatal = false;
+	REQUIRE(getErrorIds(index.getErrors(filter)) == std::vector<Id>({1, 3, 5, 7}));
+	REQUIRE(
+		getErrorIds(filter.filterErrors(index.getErrors(ErrorFilter()))) ==
+		std::vector<Id>({1, 3, 5, 7}));
+
+	REQUIRE(getErrorIds(index.getErrorsAfter(7)) == std::vector<Id>({8, 9, 10}));
+	REQUIRE(index.getErrorsAfter(10).empty());
+}
+
+TEST_CASE("error index finds errors of files")
+{
+	ErrorIndex index;
+	index.addError(createError(1, false, true, L"a.cpp"), 10);
+	index.addError(createError(2, true, true, L"b.cpp"), 11);
+	index.addError(createError(3, false, true, L"a.cpp"), 12);
+	index.addError(createError(4, true, true, L"a.cpp"), 10);
+
+	ErrorFilter fatalFilter;
+	fatalFilter.error = false;
+
+	REQUIRE(
+		getErrorIds(index.getErrorsForFiles(ErrorFilter(), {10, 11})) ==
+		std::vector<Id>({1, 2, 4}));
+	REQUIRE(getErrorIds(index.getErrorsForFiles(fatalFilter, {10, 12})) == std::vector<Id>({4}));
+	REQUIRE(index.getErrorsForFiles(ErrorFilter(), {13}).empty());
+
+	index.clear();
+	REQUIRE(index.empty());
+	REQUIRE(index.getErrorCount().total == 0);
+}
@@ -0,0 +1,61 @@
+#include "catch.hpp"
+
+#include "FileReferenceGraph.h"
+
+TEST_CASE("file reference graph finds transitively referencing and referenced files")
+{
+	FileReferenceGraph graph;
+	graph.addReference(1, 2);
+	graph.addReference(2, 3);
+	graph.addReference(4, 3);
+	graph.addReference(5, 6);
+	graph.finish();
+
+	REQUIRE(graph.getReferencing({3}) == std::set<Id>({1, 2, 4}));
+	REQUIRE(graph.getReferencing({2}) == std::set<Id>({1}));
+	REQUIRE(graph.getReferencing({1}).empty());
+	REQUIRE(graph.getReferenced({1}) == std::set<Id>({2, 3}));
+	REQUIRE(graph.getReferenced({1, 5}) == std::set<Id>({2, 3, 6}));
+	REQUIRE(graph.getReferenced({7}).empty());
+}
+
+TEST_CASE("file reference graph contains passed files only if they are part of a cycle")
+{
+	FileReferenceGraph graph;
+	graph.addReference(1, 2);
+	graph.addReference(2, 3);
+	graph.addReference(3, 1);
+	graph.addReference(3, 4);
+	graph.addReference(5, 5);
+	graph.addReference(5, 1);
+	graph.finish();
+
+	REQUIRE(graph.getComponentCount() == 3);
+	REQUIRE(graph.getReferencing({2}) == std::set<Id>({1, 2, 3, 5}));
+	REQUIRE(graph.getReferenced({2}) == std::set<Id>({1, 2, 3, 4}));
+	REQUIRE(graph.getReferencing({4}) == std::set<Id>({1, 2, 3, 5}));
+	REQUIRE(graph.getReferencing({5}) == std::set<Id>({5}));
+	REQUIRE(graph.getReferenced({4}).empty());
+}
+
+TEST_CASE("file reference graph handles long reference chains")
+{
+	FileReferenceGraph graph;
+	for (Id i = 1; i < 100000; i++)
+	{
+		graph.addReference(i, i + 1);
+	}
+	graph.addReference(100000, 1);
+	graph.finish();
+
+	REQUIRE(graph.getFileCount() == 100000);
+	REQUIRE(graph.getComponentCount() == 1);
+	REQUIRE(graph.getReferencing({50000}).size() == 100000);
+
+	graph.clear();
+	graph.addReference(1, 2);
+	graph.finish();
+
+	REQUIRE(graph.getReferenced({1}) == std::set<Id>({2}));
+	REQUIRE(graph.getReferenced({100000}).empty());
+}
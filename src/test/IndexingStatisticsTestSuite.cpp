@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include "IndexingStatistics.h"
+
+namespace
+{
+bool containsLine(const std::string& json, const std::string& line)
+{
+	return json.find("\n" + line + "\n") != std::string::npos;
+}
+}	 // namespace
+
+TEST_CASE("indexing statistics export recorded values as json")
+{
+	std::shared_ptr<IndexingStatistics> statistics = IndexingStatistics::getInstance();
+	statistics->start(4);
+
+	statistics->recordIndexedFile(0.5f, 100);
+	statistics->recordIndexedFile(2.0f, 200);
+	statistics->recordIndexedFile(1.0f, 300);
+	statistics->recordSharedMemoryGrowth(1024);
+	statistics->recordMerge(0.25f);
+	statistics->recordInjection(2.0f, 1000);
+	statistics->recordStorageQueueDepth(3, 500);
+	statistics->recordStorageQueueDepth(1, 100);
+	statistics->recordMemoryBudget(4096);
+	statistics->recordThrottling();
+
+	const std::string json = statistics->toJson();
+	statistics->finish();
+
+	REQUIRE(json.find("{\n") == 0);
+	REQUIRE(json.substr(json.size() - 2) == "}\n");
+
+	REQUIRE(containsLine(json, "\t\"source_file_count\": 4,"));
+	REQUIRE(containsLine(json, "\t\"indexed_file_count\": 3,"));
+	REQUIRE(json.find("\t\"elapsed_seconds\": ") != std::string::npos);
+	REQUIRE(json.find("\t\"files_per_second\": ") != std::string::npos);
+	REQUIRE(containsLine(
+		json, "\t\"parse_seconds\": {\"total\": 3.5, \"median\": 1, \"90th\": 2, \"max\": 2},"));
+	REQUIRE(containsLine(
+		json, "\t\"intermediate_storage_bytes\": {\"total\": 600, \"max\": 300},"));
+	REQUIRE(containsLine(json, "\t\"shared_memory_growth\": {\"count\": 1, \"bytes\": 1024},"));
+	REQUIRE(containsLine(json, "\t\"merge\": {\"count\": 1, \"seconds\": 0.25},"));
+	REQUIRE(containsLine(
+		json,
+		"\t\"injection\": {\"count\": 1, \"seconds\": 2, \"rows\": 1000, \"rows_per_second\": "
+		"500},"));
+	REQUIRE(containsLine(json, "\t\"storage_queue_depth\": {\"current\": 1, \"max\": 3},"));
+	REQUIRE(containsLine(
+		json, "\t\"storage_queue_bytes\": {\"current\": 100, \"max\": 500, \"budget\": 4096},"));
+	REQUIRE(containsLine(json, "\t\"throttle_count\": 1"));
+}
@@ -0,0 +1,64 @@
+#include "catch.hpp"
+
+#include "InternedStringTable.h"
+
+TEST_CASE("interned string table cannot find element after creation")
+{
+	InternedStringTable table;
+
+	REQUIRE(table.empty());
+	REQUIRE(table.find("a") == 0);
+}
+
+TEST_CASE("interned string table finds elements")
+{
+	InternedStringTable table;
+	table.add("ab", 1);
+	table.add("ac", 2);
+	table.add("", 3);
+
+	REQUIRE(table.size() == 3);
+	REQUIRE(table.find("ab") == 1);
+	REQUIRE(table.find("ac") == 2);
+	REQUIRE(table.find("") == 3);
+	REQUIRE(table.find("a") == 0);
+	REQUIRE(table.find("abc") == 0);
+}
+
+TEST_CASE("interned string table keeps first value of string added twice")
+{
+	InternedStringTable table;
+	table.add("abba", 1);
+	table.add("abba", 2);
+
+	REQUIRE(table.find("abba") == 1);
+}
+
+TEST_CASE("interned string table finds elements after growing")
+{
+	InternedStringTable table;
+	for (uint32_t i = 1; i <= 20000; i++)
+	{
+		table.add("::\tmnamespace\tn" + std::to_string(i) + "\ts\tp", i);
+	}
+
+	// longer than an arena block
+	const std::string longString(100000, 'x');
+	table.add(longString, 20001);
+
+	size_t foundCount = 0;
+	for (uint32_t i = 1; i <= 20000; i++)
+	{
+		foundCount += table.find("::\tmnamespace\tn" + std::to_string(i) + "\ts\tp") == i;
+	}
+
+	REQUIRE(table.size() == 20001);
+	REQUIRE(foundCount == 20000);
+	REQUIRE(table.find(longString) == 20001);
+	REQUIRE(table.find("::\tmnamespace\tn0\ts\tp") == 0);
+	REQUIRE(table.getByteSize() > longString.size());
+
+	table.clear();
+	REQUIRE(table.empty());
+	REQUIRE(table.find("::\tmnamespace\tn1\ts\tp") == 0);
+}
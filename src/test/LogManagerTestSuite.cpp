@@ -289,3 +289,118 @@ TEST_CASE("logger logs threaded")
 		messageCount * 6 ==
 		logger->getErrorCount() + logger->getWarningCount() + logger->getMessageCount());
 }
+
+TEST_CASE("logger logs asynchronously after flush")
+{
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.setAsync(true);
+
+	const std::wstring log = L"test";
+	std::shared_ptr<TestLogger> logger = std::make_shared<TestLogger>();
+	logManagerImplementation.addLogger(logger);
+
+	logManagerImplementation.logInfo(log, __FILE__, __FUNCTION__, __LINE__);
+	logManagerImplementation.logError(log, __FILE__, __FUNCTION__, __LINE__);
+	logManagerImplementation.flush();
+
+	REQUIRE(1 == logger->getMessageCount());
+	REQUIRE(1 == logger->getErrorCount());
+	REQUIRE(log == logger->getLastInfo());
+	REQUIRE(log == logger->getLastError());
+}
+
+TEST_CASE("logger logs asynchronously threaded")
+{
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.setAsync(true);
+
+	std::wstring log = L"foo";
+	unsigned int messageCount = 3000;
+	std::shared_ptr<TestLogger> logger = std::make_shared<TestLogger>();
+	logManagerImplementation.addLogger(logger);
+
+	std::thread thread0(logSomeMessages, &logManagerImplementation, log, messageCount);
+	std::thread thread1(logSomeMessages, &logManagerImplementation, log, messageCount);
+
+	thread0.join();
+	thread1.join();
+
+	logManagerImplementation.setAsync(false);
+
+	REQUIRE(logger->getLastError() == log);
+	REQUIRE(
+		messageCount * 6 ==
+		logger->getErrorCount() + logger->getWarningCount() + logger->getMessageCount());
+}
+
+TEST_CASE("logger logs asynchronous messages of one thread in order")
+{
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.setAsync(true);
+
+	std::shared_ptr<TestLogger> logger = std::make_shared<TestLogger>();
+	logManagerImplementation.addLogger(logger);
+
+	for (int i = 0; i < 10000; i++)
+	{
+		logManagerImplementation.logInfo(std::to_wstring(i), __FILE__, __FUNCTION__, __LINE__);
+	}
+	logManagerImplementation.flush();
+
+	REQUIRE(10000 == logger->getMessageCount());
+	REQUIRE(L"9999" == logger->getLastInfo());
+}
+
+TEST_CASE("logger logs asynchronous errors and preceding messages before returning")
+{
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.setAsync(true);
+
+	const std::wstring log = L"test";
+	std::shared_ptr<TestLogger> logger = std::make_shared<TestLogger>();
+	logManagerImplementation.addLogger(logger);
+
+	logManagerImplementation.logInfo(log, __FILE__, __FUNCTION__, __LINE__);
+	logManagerImplementation.logError(log, __FILE__, __FUNCTION__, __LINE__);
+
+	REQUIRE(1 == logger->getMessageCount());
+	REQUIRE(1 == logger->getErrorCount());
+}
+
+TEST_CASE("logger keeps messages logged while asynchronous logging is disabled")
+{
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.setAsync(true);
+
+	std::wstring log = L"foo";
+	unsigned int messageCount = 3000;
+	std::shared_ptr<TestLogger> logger = std::make_shared<TestLogger>();
+	logManagerImplementation.addLogger(logger);
+
+	std::thread thread0(logSomeMessages, &logManagerImplementation, log, messageCount);
+	std::thread thread1(logSomeMessages, &logManagerImplementation, log, messageCount);
+
+	logManagerImplementation.setAsync(false);
+
+	thread0.join();
+	thread1.join();
+
+	REQUIRE(
+		messageCount * 6 ==
+		logger->getErrorCount() + logger->getWarningCount() + logger->getMessageCount());
+}
+
+TEST_CASE("logger decodes asynchronous utf-8 messages when writing them")
+{
+	LogManagerImplementation logManagerImplementation;
+	logManagerImplementation.setAsync(true);
+
+	std::shared_ptr<TestLogger> logger = std::make_shared<TestLogger>();
+	logManagerImplementation.addLogger(logger);
+
+	logManagerImplementation.logInfo(std::string("f\xC3\xBC"), __FILE__, __FUNCTION__, __LINE__);
+	logManagerImplementation.flush();
+
+	REQUIRE(1 == logger->getMessageCount());
+	REQUIRE(L"f\u00FC" == logger->getLastInfo());
+}
@@ -0,0 +1,101 @@
+#include "catch.hpp"
+
+#include "NameHierarchy.h"
+#include "NodeTable.h"
+
+namespace
+{
+StorageNode createNode(Id id, int type, const std::wstring& name)
+{
+	return StorageNode(
+		id, type, NameHierarchy::serialize(NameHierarchy(name, NAME_DELIMITER_CXX)));
+}
+
+std::vector<Id> getNodeIds(const std::vector<StorageNode>& nodes)
+{
+	std::vector<Id> ids;
+	for (const StorageNode& node: nodes)
+	{
+		ids.push_back(node.id);
+	}
+	return ids;
+}
+}	 // namespace
+
+TEST_CASE("node table returns types and names of added nodes")
+{
+	NodeTable table;
+	table.addNode(createNode(3, 1, L"foo"));
+	table.addNode(createNode(1, 2, L"bar"));
+
+	REQUIRE(table.getNodeCount() == 2);
+	REQUIRE(table.containsNode(1));
+	REQUIRE(!table.containsNode(2));
+	REQUIRE(table.getNodeType(3) == 1);
+	REQUIRE(table.getNodeType(2) == 0);
+
+	REQUIRE(table.getNameHierarchy(1)->getQualifiedName() == L"bar");
+	REQUIRE(table.getNameHierarchy(3)->getQualifiedName() == L"foo");
+	REQUIRE(table.getNameHierarchy(2) == nullptr);
+	REQUIRE(table.getNameHierarchy(3) == table.getNameHierarchy(3));
+
+	std::vector<StorageNode> nodes;
+	REQUIRE(table.getNodes({3, 4, 1, 3}, &nodes) == std::vector<Id>({4}));
+	REQUIRE(getNodeIds(nodes) == std::vector<Id>({1, 3}));
+	REQUIRE(nodes[1].type == 1);
+	REQUIRE(nodes[1].serializedName == createNode(3, 1, L"foo").serializedName);
+
+	size_t visitedCount = 0;
+	table.forEachNode([&](Id nodeId, int type) {
+		REQUIRE(type == table.getNodeType(nodeId));
+		visitedCount++;
+	});
+	REQUIRE(visitedCount == 2);
+}
+
+TEST_CASE("node table looks up names without caching them")
+{
+	NodeTable table;
+	table.addNode(createNode(1, 1, L"foo"));
+	table.addNode(createNode(2, 1, L"bar"));
+
+	std::shared_ptr<const NameHierarchy> cachedName = table.getNameHierarchy(1);
+	REQUIRE(table.getNameHierarchyWithoutCaching(1) == cachedName);
+
+	std::shared_ptr<const NameHierarchy> uncachedName = table.getNameHierarchyWithoutCaching(2);
+	REQUIRE(uncachedName->getQualifiedName() == L"bar");
+	REQUIRE(table.getNameHierarchyWithoutCaching(2) != uncachedName);
+	REQUIRE(table.getNameHierarchyWithoutCaching(3) == nullptr);
+}
+
+TEST_CASE("node table replaces and removes nodes")
+{
+	NodeTable table;
+	for (Id id = 1; id <= 10; id++)
+	{
+		table.addNode(createNode(id, 1, L"node" + std::to_wstring(id)));
+	}
+	REQUIRE(table.getNameHierarchy(5)->getQualifiedName() == L"node5");
+
+	table.addNode(createNode(5, 2, L"renamed"));
+	REQUIRE(table.getNodeCount() == 10);
+	REQUIRE(table.getNodeType(5) == 2);
+	REQUIRE(table.getNameHierarchy(5)->getQualifiedName() == L"renamed");
+
+	for (Id id = 1; id <= 8; id++)
+	{
+		table.removeNode(id);
+	}
+	table.removeNode(11);
+
+	std::vector<StorageNode> nodes;
+	REQUIRE(table.getNodes({5, 9, 10}, &nodes) == std::vector<Id>({5}));
+	REQUIRE(getNodeIds(nodes) == std::vector<Id>({9, 10}));
+	REQUIRE(table.getNameHierarchy(5) == nullptr);
+	REQUIRE(table.getNameHierarchy(9)->getQualifiedName() == L"node9");
+	REQUIRE(table.getNameHierarchy(10)->getQualifiedName() == L"node10");
+
+	table.clear();
+	REQUIRE(table.getNodeCount() == 0);
+	REQUIRE(table.getNameHierarchy(9) == nullptr);
+}
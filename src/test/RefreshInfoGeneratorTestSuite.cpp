@@ -139,8 +139,13 @@ Id addFileToStorage(
 				NODE_FILE,
 				NameHierarchy::serialize(NameHierarchy(filePath.wstr(), NAME_DELIMITER_FILE))))
 			.first;
-	storage->addFile(
-		StorageFile(id, filePath.wstr(), L"someLanguage", modificationTime, indexed, complete));
+	storage->addFile(StorageFile(
+		id,
+		utility::encodeToUtf8(filePath.wstr()),
+		L"someLanguage",
+		modificationTime,
+		indexed,
+		complete));
 	return id;
 }
 
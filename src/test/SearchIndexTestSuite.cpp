@@ -4,10 +4,34 @@
 #include "SearchIndex.h"
 #include "utility.h"
 
+namespace
+{
+std::vector<std::wstring> getResultDescriptions(const std::vector<SearchResult>& results)
+{
+	std::vector<std::wstring> descriptions;
+	for (const SearchResult& result: results)
+	{
+		std::wstring description = result.text + L" score: " + std::to_wstring(result.score) +
+			L" ids:";
+		for (Id id: result.elementIds)
+		{
+			description += L" " + std::to_wstring(id);
+		}
+		description += L" indices:";
+		for (size_t index: result.indices)
+		{
+			description += L" " + std::to_wstring(index);
+		}
+		descriptions.push_back(description);
+	}
+	return descriptions;
+}
+}	 // namespace
+
 TEST_CASE("search index finds id of element added")
 {
 	SearchIndex index;
-	index.addNode(1, NameHierarchy::deserialize(L"::\tmfoo\tsvoid\tp() const").getQualifiedName());
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	std::vector<SearchResult> results = index.search(L"oo", NodeTypeSet::all(), 0);
 
@@ -19,7 +43,7 @@ TEST_CASE("search index finds id of element added")
 TEST_CASE("search index finds correct indices for query")
 {
 	SearchIndex index;
-	index.addNode(1, NameHierarchy::deserialize(L"::\tmfoo\tsvoid\tp() const").getQualifiedName());
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	std::vector<SearchResult> results = index.search(L"oo", NodeTypeSet::all(), 0);
 
@@ -32,8 +56,8 @@ TEST_CASE("search index finds correct indices for query")
 TEST_CASE("search index finds ids for ambiguous query")
 {
 	SearchIndex index;
-	index.addNode(1, NameHierarchy::deserialize(L"::\tmfor\tsvoid\tp() const").getQualifiedName());
-	index.addNode(2, NameHierarchy::deserialize(L"::\tmfos\tsvoid\tp() const").getQualifiedName());
+	index.addNode(1, NameHierarchy::deserialize("::\tmfor\tsvoid\tp() const").getQualifiedName());
+	index.addNode(2, NameHierarchy::deserialize("::\tmfos\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	std::vector<SearchResult> results = index.search(L"fo", NodeTypeSet::all(), 0);
 
@@ -47,7 +71,7 @@ TEST_CASE("search index finds ids for ambiguous query")
 TEST_CASE("search index does not find anything after clear")
 {
 	SearchIndex index;
-	index.addNode(1, NameHierarchy::deserialize(L"::\tmfoo\tsvoid\tp() const").getQualifiedName());
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	index.clear();
 	std::vector<SearchResult> results = index.search(L"oo", NodeTypeSet::all(), 0);
@@ -58,8 +82,8 @@ TEST_CASE("search index does not find anything after clear")
 TEST_CASE("search index does not find all results when max amount is limited")
 {
 	SearchIndex index;
-	index.addNode(1, NameHierarchy::deserialize(L"::\tmfoo1\tsvoid\tp() const").getQualifiedName());
-	index.addNode(2, NameHierarchy::deserialize(L"::\tmfoo2\tsvoid\tp() const").getQualifiedName());
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo1\tsvoid\tp() const").getQualifiedName());
+	index.addNode(2, NameHierarchy::deserialize("::\tmfoo2\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	std::vector<SearchResult> results = index.search(L"oo", NodeTypeSet::all(), 1);
 
@@ -69,8 +93,8 @@ TEST_CASE("search index does not find all results when max amount is limited")
 TEST_CASE("search index query is case insensitive")
 {
 	SearchIndex index;
-	index.addNode(1, NameHierarchy::deserialize(L"::\tmfoo1\tsvoid\tp() const").getQualifiedName());
-	index.addNode(2, NameHierarchy::deserialize(L"::\tmFOO2\tsvoid\tp() const").getQualifiedName());
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo1\tsvoid\tp() const").getQualifiedName());
+	index.addNode(2, NameHierarchy::deserialize("::\tmFOO2\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	std::vector<SearchResult> results = index.search(L"oo", NodeTypeSet::all(), 0);
 
@@ -81,9 +105,9 @@ TEST_CASE("search index rates higher on consecutive letters")
 {
 	SearchIndex index;
 	index.addNode(
-		1, NameHierarchy::deserialize(L"::\tmoaabbcc\tsvoid\tp() const").getQualifiedName());
+		1, NameHierarchy::deserialize("::\tmoaabbcc\tsvoid\tp() const").getQualifiedName());
 	index.addNode(
-		2, NameHierarchy::deserialize(L"::\tmocbcabc\tsvoid\tp() const").getQualifiedName());
+		2, NameHierarchy::deserialize("::\tmocbcabc\tsvoid\tp() const").getQualifiedName());
 	index.finishSetup();
 	std::vector<SearchResult> results = index.search(L"abc", NodeTypeSet::all(), 0);
 
@@ -91,3 +115,220 @@ TEST_CASE("search index rates higher on consecutive letters")
 	REQUIRE(L"ocbcabc" == results[0].text);
 	REQUIRE(L"oaabbcc" == results[1].text);
 }
+
+TEST_CASE("search index finds element added after setup")
+{
+	SearchIndex index;
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo\tsvoid\tp() const").getQualifiedName());
+	index.finishSetup();
+	index.addNode(2, NameHierarchy::deserialize("::\tmfbar\tsvoid\tp() const").getQualifiedName());
+	std::vector<SearchResult> results = index.search(L"fbr", NodeTypeSet::all(), 0);
+
+	REQUIRE(1 == results.size());
+	REQUIRE(1 == results[0].elementIds.size());
+	REQUIRE(utility::containsElement<Id>(results[0].elementIds, 2));
+}
+
+TEST_CASE("search index does not find removed element")
+{
+	SearchIndex index;
+	index.addNode(1, NameHierarchy::deserialize("::\tmfoo\tsvoid\tp() const").getQualifiedName());
+	index.addNode(2, NameHierarchy::deserialize("::\tmfor\tsvoid\tp() const").getQualifiedName());
+	index.finishSetup();
+
+	REQUIRE(!index.removeNode(1, L"fo"));
+	REQUIRE(index.removeNode(1, L"foo"));
+	std::vector<SearchResult> results = index.search(L"fo", NodeTypeSet::all(), 0);
+
+	REQUIRE(1 == results.size());
+	REQUIRE(1 == results[0].elementIds.size());
+	REQUIRE(utility::containsElement<Id>(results[0].elementIds, 2));
+}
+
+TEST_CASE("search index finds same results in trie and flat arrays")
+{
+	SearchIndex flatIndex;
+	SearchIndex trieIndex(false);
+	for (Id id = 1; id <= 1000; id++)
+	{
+		const std::wstring name = L"ns" + std::to_wstring(id % 7) + L"::Class" +
+			std::to_wstring(id % 31) + L"::method" + std::to_wstring(id) + L"ä";
+		flatIndex.addNode(id, name);
+		trieIndex.addNode(id, name);
+	}
+	flatIndex.finishSetup();
+	trieIndex.finishSetup();
+
+	REQUIRE(flatIndex.isFlattened());
+	REQUIRE(!trieIndex.isFlattened());
+
+	const std::vector<std::wstring> queries = {
+		L"ns3cl", L"class2meth1", L"METHOD99", L"9ä", L"zz"};
+	for (const std::wstring& query: queries)
+	{
+		REQUIRE(
+			getResultDescriptions(flatIndex.search(query, NodeTypeSet::all(), 20)) ==
+			getResultDescriptions(trieIndex.search(query, NodeTypeSet::all(), 20)));
+	}
+}
+
+TEST_CASE("search index finds same results in parallel and sequential search")
+{
+	// the trie is always searched on a single thread
+	SearchIndex parallelIndex;
+	SearchIndex sequentialIndex(false);
+	for (Id id = 1; id <= 30000; id++)
+	{
+		const std::wstring name = L"ns::Class" + std::to_wstring(id % 211) + L"::method" +
+			std::to_wstring(id);
+		parallelIndex.addNode(id, name);
+		sequentialIndex.addNode(id, name);
+	}
+	parallelIndex.finishSetup();
+	sequentialIndex.finishSetup();
+
+	const std::vector<std::wstring> queries = {
+		L"cl42", L"class1meth12", L"ns::m2", L"method29999", L"zz"};
+	for (const std::wstring& query: queries)
+	{
+		for (size_t maxResultCount: {0, 1, 20})
+		{
+			REQUIRE(
+				getResultDescriptions(
+					parallelIndex.search(query, NodeTypeSet::all(), maxResultCount)) ==
+				getResultDescriptions(
+					sequentialIndex.search(query, NodeTypeSet::all(), maxResultCount)));
+		}
+	}
+}
+
+TEST_CASE("search index finds same results when continuing a search session")
+{
+	for (Id nameCount: {1000, 30000})
+	{
+		SearchIndex index;
+		for (Id id = 1; id <= nameCount; id++)
+		{
+			index.addNode(
+				id,
+				L"ns::Class" + std::to_wstring(id % 211) + L"::methodWith" + std::to_wstring(id),
+				NodeType(id % 2 ? NODE_METHOD : NODE_FIELD));
+		}
+		index.finishSetup();
+
+		const std::vector<NodeTypeSet> nodeTypeSets = {
+			NodeTypeSet::all(), NodeTypeSet(NodeType(NODE_METHOD))};
+		const std::vector<std::wstring> queries = {
+			L"c", L"cl", L"cl4", L"cl42m", L"cl42mwith", L"cl42mwith9", L"ns", L"nsw1"};
+		std::vector<SearchIndex::SearchSession> sessions(nodeTypeSets.size());
+		for (const std::wstring& query: queries)
+		{
+			for (size_t j = 0; j < nodeTypeSets.size(); j++)
+			{
+				const NodeTypeSet& nodeTypes = nodeTypeSets[j];
+				REQUIRE(
+					getResultDescriptions(index.search(query, nodeTypes, 20, 0, &sessions[j])) ==
+					getResultDescriptions(index.search(query, nodeTypes, 20)));
+			}
+		}
+
+		// the changed trie is searched until it is packed into flat arrays again
+		SearchIndex::SearchSession session;
+		index.search(L"methodwith", NodeTypeSet::all(), 20, 0, &session);
+		index.addNode(nameCount + 1, L"methodWithout");
+
+		std::vector<SearchResult> results = index.search(
+			L"methodwithout", NodeTypeSet::all(), 20, 0, &session);
+		REQUIRE(!index.isFlattened());
+		REQUIRE(results.size() == 1);
+		REQUIRE(results[0].elementIds == std::vector<Id>({nameCount + 1}));
+
+		index.repack();
+		REQUIRE(index.isFlattened());
+
+		results = index.search(L"methodwithout", NodeTypeSet::all(), 20, 0, &session);
+		REQUIRE(results.size() == 1);
+		REQUIRE(results[0].elementIds == std::vector<Id>({nameCount + 1}));
+	}
+}
+
+TEST_CASE("search index does not find anything when search is cancelled")
+{
+	SearchIndex index;
+	index.addNode(1, L"abc");
+	index.addNode(2, L"abd");
+	index.finishSetup();
+
+	SearchIndex::SearchSession session;
+	REQUIRE(index.search(L"ab", NodeTypeSet::all(), 0, 0, &session, []() { return true; }).empty());
+	REQUIRE(index.search(L"abc", NodeTypeSet::all(), 0, 0, &session).size() == 1);
+}
+
+TEST_CASE("search index passes found results before rescoring them")
+{
+	SearchIndex index;
+	for (Id id = 1; id <= 100; id++)
+	{
+		index.addNode(id, L"ns::method" + std::to_wstring(id));
+	}
+	index.finishSetup();
+
+	std::vector<std::wstring> foundTexts;
+	const std::vector<SearchResult> results = index.search(
+		L"m1",
+		NodeTypeSet::all(),
+		5,
+		0,
+		nullptr,
+		std::function<bool()>(),
+		[&foundTexts](const std::multiset<SearchResult>& foundResults) {
+			for (const SearchResult& result: foundResults)
+			{
+				foundTexts.push_back(result.text);
+			}
+		});
+
+	REQUIRE(results.size() == 5);
+	REQUIRE(foundTexts.size() > results.size());
+	for (const SearchResult& result: results)
+	{
+		REQUIRE(utility::containsElement(foundTexts, result.text));
+	}
+}
+
+TEST_CASE("search index benchmark", "[.][benchmark]")
+{
+	SearchIndex flatIndex;
+	SearchIndex trieIndex(false);
+	for (Id id = 1; id <= 500000; id++)
+	{
+		const std::wstring name = L"namespace" + std::to_wstring(id % 97) + L"::Class" +
+			std::to_wstring(id % 4999) + L"::method" + std::to_wstring(id);
+		flatIndex.addNode(id, name);
+		trieIndex.addNode(id, name);
+	}
+	flatIndex.finishSetup();
+	trieIndex.finishSetup();
+
+	const std::vector<std::wstring> queries = {L"nam1cl2me3", L"class42", L"m1234", L"spaceclass"};
+
+	size_t trieResultCount = 0;
+	BENCHMARK("search in trie")
+	{
+		for (const std::wstring& query: queries)
+		{
+			trieResultCount += trieIndex.search(query, NodeTypeSet::all(), 100).size();
+		}
+	}
+
+	size_t flatResultCount = 0;
+	BENCHMARK("search in flat arrays")
+	{
+		for (const std::wstring& query: queries)
+		{
+			flatResultCount += flatIndex.search(query, NodeTypeSet::all(), 100).size();
+		}
+	}
+
+	REQUIRE(trieResultCount == flatResultCount);
+}
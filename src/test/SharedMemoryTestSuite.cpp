@@ -1,9 +1,16 @@
 #include "catch.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <set>
 #include <thread>
 
+#include "InterprocessEvent.h"
 #include "SharedMemory.h"
+#include "SharedMemoryRing.h"
+#include "SharedStorageTypes.h"
+#include "SharedStringListTable.h"
 
 TEST_CASE("shared memory")
 {
@@ -96,3 +103,243 @@ TEST_CASE("shared memory")
 		}
 	}
 }
+
+TEST_CASE("shared memory ring passes records in order")
+{
+	SharedMemoryRing producer("ring", 4, 1024, true);
+	SharedMemoryRing consumer("ring", 0, 0, false);
+
+	REQUIRE(producer.getCapacity() == 4);
+	REQUIRE(consumer.getCapacity() == 4);
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		SharedMemoryRing::Record record;
+		record.type = i;
+		record.fields = {{"file_" + std::to_string(i)}, {"-flag", "-other_flag"}, {}};
+		REQUIRE(producer.tryPush(record));
+	}
+
+	REQUIRE(!producer.tryPush(SharedMemoryRing::Record()));
+	REQUIRE(consumer.size() == 4);
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		SharedMemoryRing::Record record;
+		REQUIRE(consumer.tryPop(record));
+		REQUIRE(record.type == i);
+		REQUIRE(record.fields.size() == 3);
+		REQUIRE(record.fields[0] == std::vector<std::string>({"file_" + std::to_string(i)}));
+		REQUIRE(record.fields[1] == std::vector<std::string>({"-flag", "-other_flag"}));
+		REQUIRE(record.fields[2].empty());
+	}
+
+	SharedMemoryRing::Record record;
+	REQUIRE(!consumer.tryPop(record));
+	REQUIRE(consumer.size() == 0);
+}
+
+TEST_CASE("shared memory ring reuses string pool of popped records while others are queued")
+{
+	SharedMemoryRing ring("ring", 8, 128, true);
+	REQUIRE(ring.getRecordPoolSize() == 64);
+
+	SharedMemoryRing::Record record;
+	record.fields = {{std::string(40, 'a')}};
+	REQUIRE(ring.tryPush(record));
+
+	record.fields = {{std::string(40, 'b')}};
+	REQUIRE(ring.tryPush(record));
+
+	record.fields = {{std::string(40, 'c')}};
+	REQUIRE(!ring.tryPush(record));
+
+	SharedMemoryRing::Record poppedRecord;
+	REQUIRE(ring.tryPop(poppedRecord));
+	REQUIRE(poppedRecord.fields[0][0] == std::string(40, 'a'));
+
+	REQUIRE(ring.tryPush(record));
+	REQUIRE(ring.tryPop(poppedRecord));
+	REQUIRE(poppedRecord.fields[0][0] == std::string(40, 'b'));
+	REQUIRE(ring.tryPop(poppedRecord));
+	REQUIRE(poppedRecord.fields[0][0] == std::string(40, 'c'));
+}
+
+TEST_CASE("shared memory ring tells consumers when it is closed")
+{
+	SharedMemoryRing producer("ring", 4, 1024, true);
+	SharedMemoryRing consumer("ring", 0, 0, false);
+
+	REQUIRE(!consumer.isClosed());
+	producer.close();
+	REQUIRE(consumer.isClosed());
+}
+
+TEST_CASE("shared memory ring passes each record to exactly one of many consumers")
+{
+	const size_t recordCount = 10000;
+	const size_t consumerCount = 8;
+
+	SharedMemoryRing producer("ring", 16, 1048576, true);
+
+	std::vector<std::vector<uint32_t>> poppedTypes(consumerCount);
+	std::vector<std::shared_ptr<std::thread>> threads;
+	for (size_t i = 0; i < consumerCount; i++)
+	{
+		threads.push_back(std::make_shared<std::thread>([&poppedTypes, i]() {
+			SharedMemoryRing consumer("ring", 0, 0, false);
+
+			SharedMemoryRing::Record record;
+			while (true)
+			{
+				if (!consumer.tryPop(record))
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				if (record.type == 0)
+				{
+					break;
+				}
+				poppedTypes[i].push_back(record.type);
+			}
+		}));
+	}
+
+	for (uint32_t i = 1; i <= recordCount + consumerCount; i++)
+	{
+		SharedMemoryRing::Record record;
+		record.type = i <= recordCount ? i : 0;
+		record.fields = {{"shared_string"}, {std::to_string(i)}};
+		while (!producer.tryPush(record))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	for (auto& thread: threads)
+	{
+		thread->join();
+	}
+
+	std::set<uint32_t> types;
+	for (const std::vector<uint32_t>& consumerTypes: poppedTypes)
+	{
+		types.insert(consumerTypes.begin(), consumerTypes.end());
+		REQUIRE(std::is_sorted(consumerTypes.begin(), consumerTypes.end()));
+	}
+
+	REQUIRE(types.size() == recordCount);
+	REQUIRE(*types.begin() == 1);
+	REQUIRE(*types.rbegin() == recordCount);
+}
+
+TEST_CASE("shared string list table passes lists by id")
+{
+	SharedStringListTable producer("table", 4, 1024, true);
+	SharedStringListTable consumer("table", 0, 0, false);
+
+	uint32_t firstId = 0;
+	uint32_t secondId = 0;
+	uint32_t emptyId = 0;
+	REQUIRE(producer.tryAdd({"-flag", "-other_flag"}, firstId));
+	REQUIRE(producer.tryAdd({"-flag", std::string("with\0null", 9)}, secondId));
+	REQUIRE(producer.tryAdd({}, emptyId));
+	REQUIRE(firstId != secondId);
+	REQUIRE(consumer.size() == 3);
+
+	std::vector<std::string> strings;
+	REQUIRE(consumer.get(secondId, strings));
+	REQUIRE(strings == std::vector<std::string>({"-flag", std::string("with\0null", 9)}));
+	REQUIRE(consumer.get(firstId, strings));
+	REQUIRE(strings == std::vector<std::string>({"-flag", "-other_flag"}));
+	REQUIRE(consumer.get(emptyId, strings));
+	REQUIRE(strings.empty());
+
+	REQUIRE(!consumer.get(3, strings));
+}
+
+TEST_CASE("shared string list table rejects lists when full")
+{
+	SharedStringListTable table("table", 2, 64, true);
+
+	uint32_t id = 0;
+	REQUIRE(!table.tryAdd({std::string(80, 'a')}, id));
+	REQUIRE(table.tryAdd({std::string(40, 'a')}, id));
+	REQUIRE(!table.tryAdd({std::string(40, 'b')}, id));
+	REQUIRE(table.tryAdd({"b"}, id));
+	REQUIRE(!table.tryAdd({"c"}, id));
+	REQUIRE(table.size() == 2);
+}
+
+TEST_CASE("shared storage types keep utf-8 node names and file paths")
+{
+	SharedMemory memory("storage_types", 10000, SharedMemory::CREATE_AND_DELETE);
+	SharedMemory::ScopedAccess access(&memory);
+
+	const std::string serializedName = "::\tmgr\xc3\xbc\xc3\x9f\ts\tp";
+	const std::string filePath = "/tmp/\xc3\xa4\xc3\xb6\xc3\xbc.cpp";
+
+	const StorageNode node = fromShared(
+		toShared(StorageNode(3, 4, serializedName), access.getAllocator()));
+	REQUIRE(node.id == 3);
+	REQUIRE(node.type == 4);
+	REQUIRE(node.serializedName == serializedName);
+
+	const StorageFile file = fromShared(toShared(
+		StorageFile(5, filePath, L"cpp", "", true, false), access.getAllocator()));
+	REQUIRE(file.id == 5);
+	REQUIRE(file.filePath == filePath);
+	REQUIRE(file.languageIdentifier == L"cpp");
+	REQUIRE(file.indexed);
+	REQUIRE(!file.complete);
+}
+
+TEST_CASE("interprocess event wait times out without notification")
+{
+	InterprocessEvent event("event", true);
+
+	REQUIRE(!event.wait(10));
+}
+
+TEST_CASE("interprocess event keeps notification sent before waiting")
+{
+	InterprocessEvent owner("event", true);
+	InterprocessEvent event("event", false);
+
+	owner.notify();
+	owner.notify();
+
+	REQUIRE(event.wait(0));
+	REQUIRE(!event.wait(0));
+}
+
+TEST_CASE("interprocess event wakes up all waiting instances")
+{
+	InterprocessEvent owner("event", true);
+
+	std::atomic<size_t> openedCount(0);
+	std::vector<int> notified(4, 0);
+	std::vector<std::shared_ptr<std::thread>> threads;
+	for (size_t i = 0; i < notified.size(); i++)
+	{
+		threads.push_back(std::make_shared<std::thread>([&openedCount, &notified, i]() {
+			InterprocessEvent event("event", false);
+			openedCount++;
+			notified[i] = event.wait(10000) ? 1 : 0;
+		}));
+	}
+
+	while (openedCount < notified.size())
+	{
+		std::this_thread::yield();
+	}
+	owner.notify();
+
+	for (auto& thread: threads)
+	{
+		thread->join();
+	}
+
+	REQUIRE(notified == std::vector<int>(4, 1));
+}
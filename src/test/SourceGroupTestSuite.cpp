@@ -18,6 +18,9 @@
 #include "utilityString.h"
 
 #if BUILD_CXX_LANGUAGE_PACKAGE
+#	include <clang/Tooling/JSONCompilationDatabase.h>
+
+#	include "CompilationDatabaseEntries.h"
 #	include "IndexerCommandCxx.h"
 #	include "SourceGroupCxxCdb.h"
 #	include "SourceGroupCxxCodeblocks.h"
@@ -125,6 +128,32 @@ std::wstring indexerCommandCxxToString(
 	}
 	return result;
 }
+
+utility::CompilationDatabaseEntries loadCompilationDatabaseEntries(const std::string& json)
+{
+	std::string error;
+	std::shared_ptr<clang::tooling::JSONCompilationDatabase> cdb =
+		clang::tooling::JSONCompilationDatabase::loadFromBuffer(
+			json, error, clang::tooling::JSONCommandLineSyntax::Gnu);
+	REQUIRE(error.empty());
+
+	return utility::CompilationDatabaseEntries(
+		cdb, FilePath(L"data/SourceGroupTestSuite/compile_commands.json"));
+}
+
+const utility::CompilationDatabaseEntries::Entry& getEntry(
+	const utility::CompilationDatabaseEntries& entries, const std::wstring& sourceFileArgument)
+{
+	for (const utility::CompilationDatabaseEntries::Entry& entry: entries.getEntries())
+	{
+		if (entry.sourceFileArgument == sourceFileArgument)
+		{
+			return entry;
+		}
+	}
+	FAIL("no entry for " + utility::encodeToUtf8(sourceFileArgument));
+	return entries.getEntries().front();
+}
 #endif	  // BUILD_CXX_LANGUAGE_PACKAGE
 
 #if BUILD_JAVA_LANGUAGE_PACKAGE
@@ -451,6 +480,64 @@ TEST_CASE("source group cxx cdb generates expected output")
 	applicationSettings->setFrameworkSearchPaths(storedFrameworkSearchPaths);
 }
 
+TEST_CASE("compilation database entries replace the source file argument by a placeholder")
+{
+	const utility::CompilationDatabaseEntries entries = loadCompilationDatabaseEntries(R"([
+		{"directory": "/src", "command": "clang++ -c a.cpp -I a.cpp.d", "file": "a.cpp"}
+	])");
+
+	REQUIRE(entries.getEntries().size() == 1);
+
+	const utility::CompilationDatabaseEntries::Entry& entry = getEntry(entries, L"a.cpp");
+	REQUIRE(entry.workingDirectory.wstr() == L"/src");
+	REQUIRE(
+		*entry.compilerFlags ==
+		std::vector<std::wstring>(
+			{L"clang++",
+			 L"-c",
+			 IndexerCommandCxx::s_sourceFileArgumentPlaceholder,
+			 L"-I",
+			 L"a.cpp.d"}));
+}
+
+TEST_CASE("compilation database entries drop output files")
+{
+	const utility::CompilationDatabaseEntries entries = loadCompilationDatabaseEntries(R"([
+		{
+			"directory": "/src",
+			"command": "clang++ -o a.o -c a.cpp -MF a.d -MT a.o -MQ a.o -std=c++14",
+			"file": "a.cpp"
+		}
+	])");
+
+	REQUIRE(
+		*getEntry(entries, L"a.cpp").compilerFlags ==
+		std::vector<std::wstring>(
+			{L"clang++",
+			 L"-c",
+			 IndexerCommandCxx::s_sourceFileArgumentPlaceholder,
+			 L"-std=c++14"}));
+}
+
+TEST_CASE("compilation database entries share identical flag sets")
+{
+	const utility::CompilationDatabaseEntries entries = loadCompilationDatabaseEntries(R"([
+		{"directory": "/src", "command": "clang++ -std=c++14 -c a.cpp -o a.o", "file": "a.cpp"},
+		{"directory": "/src", "command": "clang++ -std=c++14 -c b.cpp -o b.o", "file": "b.cpp"},
+		{"directory": "/src", "command": "clang++ -std=c++17 -c c.cpp -o c.o", "file": "c.cpp"}
+	])");
+
+	REQUIRE(entries.getEntries().size() == 3);
+	REQUIRE(entries.getCompilerFlagSetCount() == 2);
+
+	const utility::CompilationDatabaseEntries::Entry& a = getEntry(entries, L"a.cpp");
+	const utility::CompilationDatabaseEntries::Entry& b = getEntry(entries, L"b.cpp");
+	const utility::CompilationDatabaseEntries::Entry& c = getEntry(entries, L"c.cpp");
+	REQUIRE(a.compilerFlags == b.compilerFlags);
+	REQUIRE(a.compilerFlags != c.compilerFlags);
+	REQUIRE(b.sourceFileArgument == L"b.cpp");
+}
+
 #endif	  // BUILD_CXX_LANGUAGE_PACKAGE
 
 #if BUILD_JAVA_LANGUAGE_PACKAGE
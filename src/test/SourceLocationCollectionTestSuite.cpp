@@ -3,6 +3,7 @@
 #include "SourceLocation.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
+#include "TokenPositionIndex.h"
 
 TEST_CASE("source locations get created with other end")
 {
@@ -183,3 +184,37 @@ TEST_CASE("get source locations filtered by lines")
 	REQUIRE(copy.getSourceLocationById(e->getLocationId())->getStartLocation());
 	REQUIRE(!copy.getSourceLocationById(e->getLocationId())->getEndLocation());
 }
+
+TEST_CASE("token position index finds single line tokens covering position")
+{
+	SourceLocationFile file(FilePath(L"file.c"), L"cpp", true, true, true);
+	file.addSourceLocation(LOCATION_TOKEN, 1, {1}, 1, 3, 1, 5);
+	file.addSourceLocation(LOCATION_QUALIFIER, 2, {2}, 1, 7, 1, 9);
+	file.addSourceLocation(LOCATION_TOKEN, 3, {3}, 2, 1, 2, 10);
+	file.addSourceLocation(LOCATION_UNSOLVED, 4, {4}, 2, 4, 2, 6);
+
+	TokenPositionIndex index(file);
+
+	REQUIRE(4 == index.getEntryCount());
+
+	REQUIRE(index.getLocationIdsAtPosition(1, 2).empty());
+	REQUIRE(std::vector<Id>({1}) == index.getLocationIdsAtPosition(1, 3));
+	REQUIRE(std::vector<Id>({1}) == index.getLocationIdsAtPosition(1, 6));
+	REQUIRE(std::vector<Id>({2}) == index.getLocationIdsAtPosition(1, 7));
+	REQUIRE(std::vector<Id>({3, 4}) == index.getLocationIdsAtPosition(2, 5));
+	REQUIRE(std::vector<Id>({3}) == index.getLocationIdsAtPosition(2, 8));
+	REQUIRE(index.getLocationIdsAtPosition(3, 1).empty());
+}
+
+TEST_CASE("token position index ignores multi line and non token locations")
+{
+	SourceLocationFile file(FilePath(L"file.c"), L"cpp", true, true, true);
+	file.addSourceLocation(LOCATION_SCOPE, 1, {1}, 1, 1, 1, 20);
+	file.addSourceLocation(LOCATION_TOKEN, 2, {2}, 1, 3, 2, 5);
+	file.addSourceLocation(LOCATION_TOKEN, 3, {3}, 1, 4, 1, 6);
+
+	TokenPositionIndex index(file);
+
+	REQUIRE(1 == index.getEntryCount());
+	REQUIRE(std::vector<Id>({3}) == index.getLocationIdsAtPosition(1, 5));
+}
@@ -11,7 +11,7 @@ TEST_CASE("storage adds node successfully")
 		SqliteIndexStorage storage(databasePath);
 		storage.setup();
 		storage.beginTransaction();
-		storage.addNode(StorageNodeData(0, L"a"));
+		storage.addNode(StorageNodeData(0, "a"));
 		storage.commitTransaction();
 		nodeCount = storage.getNodeCount();
 	}
@@ -28,7 +28,7 @@ TEST_CASE("storage removes node successfully")
 		SqliteIndexStorage storage(databasePath);
 		storage.setup();
 		storage.beginTransaction();
-		Id nodeId = storage.addNode(StorageNodeData(0, L"a"));
+		Id nodeId = storage.addNode(StorageNodeData(0, "a"));
 		storage.removeElement(nodeId);
 		storage.commitTransaction();
 		nodeCount = storage.getNodeCount();
@@ -46,8 +46,8 @@ TEST_CASE("storage adds edge successfully")
 		SqliteIndexStorage storage(databasePath);
 		storage.setup();
 		storage.beginTransaction();
-		Id sourceNodeId = storage.addNode(StorageNodeData(0, L"a"));
-		Id targetNodeId = storage.addNode(StorageNodeData(0, L"b"));
+		Id sourceNodeId = storage.addNode(StorageNodeData(0, "a"));
+		Id targetNodeId = storage.addNode(StorageNodeData(0, "b"));
 		storage.addEdge(StorageEdgeData(0, sourceNodeId, targetNodeId));
 		storage.commitTransaction();
 		edgeCount = storage.getEdgeCount();
@@ -65,8 +65,8 @@ TEST_CASE("storage removes edge successfully")
 		SqliteIndexStorage storage(databasePath);
 		storage.setup();
 		storage.beginTransaction();
-		Id sourceNodeId = storage.addNode(StorageNodeData(0, L"a"));
-		Id targetNodeId = storage.addNode(StorageNodeData(0, L"b"));
+		Id sourceNodeId = storage.addNode(StorageNodeData(0, "a"));
+		Id targetNodeId = storage.addNode(StorageNodeData(0, "b"));
 		Id edgeId = storage.addEdge(StorageEdgeData(0, sourceNodeId, targetNodeId));
 		storage.removeElement(edgeId);
 		storage.commitTransaction();
@@ -76,3 +76,132 @@ TEST_CASE("storage removes edge successfully")
 
 	REQUIRE(0 == edgeCount);
 }
+
+TEST_CASE("storage rolls back nested transaction without discarding outer transaction")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	int nodeCount = -1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, "a"));
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, "b"));
+		storage.rollbackTransaction();
+		storage.commitTransaction();
+		nodeCount = storage.getNodeCount();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(1 == nodeCount);
+}
+
+TEST_CASE("storage hides write ahead log transaction from other connections until committed")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	int nodeCountDuringTransaction = -1;
+	int nodeCountAfterCommit = -1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+
+		SqliteIndexStorage otherStorage(databasePath);
+		otherStorage.setup();
+
+		REQUIRE(storage.enableWriteAheadLog());
+		storage.beginTransaction();
+		storage.beginTransaction();
+		storage.addNode(StorageNodeData(0, "a"));
+		storage.commitTransaction();
+		nodeCountDuringTransaction = otherStorage.getNodeCount();
+
+		storage.commitTransaction();
+		storage.checkpointWriteAheadLog();
+		nodeCountAfterCommit = otherStorage.getNodeCount();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(0 == nodeCountDuringTransaction);
+	REQUIRE(1 == nodeCountAfterCommit);
+}
+
+TEST_CASE("storage tracks previous state of changed nodes and edges")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	StorageChanges changes;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		Id nodeIdA = storage.addNode(StorageNodeData(0, "a"));
+		Id nodeIdB = storage.addNode(StorageNodeData(0, "b"));
+		Id edgeId = storage.addEdge(StorageEdgeData(1, nodeIdA, nodeIdB));
+		storage.commitTransaction();
+
+		storage.startChangeTracking();
+		storage.beginTransaction();
+		storage.setNodeType(2, nodeIdA);
+		storage.setNodeType(3, nodeIdA);
+		storage.removeElement(edgeId);
+		storage.addNode(StorageNodeData(0, "c"));
+		storage.commitTransaction();
+		changes = storage.getTrackedChanges();
+		storage.stopChangeTracking();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(2 == changes.nodeIds.size());
+	REQUIRE(1 == changes.previousNodes.size());
+	REQUIRE(0 == changes.previousNodes[0].type);
+	REQUIRE("a" == changes.previousNodes[0].serializedName);
+	REQUIRE(1 == changes.edgeIds.size());
+	REQUIRE(1 == changes.previousEdges.size());
+	REQUIRE(1 == changes.previousEdges[0].type);
+}
+
+TEST_CASE("storage removes elements only located in cleared files")
+{
+	FilePath databasePath(L"data/SQLiteTestSuite/test.sqlite");
+	int nodeCount = -1;
+	int edgeCount = -1;
+	int sourceLocationCount = -1;
+	{
+		SqliteIndexStorage storage(databasePath);
+		storage.setup();
+		storage.beginTransaction();
+		Id fileIdA = storage.addNode(StorageNodeData(0, "a"));
+		storage.addFile(StorageFile(fileIdA, "a.cpp", L"cpp", "", true, true));
+		Id fileIdB = storage.addNode(StorageNodeData(0, "b"));
+		storage.addFile(StorageFile(fileIdB, "b.cpp", L"cpp", "", true, true));
+
+		Id nodeIdX = storage.addNode(StorageNodeData(0, "x"));
+		Id nodeIdY = storage.addNode(StorageNodeData(0, "y"));
+		Id nodeIdZ = storage.addNode(StorageNodeData(0, "z"));
+		Id edgeIdXZ = storage.addEdge(StorageEdgeData(1, nodeIdX, nodeIdZ));
+		Id edgeIdZY = storage.addEdge(StorageEdgeData(1, nodeIdZ, nodeIdY));
+
+		Id locationIdA = storage.addSourceLocation(
+			StorageSourceLocationData(fileIdA, 1, 1, 1, 2, 0));
+		Id locationIdB = storage.addSourceLocation(
+			StorageSourceLocationData(fileIdB, 1, 1, 1, 2, 0));
+		storage.addOccurrence(StorageOccurrence(nodeIdX, locationIdA));
+		storage.addOccurrence(StorageOccurrence(nodeIdY, locationIdA));
+		storage.addOccurrence(StorageOccurrence(edgeIdXZ, locationIdA));
+		storage.addOccurrence(StorageOccurrence(nodeIdY, locationIdB));
+		storage.addOccurrence(StorageOccurrence(nodeIdZ, locationIdB));
+		storage.addOccurrence(StorageOccurrence(edgeIdZY, locationIdB));
+
+		storage.removeElementsWithLocationInFiles({fileIdA}, nullptr);
+		storage.commitTransaction();
+
+		nodeCount = storage.getNodeCount();
+		edgeCount = storage.getEdgeCount();
+		sourceLocationCount = storage.getSourceLocationCount();
+	}
+	FileSystem::remove(databasePath);
+
+	REQUIRE(4 == nodeCount);
+	REQUIRE(1 == edgeCount);
+	REQUIRE(1 == sourceLocationCount);
+}
@@ -5,6 +5,7 @@
 #include "IntermediateStorage.h"
 #include "ParseLocation.h"
 #include "PersistentStorage.h"
+#include "StorageProvider.h"
 
 namespace
 {
@@ -52,6 +53,16 @@ NameHierarchy createFunctionNameHierarchy(std::wstring ret, std::wstring name, s
 	nameHierarchy.push(NameElement(lastName, ret, parameters));
 	return nameHierarchy;
 }
+
+std::shared_ptr<IntermediateStorage> createIntermediateStorage(size_t nodeCount)
+{
+	std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		storage->addNode(StorageNodeData(0, "node_" + std::to_string(i)));
+	}
+	return storage;
+}
 }	 // namespace
 
 TEST_CASE("storage saves file")
@@ -66,7 +77,8 @@ TEST_CASE("storage saves file")
 					nodeKindToInt(NODE_FILE),
 					NameHierarchy::serialize(NameHierarchy(filePath, NAME_DELIMITER_FILE))))
 				.first;
-	intermetiateStorage->addFile(StorageFile(id, filePath, L"someLanguage", "someTime", true, true));
+	intermetiateStorage->addFile(StorageFile(
+		id, utility::encodeToUtf8(filePath), L"someLanguage", "someTime", true, true));
 
 	storage.inject(intermetiateStorage.get());
 
@@ -283,3 +295,103 @@ TEST_CASE("storage finds and removes depending file nodes")
 	// TS_ASSERT(!storage.getEdgeWithId(id4));
 	// TS_ASSERT(!storage.getEdgeWithId(id5));
 }
+
+TEST_CASE("intermediate storage deduplicates nodes, files, edges and errors")
+{
+	IntermediateStorage storage;
+
+	std::vector<StorageNode> nodes;
+	for (size_t i = 0; i < 1000; i++)
+	{
+		nodes.emplace_back(0, 1, "node_" + std::to_string(i));
+	}
+	const std::vector<Id> nodeIds = storage.addNodes(nodes);
+
+	const std::pair<Id, bool> addedNode = storage.addNode(StorageNodeData(4, "node_500"));
+	REQUIRE(addedNode.first == nodeIds[500]);
+	REQUIRE(!addedNode.second);
+	REQUIRE(storage.getStorageNodes()[500].type == 4);
+
+	storage.setNodeType(nodeIds[10], 8);
+	REQUIRE(storage.getStorageNodes()[10].type == 8);
+
+	storage.addFile(StorageFile(nodeIds[0], "file.cpp", L"", "", false, false));
+	storage.addFile(StorageFile(nodeIds[0], "file.cpp", L"", "", true, true));
+	storage.setFileLanguage(nodeIds[0], L"cpp");
+	REQUIRE(storage.getStorageFiles().size() == 1);
+	REQUIRE(storage.getStorageFiles().front().indexed);
+	REQUIRE(storage.getStorageFiles().front().languageIdentifier == L"cpp");
+
+	const Id edgeId = storage.addEdge(StorageEdgeData(1, nodeIds[1], nodeIds[2]));
+	REQUIRE(storage.addEdge(StorageEdgeData(1, nodeIds[1], nodeIds[2])) == edgeId);
+	REQUIRE(storage.addEdge(StorageEdgeData(1, nodeIds[2], nodeIds[1])) != edgeId);
+	REQUIRE(storage.addEdge(StorageEdgeData(2, nodeIds[1], nodeIds[2])) != edgeId);
+	REQUIRE(storage.getStorageEdges().size() == 3);
+
+	const Id errorId = storage.addError(StorageErrorData(L"error", L"file.cpp", false, true));
+	REQUIRE(storage.addError(StorageErrorData(L"error", L"file.cpp", false, true)) == errorId);
+	REQUIRE(storage.addError(StorageErrorData(L"error", L"file.cpp", true, true)) != errorId);
+	REQUIRE(storage.getErrors().size() == 2);
+
+	IntermediateStorage copy;
+	copy.setStorageNodes(storage.getStorageNodes());
+	copy.setStorageEdges(storage.getStorageEdges());
+	copy.setNextId(storage.getNextId());
+	REQUIRE(copy.addNode(StorageNodeData(1, "node_999")).first == nodeIds[999]);
+	REQUIRE(copy.addEdge(StorageEdgeData(1, nodeIds[1], nodeIds[2])) == edgeId);
+	REQUIRE(copy.addNode(StorageNodeData(1, "node_1000")).second);
+}
+
+TEST_CASE("storage provider accounts byte size of queued storages")
+{
+	StorageProvider provider;
+
+	std::shared_ptr<IntermediateStorage> storage1 = createIntermediateStorage(10);
+	std::shared_ptr<IntermediateStorage> storage2 = createIntermediateStorage(20);
+	const size_t byteSize1 = storage1->getByteSize(sizeof(std::wstring));
+	const size_t byteSize2 = storage2->getByteSize(sizeof(std::wstring));
+
+	provider.insert(storage1);
+	provider.insert(storage2);
+	REQUIRE(provider.getByteSize() == byteSize1 + byteSize2);
+
+	provider.consumeLargestStorage();
+	provider.consumeLargestStorage();
+	REQUIRE(provider.getByteSize() == 0);
+	REQUIRE(provider.getStorageCount() == 0);
+
+	provider.insert(storage1);
+	provider.clear();
+	REQUIRE(provider.getByteSize() == 0);
+}
+
+TEST_CASE("storage provider adapts target byte size to injection speed")
+{
+	StorageProvider provider;
+	provider.setMemoryBudget(1073741824 /* 1 GB */);
+
+	// nothing injected yet, so the whole budget can be used
+	REQUIRE(provider.getTargetByteSize() == 1073741824);
+
+	// slow injection keeps a small amount of data queued, but not less than the minimum
+	provider.recordInjection(1024, 1.0f);
+	REQUIRE(provider.getTargetByteSize() == 67108864);
+
+	provider.recordInjection(41943040 /* 40 MB */, 1.0f);
+	const size_t target = provider.getTargetByteSize();
+	REQUIRE(target > 67108864);
+	REQUIRE(target < 1073741824);
+
+	// fast injection uses the whole budget, but never more
+	for (int i = 0; i < 20; i++)
+	{
+		provider.recordInjection(1073741824, 1.0f);
+	}
+	REQUIRE(provider.getTargetByteSize() == 1073741824);
+
+	provider.setMemoryBudget(1024);
+	REQUIRE(provider.getTargetByteSize() == 1024);
+
+	provider.insert(createIntermediateStorage(100));
+	REQUIRE(provider.isAboveTargetByteSize());
+}
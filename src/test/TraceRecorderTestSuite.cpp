@@ -0,0 +1,107 @@
+#include "catch.hpp"
+
+#include <fstream>
+#include <set>
+#include <thread>
+
+#include "FilePath.h"
+#include "FileSystem.h"
+#include "TraceRecorder.h"
+
+namespace
+{
+void recordEvents(size_t nameId, unsigned int eventCount)
+{
+	for (unsigned int i = 0; i < eventCount; i++)
+	{
+		TraceRecorder::getInstance()->recordEvent(nameId, 10 + i, 5);
+	}
+}
+
+std::vector<std::string> readLines(const FilePath& filePath)
+{
+	std::vector<std::string> lines;
+	std::ifstream stream(filePath.str());
+	std::string line;
+	while (std::getline(stream, line))
+	{
+		lines.push_back(line);
+	}
+	return lines;
+}
+}	 // namespace
+
+TEST_CASE("trace recorder exports events of all threads as chrome trace")
+{
+	const FilePath traceFilePath(L"data/TraceRecorderTestSuite/trace.json");
+	FileSystem::createDirectory(traceFilePath.getParentDirectory());
+
+	// exports and discards the events recorded before this test
+	TraceRecorder* recorder = TraceRecorder::getInstance();
+	recorder->exportChromeTrace(traceFilePath);
+	FileSystem::remove(traceFilePath);
+
+	const size_t nameId = TraceRecorder::registerEventName("test event", "recordEvents");
+	const unsigned int eventCount = 3;
+
+	TraceRecorder::setEnabled(true);
+	std::thread thread0(recordEvents, nameId, eventCount);
+	std::thread thread1(recordEvents, nameId, eventCount);
+	thread0.join();
+	thread1.join();
+	TraceRecorder::setEnabled(false);
+
+	recorder->setProcessName("test \"process\"");
+	REQUIRE(recorder->exportChromeTrace(traceFilePath));
+	recorder->setProcessName("");
+
+	const std::vector<std::string> lines = readLines(traceFilePath);
+	FileSystem::remove(traceFilePath);
+
+	REQUIRE(lines.size() == 2 + 2 * eventCount);
+	REQUIRE(lines[0] == "[");
+	REQUIRE(lines[1].find("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":") == 0);
+	REQUIRE(lines[1].find(",\"args\":{\"name\":\"test \\\"process\\\"\"}},") != std::string::npos);
+
+	std::set<std::string> threadIds;
+	for (size_t i = 2; i < lines.size(); i++)
+	{
+		const std::string& line = lines[i];
+		REQUIRE(line.find("{\"name\":\"test event\",\"cat\":\"sourcetrail\",\"ph\":\"X\"") == 0);
+		REQUIRE(line.find(",\"ts\":1") != std::string::npos);
+		REQUIRE(line.find(",\"dur\":5,\"pid\":") != std::string::npos);
+		REQUIRE(line.find(",\"args\":{\"function\":\"recordEvents\"}},") != std::string::npos);
+
+		const size_t threadIdPos = line.find("\"tid\":");
+		REQUIRE(threadIdPos != std::string::npos);
+		threadIds.insert(line.substr(threadIdPos, line.find(',', threadIdPos) - threadIdPos));
+	}
+	REQUIRE(threadIds.size() == 2);
+
+	// events are only exported once
+	REQUIRE(recorder->exportChromeTrace(traceFilePath));
+	REQUIRE(readLines(traceFilePath).size() == 1);
+	FileSystem::remove(traceFilePath);
+}
+
+TEST_CASE("trace recorder exports events once when they span multiple chunks")
+{
+	const FilePath traceFilePath(L"data/TraceRecorderTestSuite/trace.json");
+	FileSystem::createDirectory(traceFilePath.getParentDirectory());
+
+	TraceRecorder* recorder = TraceRecorder::getInstance();
+	recorder->exportChromeTrace(traceFilePath);
+	FileSystem::remove(traceFilePath);
+
+	const size_t nameId = TraceRecorder::registerEventName("chunk event", "recordEvents");
+
+	for (unsigned int eventCount: {10u, 40000u, 40000u})
+	{
+		// recorded by this thread, so all events go to the same buffer
+		recordEvents(nameId, eventCount);
+
+		REQUIRE(recorder->exportChromeTrace(traceFilePath));
+		REQUIRE(readLines(traceFilePath).size() == 1 + eventCount);
+		FileSystem::remove(traceFilePath);
+	}
+}
@@ -1,5 +1,6 @@
 #include "catch.hpp"
 
+#include "HashIndex.h"
 #include "utility.h"
 
 TEST_CASE("trim blank spaces of string")
@@ -11,3 +12,32 @@ TEST_CASE("trim blank spaces of wstring")
 {
 	REQUIRE(utility::trim(L" foo  ") == L"foo");
 }
+
+TEST_CASE("hash index finds positions of equal elements")
+{
+	std::vector<int> values;
+	HashIndex index;
+	for (int i = 0; i < 1000; i++)
+	{
+		values.push_back(i * 7);
+		// few distinct hashes, so equal hashes need to be told apart by comparing the elements
+		index.insert(static_cast<size_t>(i % 10), values.size() - 1);
+	}
+
+	REQUIRE(index.size() == 1000);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		const int value = i * 7;
+		const size_t position = index.find(
+			static_cast<size_t>(i % 10), [&values, value](size_t p) { return values[p] == value; });
+		REQUIRE(position == static_cast<size_t>(i));
+	}
+
+	REQUIRE(
+		index.find(3, [&values](size_t p) { return values[p] == 1; }) == HashIndex::s_noPosition);
+
+	index.clear();
+	REQUIRE(index.size() == 0);
+	REQUIRE(index.find(0, [](size_t) { return true; }) == HashIndex::s_noPosition);
+}
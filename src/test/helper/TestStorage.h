@@ -22,11 +22,12 @@ public:
 		std::map<Id, FilePath> filePathMap;
 		for (const StorageFile& file: storage->getStorageFiles())
 		{
-			filePathMap.emplace(file.id, FilePath(file.filePath));
-			testStorage->files.emplace(file.filePath);
+			const std::wstring filePath = utility::decodeFromUtf8(file.filePath);
+			filePathMap.emplace(file.id, FilePath(filePath));
+			testStorage->files.emplace(filePath);
 
 			testStorage->addLine(
-				L"FILE: " + FilePath(file.filePath).fileName() +
+				L"FILE: " + FilePath(filePath).fileName() +
 				(file.indexed ? L"" : L" non-indexed"));
 		}
 